@@ -172,15 +172,15 @@ RCT_EXPORT_METHOD(isARSupported:(RCTResponseSenderBlock)callback)
 + (NSDictionary *)createDictionaryFromARPointCloud:(std::shared_ptr<VROARPointCloud>) pointCloud {
     NSMutableDictionary *dict = [[NSMutableDictionary alloc] init];
 
-    std::vector<VROVector4f> points = pointCloud->getPoints();
+    const auto &points = pointCloud->getPoints();
     NSMutableArray *pointsArray = [[NSMutableArray alloc] initWithCapacity:points.size()];
     
     // note: the 4th value of the VROVector4f is a "confidence" value only meaningful in Android.
-    for (VROVector4f point : points) {
+    for (const VROVector4f &point : points) {
         [pointsArray addObject:@[@(point.x), @(point.y), @(point.z), @(point.w)]];
     }
 
-    std::vector<uint64_t> identifiers = pointCloud->getIdentifiers();
+    const auto &identifiers = pointCloud->getIdentifiers();
     NSMutableArray *identifiersArray = [[NSMutableArray alloc] initWithCapacity:identifiers.size()];
 
     for (uint64_t identifier : identifiers) {
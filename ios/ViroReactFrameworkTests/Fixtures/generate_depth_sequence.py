@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# Generates room_orbit.vrds, the depth sequence VROTSDFVolumeTests replays.
+#
+# The sequence is rendered from an analytic scene rather than captured on a
+# device, so the tests can check the fused surface against exact geometry:
+# a 4 x 2.5 x 4 m room centered on the origin (floor at y = 0) with a
+# 0.6 m cube standing on the floor at its center. The camera orbits the cube
+# at 1.4 m height for 24 frames, then turns away to face the +x wall for 6
+# frames. Depth carries 3 mm of seeded Gaussian noise and is quantized to
+# millimeters; confidence drops at grazing angles, as on LiDAR devices.
+#
+# Usage: generate_depth_sequence.py [output path]
+
+import math
+import random
+import struct
+import sys
+
+WIDTH, HEIGHT = 64, 48
+FX = FY = 50.0
+CX, CY = WIDTH / 2.0, HEIGHT / 2.0
+ROOM_HALF, ROOM_HEIGHT = 2.0, 2.5
+CUBE_HALF = 0.3
+ORBIT_FRAMES, AWAY_FRAMES = 24, 6
+NOISE = 0.003
+
+
+def normalize(v):
+    length = math.sqrt(sum(c * c for c in v))
+    return [c / length for c in v]
+
+
+def cross(a, b):
+    return [a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]]
+
+
+def dot(a, b):
+    return sum(x * y for x, y in zip(a, b))
+
+
+def look_at(eye, target):
+    forward = normalize([t - e for t, e in zip(target, eye)])
+    right = normalize(cross(forward, [0, 1, 0]))
+    up = cross(right, forward)
+    back = [-c for c in forward]
+    # Column-major camera-to-world
+    return right + [0] + up + [0] + back + [0] + list(eye) + [1]
+
+
+def intersect(origin, direction):
+    """Smallest positive t at which origin + t * direction hits the scene,
+    and the normal there."""
+    best, normal = float('inf'), None
+    # Room: the ray leaves through one of six planes
+    for axis, low, high in ((0, -ROOM_HALF, ROOM_HALF), (1, 0.0, ROOM_HEIGHT), (2, -ROOM_HALF, ROOM_HALF)):
+        if direction[axis] != 0:
+            for bound, sign in ((low, 1), (high, -1)):
+                t = (bound - origin[axis]) / direction[axis]
+                if 1e-6 < t < best:
+                    best = t
+                    normal = [0, 0, 0]
+                    normal[axis] = sign
+    # Cube: slab test
+    low = [-CUBE_HALF, 0.0, -CUBE_HALF]
+    high = [CUBE_HALF, 2 * CUBE_HALF, CUBE_HALF]
+    t_near, t_far, near_axis = -float('inf'), float('inf'), 0
+    for axis in range(3):
+        if direction[axis] == 0:
+            if not low[axis] <= origin[axis] <= high[axis]:
+                return best, normal
+            continue
+        t0 = (low[axis] - origin[axis]) / direction[axis]
+        t1 = (high[axis] - origin[axis]) / direction[axis]
+        if t0 > t1:
+            t0, t1 = t1, t0
+        if t0 > t_near:
+            t_near, near_axis = t0, axis
+        t_far = min(t_far, t1)
+    if t_near <= t_far and 1e-6 < t_near < best:
+        best = t_near
+        normal = [0, 0, 0]
+        normal[near_axis] = -1 if direction[near_axis] > 0 else 1
+    return best, normal
+
+
+def render(pose, rng):
+    right, up, back, eye = pose[0:3], pose[4:7], pose[8:11], pose[12:15]
+    depth, confidence = [], []
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            # Camera-space direction with z = -1, so t is the depth
+            cx, cy = (x - CX) / FX, -(y - CY) / FY
+            direction = [cx * r + cy * u - b for r, u, b in zip(right, up, back)]
+            t, normal = intersect(eye, direction)
+            cosine = abs(dot(normalize(direction), normal))
+            d = t + rng.gauss(0, NOISE)
+            depth.append(max(0, min(65535, int(round(d * 1000)))))
+            confidence.append(255 if cosine > 0.3 else 128)
+    return depth, confidence
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else 'room_orbit.vrds'
+    rng = random.Random(30)
+    frames = []
+    for f in range(ORBIT_FRAMES):
+        angle = math.pi * f / (ORBIT_FRAMES - 1)
+        eye = [1.4 * math.cos(angle), 1.4, 1.4 * math.sin(angle)]
+        frames.append(look_at(eye, [0, 0.3, 0]))
+    for f in range(AWAY_FRAMES):
+        eye = [0.8, 1.4, 0.2 * f - 0.5]
+        frames.append(look_at(eye, [ROOM_HALF, 1.0, 0.2 * f - 0.5]))
+
+    with open(path, 'wb') as out:
+        out.write(b'VRDS')
+        out.write(struct.pack('<3I4fII', 1, WIDTH, HEIGHT, FX, FY, CX, CY, len(frames), 1))
+        for f, pose in enumerate(frames):
+            depth, confidence = render(pose, rng)
+            out.write(struct.pack('<d', f / 30.0 * 1000.0))
+            out.write(struct.pack('<16f', *pose))
+            out.write(struct.pack('<%dH' % len(depth), *depth))
+            out.write(bytes(confidence))
+
+
+if __name__ == '__main__':
+    main()
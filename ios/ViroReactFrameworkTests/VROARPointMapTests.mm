@@ -0,0 +1,176 @@
+//
+//  VROARPointMapTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROARPointMap.h>
+#include <cstdlib>
+#include <vector>
+
+static const int kCloudPoints = 20000;
+
+/*
+ A point cloud of kCloudPoints spread over a 4 m cube, with identifiers
+ starting at firstIdentifier as ARKit provides them.
+ */
+static VROARPointCloud createCloud(uint64_t firstIdentifier, unsigned seed) {
+    srand(seed);
+    std::vector<VROVector4f> points;
+    std::vector<uint64_t> identifiers;
+    points.reserve(kCloudPoints);
+    identifiers.reserve(kCloudPoints);
+    for (int i = 0; i < kCloudPoints; i++) {
+        points.push_back(VROVector4f(4.0f * rand() / RAND_MAX - 2.0f,
+                                     4.0f * rand() / RAND_MAX - 2.0f,
+                                     4.0f * rand() / RAND_MAX - 2.0f, 1.0f));
+        identifiers.push_back(firstIdentifier + i);
+    }
+    return VROARPointCloud(std::move(points), std::move(identifiers));
+}
+
+/*
+ Sum the cloud the way VRTARUtils serializes it, one point at a time.
+ */
+static float readCloud(const std::vector<VROVector4f> &points, const std::vector<uint64_t> &identifiers) {
+    float sum = 0;
+    for (const VROVector4f &point : points) {
+        sum += point.x + point.y + point.z + point.w;
+    }
+    for (uint64_t identifier : identifiers) {
+        sum += (float) (identifier & 1);
+    }
+    return sum;
+}
+
+@interface VROARPointMapTests : XCTestCase
+
+@end
+
+@implementation VROARPointMapTests
+
+/*
+ Points re-observed under the same identifier are merged, not duplicated.
+ */
+- (void)testDeduplicatesByIdentifier {
+    VROARPointMap map;
+    VROARPointCloud cloud = createCloud(0, 1);
+    map.update(cloud);
+    map.update(cloud);
+    XCTAssertEqual(map.getPointCount(), kCloudPoints);
+    XCTAssertEqual(map.getStats().mergedPoints, kCloudPoints);
+    XCTAssertEqual(map.getStats().insertedPoints, 0);
+}
+
+/*
+ Radius queries return exactly the points a brute-force scan finds.
+ */
+- (void)testRadiusMatchesBruteForce {
+    VROARPointMap map;
+    map.update(createCloud(0, 2));
+    const std::vector<VROVector3f> &positions = map.getPositions();
+
+    std::vector<int> found;
+    for (int q = 0; q < 200; q++) {
+        VROVector3f center = positions[(q * 97) % positions.size()];
+        found.clear();
+        map.findWithinRadius(center, 0.2f, found);
+
+        int expected = 0;
+        for (const VROVector3f &p : positions) {
+            float dx = p.x - center.x, dy = p.y - center.y, dz = p.z - center.z;
+            if (dx * dx + dy * dy + dz * dz <= 0.2f * 0.2f) {
+                expected++;
+            }
+        }
+        XCTAssertEqual((int) found.size(), expected);
+    }
+}
+
+/*
+ Before: callers copied the cloud's vectors out of getPoints() and
+ getIdentifiers() on every frame.
+ */
+- (void)testPerformanceReadCloudByCopy {
+    VROARPointCloud cloud = createCloud(0, 3);
+    VROARPointCloud *cloudPtr = &cloud;
+    [self measureBlock:^{
+        for (int i = 0; i < 100; i++) {
+            std::vector<VROVector4f> points = cloudPtr->getPoints();
+            std::vector<uint64_t> identifiers = cloudPtr->getIdentifiers();
+            readCloud(points, identifiers);
+        }
+    }];
+}
+
+/*
+ After: the same read through the const references.
+ */
+- (void)testPerformanceReadCloudByReference {
+    VROARPointCloud cloud = createCloud(0, 3);
+    VROARPointCloud *cloudPtr = &cloud;
+    [self measureBlock:^{
+        for (int i = 0; i < 100; i++) {
+            const auto &points = cloudPtr->getPoints();
+            const auto &identifiers = cloudPtr->getIdentifiers();
+            readCloud(points, identifiers);
+        }
+    }];
+}
+
+/*
+ Ten frames of half-overlapping clouds folded into the map.
+ */
+- (void)testPerformanceUpdate {
+    std::vector<VROARPointCloud> clouds;
+    for (int f = 0; f < 10; f++) {
+        clouds.push_back(createCloud(f * kCloudPoints / 2, f));
+    }
+    std::vector<VROARPointCloud> *cloudsPtr = &clouds;
+    [self measureBlock:^{
+        VROARPointMap map;
+        for (const VROARPointCloud &cloud : *cloudsPtr) {
+            map.update(cloud);
+        }
+    }];
+}
+
+/*
+ k-nearest-neighbor queries against a full map.
+ */
+- (void)testPerformanceNearest {
+    VROARPointMap map;
+    map.update(createCloud(0, 4));
+    VROARPointMap *mapPtr = &map;
+    [self measureBlock:^{
+        std::vector<int> found;
+        const std::vector<VROVector3f> &positions = mapPtr->getPositions();
+        for (int q = 0; q < 2000; q++) {
+            found.clear();
+            mapPtr->findNearest(positions[(q * 97) % positions.size()], 8, 0.5f, found);
+        }
+    }];
+}
+
+@end
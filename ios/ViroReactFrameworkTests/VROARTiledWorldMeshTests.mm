@@ -0,0 +1,298 @@
+//
+//  VROARTiledWorldMeshTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROARTiledWorldMesh.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <vector>
+
+/*
+ The tile collision bodies need Bullet, which the prebuilt framework does
+ not ship, so these tests check the tiles' meshes and update costs only.
+ */
+
+static const int kDepthWidth = 256;
+static const int kDepthHeight = 192;
+
+/*
+ A camera 1.6 m up looking straight down at a floor 0.1 m above the
+ origin, so every tile of the floor lies in one layer of cubes. The camera
+ is offset cameraX along the x axis.
+ */
+static VRODepthImage createFloorImage(const std::vector<float> &depth, float cameraX = 0) {
+    const float kLookDown[16] = { 1, 0, 0, 0,
+                                  0, 0, -1, 0,
+                                  0, 1, 0, 0,
+                                  cameraX, 1.6f, 0, 1 };
+    VRODepthImage image;
+    image.width = kDepthWidth;
+    image.height = kDepthHeight;
+    image.depth = depth.data();
+    image.fx = image.fy = 212.0f;
+    image.cx = kDepthWidth * 0.5f;
+    image.cy = kDepthHeight * 0.5f;
+    image.cameraToWorld = VROMatrix4f(kLookDown);
+    return image;
+}
+
+/*
+ The floor with a 0.3 m box standing on it under the image center.
+ */
+static std::vector<float> createBoxDepth() {
+    std::vector<float> depth(kDepthWidth * kDepthHeight, 1.5f);
+    for (int y = kDepthHeight / 2 - 20; y < kDepthHeight / 2 + 20; y++) {
+        for (int x = kDepthWidth / 2 - 20; x < kDepthWidth / 2 + 20; x++) {
+            depth[y * kDepthWidth + x] = 1.2f;
+        }
+    }
+    return depth;
+}
+
+typedef std::tuple<float, float, float> Corner;
+
+/*
+ Count the triangles across every tile, the distinct ones among them, and
+ the triangles a tile holds more than once. A triangle is identified by its
+ corner positions, in any order. Tiles overlap, so a triangle near a tile
+ border is expected in more than one tile, but never twice in one.
+ */
+static void countTriangles(const VROARTiledWorldMesh &mesh, int *total, int *distinct, int *stacked) {
+    std::set<std::vector<Corner>> triangles;
+    *total = 0;
+    *stacked = 0;
+    for (int t = 0; t < mesh.getTileCount(); t++) {
+        std::shared_ptr<VROARDepthMesh> tileMesh = mesh.getTileMesh(t);
+        if (!tileMesh) {
+            continue;
+        }
+        std::set<std::vector<Corner>> tileTriangles;
+        const std::vector<VROVector3f> &vertices = tileMesh->getVertices();
+        const std::vector<int> &indices = tileMesh->getIndices();
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            std::vector<Corner> corners;
+            for (int c = 0; c < 3; c++) {
+                const VROVector3f &v = vertices[indices[i + c]];
+                corners.push_back(Corner(v.x, v.y, v.z));
+            }
+            std::sort(corners.begin(), corners.end());
+            triangles.insert(corners);
+            if (!tileTriangles.insert(corners).second) {
+                (*stacked)++;
+            }
+            (*total)++;
+        }
+    }
+    *distinct = (int) triangles.size();
+}
+
+/*
+ Drop a vertical ray every 5 mm over the given x and z range onto the tile
+ meshes, and return how many hit no triangle of any tile.
+ */
+static int countVerticalMisses(const VROARTiledWorldMesh &mesh, float halfX, float halfZ) {
+    const float step = 0.005f;
+    int columns = (int) (2 * halfX / step) + 1;
+    int rows = (int) (2 * halfZ / step) + 1;
+    std::vector<uint8_t> hit(columns * rows, 0);
+
+    for (int t = 0; t < mesh.getTileCount(); t++) {
+        std::shared_ptr<VROARDepthMesh> tileMesh = mesh.getTileMesh(t);
+        if (!tileMesh) {
+            continue;
+        }
+        const std::vector<VROVector3f> &vertices = tileMesh->getVertices();
+        const std::vector<int> &indices = tileMesh->getIndices();
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const VROVector3f &a = vertices[indices[i]];
+            const VROVector3f &b = vertices[indices[i + 1]];
+            const VROVector3f &c = vertices[indices[i + 2]];
+            float area = (b.x - a.x) * (c.z - a.z) - (c.x - a.x) * (b.z - a.z);
+            if (area == 0) {
+                continue;
+            }
+            int x0 = std::max(0, (int) ceilf((std::min(std::min(a.x, b.x), c.x) + halfX) / step));
+            int x1 = std::min(columns - 1, (int) floorf((std::max(std::max(a.x, b.x), c.x) + halfX) / step));
+            int z0 = std::max(0, (int) ceilf((std::min(std::min(a.z, b.z), c.z) + halfZ) / step));
+            int z1 = std::min(rows - 1, (int) floorf((std::max(std::max(a.z, b.z), c.z) + halfZ) / step));
+            for (int zi = z0; zi <= z1; zi++) {
+                for (int xi = x0; xi <= x1; xi++) {
+                    float x = xi * step - halfX;
+                    float z = zi * step - halfZ;
+                    float u = ((b.x - x) * (c.z - z) - (c.x - x) * (b.z - z)) / area;
+                    float v = ((c.x - x) * (a.z - z) - (a.x - x) * (c.z - z)) / area;
+                    if (u >= 0 && v >= 0 && u + v <= 1) {
+                        hit[zi * columns + xi] = 1;
+                    }
+                }
+            }
+        }
+    }
+    return (int) std::count(hit.begin(), hit.end(), 0);
+}
+
+@interface VROARTiledWorldMeshTests : XCTestCase
+
+@end
+
+@implementation VROARTiledWorldMeshTests
+
+/*
+ An unchanged frame re-meshes nothing.
+ */
+- (void)testUnchangedFrameRebuildsNothing {
+    std::vector<float> depth(kDepthWidth * kDepthHeight, 1.5f);
+    VROARTiledWorldMesh mesh(nullptr);
+    mesh.forceUpdate(createFloorImage(depth));
+    XCTAssert(mesh.getStats().meshedTileCount > 1);
+    XCTAssertEqual(mesh.getStats().activeTileCount, 0);
+    XCTAssertEqual(mesh.getStats().rebuiltTileCount, mesh.getStats().tileCount);
+
+    mesh.forceUpdate(createFloorImage(depth));
+    XCTAssertEqual(mesh.getStats().rebuiltTileCount, 0);
+}
+
+/*
+ Every triangle of the frame is meshed, once into each tile it overlaps:
+ triangles of quads that straddle a tile border are in both tiles.
+ */
+- (void)testEachTriangleInEveryOverlappedTile {
+    std::vector<float> depth(kDepthWidth * kDepthHeight, 1.5f);
+    VROARTiledWorldMesh mesh(nullptr);
+    mesh.forceUpdate(createFloorImage(depth));
+
+    int stride = mesh.getConfig().mesh.stride;
+    int gridWidth = (kDepthWidth - 1) / stride + 1;
+    int gridHeight = (kDepthHeight - 1) / stride + 1;
+    int total, distinct, stacked;
+    countTriangles(mesh, &total, &distinct, &stacked);
+    XCTAssertEqual(distinct, (gridWidth - 1) * (gridHeight - 1) * 2);
+    XCTAssert(total > distinct);
+    XCTAssertEqual(stacked, 0);
+    XCTAssertEqual(mesh.getStats().triangleCount, total);
+}
+
+/*
+ A box appearing on the floor re-meshes only the tiles around it, and the
+ rebuilt tiles do not duplicate triangles. The floor the box occludes is
+ kept. Removing the box again restores exactly the floor.
+ */
+- (void)testChangeRebuildsOnlyAffectedTiles {
+    std::vector<float> floor(kDepthWidth * kDepthHeight, 1.5f);
+    std::vector<float> box = createBoxDepth();
+    VROARTiledWorldMesh mesh(nullptr);
+    mesh.forceUpdate(createFloorImage(floor));
+    int floorTriangles = mesh.getStats().triangleCount;
+
+    mesh.forceUpdate(createFloorImage(box));
+    XCTAssert(mesh.getStats().rebuiltTileCount > 0);
+    XCTAssert(mesh.getStats().rebuiltTileCount < mesh.getStats().tileCount);
+    int total, distinct, stacked;
+    countTriangles(mesh, &total, &distinct, &stacked);
+    XCTAssertEqual(stacked, 0);
+    XCTAssert(total > floorTriangles);
+
+    mesh.forceUpdate(createFloorImage(floor));
+    countTriangles(mesh, &total, &distinct, &stacked);
+    XCTAssertEqual(stacked, 0);
+    XCTAssertEqual(total, floorTriangles);
+}
+
+/*
+ A bump appears on the floor while the camera moves by half a grid cell, so
+ the tiles around the bump are rebuilt from a grid that no longer lines up
+ with their neighbours'. A ray dropped anywhere on the floor seen in both
+ frames still hits a tile.
+ */
+- (void)testNoGapsBetweenTilesRebuiltInDifferentFrames {
+    std::vector<float> floor(kDepthWidth * kDepthHeight, 1.5f);
+    std::vector<float> bump = floor;
+    for (int y = kDepthHeight / 2 - 20; y < kDepthHeight / 2 + 20; y++) {
+        for (int x = kDepthWidth / 2 - 20; x < kDepthWidth / 2 + 20; x++) {
+            bump[y * kDepthWidth + x] = 1.45f;
+        }
+    }
+    VROARTiledWorldMesh mesh(nullptr);
+    mesh.forceUpdate(createFloorImage(floor));
+    XCTAssertEqual(countVerticalMisses(mesh, 0.8f, 0.6f), 0);
+
+    mesh.forceUpdate(createFloorImage(bump, 0.013f));
+    XCTAssert(mesh.getStats().rebuiltTileCount > 0);
+    XCTAssert(mesh.getStats().rebuiltTileCount < mesh.getStats().tileCount);
+    XCTAssertEqual(countVerticalMisses(mesh, 0.8f, 0.6f), 0);
+}
+
+/*
+ Change detection on an unchanged 256 x 192 frame sampled at stride 2:
+ the sampling, reprojection and comparison that run on every update.
+ */
+- (void)testPerformanceUnchangedUpdate {
+    std::vector<float> depth(kDepthWidth * kDepthHeight, 1.5f);
+    VROTiledWorldMeshConfig config;
+    config.mesh.stride = 2;
+    VROARTiledWorldMesh mesh(nullptr, config);
+    mesh.forceUpdate(createFloorImage(depth));
+
+    VROARTiledWorldMesh *meshPtr = &mesh;
+    const std::vector<float> *depthPtr = &depth;
+    [self measureBlock:^{
+        for (int i = 0; i < 10; i++) {
+            meshPtr->forceUpdate(createFloorImage(*depthPtr));
+        }
+        NSLog(@"Unchanged update: %.2f ms sampling, %d tiles rebuilt",
+              meshPtr->getStats().sampleTimeMs, meshPtr->getStats().rebuiltTileCount);
+    }];
+}
+
+/*
+ Alternating between the floor and the box, so the tiles around the box
+ are re-meshed on every update.
+ */
+- (void)testPerformanceChangingUpdate {
+    std::vector<float> floor(kDepthWidth * kDepthHeight, 1.5f);
+    std::vector<float> box = createBoxDepth();
+    VROTiledWorldMeshConfig config;
+    config.mesh.stride = 2;
+    VROARTiledWorldMesh mesh(nullptr, config);
+    mesh.forceUpdate(createFloorImage(floor));
+
+    VROARTiledWorldMesh *meshPtr = &mesh;
+    const std::vector<float> *floorPtr = &floor;
+    const std::vector<float> *boxPtr = &box;
+    [self measureBlock:^{
+        for (int i = 0; i < 10; i++) {
+            meshPtr->forceUpdate(createFloorImage(i % 2 == 0 ? *boxPtr : *floorPtr));
+        }
+        NSLog(@"Changing update: %.2f ms sampling, %.2f ms rebuilding %d tiles",
+              meshPtr->getStats().sampleTimeMs, meshPtr->getStats().rebuildTimeMs,
+              meshPtr->getStats().rebuiltTileCount);
+    }];
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  VROAnimationClipTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROAnimationClip.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+static const int kInstances = 500;
+static const int kBones = 60;
+
+/*
+ A four-second, 30 Hz clip rotating and translating every bone of a
+ 60-bone skeleton.
+ */
+static std::shared_ptr<const VROAnimationClip> createSkeletonClip() {
+    VROAnimationClipBuilder builder("walk");
+    const int keys = 4 * 30;
+    std::vector<float> times(keys);
+    for (int k = 0; k < keys; k++) {
+        times[k] = k / 30.0f;
+    }
+    for (int bone = 0; bone < kBones; bone++) {
+        std::vector<float> rotations, translations;
+        for (int k = 0; k < keys; k++) {
+            float angle = 0.5f * sinf(times[k] * 3.0f + bone);
+            rotations.insert(rotations.end(), { sinf(angle * 0.5f), 0, 0, cosf(angle * 0.5f) });
+            translations.insert(translations.end(), { 0, 0.1f + 0.01f * angle, 0 });
+        }
+        builder.addTrack(bone, 0, VROAnimationTrackType::Quaternion, VROAnimationInterpolation::Linear,
+                         times, rotations);
+        builder.addTrack(bone, 1, VROAnimationTrackType::Vector3, VROAnimationInterpolation::Linear,
+                         times, translations);
+    }
+    return builder.build();
+}
+
+@interface VROAnimationClipTests : XCTestCase
+
+@end
+
+@implementation VROAnimationClipTests
+
+- (void)testSampleInterpolates {
+    VROAnimationClipBuilder builder("test");
+    builder.addTrack(0, 0, VROAnimationTrackType::Float, VROAnimationInterpolation::Linear, { 0, 1, 2 }, { 0, 10, 30 });
+    builder.addTrack(0, 1, VROAnimationTrackType::Float, VROAnimationInterpolation::Step, { 0, 1, 2 }, { 0, 10, 30 });
+    std::shared_ptr<const VROAnimationClip> clip = builder.build();
+    XCTAssertEqual(clip->getDuration(), 2.0f);
+    XCTAssertEqual(clip->getOutputSize(), 2);
+
+    VROAnimationInstance instance(clip);
+    instance.setLooping(false);
+    instance.advance(1.5f);
+    XCTAssertEqualWithAccuracy(instance.getOutput()[0], 20.0f, 1e-5);
+    XCTAssertEqualWithAccuracy(instance.getOutput()[1], 10.0f, 1e-5);
+
+    instance.advance(5.0f);
+    XCTAssert(instance.isFinished());
+    XCTAssertEqualWithAccuracy(instance.getOutput()[0], 30.0f, 1e-5);
+}
+
+/*
+ 500 instances of one shared skeleton clip, at staggered times, advanced
+ one 60 Hz frame.
+ */
+- (void)testPerformance500Instances {
+    std::shared_ptr<const VROAnimationClip> clip = createSkeletonClip();
+    std::vector<std::unique_ptr<VROAnimationInstance>> instances;
+    std::vector<VROAnimationInstance *> pointers;
+    for (int i = 0; i < kInstances; i++) {
+        instances.emplace_back(new VROAnimationInstance(clip));
+        instances.back()->setTime(i * 0.0137f);
+        instances.back()->setSpeed(0.8f + (i % 5) * 0.1f);
+        pointers.push_back(instances.back().get());
+    }
+
+    [self measureBlock:^{
+        VROAnimationSampler::advance(pointers, 1.0f / 60.0f);
+    }];
+}
+
+@end
@@ -0,0 +1,337 @@
+//
+//  VROBodyAnimStreamTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROBodyAnimStream.h>
+#include <ViroKit/VRORenderContext.h>
+#include <malloc/malloc.h>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Ten minutes at 30 Hz
+static const int kTenMinuteRows = 10 * 60 * 30;
+
+static std::shared_ptr<VROBodyAnimData> createRecording(int rows) {
+    std::shared_ptr<VROBodyAnimData> data = std::make_shared<VROBodyAnimData>();
+    data->setVersion("1.0");
+    data->setTotalTime(rows * 1000.0 / 30.0);
+    for (int r = 0; r < rows; r++) {
+        std::map<VROBodyJointType, VROVector3f> joints;
+        for (int j = 0; j < kNumBodyJoints; j++) {
+            float t = r / 30.0f + j;
+            joints[(VROBodyJointType) j] = VROVector3f(sinf(t), 1.0f + 0.5f * cosf(t * 0.7f), -2.0f + 0.1f * j);
+        }
+        data->addAnimRow(r * 1000.0 / 30.0, joints);
+    }
+    return data;
+}
+
+static std::string temporaryPath(const char *name) {
+    return std::string([NSTemporaryDirectory() UTF8String]) + name;
+}
+
+/*
+ Bytes allocated on the heap by this process.
+ */
+static size_t getHeapInUse() {
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(nullptr, &statistics);
+    return statistics.size_in_use;
+}
+
+/*
+ Stands in for the platform's JSON reader, returning a fixed recording.
+ */
+class TestAnimReader : public VROBodyAnimDataReader {
+public:
+    TestAnimReader(std::shared_ptr<VROBodyAnimData> data) : _data(data) {}
+    std::shared_ptr<VROBodyAnimData> fromJSON(std::string jsonData) {
+        return jsonData.empty() ? nullptr : _data;
+    }
+private:
+    std::shared_ptr<VROBodyAnimData> _data;
+};
+
+/*
+ Records what the player delivers.
+ */
+class TestPlayerDelegate : public VROBodyPlayerDelegate {
+public:
+    int startCount = 0;
+    std::map<VROBodyJointType, VROVector3f> joints;
+    VROBodyPlayerStatus status = VROBodyPlayerStatus::Initialized;
+
+    void onBodyPlaybackStarting(std::shared_ptr<VROBodyAnimData> animData) {
+        startCount++;
+    }
+    void onBodyJointsPlayback(const std::map<VROBodyJointType, VROVector3f> &joints, VROBodyPlayerStatus status) {
+        this->joints = joints;
+        this->status = status;
+    }
+};
+
+@interface VROBodyAnimStreamTests : XCTestCase
+
+@end
+
+@implementation VROBodyAnimStreamTests
+
+/*
+ Rows recorded out of order are written sorted, so the result can be read
+ back and searched.
+ */
+- (void)testEncodeSortsRows {
+    std::shared_ptr<VROBodyAnimData> data = std::make_shared<VROBodyAnimData>();
+    data->setTotalTime(300);
+    const double timestamps[] = { 200, 0, 100, NAN, 300 };
+    for (double timestamp : timestamps) {
+        std::map<VROBodyJointType, VROVector3f> joints;
+        joints[(VROBodyJointType) 0] = VROVector3f(std::isnan(timestamp) ? 0 : timestamp, 0, 0);
+        data->addAnimRow(timestamp, joints);
+    }
+
+    std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(VROBodyAnimStreamWriter::encode(data));
+    XCTAssert(stream != nullptr);
+    XCTAssertEqual(stream->getTotalRows(), 4);
+    for (long r = 0; r < 4; r++) {
+        XCTAssertEqual(stream->getAnimRowTimestamp(r), r * 100.0);
+        VROVector3f positions[kNumBodyJoints];
+        stream->getAnimRowJoints(r, positions);
+        XCTAssertEqualWithAccuracy(positions[0].x, r * 100.0, 0.01);
+    }
+    XCTAssertEqual(stream->findRow(150), 2);
+}
+
+/*
+ A ten-minute recording is at most 6 bytes per joint per row plus the
+ timestamp and presence columns, and decodes to within the quantization
+ step.
+ */
+- (void)testTenMinuteRecordingSize {
+    std::shared_ptr<VROBodyAnimData> data = createRecording(kTenMinuteRows);
+    std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(VROBodyAnimStreamWriter::encode(data));
+    XCTAssert(stream != nullptr);
+
+    size_t bound = (size_t) kTenMinuteRows * (kNumBodyJoints * 6 + sizeof(double) + sizeof(uint32_t)) + 4096;
+    XCTAssertLessThan(stream->getSize(), bound);
+
+    VROVector3f positions[kNumBodyJoints];
+    for (long r = 0; r < kTenMinuteRows; r += 997) {
+        stream->getAnimRowJoints(r, positions);
+        std::map<VROBodyJointType, VROVector3f> expected = data->getAnimRowJoints(r);
+        for (int j = 0; j < kNumBodyJoints; j++) {
+            XCTAssertEqualWithAccuracy(positions[j].x, expected[(VROBodyJointType) j].x, 1e-4);
+            XCTAssertEqualWithAccuracy(positions[j].y, expected[(VROBodyJointType) j].y, 1e-4);
+        }
+    }
+}
+
+/*
+ A recording written to disk and memory mapped reads back the same rows and
+ metadata as the in-memory buffer. Missing and truncated files fail to open.
+ */
+- (void)testOpenMappedFile {
+    std::shared_ptr<VROBodyAnimData> data = createRecording(1000);
+    data->setBoneLengths({ { "spine", 0.5f } });
+    std::string path = temporaryPath("testOpenMappedFile.vrba");
+    XCTAssertTrue(VROBodyAnimStreamWriter::write(data, path));
+
+    std::shared_ptr<VROBodyAnimStream> mapped = VROBodyAnimStream::open(path);
+    std::shared_ptr<VROBodyAnimStream> buffered = VROBodyAnimStream::open(VROBodyAnimStreamWriter::encode(data));
+    XCTAssert(mapped != nullptr);
+    XCTAssert(buffered != nullptr);
+    XCTAssertEqual(mapped->getTotalRows(), 1000);
+    XCTAssertEqual(mapped->getSize(), buffered->getSize());
+    XCTAssert(mapped->getVersion() == "1.0");
+    XCTAssertEqual(mapped->getBoneLengths().at("spine"), 0.5f);
+    for (long r = 0; r < 1000; r += 37) {
+        XCTAssertEqual(mapped->getAnimRowTimestamp(r), buffered->getAnimRowTimestamp(r));
+        VROVector3f a[kNumBodyJoints], b[kNumBodyJoints];
+        XCTAssertEqual(mapped->getAnimRowJoints(r, a), buffered->getAnimRowJoints(r, b));
+        for (int j = 0; j < kNumBodyJoints; j++) {
+            XCTAssertEqual(a[j].x, b[j].x);
+            XCTAssertEqual(a[j].z, b[j].z);
+        }
+    }
+
+    XCTAssert(VROBodyAnimStream::open(temporaryPath("missing.vrba")) == nullptr);
+    std::string truncatedPath = temporaryPath("testOpenMappedFileTruncated.vrba");
+    std::vector<uint8_t> encoded = VROBodyAnimStreamWriter::encode(data);
+    FILE *file = fopen(truncatedPath.c_str(), "wb");
+    fwrite(encoded.data(), 1, encoded.size() / 2, file);
+    fclose(file);
+    XCTAssert(VROBodyAnimStream::open(truncatedPath) == nullptr);
+
+    remove(path.c_str());
+    remove(truncatedPath.c_str());
+}
+
+/*
+ loadRecording() maps a file and replaces the player's stream; a file that
+ fails to load keeps the current one. loadAnimation() converts JSON through
+ the reader.
+ */
+- (void)testPlayerLoadsRecordingAndJSON {
+    std::shared_ptr<VROBodyAnimData> data = createRecording(300);
+    std::string path = temporaryPath("testPlayerLoadsRecording.vrba");
+    XCTAssertTrue(VROBodyAnimStreamWriter::write(data, path));
+
+    std::shared_ptr<VROBodyStreamPlayer> player = std::make_shared<VROBodyStreamPlayer>(
+            std::make_shared<TestAnimReader>(createRecording(50)));
+    XCTAssertTrue(player->loadRecording(path));
+    XCTAssertEqual(player->getStream()->getTotalRows(), 300);
+
+    XCTAssertFalse(player->loadRecording(temporaryPath("missing.vrba")));
+    XCTAssertEqual(player->getStream()->getTotalRows(), 300);
+
+    player->loadAnimation("{}");
+    XCTAssertEqual(player->getStream()->getTotalRows(), 50);
+    player->loadAnimation("");
+    XCTAssertEqual(player->getStream()->getTotalRows(), 50);
+
+    remove(path.c_str());
+}
+
+/*
+ Playback delivers the row at the player's time. setTime() places the
+ player on a row, so each frame's row is known without waiting: the next
+ row is 33 ms later. Past the last row playback finishes, or restarts
+ when looping.
+ */
+- (void)testPlayerPlayback {
+    std::shared_ptr<VROBodyAnimData> data = createRecording(300);
+    std::shared_ptr<VROBodyStreamPlayer> player = std::make_shared<VROBodyStreamPlayer>();
+    std::shared_ptr<TestPlayerDelegate> delegate = std::make_shared<TestPlayerDelegate>();
+    player->setDelegate(delegate);
+
+    std::string path = temporaryPath("testPlayerPlayback.vrba");
+    XCTAssertTrue(VROBodyAnimStreamWriter::write(data, path));
+    XCTAssertTrue(player->loadRecording(path));
+    VRORenderContext context(nullptr);
+
+    player->start();
+    XCTAssertEqual(delegate->startCount, 1);
+    player->setTime(5000);
+    player->onFrameWillRender(context);
+    XCTAssert(delegate->status == VROBodyPlayerStatus::Start);
+    std::map<VROBodyJointType, VROVector3f> expected = data->getAnimRowJoints(150);
+    XCTAssertEqual(delegate->joints.size(), kNumBodyJoints);
+    XCTAssertEqualWithAccuracy(delegate->joints[(VROBodyJointType) 3].x, expected[(VROBodyJointType) 3].x, 1e-4);
+
+    player->setTime(6000);
+    player->onFrameWillRender(context);
+    XCTAssert(delegate->status == VROBodyPlayerStatus::Playing);
+    expected = data->getAnimRowJoints(180);
+    XCTAssertEqualWithAccuracy(delegate->joints[(VROBodyJointType) 3].x, expected[(VROBodyJointType) 3].x, 1e-4);
+
+    player->setTime(data->getAnimRowTimestamp(299));
+    player->onFrameWillRender(context);
+    XCTAssert(delegate->status == VROBodyPlayerStatus::Finished);
+    player->onFrameWillRender(context);
+    XCTAssert(delegate->status == VROBodyPlayerStatus::Finished);
+
+    // Starting again from the end rewinds; looping restarts instead of finishing
+    player->setLooping(true);
+    player->start();
+    XCTAssertEqual(delegate->startCount, 2);
+    player->setTime(data->getAnimRowTimestamp(299));
+    player->onFrameWillRender(context);
+    player->onFrameWillRender(context);
+    XCTAssert(delegate->status == VROBodyPlayerStatus::Start);
+    expected = data->getAnimRowJoints(0);
+    XCTAssertEqualWithAccuracy(delegate->joints[(VROBodyJointType) 3].x, expected[(VROBodyJointType) 3].x, 1e-4);
+
+    remove(path.c_str());
+}
+
+/*
+ Memory for a ten-minute capture: the heap held by VROBodyAnimData (a map
+ per row) against the binary file, which a mapped stream reads in place
+ with only its parsed metadata on the heap.
+ */
+- (void)testTenMinuteRecordingMemory {
+    size_t heapBefore = getHeapInUse();
+    std::shared_ptr<VROBodyAnimData> data = createRecording(kTenMinuteRows);
+    size_t animDataBytes = getHeapInUse() - heapBefore;
+
+    std::string path = temporaryPath("testTenMinuteRecordingMemory.vrba");
+    XCTAssertTrue(VROBodyAnimStreamWriter::write(data, path));
+    data.reset();
+
+    heapBefore = getHeapInUse();
+    std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(path);
+    size_t streamHeapBytes = getHeapInUse() - heapBefore;
+    XCTAssert(stream != nullptr);
+
+    NSLog(@"Ten-minute recording: VROBodyAnimData %.2f MB on the heap; binary file %.2f MB, mapped with %.1f KB on the heap",
+          animDataBytes / 1048576.0, stream->getSize() / 1048576.0, streamHeapBytes / 1024.0);
+    XCTAssertLessThan(stream->getSize() * 5, animDataBytes);
+    XCTAssertLessThan(streamHeapBytes, 64 * 1024);
+
+    stream.reset();
+    remove(path.c_str());
+}
+
+/*
+ Open a memory-mapped ten-minute recording, including validating its
+ timestamps.
+ */
+- (void)testPerformanceTenMinuteMappedLoad {
+    std::string path = temporaryPath("testPerformanceTenMinuteMappedLoad.vrba");
+    XCTAssertTrue(VROBodyAnimStreamWriter::write(createRecording(kTenMinuteRows), path));
+    std::string *pathPtr = &path;
+    [self measureBlock:^{
+        std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(*pathPtr);
+        XCTAssert(stream != nullptr);
+    }];
+    remove(path.c_str());
+}
+
+- (void)testPerformanceTenMinuteLoad {
+    std::vector<uint8_t> encoded = VROBodyAnimStreamWriter::encode(createRecording(kTenMinuteRows));
+    [self measureBlock:^{
+        std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(encoded);
+        XCTAssert(stream != nullptr);
+    }];
+}
+
+- (void)testPerformanceTenMinuteSeek {
+    std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(
+            VROBodyAnimStreamWriter::encode(createRecording(kTenMinuteRows)));
+    const double totalTime = stream->getTotalTime();
+    [self measureBlock:^{
+        VROVector3f positions[kNumBodyJoints];
+        srand(7);
+        for (int i = 0; i < 10000; i++) {
+            long row = stream->findRow(totalTime * rand() / RAND_MAX);
+            stream->getAnimRowJoints(row, positions);
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,448 @@
+//
+//  VROClusteredLightingTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROClusteredLighting.h>
+#include <ViroKit/VRORecordingDriver.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <utility>
+
+static const float kNear = 0.1f;
+static const float kFar = 100.0f;
+
+/*
+ Symmetric 60 degree perspective projection, column-major.
+ */
+static void makeProjection(float *projection) {
+    float f = 1.0f / tanf(M_PI / 6.0f);
+    for (int i = 0; i < 16; i++) {
+        projection[i] = 0;
+    }
+    projection[0] = f / (16.0f / 9.0f);
+    projection[5] = f;
+    projection[10] = (kFar + kNear) / (kNear - kFar);
+    projection[11] = -1;
+    projection[14] = 2 * kFar * kNear / (kNear - kFar);
+}
+
+/*
+ True if the cluster containing the given view-space point lists the light.
+ */
+static bool clusterHasLight(const VROClusteredLightGrid &grid, float x, float y, float z, uint32_t light) {
+    int cluster = grid.getClusterIndex(x, y, z);
+    if (cluster < 0) {
+        return false;
+    }
+    uint32_t offset = grid.getClusters()[cluster * 2];
+    uint32_t count = grid.getClusters()[cluster * 2 + 1];
+    for (uint32_t i = offset; i < offset + count; i++) {
+        if (grid.getLightIndices()[i] == light) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ Scatter lights through the view frustum between 2 and 60 units, as in a
+ large lit interior: three point lights for every spot light, with radii of
+ 1 to 5 units. Positions come from a fixed LCG so runs are comparable.
+ Returns the view-space positions of the point lights, by light index.
+ */
+static std::vector<std::pair<uint32_t, VROVector3f>> addSceneLights(VROClusteredLightGrid &grid, int count) {
+    std::vector<std::pair<uint32_t, VROVector3f>> pointLights;
+    uint32_t state = 12345;
+    auto random = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / (float) (1 << 24);
+    };
+    const float tanHalfFov = tanf(M_PI / 6.0f);
+    for (int l = 0; l < count; l++) {
+        float depth = 2 + random() * 58;
+        float position[3] = {
+            (random() * 2 - 1) * 0.9f * tanHalfFov * (16.0f / 9.0f) * depth,
+            (random() * 2 - 1) * 0.9f * tanHalfFov * depth,
+            -depth
+        };
+        float radius = 1 + random() * 4;
+        if (l % 4 == 3) {
+            VROVector3f direction = VROVector3f(random() * 2 - 1, random() * 2 - 1, -1).normalize();
+            float directionArray[3] = { direction.x, direction.y, direction.z };
+            grid.addLight(position, radius, directionArray, VROClusteredLightGrid::getSpotCosine(45));
+        } else {
+            float down[3] = { 0, -1, 0 };
+            grid.addLight(position, radius, down, -1);
+            pointLights.push_back({ (uint32_t) l, VROVector3f(position[0], position[1], position[2]) });
+        }
+    }
+    return pointLights;
+}
+
+/*
+ Recording driver that also issues its texture binds to the current GL
+ context, so the uploader's textures are really bound.
+ */
+class VROTestGLTextureDriver : public VRORecordingDriver {
+public:
+    void setActiveTextureUnit(int unit) {
+        VRORecordingDriver::setActiveTextureUnit(unit);
+        glActiveTexture(unit);
+    }
+    void bindTexture(int target, int texture) {
+        VRORecordingDriver::bindTexture(target, texture);
+        glBindTexture(target, texture);
+    }
+};
+
+static const int kTargetSize = 64;
+static const float kPlaneDepth = 5.0f;
+
+/*
+ A stand-in for the standard fragment shader: the modifier's uniforms at the
+ top, and its body after _output_color is set, with the surface a plane
+ facing the camera at kPlaneDepth. The view matrix is the identity, so
+ world and view space coincide.
+ */
+static std::string createLitPlaneFragmentShader() {
+    std::string uniforms, body;
+    for (const std::string &line : VROClusteredLightingShaderSource()) {
+        (line.compare(0, 8, "uniform ") == 0 ? uniforms : body) += line + "\n";
+    }
+    return "#version 300 es\n"
+           "struct VROSurface {\n"
+           "    lowp vec4 diffuse_color;\n"
+           "    lowp float diffuse_intensity;\n"
+           "    lowp float shininess;\n"
+           "    lowp vec3 specular_color;\n"
+           "    lowp vec3 normal;\n"
+           "    highp vec3 position;\n"
+           "} _surface;\n" + uniforms +
+           "uniform highp vec2 test_projection;\n"
+           "layout (location = 0) out highp vec4 frag_color;\n"
+           "void main() {\n"
+           "    highp vec2 ndc = gl_FragCoord.xy / cluster_viewport.zw * 2.0 - 1.0;\n"
+           "    _surface.position = vec3(ndc / test_projection * " + std::to_string(kPlaneDepth) + ", -" +
+                std::to_string(kPlaneDepth) + ");\n"
+           "    _surface.normal = vec3(0.0, 0.0, 1.0);\n"
+           "    _surface.diffuse_color = vec4(1.0);\n"
+           "    _surface.diffuse_intensity = 1.0;\n"
+           "    _surface.shininess = 2.0;\n"
+           "    _surface.specular_color = vec3(0.0);\n"
+           "    highp vec4 _output_color = vec4(0.0, 0.0, 0.0, 1.0);\n" + body +
+           "    frag_color = _output_color;\n"
+           "}\n";
+}
+
+static GLuint compileShader(GLenum type, const std::string &source) {
+    GLuint shader = glCreateShader(type);
+    const char *text = source.c_str();
+    glShaderSource(shader, 1, &text, nullptr);
+    glCompileShader(shader);
+    GLint status = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        char log[2048];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        NSLog(@"Shader compile failed: %s", log);
+    }
+    return shader;
+}
+
+static std::shared_ptr<VROLight> createOmniLight(VROVector3f position, VROVector3f color, float radius) {
+    std::shared_ptr<VROLight> light = std::make_shared<VROLight>(VROLightType::Omni);
+    light->setColor(color);
+    light->setIntensity(1000);
+    light->setAttenuationStartDistance(0);
+    light->setAttenuationEndDistance(radius);
+    light->setAttenuationFalloffExponent(2);
+    light->setTransformedPosition(position);
+    return light;
+}
+
+@interface VROClusteredLightingTests : XCTestCase
+
+@end
+
+@implementation VROClusteredLightingTests {
+    EAGLContext *_context;
+}
+
+- (void)setUp {
+    [super setUp];
+    _context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(_context);
+    [EAGLContext setCurrentContext:_context];
+}
+
+- (void)tearDown {
+    [EAGLContext setCurrentContext:nil];
+    _context = nil;
+    [super tearDown];
+}
+
+- (void)testSpotCosineUsesHalfAngle {
+    // VROLight spot angles are full, edge-to-edge angles
+    XCTAssertEqualWithAccuracy(VROClusteredLightGrid::getSpotCosine(90), cosf(M_PI / 4), 1e-5);
+    XCTAssertEqualWithAccuracy(VROClusteredLightGrid::getSpotCosine(60), cosf(M_PI / 6), 1e-5);
+    XCTAssertEqualWithAccuracy(VROClusteredLightGrid::getSpotCosine(0), 1.0f, 1e-5);
+}
+
+- (void)testPointLightClusters {
+    float projection[16];
+    makeProjection(projection);
+    VROClusteredLightGrid grid;
+    grid.setProjection(projection, kNear, kFar);
+
+    float position[3] = { 0, 0, -10 };
+    float direction[3] = { 0, 0, -1 };
+    grid.addLight(position, 1, direction, -1);
+    grid.assign();
+
+    XCTAssertEqual(grid.getStats().lights, 1);
+    XCTAssertTrue(clusterHasLight(grid, 0, 0, -10, 0));
+    XCTAssertTrue(clusterHasLight(grid, 0.5f, 0, -10.5f, 0));
+    XCTAssertFalse(clusterHasLight(grid, 0, 0, -50, 0));
+    XCTAssertFalse(clusterHasLight(grid, 0, 0, -2, 0));
+    XCTAssertFalse(clusterHasLight(grid, 5, 0, -10, 0));
+}
+
+- (void)testSpotLightClusters {
+    float projection[16];
+    makeProjection(projection);
+    VROClusteredLightGrid grid;
+    grid.setProjection(projection, kNear, kFar);
+
+    // A 30 degree cone pointing away from the camera, reaching 20 units
+    float position[3] = { 0, 0, -10 };
+    float direction[3] = { 0, 0, -1 };
+    grid.addLight(position, 20, direction, VROClusteredLightGrid::getSpotCosine(30));
+    grid.assign();
+
+    XCTAssertEqualWithAccuracy(grid.getLights()[0].cosOuterAngle, cosf(M_PI / 12), 1e-5);
+    XCTAssertTrue(clusterHasLight(grid, 0, 0, -20, 0));
+    XCTAssertTrue(clusterHasLight(grid, 0, 0, -29, 0));
+
+    // Behind the light and past its reach; a point light of the same
+    // radius would cover the first of these
+    XCTAssertFalse(clusterHasLight(grid, 0, 0, -5, 0));
+    XCTAssertFalse(clusterHasLight(grid, 0, 0, -35, 0));
+}
+
+/*
+ Assignment of many lights on the default 16x9x24 grid: each point light is
+ listed by the cluster at its center, and none are dropped.
+ */
+- (void)testManyLightsAssigned {
+    float projection[16];
+    makeProjection(projection);
+    VROClusteredLightGrid grid;
+    grid.setProjection(projection, kNear, kFar);
+    std::vector<std::pair<uint32_t, VROVector3f>> pointLights = addSceneLights(grid, 128);
+    grid.assign();
+
+    const VROClusterStats &stats = grid.getStats();
+    XCTAssertEqual(stats.lights, 128);
+    XCTAssertEqual(stats.droppedIndices, 0);
+    XCTAssertGreaterThan(stats.occupiedClusters, 0);
+    for (const auto &light : pointLights) {
+        XCTAssertTrue(clusterHasLight(grid, light.second.x, light.second.y, light.second.z, light.first));
+    }
+}
+
+- (void)assignPerformanceWithLights:(int)count {
+    float projection[16];
+    makeProjection(projection);
+    __block VROClusteredLightGrid grid;
+    grid.setProjection(projection, kNear, kFar);
+    addSceneLights(grid, count);
+
+    [self measureBlock:^{
+        double start = VROTimeCurrentMillis();
+        const int kFrames = 100;
+        for (int f = 0; f < kFrames; f++) {
+            grid.assign();
+        }
+        const VROClusterStats &stats = grid.getStats();
+        NSLog(@"%d lights on %d clusters: %.3f ms per assignment, %d clusters occupied, %d max and %d total indices",
+              count, grid.getClusterCount(), (VROTimeCurrentMillis() - start) / kFrames,
+              stats.occupiedClusters, stats.maxClusterLights, stats.totalIndices);
+    }];
+}
+
+/*
+ Cost of the per-frame assignment pass on the default 16x9x24 grid.
+ */
+- (void)testPerformanceAssign64Lights {
+    [self assignPerformanceWithLights:64];
+}
+
+- (void)testPerformanceAssign256Lights {
+    [self assignPerformanceWithLights:256];
+}
+
+- (void)testShaderSharesIndexTextureWidth {
+    std::string source;
+    for (const std::string &line : VROClusteredLightingShaderSource()) {
+        source += line + "\n";
+    }
+    std::string width = "cluster_index_width = " + std::to_string(kClusterIndexTextureWidth) + ";";
+    XCTAssertTrue(source.find(width) != std::string::npos);
+    XCTAssertTrue(source.find("% 1024") == std::string::npos);
+}
+
+/*
+ The modifier runs at the Fragment entry and has a binder for each of its
+ uniforms.
+ */
+- (void)testModifierBindsEveryUniform {
+    VROClusteredLighting lighting;
+    std::shared_ptr<VROShaderModifier> modifier = lighting.getShaderModifier();
+    XCTAssert(modifier->getEntryPoint() == VROShaderEntryPoint::Fragment);
+
+    std::vector<std::string> uniforms = modifier->getUniforms();
+    for (const char *name : { "cluster_grid", "cluster_indices", "cluster_lights", "cluster_viewport",
+                              "cluster_params", "cluster_depth", "cluster_view_matrix" }) {
+        XCTAssert(std::find(uniforms.begin(), uniforms.end(), name) != uniforms.end());
+    }
+}
+
+/*
+ The uploader binds through the driver, so binding its textures again on
+ the same units is elided; only the unit switches are issued.
+ */
+- (void)testUploaderBindsThroughDriver {
+    std::shared_ptr<VRORecordingDriver> recordingDriver = std::make_shared<VRORecordingDriver>();
+    recordingDriver->setStateCachingEnabled(true);
+    std::shared_ptr<VRODriver> driver = recordingDriver;
+    std::shared_ptr<VRODriverCommandLog> log = recordingDriver->getCommandLog();
+
+    VROClusteredLightUploader uploader;
+    uploader.bind(4, 5, 6, driver);
+    XCTAssertEqual(log->getCount(VRODriverCommand::BindTexture), 3);
+    XCTAssertEqual(log->getCommands().back().a, 6);
+
+    log->clear();
+    uploader.bind(4, 5, 6, driver);
+    XCTAssertEqual(log->getCount(VRODriverCommand::BindTexture), 0);
+    XCTAssertEqual(log->getCount(VRODriverCommand::SetActiveTextureUnit), 3);
+
+    const VRODriverStateStats &stats = recordingDriver->getStateCache().getFrameStats();
+    XCTAssertEqual(stats.getIssued(VRODriverStateCategory::Texture), 3);
+    XCTAssertEqual(stats.getElided(VRODriverStateCategory::Texture), 3);
+}
+
+/*
+ Draw a plane lit by a red light in front of its center and a green light
+ in front of its upper right, each reaching only its own part of the plane,
+ through the modifier's GLSL and the uploader's textures. Each part is lit
+ by its own light only, so each fragment found its cluster and read its
+ lights' data.
+ */
+- (void)testShaderLightsFragmentsFromTheirCluster {
+    float projection[16];
+    makeProjection(projection);
+    projection[0] = projection[5];
+
+    VROClusteredLightGrid grid;
+    grid.setProjection(projection, kNear, kFar);
+    float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    std::vector<std::shared_ptr<VROLight>> lights = {
+        createOmniLight({ 0, 0, -kPlaneDepth + 0.5f }, { 1, 0, 0 }, 2),
+        createOmniLight({ 2, 2, -kPlaneDepth + 0.5f }, { 0, 1, 0 }, 1),
+    };
+    XCTAssertEqual(grid.setLights(lights, identity), 2);
+    grid.assign();
+
+    std::shared_ptr<VRODriver> driver = std::make_shared<VROTestGLTextureDriver>();
+    VROClusteredLightUploader uploader;
+    uploader.upload(grid, driver);
+    uploader.bind(13, 14, 15, driver);
+
+    GLuint target, framebuffer, vao;
+    glGenTextures(1, &target);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, target);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kTargetSize, kTargetSize);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target, 0);
+    glViewport(0, 0, kTargetSize, kTargetSize);
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER,
+        "#version 300 es\n"
+        "void main() {\n"
+        "    gl_Position = vec4(float(gl_VertexID / 2) * 4.0 - 1.0, float(gl_VertexID % 2) * 4.0 - 1.0, 0.0, 1.0);\n"
+        "}\n");
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, createLitPlaneFragmentShader());
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    XCTAssertTrue(linked);
+    glUseProgram(program);
+
+    const VROClusterGridConfig &config = grid.getConfig();
+    glUniform1i(glGetUniformLocation(program, "cluster_grid"), 13);
+    glUniform1i(glGetUniformLocation(program, "cluster_indices"), 14);
+    glUniform1i(glGetUniformLocation(program, "cluster_lights"), 15);
+    glUniform4f(glGetUniformLocation(program, "cluster_viewport"), 0, 0, kTargetSize, kTargetSize);
+    glUniform4f(glGetUniformLocation(program, "cluster_params"), config.tilesX, config.tilesY, config.slices, 0);
+    glUniform2f(glGetUniformLocation(program, "cluster_depth"), kNear, config.slices / logf(kFar / kNear));
+    glUniformMatrix4fv(glGetUniformLocation(program, "cluster_view_matrix"), 1, GL_FALSE, identity);
+    glUniform2f(glGetUniformLocation(program, "test_projection"), projection[0], projection[5]);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    std::vector<uint8_t> pixels(kTargetSize * kTargetSize * 4);
+    glReadPixels(0, 0, kTargetSize, kTargetSize, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+
+    // The plane point under each light, in pixels
+    int green = (int) ((2 * projection[0] / kPlaneDepth + 1) * 0.5f * kTargetSize);
+    const uint8_t *center = &pixels[((kTargetSize / 2) * kTargetSize + kTargetSize / 2) * 4];
+    const uint8_t *upperRight = &pixels[(green * kTargetSize + green) * 4];
+    const uint8_t *corner = &pixels[0];
+    XCTAssert(center[0] > 100);
+    XCTAssertEqual(center[1], 0);
+    XCTAssertEqual(upperRight[0], 0);
+    XCTAssert(upperRight[1] > 50);
+    XCTAssertEqual(corner[0], 0);
+    XCTAssertEqual(corner[1], 0);
+
+    glDeleteProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &target);
+}
+
+@end
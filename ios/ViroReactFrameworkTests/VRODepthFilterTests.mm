@@ -0,0 +1,418 @@
+//
+//  VRODepthFilterTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VRODepthFilter.h>
+#include <ViroKit/VRODepthSequence.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// LiDAR depth map and captured image resolutions
+static const int kDepthWidth = 256;
+static const int kDepthHeight = 192;
+static const int kGuideWidth = 1920;
+static const int kGuideHeight = 1440;
+
+/*
+ A static camera facing a wall at 2 m, with a box at 1 m covering the
+ left half of the image when withBox is set. Depth carries Gaussian noise.
+ */
+static void renderDepth(std::vector<float> &depth, bool withBox, std::mt19937 &random,
+                        int width = kDepthWidth, int height = kDepthHeight) {
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    depth.resize(width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float d = (withBox && x < width / 2) ? 1.0f : 2.0f;
+            depth[y * width + x] = d + noise(random);
+        }
+    }
+}
+
+static VRODepthImage createImage(const std::vector<float> &depth, int width = kDepthWidth,
+                                 int height = kDepthHeight) {
+    VRODepthImage image;
+    image.width = width;
+    image.height = height;
+    image.depth = depth.data();
+    image.fx = image.fy = 212.0f * width / kDepthWidth;
+    image.cx = width * 0.5f;
+    image.cy = height * 0.5f;
+    return image;
+}
+
+/*
+ A guide image with a luma edge exactly where the box ends.
+ */
+static std::vector<uint8_t> createGuide(int width, int height) {
+    std::vector<uint8_t> luma(width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            luma[y * width + x] = x < width / 2 ? 40 : 200;
+        }
+    }
+    return luma;
+}
+
+/*
+ Depth of the tilted wall z = -(2 + 0.5 x) seen by a camera at (cameraX, 0, 0)
+ looking down -z, with noise. The depth at a given pixel changes by 0.5 m
+ per meter of camera motion, so history is only usable if it is moved with
+ the camera.
+ */
+static float tiltedWallDepth(float cameraX, int x, int y) {
+    float dx = (x - kDepthWidth * 0.5f) / 212.0f;
+    return (2.0f + 0.5f * cameraX) / (1.0f - 0.5f * dx);
+}
+
+static void renderTiltedWall(std::vector<float> &depth, float cameraX, std::mt19937 &random) {
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    depth.resize(kDepthWidth * kDepthHeight);
+    for (int y = 0; y < kDepthHeight; y++) {
+        for (int x = 0; x < kDepthWidth; x++) {
+            depth[y * kDepthWidth + x] = tiltedWallDepth(cameraX, x, y) + noise(random);
+        }
+    }
+}
+
+static VRODepthImage createMovingImage(const std::vector<float> &depth, float cameraX) {
+    VRODepthImage image = createImage(depth);
+    image.cameraToWorld = VROMatrix4f::identity();
+    image.cameraToWorld[12] = cameraX;
+    return image;
+}
+
+/*
+ Distance from a point to the nearest surface of the scene room_orbit.vrds
+ was rendered from (see Fixtures/generate_depth_sequence.py): a 4 x 2.5 x 4 m
+ room with its floor at y = 0 and a 0.6 m cube standing at its center.
+ */
+static float sceneDistance(VROVector3f p) {
+    float room = std::min({ 2.0f - fabsf(p.x), 2.0f - fabsf(p.z), p.y, 2.5f - p.y });
+    float dx = fabsf(p.x) - 0.3f;
+    float dy = fabsf(p.y - 0.3f) - 0.3f;
+    float dz = fabsf(p.z) - 0.3f;
+    float ox = std::max(dx, 0.0f), oy = std::max(dy, 0.0f), oz = std::max(dz, 0.0f);
+    float cube = sqrtf(ox * ox + oy * oy + oz * oz) + std::min(std::max({ dx, dy, dz }), 0.0f);
+    return std::min(fabsf(room), fabsf(cube));
+}
+
+/*
+ Mean distance from the scene of the filtered depth, over its confident
+ pixels.
+ */
+static float meanSceneError(const VRODepthImage &image) {
+    double total = 0;
+    int count = 0;
+    for (int y = 0; y < image.height; y++) {
+        for (int x = 0; x < image.width; x++) {
+            float d = image.getDepth(x, y);
+            if (d > 0 && image.getConfidence(x, y) > 0.5f) {
+                total += sceneDistance(image.unprojectToWorld((float) x, (float) y, d));
+                count++;
+            }
+        }
+    }
+    return count > 0 ? (float) (total / count) : 1.0f;
+}
+
+/*
+ Noisy box-and-wall depth at the given resolution and a guide with the
+ matching edge, for the per-resolution benchmarks.
+ */
+static VRODepthImage createBenchmarkFrame(int depthWidth, int depthHeight, int guideWidth, int guideHeight,
+                                          std::vector<float> &depth, std::vector<uint8_t> &luma,
+                                          VROLumaImage &guide) {
+    std::mt19937 random(35);
+    renderDepth(depth, true, random, depthWidth, depthHeight);
+    luma = createGuide(guideWidth, guideHeight);
+    guide.width = guideWidth;
+    guide.height = guideHeight;
+    guide.bytesPerRow = guideWidth;
+    guide.luma = luma.data();
+    return createImage(depth, depthWidth, depthHeight);
+}
+
+static float standardDeviation(const VRODepthImage &image, int x0, int x1, float mean) {
+    double sum = 0;
+    int count = 0;
+    for (int y = 8; y < image.height - 8; y++) {
+        for (int x = x0; x < x1; x++) {
+            float error = image.getDepth(x, y) - mean;
+            sum += error * error;
+            count++;
+        }
+    }
+    return (float) sqrt(sum / count);
+}
+
+@interface VRODepthFilterTests : XCTestCase
+
+@end
+
+@implementation VRODepthFilterTests {
+    std::shared_ptr<VRODepthSequence> _sequence;
+}
+
+- (void)setUp {
+    [super setUp];
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:@"room_orbit" ofType:@"vrds"];
+    XCTAssertNotNil(path);
+    _sequence = VRODepthSequence::open(std::string([path UTF8String]));
+    XCTAssert(_sequence);
+}
+
+/*
+ With a static camera, temporal filtering reduces the depth noise of the
+ wall, and a single full-confidence frame is already fully confident.
+ */
+- (void)testTemporalFilteringReducesNoise {
+    std::mt19937 random(32);
+    std::vector<float> depth;
+    VRODepthFilter filter;
+
+    renderDepth(depth, false, random);
+    filter.process(createImage(depth));
+    XCTAssertEqual(filter.getStats().reprojectedPixels, 0);
+    XCTAssertEqual(filter.getOutput().getConfidence(10, 10), 1.0f);
+    float noisy = standardDeviation(filter.getOutput(), 8, kDepthWidth - 8, 2.0f);
+
+    for (int f = 0; f < 7; f++) {
+        renderDepth(depth, false, random);
+        filter.process(createImage(depth));
+    }
+    XCTAssertGreaterThan(filter.getStats().reprojectedPixels, kDepthWidth * kDepthHeight / 2);
+    float filtered = standardDeviation(filter.getOutput(), 8, kDepthWidth - 8, 2.0f);
+    XCTAssertLessThan(filtered, noisy * 0.5f);
+}
+
+/*
+ When a box appears in front of the wall, the history there disagrees and
+ is dropped instead of ghosting into the new depth.
+ */
+- (void)testDisagreeingHistoryResets {
+    std::mt19937 random(33);
+    std::vector<float> depth;
+    VRODepthFilter filter;
+    for (int f = 0; f < 8; f++) {
+        renderDepth(depth, false, random);
+        filter.process(createImage(depth));
+    }
+
+    renderDepth(depth, true, random);
+    filter.process(createImage(depth));
+    const VRODepthImage &output = filter.getOutput();
+    for (int y = 8; y < kDepthHeight - 8; y += 8) {
+        XCTAssertEqualWithAccuracy(output.getDepth(kDepthWidth / 4, y), 1.0f, 0.05f);
+        XCTAssertEqualWithAccuracy(output.getDepth(kDepthWidth * 3 / 4, y), 2.0f, 0.05f);
+    }
+}
+
+/*
+ With a camera moving 0.3 m per frame past a tilted wall, the depth at each
+ pixel changes by more than temporalAgreement every frame. History only
+ agrees, and noise only drops, if it is reprojected with the pose delta.
+ */
+- (void)testMovingCameraReprojectsHistory {
+    std::mt19937 random(37);
+    std::vector<float> depth;
+    VRODepthFilter filter;
+
+    renderTiltedWall(depth, 0, random);
+    filter.process(createMovingImage(depth, 0));
+    float noisy = 0;
+    {
+        double sum = 0;
+        for (int y = 8; y < kDepthHeight - 8; y++) {
+            for (int x = 8; x < kDepthWidth - 8; x++) {
+                float error = filter.getOutput().getDepth(x, y) - tiltedWallDepth(0, x, y);
+                sum += error * error;
+            }
+        }
+        noisy = (float) sqrt(sum / ((kDepthHeight - 16) * (kDepthWidth - 16)));
+    }
+
+    float cameraX = 0;
+    for (int f = 0; f < 6; f++) {
+        cameraX += 0.3f;
+        renderTiltedWall(depth, cameraX, random);
+        filter.process(createMovingImage(depth, cameraX));
+
+        // Moving right, the left edge of the view was not seen last frame
+        XCTAssertGreaterThan(filter.getStats().reprojectedPixels, kDepthWidth * kDepthHeight * 6 / 10);
+    }
+
+    // Compare on the right half, which has been in view for every frame
+    double sum = 0;
+    int count = 0;
+    for (int y = 8; y < kDepthHeight - 8; y++) {
+        for (int x = kDepthWidth / 2; x < kDepthWidth - 8; x++) {
+            float error = filter.getOutput().getDepth(x, y) - tiltedWallDepth(cameraX, x, y);
+            sum += error * error;
+            count++;
+        }
+    }
+    float filtered = (float) sqrt(sum / count);
+    XCTAssertLessThan(filtered, noisy * 0.6f);
+}
+
+/*
+ The recorded orbit moves the camera 7.8 degrees around the cube each
+ frame. History is reprojected through every move, and the filtered depth
+ stays on the surfaces the recording was rendered from. Frame 24 turns the
+ camera away from the cube, so most of its history is out of view.
+ */
+- (void)testRecordedSequence {
+    static const int kOrbitFrames = 24;
+    VRODepthFilter filter;
+    for (int f = 0; f < _sequence->getFrameCount(); f++) {
+        VRODepthImage frame = _sequence->getFrame(f);
+        filter.process(frame);
+        if (f > 0 && f != kOrbitFrames) {
+            XCTAssertGreaterThan(filter.getStats().reprojectedPixels, frame.width * frame.height / 2, @"frame %d", f);
+        }
+        XCTAssertLessThan(meanSceneError(filter.getOutput()), 0.005f, @"frame %d", f);
+    }
+}
+
+/*
+ Upsampled depth edges follow the luma edge of the guide: output pixels
+ just either side of the edge take the depth of their own side.
+ */
+- (void)testUpsamplingSnapsToGuideEdges {
+    std::mt19937 random(34);
+    std::vector<float> depth;
+    renderDepth(depth, true, random);
+    int guideWidth = kDepthWidth * 4, guideHeight = kDepthHeight * 4;
+    std::vector<uint8_t> luma = createGuide(guideWidth, guideHeight);
+
+    VROLumaImage guide;
+    guide.width = guideWidth;
+    guide.height = guideHeight;
+    guide.bytesPerRow = guideWidth;
+    guide.luma = luma.data();
+
+    VRODepthFilter filter;
+    filter.process(createImage(depth), &guide);
+    const VRODepthImage &output = filter.getOutput();
+    XCTAssertEqual(output.width, guideWidth);
+    XCTAssertEqual(output.height, guideHeight);
+    XCTAssertEqualWithAccuracy(output.fx, 212.0f * 4, 1e-3f);
+
+    for (int y = 16; y < guideHeight - 16; y += 16) {
+        XCTAssertEqualWithAccuracy(output.getDepth(guideWidth / 2 - 1, y), 1.0f, 0.05f);
+        XCTAssertEqualWithAccuracy(output.getDepth(guideWidth / 2, y), 2.0f, 0.05f);
+    }
+}
+
+/*
+ One LiDAR frame upsampled to the captured image resolution, with history.
+ */
+- (void)testPerformanceLiDARFrame {
+    std::vector<float> depth;
+    std::vector<uint8_t> luma;
+    VROLumaImage guide;
+    VRODepthImage image = createBenchmarkFrame(kDepthWidth, kDepthHeight, kGuideWidth, kGuideHeight, depth, luma, guide);
+
+    VRODepthFilter filter;
+    VRODepthFilter *filterPtr = &filter;
+    VROLumaImage *guidePtr = &guide;
+    filter.process(image, guidePtr);
+    [self measureBlock:^{
+        filterPtr->process(image, guidePtr);
+    }];
+}
+
+/*
+ One LiDAR frame upsampled to a 960 x 720 preview.
+ */
+- (void)testPerformanceLiDARFrameToPreview {
+    std::vector<float> depth;
+    std::vector<uint8_t> luma;
+    VROLumaImage guide;
+    VRODepthImage image = createBenchmarkFrame(kDepthWidth, kDepthHeight, 960, 720, depth, luma, guide);
+
+    VRODepthFilter filter;
+    VRODepthFilter *filterPtr = &filter;
+    VROLumaImage *guidePtr = &guide;
+    filter.process(image, guidePtr);
+    [self measureBlock:^{
+        filterPtr->process(image, guidePtr);
+    }];
+}
+
+/*
+ A 160 x 120 ARCore depth frame upsampled to a 640 x 480 camera image.
+ */
+- (void)testPerformanceARCoreFrame {
+    std::vector<float> depth;
+    std::vector<uint8_t> luma;
+    VROLumaImage guide;
+    VRODepthImage image = createBenchmarkFrame(160, 120, 640, 480, depth, luma, guide);
+
+    VRODepthFilter filter;
+    VRODepthFilter *filterPtr = &filter;
+    VROLumaImage *guidePtr = &guide;
+    filter.process(image, guidePtr);
+    [self measureBlock:^{
+        filterPtr->process(image, guidePtr);
+    }];
+}
+
+/*
+ The recorded orbit, temporal pass only, with a new pose every frame.
+ */
+- (void)testPerformanceRecordedSequence {
+    VRODepthSequence *sequence = _sequence.get();
+    [self measureBlock:^{
+        VRODepthFilter filter;
+        for (int f = 0; f < sequence->getFrameCount(); f++) {
+            filter.process(sequence->getFrame(f));
+        }
+    }];
+}
+
+/*
+ The temporal pass alone, at depth resolution.
+ */
+- (void)testPerformanceTemporalOnly {
+    std::mt19937 random(36);
+    std::vector<float> depth;
+    renderDepth(depth, true, random);
+
+    VRODepthFilter filter;
+    VRODepthFilter *filterPtr = &filter;
+    VRODepthImage image = createImage(depth);
+    filter.process(image);
+
+    [self measureBlock:^{
+        filterPtr->process(image);
+    }];
+}
+
+@end
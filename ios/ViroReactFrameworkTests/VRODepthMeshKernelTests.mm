@@ -0,0 +1,199 @@
+//
+//  VRODepthMeshKernelTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VRODepthMeshKernel.h>
+#include <ViroKit/VRODepthSequence.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// LiDAR depth map resolution
+static const int kDepthWidth = 256;
+static const int kDepthHeight = 192;
+
+/*
+ A wall at 3 m with a box at 1 m covering the middle of the image, and a
+ band of missing depth along the bottom.
+ */
+static std::vector<float> createDepthMap(bool withBox) {
+    std::vector<float> depth(kDepthWidth * kDepthHeight);
+    for (int y = 0; y < kDepthHeight; y++) {
+        for (int x = 0; x < kDepthWidth; x++) {
+            bool inBox = withBox && x > 80 && x < 176 && y > 48 && y < 144;
+            float d = inBox ? 1.0f : 3.0f + 0.001f * x;
+            depth[y * kDepthWidth + x] = y >= kDepthHeight - 8 ? 0.0f : d;
+        }
+    }
+    return depth;
+}
+
+static VRODepthImage createImage(const std::vector<float> &depth) {
+    VRODepthImage image;
+    image.width = kDepthWidth;
+    image.height = kDepthHeight;
+    image.depth = depth.data();
+    image.fx = image.fy = 212.0f;
+    image.cx = kDepthWidth * 0.5f;
+    image.cy = kDepthHeight * 0.5f;
+    return image;
+}
+
+/*
+ Distance from a point to the nearest surface of the scene room_orbit.vrds
+ was rendered from (see Fixtures/generate_depth_sequence.py): a 4 x 2.5 x 4 m
+ room with its floor at y = 0 and a 0.6 m cube standing at its center.
+ */
+static float sceneDistance(VROVector3f p) {
+    float room = std::min({ 2.0f - fabsf(p.x), 2.0f - fabsf(p.z), p.y, 2.5f - p.y });
+    float dx = fabsf(p.x) - 0.3f;
+    float dy = fabsf(p.y - 0.3f) - 0.3f;
+    float dz = fabsf(p.z) - 0.3f;
+    float ox = std::max(dx, 0.0f), oy = std::max(dy, 0.0f), oz = std::max(dz, 0.0f);
+    float cube = sqrtf(ox * ox + oy * oy + oz * oz) + std::min(std::max({ dx, dy, dz }), 0.0f);
+    return std::min(fabsf(room), fabsf(cube));
+}
+
+@interface VRODepthMeshKernelTests : XCTestCase
+
+@end
+
+@implementation VRODepthMeshKernelTests {
+    std::shared_ptr<VRODepthSequence> _sequence;
+}
+
+- (void)setUp {
+    [super setUp];
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:@"room_orbit" ofType:@"vrds"];
+    XCTAssertNotNil(path);
+    _sequence = VRODepthSequence::open(std::string([path UTF8String]));
+    XCTAssert(_sequence);
+}
+
+/*
+ Every quad of a continuous surface is meshed; the band of missing depth is
+ not.
+ */
+- (void)testContinuousSurface {
+    std::vector<float> depth = createDepthMap(false);
+    VRODepthMeshKernelConfig config;
+    VRODepthMeshKernel kernel;
+    kernel.run(createImage(depth), config);
+
+    int gridWidth = (kDepthWidth - 1) / config.stride + 1;
+    int validRows = (kDepthHeight - 8 - 1) / config.stride + 1;
+    XCTAssertEqual(kernel.getTriangleCount(), (gridWidth - 1) * (validRows - 1) * 2);
+    XCTAssertEqual(kernel.getVertexCount(), gridWidth * validRows);
+    XCTAssert(kernel.uses16BitIndices());
+}
+
+/*
+ No triangle may bridge the box and the wall behind it.
+ */
+- (void)testRejectsSilhouetteEdges {
+    std::vector<float> depth = createDepthMap(true);
+    VRODepthMeshKernel kernel;
+    kernel.run(createImage(depth), VRODepthMeshKernelConfig());
+    XCTAssert(kernel.getTriangleCount() > 0);
+
+    const std::vector<VROVector3f> &vertices = kernel.getVertices();
+    const std::vector<uint16_t> &indices = kernel.getIndices16();
+    int bridging = 0;
+    for (int t = 0; t < kernel.getTriangleCount(); t++) {
+        float minZ = 0, maxZ = -100;
+        for (int c = 0; c < 3; c++) {
+            float z = vertices[indices[t * 3 + c]].z;
+            minZ = std::min(minZ, z);
+            maxZ = std::max(maxZ, z);
+        }
+        if (maxZ - minZ > 1.0f) {
+            bridging++;
+        }
+    }
+    XCTAssertEqual(bridging, 0);
+}
+
+/*
+ One LiDAR-sized frame at the default stride of 4.
+ */
+- (void)testPerformanceLiDARFrame {
+    std::vector<float> depth = createDepthMap(true);
+    VRODepthImage image = createImage(depth);
+    VRODepthMeshKernelConfig config;
+    __block VRODepthMeshKernel kernel;
+    kernel.run(image, config);
+
+    [self measureBlock:^{
+        kernel.run(image, config);
+    }];
+}
+
+/*
+ Every frame of the recorded orbit meshes onto the surfaces it was rendered
+ from, with vertices in world space.
+ */
+- (void)testRecordedSequenceMatchesScene {
+    VRODepthMeshKernelConfig config;
+    config.stride = 1;
+    VRODepthMeshKernel kernel;
+    for (int f = 0; f < _sequence->getFrameCount(); f++) {
+        kernel.run(_sequence->getFrame(f), config);
+        XCTAssert(kernel.getTriangleCount() > 0, @"frame %d", f);
+
+        float total = 0, worst = 0;
+        for (int v = 0; v < kernel.getVertexCount(); v++) {
+            float distance = sceneDistance(kernel.getVertices()[v]);
+            total += distance;
+            worst = std::max(worst, distance);
+        }
+        XCTAssertLessThan(total / kernel.getVertexCount(), 0.005f, @"frame %d", f);
+        XCTAssertLessThan(worst, 0.02f, @"frame %d", f);
+    }
+}
+
+/*
+ Every frame of the recorded orbit, at stride 1 since the recording is
+ 64 x 48. Each frame has a new pose and new silhouettes, unlike the
+ synthetic frame above.
+ */
+- (void)testPerformanceRecordedSequence {
+    VRODepthSequence *sequence = _sequence.get();
+    VRODepthMeshKernelConfig config;
+    config.stride = 1;
+    __block VRODepthMeshKernel kernel;
+    [self measureBlock:^{
+        int triangles = 0;
+        double start = VROTimeCurrentMillis();
+        for (int f = 0; f < sequence->getFrameCount(); f++) {
+            kernel.run(sequence->getFrame(f), config);
+            triangles += kernel.getTriangleCount();
+        }
+        NSLog(@"Recorded sequence: %.3f ms per frame, %d triangles per frame",
+              (VROTimeCurrentMillis() - start) / sequence->getFrameCount(), triangles / sequence->getFrameCount());
+    }];
+}
+
+@end
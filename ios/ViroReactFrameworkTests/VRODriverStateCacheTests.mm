@@ -0,0 +1,178 @@
+//
+//  VRODriverStateCacheTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VRODriverStateCache.h>
+#include <ViroKit/VROMaterial.h>
+
+@interface VRODriverStateCacheTests : XCTestCase
+
+@end
+
+@implementation VRODriverStateCacheTests
+
+/*
+ Setting a state to its current value is elided; changing it is issued.
+ Both are counted under the state's category.
+ */
+- (void)testRedundantStateIsElided {
+    VRODriverStateCache cache;
+    cache.beginFrame();
+
+    XCTAssertTrue(cache.setDepthWritingEnabled(true));
+    XCTAssertFalse(cache.setDepthWritingEnabled(true));
+    XCTAssertTrue(cache.setDepthWritingEnabled(false));
+    XCTAssertTrue(cache.setCullMode(VROCullMode::Back));
+    XCTAssertFalse(cache.setCullMode(VROCullMode::Back));
+    XCTAssertTrue(cache.setBlendingMode(VROBlendMode::Alpha));
+    XCTAssertFalse(cache.setBlendingMode(VROBlendMode::Alpha));
+    XCTAssertTrue(cache.setStencilTestEnabled(false));
+    XCTAssertFalse(cache.setStencilTestEnabled(false));
+
+    const VRODriverStateStats &stats = cache.getFrameStats();
+    XCTAssertEqual(stats.getIssued(VRODriverStateCategory::DepthWrite), 2);
+    XCTAssertEqual(stats.getElided(VRODriverStateCategory::DepthWrite), 1);
+    XCTAssertEqual(stats.getElided(VRODriverStateCategory::CullMode), 1);
+    XCTAssertEqual(stats.getElided(VRODriverStateCategory::BlendMode), 1);
+    XCTAssertEqual(stats.getElided(VRODriverStateCategory::StencilTest), 1);
+    XCTAssertEqual(stats.getTotalIssued(), 5);
+    XCTAssertEqual(stats.getTotalElided(), 4);
+}
+
+/*
+ The render target and material color masks are tracked separately, but
+ counted under one category.
+ */
+- (void)testColorMasksAreTrackedSeparately {
+    VRODriverStateCache cache;
+    XCTAssertTrue(cache.setRenderTargetColorWritingMask(VROColorMaskAll));
+    XCTAssertTrue(cache.setMaterialColorWritingMask(VROColorMaskAll));
+    XCTAssertFalse(cache.setRenderTargetColorWritingMask(VROColorMaskAll));
+    XCTAssertFalse(cache.setMaterialColorWritingMask(VROColorMaskAll));
+    XCTAssertEqual(cache.getFrameStats().getIssued(VRODriverStateCategory::ColorMask), 2);
+    XCTAssertEqual(cache.getFrameStats().getElided(VRODriverStateCategory::ColorMask), 2);
+}
+
+/*
+ Each unit keeps its own binding. Rebinding the same texture with a
+ different target is a change.
+ */
+- (void)testTextureBindingsPerUnit {
+    VRODriverStateCache cache;
+    XCTAssertTrue(cache.bindTexture(0, GL_TEXTURE_2D, 5));
+    XCTAssertTrue(cache.bindTexture(1, GL_TEXTURE_2D, 5));
+    XCTAssertFalse(cache.bindTexture(0, GL_TEXTURE_2D, 5));
+    XCTAssertFalse(cache.bindTexture(1, GL_TEXTURE_2D, 5));
+    XCTAssertTrue(cache.bindTexture(0, GL_TEXTURE_CUBE_MAP, 5));
+    XCTAssertTrue(cache.bindTexture(0, GL_TEXTURE_2D, 5));
+
+    XCTAssertTrue(cache.setActiveTextureUnit(1));
+    XCTAssertFalse(cache.bindTexture(GL_TEXTURE_2D, 5));
+    XCTAssertFalse(cache.setActiveTextureUnit(1));
+
+    // Units outside the shadow state are always issued
+    XCTAssertTrue(cache.bindTexture(VRODriverStateCache::kMaxTextureUnits, GL_TEXTURE_2D, 5));
+    XCTAssertTrue(cache.bindTexture(VRODriverStateCache::kMaxTextureUnits, GL_TEXTURE_2D, 5));
+    XCTAssertTrue(cache.bindTexture(-1, GL_TEXTURE_2D, 5));
+}
+
+/*
+ invalidate() forgets everything; invalidateTextures() only the unit and
+ texture bindings.
+ */
+- (void)testInvalidate {
+    VRODriverStateCache cache;
+    cache.setActiveTextureUnit(2);
+    cache.bindTexture(GL_TEXTURE_2D, 9);
+    cache.setDepthReadingEnabled(true);
+
+    cache.invalidateTextures();
+    XCTAssertTrue(cache.setActiveTextureUnit(2));
+    XCTAssertTrue(cache.bindTexture(GL_TEXTURE_2D, 9));
+    XCTAssertFalse(cache.setDepthReadingEnabled(true));
+
+    cache.invalidate();
+    XCTAssertTrue(cache.setActiveTextureUnit(2));
+    XCTAssertTrue(cache.bindTexture(GL_TEXTURE_2D, 9));
+    XCTAssertTrue(cache.setDepthReadingEnabled(true));
+}
+
+/*
+ Unbinding the shader is tracked like a bind of no program.
+ */
+- (void)testUnbindShader {
+    VRODriverStateCache cache;
+    XCTAssertTrue(cache.bindShader(nullptr));
+    XCTAssertFalse(cache.bindShader(nullptr));
+    XCTAssertEqual(cache.getFrameStats().getElided(VRODriverStateCategory::Shader), 1);
+}
+
+/*
+ Disabled, every call is issued but still counted, and the shadow state is
+ rebuilt from unknown when re-enabled.
+ */
+- (void)testDisabled {
+    VRODriverStateCache cache;
+    cache.setEnabled(false);
+    XCTAssertFalse(cache.isEnabled());
+    for (int i = 0; i < 3; i++) {
+        XCTAssertTrue(cache.setCullMode(VROCullMode::None));
+        XCTAssertTrue(cache.bindTexture(0, GL_TEXTURE_2D, 3));
+    }
+    XCTAssertEqual(cache.getFrameStats().getIssued(VRODriverStateCategory::CullMode), 3);
+    XCTAssertEqual(cache.getFrameStats().getTotalElided(), 0);
+
+    cache.setEnabled(true);
+    XCTAssertTrue(cache.setCullMode(VROCullMode::None));
+    XCTAssertFalse(cache.setCullMode(VROCullMode::None));
+}
+
+/*
+ Counters cover one frame; the previous frame's are kept until the next
+ frame ends. Shadow state carries across frames.
+ */
+- (void)testFrameStats {
+    VRODriverStateCache cache;
+    cache.beginFrame();
+    cache.setDepthWritingEnabled(true);
+    cache.setDepthWritingEnabled(true);
+    cache.countRenderTargetBind(true);
+    cache.countRenderTargetBind(false);
+    cache.endFrame();
+
+    cache.beginFrame();
+    XCTAssertEqual(cache.getFrameStats().getTotalIssued(), 0);
+    XCTAssertFalse(cache.setDepthWritingEnabled(true));
+
+    const VRODriverStateStats &last = cache.getLastFrameStats();
+    XCTAssertEqual(last.getIssued(VRODriverStateCategory::DepthWrite), 1);
+    XCTAssertEqual(last.getElided(VRODriverStateCategory::DepthWrite), 1);
+    XCTAssertEqual(last.getIssued(VRODriverStateCategory::RenderTarget), 1);
+    XCTAssertEqual(last.getElided(VRODriverStateCategory::RenderTarget), 1);
+    XCTAssertTrue(last.toString().find("depth write: 1 issued, 1 elided") != std::string::npos);
+}
+
+@end
@@ -0,0 +1,194 @@
+//
+//  VROIKSolverTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROIKSolver.h>
+#include <ViroKit/VROIKRig.h>
+#include <ViroKit/VRONode.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+/*
+ Humanoid test rig: a root branching into two legs and a spine, the spine's
+ chest branching into the neck and both arms. Effectors are the head, hands
+ and feet.
+ */
+static const int kHumanoidParents[] = {
+    -1,                         // 0 root
+    0, 1, 2,                    // 1-3 spine, 3 is the chest
+    3, 4,                       // 4-5 neck, head
+    3, 6, 7,                    // 6-8 left shoulder, elbow, hand
+    3, 9, 10,                   // 9-11 right shoulder, elbow, hand
+    0, 12, 13,                  // 12-14 left hip, knee, foot
+    0, 15, 16,                  // 15-17 right hip, knee, foot
+};
+static const float kHumanoidRest[][3] = {
+    {  0.0f, 1.0f, 0 },
+    {  0.0f, 1.2f, 0 }, {  0.0f, 1.4f, 0 }, { 0.0f, 1.5f, 0 },
+    {  0.0f, 1.6f, 0 }, {  0.0f, 1.8f, 0 },
+    { -0.2f, 1.5f, 0 }, { -0.5f, 1.5f, 0 }, { -0.8f, 1.5f, 0 },
+    {  0.2f, 1.5f, 0 }, {  0.5f, 1.5f, 0 }, {  0.8f, 1.5f, 0 },
+    { -0.1f, 0.9f, 0 }, { -0.1f, 0.5f, 0 }, { -0.1f, 0.0f, 0 },
+    {  0.1f, 0.9f, 0 }, {  0.1f, 0.5f, 0 }, {  0.1f, 0.0f, 0 },
+};
+static const int kHumanoidEffectors[] = { 5, 8, 11, 14, 17 };
+
+static std::shared_ptr<VROIKCompiledRig> compileHumanoid() {
+    int count = sizeof(kHumanoidParents) / sizeof(int);
+    std::vector<int> parents(kHumanoidParents, kHumanoidParents + count);
+    std::vector<VROVector3f> rest;
+    for (int i = 0; i < count; i++) {
+        rest.push_back(VROVector3f(kHumanoidRest[i][0], kHumanoidRest[i][1], kHumanoidRest[i][2]));
+    }
+    std::vector<int> effectors(kHumanoidEffectors, kHumanoidEffectors + sizeof(kHumanoidEffectors) / sizeof(int));
+    return VROIKCompiledRig::compile(parents, rest, effectors);
+}
+
+@interface VROIKSolverTests : XCTestCase
+
+@end
+
+@implementation VROIKSolverTests
+
+- (void)testCompileRejectsNullJoints {
+    std::shared_ptr<VROIKJoint> root = std::make_shared<VROIKJoint>();
+    XCTAssertTrue(VROIKCompiledRig::compile(root, {}, nullptr) == nullptr);
+    std::vector<std::shared_ptr<VROIKJoint>> joints;
+    XCTAssertTrue(VROIKCompiledRig::compile(nullptr, {}, &joints) == nullptr);
+}
+
+- (void)testSolveKeepsBoneLengths {
+    std::shared_ptr<VROIKCompiledRig> rig = compileHumanoid();
+    XCTAssertTrue(rig != nullptr);
+
+    VROIKRigInstance instance(rig);
+    for (int i = 0; i < rig->getJointCount(); i++) {
+        instance.setPosition(i, VROVector3f(kHumanoidRest[i][0], kHumanoidRest[i][1], kHumanoidRest[i][2]));
+    }
+    instance.setTarget(1, VROVector3f(-0.6f, 1.7f, 0.3f));
+    instance.setTarget(2, VROVector3f( 0.5f, 1.2f, 0.4f));
+    for (int e : { 0, 3, 4 }) {
+        int joint = rig->getEffectorJoint(e);
+        instance.setTarget(e, VROVector3f(kHumanoidRest[joint][0], kHumanoidRest[joint][1], kHumanoidRest[joint][2]));
+    }
+
+    VROIKSolverConfig config;
+    config.maxIterations = 50;
+    VROIKSolver::solve(&instance, config);
+    XCTAssertLessThan(instance.getError(), 0.01f);
+    XCTAssertEqualWithAccuracy(instance.getPosition(0).y, 1.0f, 1e-5);
+    for (int i = 1; i < rig->getJointCount(); i++) {
+        float length = instance.getPosition(i).distance(instance.getPosition(rig->getParent(i)));
+        XCTAssertEqualWithAccuracy(length, rig->getBoneLength(i), 1e-4);
+    }
+}
+
+/*
+ Solve the same branching rig with VROIKRig and with the compiled solver,
+ and compare the solved positions. Every joint is the root, a branch or an
+ effector, so VROIKRig locks no intermediary joints and both solve the same
+ chains. Only positions are compared; the compiled solver does not derive
+ rotations.
+ */
+- (void)testMatchesIKRig {
+    const VROVector3f rest[] = { { 0, 0, 0 }, { 0, 1, 0 }, { -1, 1.5f, 0 }, { 1, 1.5f, 0 }, { 0, 2, 0 } };
+    const int parents[] = { -1, 0, 1, 1, 1 };
+    const VROVector3f targets[] = { { -0.9f, 1.4f, 0.4f }, { 0.9f, 1.7f, -0.3f }, { 0.1f, 2.0f, 0.2f } };
+
+    std::vector<std::shared_ptr<VRONode>> nodes;
+    for (int i = 0; i < 5; i++) {
+        std::shared_ptr<VRONode> node = std::make_shared<VRONode>();
+        VROVector3f parentPosition = parents[i] >= 0 ? rest[parents[i]] : VROVector3f();
+        node->setPosition(rest[i] - parentPosition);
+        if (parents[i] >= 0) {
+            nodes[parents[i]]->addChildNode(node);
+        }
+        nodes.push_back(node);
+    }
+    nodes[0]->computeTransforms(VROMatrix4f::identity(), VROMatrix4f::identity());
+
+    std::map<std::string, std::shared_ptr<VRONode>> effectorNodes = {
+        { "left", nodes[2] }, { "right", nodes[3] }, { "head", nodes[4] } };
+    VROIKRig ikRig(nodes[0], effectorNodes);
+    ikRig.setPositionForEffector("left", targets[0]);
+    ikRig.setPositionForEffector("right", targets[1]);
+    ikRig.setPositionForEffector("head", targets[2]);
+    ikRig.processRig();
+    nodes[0]->computeTransforms(VROMatrix4f::identity(), VROMatrix4f::identity());
+
+    std::shared_ptr<VROIKCompiledRig> rig = VROIKCompiledRig::compile(
+        std::vector<int>(parents, parents + 5), std::vector<VROVector3f>(rest, rest + 5), { 2, 3, 4 });
+    VROIKRigInstance instance(rig);
+    for (int i = 0; i < 5; i++) {
+        instance.setPosition(i, rest[i]);
+    }
+    for (int e = 0; e < 3; e++) {
+        instance.setTarget(e, targets[e]);
+    }
+    VROIKSolver::solve(&instance);
+
+    for (int i = 0; i < 5; i++) {
+        float distance = instance.getPosition(i).distance(nodes[i]->getWorldPosition());
+        XCTAssertLessThan(distance, 0.01f);
+    }
+}
+
+/*
+ Rigs per millisecond: 1,000 humanoid instances sharing one compiled rig,
+ each reaching for new hand targets.
+ */
+- (void)testPerformanceSolveHumanoids {
+    const int kRigs = 1000;
+    std::shared_ptr<VROIKCompiledRig> rig = compileHumanoid();
+    std::vector<std::unique_ptr<VROIKRigInstance>> instances;
+    std::vector<VROIKRigInstance *> batch;
+    for (int r = 0; r < kRigs; r++) {
+        instances.emplace_back(new VROIKRigInstance(rig));
+        batch.push_back(instances.back().get());
+    }
+    auto reset = [&](int frame) {
+        for (int r = 0; r < kRigs; r++) {
+            VROIKRigInstance *instance = batch[r];
+            for (int i = 0; i < rig->getJointCount(); i++) {
+                instance->setPosition(i, VROVector3f(kHumanoidRest[i][0], kHumanoidRest[i][1], kHumanoidRest[i][2]));
+            }
+            float phase = (r + frame) * 0.01f;
+            instance->setTarget(0, VROVector3f(0.05f * sinf(phase), 1.78f, 0.05f));
+            instance->setTarget(1, VROVector3f(-0.6f, 1.5f + 0.2f * sinf(phase), 0.3f * cosf(phase)));
+            instance->setTarget(2, VROVector3f( 0.6f, 1.5f + 0.2f * cosf(phase), 0.3f * sinf(phase)));
+            instance->setTarget(3, VROVector3f(-0.1f, 0.0f, 0.1f * sinf(phase)));
+            instance->setTarget(4, VROVector3f( 0.1f, 0.0f, 0.1f * cosf(phase)));
+        }
+    };
+    __block int frame = 0;
+    [self measureBlock:^{
+        reset(frame++);
+        VROIKSolver::solve(batch);
+    }];
+}
+
+@end
@@ -0,0 +1,426 @@
+//
+//  VROImagePreprocessorTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROImagePreprocessor.h>
+#include <array>
+#include <cmath>
+#include <vector>
+
+static const int kImageWidth = 64;
+static const int kImageHeight = 48;
+
+/*
+ A synthetic NV12 camera image: diagonal luma ramp and independent chroma
+ ramps, with row padding as camera buffers have.
+ */
+struct TestImage {
+    std::vector<uint8_t> luma;
+    std::vector<uint8_t> chroma;
+    VRONV12Image image;
+
+    TestImage(bool fullRange) {
+        int lumaStride = kImageWidth + 16;
+        int chromaStride = kImageWidth + 16;
+        luma.assign((size_t) lumaStride * kImageHeight, 0);
+        chroma.assign((size_t) chromaStride * kImageHeight / 2, 0);
+        for (int y = 0; y < kImageHeight; y++) {
+            for (int x = 0; x < kImageWidth; x++) {
+                luma[y * lumaStride + x] = (uint8_t) (16 + (x * 3 + y * 2) % 220);
+            }
+        }
+        for (int y = 0; y < kImageHeight / 2; y++) {
+            for (int x = 0; x < kImageWidth / 2; x++) {
+                chroma[y * chromaStride + x * 2] = (uint8_t) (40 + x * 5);
+                chroma[y * chromaStride + x * 2 + 1] = (uint8_t) (200 - y * 6);
+            }
+        }
+        image.width = kImageWidth;
+        image.height = kImageHeight;
+        image.luma = luma.data();
+        image.lumaBytesPerRow = lumaStride;
+        image.chroma = chroma.data();
+        image.chromaBytesPerRow = chromaStride;
+        image.fullRange = fullRange;
+    }
+};
+
+/*
+ Direct per-pixel reference: bilinear sample of a plane at output pixel i of
+ a crop, with pixel centers aligned, as the camera crop-and-scale path does.
+ */
+static float sampleAxis(float offset, float size, int planeSize, int outputSize, int i, int *s0) {
+    float center = offset + (i + 0.5f) * size / outputSize - 0.5f;
+    center = std::max(0.0f, std::min((float) (planeSize - 1), center));
+    *s0 = std::max(0, std::min(planeSize - 2, (int) floorf(center)));
+    return center - *s0;
+}
+
+static float samplePlane(const uint8_t *plane, int stride, int pixelStride, int x0, float tx, int y0, float ty) {
+    const uint8_t *row0 = plane + (size_t) y0 * stride;
+    const uint8_t *row1 = row0 + stride;
+    float top = row0[x0 * pixelStride] * (1 - tx) + row0[(x0 + 1) * pixelStride] * tx;
+    float bottom = row1[x0 * pixelStride] * (1 - tx) + row1[(x0 + 1) * pixelStride] * tx;
+    return top * (1 - ty) + bottom * ty;
+}
+
+static void referencePixel(const VRONV12Image &image, VROImageRect crop, int width, int height, int x, int y, float *rgb) {
+    int lx, ly, cx, cy;
+    float ltx = sampleAxis(crop.x, crop.width, image.width, width, x, &lx);
+    float lty = sampleAxis(crop.y, crop.height, image.height, height, y, &ly);
+    float ctx = sampleAxis(crop.x * 0.5f, crop.width * 0.5f, image.width / 2, width, x, &cx);
+    float cty = sampleAxis(crop.y * 0.5f, crop.height * 0.5f, image.height / 2, height, y, &cy);
+
+    float luma = samplePlane(image.luma, image.lumaBytesPerRow, 1, lx, ltx, ly, lty);
+    float cb = samplePlane(image.chroma, image.chromaBytesPerRow, 2, cx, ctx, cy, cty) - 128;
+    float cr = samplePlane(image.chroma + 1, image.chromaBytesPerRow, 2, cx, ctx, cy, cty) - 128;
+    if (!image.fullRange) {
+        luma = (luma - 16) * 255.0f / 219.0f;
+        cb *= 255.0f / 224.0f;
+        cr *= 255.0f / 224.0f;
+    }
+    rgb[0] = luma + 1.402f * cr;
+    rgb[1] = luma - 0.344136f * cb - 0.714136f * cr;
+    rgb[2] = luma + 1.772f * cb;
+    for (int c = 0; c < 3; c++) {
+        rgb[c] = std::max(0.0f, std::min(255.0f, rgb[c]));
+    }
+}
+
+/*
+ An NV12 image made of 2x2 pixel blocks, one (Y, Cb, Cr) per block (one
+ chroma sample each), given in row-major block order.
+ */
+struct BlockImage {
+    std::vector<uint8_t> luma;
+    std::vector<uint8_t> chroma;
+    VRONV12Image image;
+
+    BlockImage(int blocksX, int blocksY, const std::vector<std::array<uint8_t, 3>> &blocks) {
+        int width = blocksX * 2, height = blocksY * 2;
+        luma.assign((size_t) width * height, 0);
+        chroma.assign((size_t) width * blocksY, 0);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                luma[y * width + x] = blocks[(y / 2) * blocksX + x / 2][0];
+            }
+        }
+        for (int by = 0; by < blocksY; by++) {
+            for (int bx = 0; bx < blocksX; bx++) {
+                chroma[by * width + bx * 2] = blocks[by * blocksX + bx][1];
+                chroma[by * width + bx * 2 + 1] = blocks[by * blocksX + bx][2];
+            }
+        }
+        image.width = width;
+        image.height = height;
+        image.luma = luma.data();
+        image.lumaBytesPerRow = width;
+        image.chroma = chroma.data();
+        image.chromaBytesPerRow = width;
+    }
+};
+
+static VROTensorFormat imageNetFormat(int width, int height) {
+    VROTensorFormat format;
+    format.width = width;
+    format.height = height;
+    const float mean[3] = { 0.485f, 0.456f, 0.406f };
+    const float std[3] = { 0.229f, 0.224f, 0.225f };
+    for (int c = 0; c < 3; c++) {
+        format.mean[c] = mean[c];
+        format.std[c] = std[c];
+    }
+    return format;
+}
+
+@interface VROImagePreprocessorTests : XCTestCase
+
+@end
+
+@implementation VROImagePreprocessorTests
+
+/*
+ A uniform image resamples to itself, so the output is fixed: full-range
+ BT.601 (Y, Cb, Cr) = (81, 90, 240) is RGB (238.02, 14.09, 13.66), which
+ normalizes with the ImageNet mean and std to (1.9582, -1.7890, -1.5663).
+ */
+- (void)testGoldenUniformColor {
+    std::vector<uint8_t> luma(16 * 16, 81), chroma(16 * 8, 0);
+    for (size_t i = 0; i < chroma.size(); i += 2) {
+        chroma[i] = 90;
+        chroma[i + 1] = 240;
+    }
+    VRONV12Image image;
+    image.width = image.height = 16;
+    image.luma = luma.data();
+    image.lumaBytesPerRow = 16;
+    image.chroma = chroma.data();
+    image.chromaBytesPerRow = 16;
+
+    VROTensorFormat format = imageNetFormat(5, 3);
+    std::vector<float> output(5 * 3 * 3);
+    VROImagePreprocessor preprocessor;
+    XCTAssertTrue(preprocessor.process(image, VROImageRect(0, 0, 16, 16), 0, VROResizeFilter::Bilinear,
+                                       format, output.data()));
+
+    const float golden[3] = { 1.9582f, -1.7890f, -1.5663f };
+    for (int c = 0; c < 3; c++) {
+        for (int i = 0; i < 15; i++) {
+            XCTAssertEqualWithAccuracy(output[c * 15 + i], golden[c], 1e-3);
+        }
+    }
+}
+
+/*
+ Golden values for the other color paths, from the BT.601 (Kr 0.299, Kb
+ 0.114) and BT.709 (Kr 0.2126, Kb 0.0722) definitions. (Y, Cb, Cr) =
+ (126, 100, 180) with the default [0, 1] normalization is:
+
+   BT.709 video range  (0.86786, 0.41703, 0.27033)
+   BT.601 video range  (0.82775, 0.37952, 0.28078)
+   BT.709 full range   (0.81525, 0.41923, 0.29037)
+ */
+- (void)testGoldenColorPaths {
+    struct Path {
+        bool fullRange, bt709;
+        float rgb[3];
+    };
+    const Path paths[] = {
+        { false, true,  { 0.86786f, 0.41703f, 0.27033f } },
+        { false, false, { 0.82775f, 0.37952f, 0.28078f } },
+        { true,  true,  { 0.81525f, 0.41923f, 0.29037f } },
+    };
+
+    BlockImage test(4, 4, std::vector<std::array<uint8_t, 3>>(16, { 126, 100, 180 }));
+    VROTensorFormat format;
+    format.width = 5;
+    format.height = 3;
+    std::vector<float> output(5 * 3 * 3);
+    VROImagePreprocessor preprocessor;
+    for (const Path &path : paths) {
+        test.image.fullRange = path.fullRange;
+        test.image.bt709 = path.bt709;
+        XCTAssertTrue(preprocessor.process(test.image, VROImageRect(0, 0, 8, 8), 0, VROResizeFilter::Bilinear,
+                                           format, output.data()));
+        for (int c = 0; c < 3; c++) {
+            for (int i = 0; i < 15; i++) {
+                XCTAssertEqualWithAccuracy(output[c * 15 + i], path.rgb[c], 1e-4);
+            }
+        }
+    }
+}
+
+/*
+ Float16 CHW output, four pixels per row so the vectorized half store is
+ used: BT.709 video range (126, 100, 180) is (0.86786, 0.41703, 0.27033),
+ which rounds to the half-precision bits 0x3af1, 0x36ac and 0x3453.
+ */
+- (void)testGoldenFloat16CHW {
+    BlockImage test(4, 4, std::vector<std::array<uint8_t, 3>>(16, { 126, 100, 180 }));
+    test.image.fullRange = false;
+    test.image.bt709 = true;
+
+    VROTensorFormat format;
+    format.width = 4;
+    format.height = 2;
+    format.type = VROTensorType::Float16;
+    std::vector<uint16_t> output(4 * 2 * 3);
+    VROImagePreprocessor preprocessor;
+    XCTAssertTrue(preprocessor.process(test.image, VROImageRect(0, 0, 8, 8), 0, VROResizeFilter::Bilinear,
+                                       format, output.data()));
+
+    const uint16_t golden[3] = { 0x3af1, 0x36ac, 0x3453 };
+    for (int c = 0; c < 3; c++) {
+        for (int i = 0; i < 8; i++) {
+            XCTAssertEqual(output[c * 8 + i], golden[c]);
+        }
+    }
+}
+
+/*
+ Float16 HWC output rotated a quarter turn clockwise. Area filtering a 4x4
+ image of four uniform quadrants to 2x2 gives each quadrant's color exactly,
+ and the rotation moves the bottom-left quadrant to the top left. Golden
+ half-precision bits for the full-range BT.601 quadrant colors:
+
+   Top left      (60, 110, 150)   (0.35625, 0.19797, 0.11021)   0x35b3 0x3256 0x2f0e
+   Top right    (200, 140, 100)   (0.63037, 0.84653, 0.86770)   0x390b 0x3ac6 0x3af1
+   Bottom left   (120, 90, 210)   (0.92143, 0.29223, 0.20653)   0x3b5f 0x34ad 0x329c
+   Bottom right (170, 160, 128)   (0.66667, 0.62348, 0.88904)   0x3955 0x38fd 0x3b1d
+ */
+- (void)testGoldenRotatedFloat16HWC {
+    BlockImage test(2, 2, { { 60, 110, 150 }, { 200, 140, 100 }, { 120, 90, 210 }, { 170, 160, 128 } });
+
+    VROTensorFormat format;
+    format.width = 2;
+    format.height = 2;
+    format.layout = VROTensorLayout::HWC;
+    format.type = VROTensorType::Float16;
+    std::vector<uint16_t> output(2 * 2 * 3);
+    VROImagePreprocessor preprocessor;
+    XCTAssertTrue(preprocessor.process(test.image, VROImageRect(0, 0, 4, 4), 1, VROResizeFilter::Area,
+                                       format, output.data()));
+
+    const uint16_t golden[12] = {
+        0x3b5f, 0x34ad, 0x329c,     // Bottom left
+        0x35b3, 0x3256, 0x2f0e,     // Top left
+        0x3955, 0x38fd, 0x3b1d,     // Bottom right
+        0x390b, 0x3ac6, 0x3af1,     // Top right
+    };
+    for (int i = 0; i < 12; i++) {
+        XCTAssertEqual(output[i], golden[i], @"index %d", i);
+    }
+}
+
+/*
+ A 2x2 image has a single chroma sample, so bilinear taps on the chroma
+ plane must not read a second one. The chroma buffer holds exactly that
+ sample; the output is the uniform golden color.
+ */
+- (void)testSingleChromaSample {
+    BlockImage test(1, 1, { { 81, 90, 240 } });
+    XCTAssertEqual(test.chroma.size(), 2);
+
+    VROTensorFormat format = imageNetFormat(3, 3);
+    std::vector<float> output(3 * 3 * 3);
+    VROImagePreprocessor preprocessor;
+    XCTAssertTrue(preprocessor.process(test.image, VROImageRect(0, 0, 2, 2), 0, VROResizeFilter::Bilinear,
+                                       format, output.data()));
+
+    const float golden[3] = { 1.9582f, -1.7890f, -1.5663f };
+    for (int c = 0; c < 3; c++) {
+        for (int i = 0; i < 9; i++) {
+            XCTAssertEqualWithAccuracy(output[c * 9 + i], golden[c], 1e-3);
+        }
+    }
+}
+
+- (void)testBilinearMatchesReference {
+    VROImagePreprocessor preprocessor;
+    for (bool fullRange : { true, false }) {
+        TestImage test(fullRange);
+        VROImageRect crop(6, 4, 50, 38);
+        VROTensorFormat format = imageNetFormat(19, 13);
+        std::vector<float> output(19 * 13 * 3);
+        XCTAssertTrue(preprocessor.process(test.image, crop, 0, VROResizeFilter::Bilinear, format, output.data()));
+
+        float maxError = 0;
+        for (int y = 0; y < 13; y++) {
+            for (int x = 0; x < 19; x++) {
+                float rgb[3];
+                referencePixel(test.image, crop, 19, 13, x, y, rgb);
+                for (int c = 0; c < 3; c++) {
+                    float expected = (rgb[c] / 255.0f - format.mean[c]) / format.std[c];
+                    maxError = std::max(maxError, fabsf(output[c * 19 * 13 + y * 19 + x] - expected));
+                }
+            }
+        }
+        XCTAssertLessThan(maxError, 1e-3f);
+    }
+}
+
+/*
+ A quarter turn clockwise: output pixel (x, y) of the upright tensor comes
+ from resampled pixel (y, height - 1 - x).
+ */
+- (void)testRotationHWCMatchesReference {
+    TestImage test(true);
+    VROImageRect crop(0, 0, kImageWidth, kImageHeight);
+    VROTensorFormat format = imageNetFormat(12, 16);
+    format.layout = VROTensorLayout::HWC;
+    std::vector<float> output(12 * 16 * 3);
+    VROImagePreprocessor preprocessor;
+    XCTAssertTrue(preprocessor.process(test.image, crop, 1, VROResizeFilter::Bilinear, format, output.data()));
+
+    float maxError = 0;
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 12; x++) {
+            float rgb[3];
+            referencePixel(test.image, crop, 16, 12, y, 12 - 1 - x, rgb);
+            for (int c = 0; c < 3; c++) {
+                float expected = (rgb[c] / 255.0f - format.mean[c]) / format.std[c];
+                maxError = std::max(maxError, fabsf(output[(y * 12 + x) * 3 + c] - expected));
+            }
+        }
+    }
+    XCTAssertLessThan(maxError, 1e-3f);
+}
+
+/*
+ Area filtering a one-pixel luma checkerboard by 8x averages it to mid-gray.
+ */
+- (void)testAreaAveragesCheckerboard {
+    std::vector<uint8_t> luma(64 * 64), chroma(64 * 32, 128);
+    for (int y = 0; y < 64; y++) {
+        for (int x = 0; x < 64; x++) {
+            luma[y * 64 + x] = ((x + y) & 1) ? 255 : 0;
+        }
+    }
+    VRONV12Image image;
+    image.width = image.height = 64;
+    image.luma = luma.data();
+    image.lumaBytesPerRow = 64;
+    image.chroma = chroma.data();
+    image.chromaBytesPerRow = 64;
+
+    VROTensorFormat format;
+    format.width = format.height = 8;
+    std::vector<float> output(8 * 8 * 3);
+    VROImagePreprocessor preprocessor;
+    XCTAssertTrue(preprocessor.process(image, VROImageRect(0, 0, 64, 64), 0, VROResizeFilter::Area, format, output.data()));
+    for (float value : output) {
+        XCTAssertEqualWithAccuracy(value, 0.5f, 1e-4);
+    }
+}
+
+- (void)testPerformanceCameraFrameToTensor {
+    const int width = 1920, height = 1440;
+    std::vector<uint8_t> luma((size_t) width * height), chroma((size_t) width * height / 2);
+    for (size_t i = 0; i < luma.size(); i++) {
+        luma[i] = (uint8_t) (i * 31);
+    }
+    for (size_t i = 0; i < chroma.size(); i++) {
+        chroma[i] = (uint8_t) (i * 17);
+    }
+    VRONV12Image image;
+    image.width = width;
+    image.height = height;
+    image.luma = luma.data();
+    image.lumaBytesPerRow = width;
+    image.chroma = chroma.data();
+    image.chromaBytesPerRow = width;
+
+    VROTensorFormat format = imageNetFormat(256, 256);
+    std::vector<float> output(256 * 256 * 3);
+    float *outputData = output.data();
+    VROImagePreprocessor preprocessor;
+    VROImagePreprocessor *preprocessorPtr = &preprocessor;
+    [self measureBlock:^{
+        preprocessorPtr->process(image, VROImageRect(240, 0, 1440, 1440), 1, VROResizeFilter::Area, format, outputData);
+    }];
+}
+
+@end
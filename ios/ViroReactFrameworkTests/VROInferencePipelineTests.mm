@@ -0,0 +1,372 @@
+//
+//  VROInferencePipelineTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROInferencePipeline.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+/*
+ The fake model's frames: the frame id travels through every stage so
+ postprocess can check ordering.
+ */
+typedef VROInferencePipeline<uint64_t, uint64_t, uint64_t> VROFakePipeline;
+
+/*
+ Upper bound on any wait in these tests. Waits end as soon as their
+ condition holds, so this only matters when a test fails.
+ */
+static const std::chrono::seconds kTimeout(5);
+
+/*
+ Wait until the predicate holds or the timeout expires.
+ */
+static bool waitFor(std::function<bool()> predicate) {
+    auto deadline = std::chrono::steady_clock::now() + kTimeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+/*
+ Holds each frame that reaches a stage until the test releases it, so tests
+ control exactly which frame is in which stage instead of relying on sleeps.
+ */
+class VROStageGate {
+public:
+
+    VROStageGate() : _permits(0), _inside(0), _open(false) {}
+
+    // Called by the stage function
+    void pass(uint64_t frameId) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _entered.push_back(frameId);
+        _inside++;
+        _condition.notify_all();
+        _condition.wait(lock, [this] { return _open || _permits > 0; });
+        if (!_open) {
+            _permits--;
+        }
+        _inside--;
+    }
+
+    // Let the given number of frames through
+    void release(int count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _permits += count;
+        _condition.notify_all();
+    }
+
+    // Let every frame through from now on
+    void open() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _open = true;
+        _condition.notify_all();
+    }
+
+    // Wait until the given number of frames have reached the gate in total
+    bool waitForEntered(size_t count) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _condition.wait_for(lock, kTimeout, [this, count] { return _entered.size() >= count; });
+    }
+
+    int getInside() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _inside;
+    }
+
+    std::vector<uint64_t> getEntered() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entered;
+    }
+
+private:
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<uint64_t> _entered;
+    int _permits;
+    int _inside;
+    bool _open;
+
+};
+
+/*
+ A pipeline whose stages pass through the given gates, standing in for
+ crop/scale, the model, and output decoding. A null gate lets frames
+ straight through. Postprocess records the ids of completed frames.
+ */
+static std::unique_ptr<VROFakePipeline> createFakePipeline(VROStageGate *preprocess, VROStageGate *inference,
+                                                           VROStageGate *postprocess, size_t queueCapacity,
+                                                           std::mutex *mutex, std::vector<uint64_t> *outCompleted) {
+    return std::unique_ptr<VROFakePipeline>(new VROFakePipeline("fake",
+        [preprocess](uint64_t &input, uint64_t *outPrepared) {
+            if (preprocess) {
+                preprocess->pass(input);
+            }
+            *outPrepared = input;
+            return true;
+        },
+        [inference](uint64_t &prepared, uint64_t *outOutput) {
+            if (inference) {
+                inference->pass(prepared);
+            }
+            *outOutput = prepared;
+            return true;
+        },
+        [postprocess, mutex, outCompleted](uint64_t &output, const VROInferenceFrameInfo &info) {
+            if (postprocess) {
+                postprocess->pass(output);
+            }
+            std::lock_guard<std::mutex> lock(*mutex);
+            outCompleted->push_back(info.frameId);
+        }, queueCapacity));
+}
+
+@interface VROInferencePipelineTests : XCTestCase
+
+@end
+
+@implementation VROInferencePipelineTests
+
+/*
+ While the model is busy with frame 0, frames 1-5 arrive. Each queue holds
+ one frame, so frames 1-4 are dropped oldest-first and only the newest
+ frame is run next.
+ */
+- (void)testDropsOldestWhileModelIsBusy {
+    std::mutex mutex;
+    std::vector<uint64_t> completed;
+    VROStageGate inference;
+    std::unique_ptr<VROFakePipeline> pipeline = createFakePipeline(nullptr, &inference, nullptr, 1, &mutex, &completed);
+    VROFakePipeline *pipelinePtr = pipeline.get();
+    pipeline->start();
+
+    pipeline->submit(0);
+    XCTAssert(inference.waitForEntered(1));
+    for (uint64_t i = 1; i <= 5; i++) {
+        pipeline->submit(i);
+    }
+    XCTAssert(waitFor([pipelinePtr] { return pipelinePtr->getDroppedCount() == 4; }));
+
+    inference.release(1);
+    XCTAssert(waitFor([pipelinePtr] { return pipelinePtr->getCompletedCount() == 1; }));
+    inference.release(1);
+    XCTAssert(waitFor([pipelinePtr] { return pipelinePtr->getCompletedCount() == 2; }));
+    inference.open();
+    pipeline->stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    XCTAssert(completed == std::vector<uint64_t>({ 0, 5 }));
+    XCTAssert(inference.getEntered() == std::vector<uint64_t>({ 0, 5 }));
+    XCTAssertEqual(pipeline->getSubmittedCount(), 6);
+    XCTAssertEqual(pipeline->getDroppedCount(), 4);
+}
+
+/*
+ The stages overlap: frame 2 is preprocessed while frame 1 is in the model
+ and frame 0 is being decoded. Frames still complete in order; the queues
+ have room for every frame, so none are dropped when the gates open.
+ */
+- (void)testStagesOverlap {
+    std::mutex mutex;
+    std::vector<uint64_t> completed;
+    VROStageGate preprocess, inference, postprocess;
+    std::unique_ptr<VROFakePipeline> pipeline = createFakePipeline(&preprocess, &inference, &postprocess, 4,
+                                                                   &mutex, &completed);
+    VROFakePipeline *pipelinePtr = pipeline.get();
+    pipeline->start();
+
+    pipeline->submit(0);
+    XCTAssert(preprocess.waitForEntered(1));
+    preprocess.release(1);
+    XCTAssert(inference.waitForEntered(1));
+
+    pipeline->submit(1);
+    XCTAssert(preprocess.waitForEntered(2));
+    preprocess.release(1);
+    inference.release(1);
+    XCTAssert(postprocess.waitForEntered(1));
+    XCTAssert(inference.waitForEntered(2));
+
+    pipeline->submit(2);
+    XCTAssert(preprocess.waitForEntered(3));
+
+    XCTAssertEqual(preprocess.getInside(), 1);
+    XCTAssertEqual(inference.getInside(), 1);
+    XCTAssertEqual(postprocess.getInside(), 1);
+    XCTAssertEqual(preprocess.getEntered().back(), 2);
+    XCTAssertEqual(inference.getEntered().back(), 1);
+    XCTAssertEqual(postprocess.getEntered().back(), 0);
+
+    preprocess.open();
+    inference.open();
+    postprocess.open();
+    XCTAssert(waitFor([pipelinePtr] { return pipelinePtr->getCompletedCount() == 3; }));
+    pipeline->stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    XCTAssert(completed == std::vector<uint64_t>({ 0, 1, 2 }));
+    XCTAssertEqual(pipeline->getDroppedCount(), 0);
+    for (int stage = 0; stage <= (int) VROInferenceStage::EndToEnd; stage++) {
+        XCTAssertEqual(pipeline->getLatency((VROInferenceStage) stage).getCount(), 3);
+    }
+}
+
+/*
+ Frames rejected by a stage function are counted as dropped.
+ */
+- (void)testRejectedFramesAreCounted {
+    std::atomic<uint64_t> completed { 0 };
+    VROFakePipeline pipeline("reject",
+        [](uint64_t &input, uint64_t *outPrepared) {
+            *outPrepared = input;
+            return input % 2 == 0;
+        },
+        [](uint64_t &prepared, uint64_t *outOutput) {
+            *outOutput = prepared;
+            return true;
+        },
+        [&completed](uint64_t &output, const VROInferenceFrameInfo &info) {
+            completed++;
+        }, 256);
+    pipeline.start();
+    for (uint64_t i = 0; i < 100; i++) {
+        pipeline.submit(i);
+    }
+    VROFakePipeline *pipelinePtr = &pipeline;
+    XCTAssert(waitFor([pipelinePtr] {
+        return pipelinePtr->getCompletedCount() + pipelinePtr->getDroppedCount() == 100;
+    }));
+    pipeline.stop();
+
+    XCTAssertEqual(completed.load(), 50);
+    XCTAssertEqual(pipeline.getDroppedCount(), 50);
+}
+
+/*
+ A stopped pipeline drops submitted frames, can be restarted, and then
+ processes new frames.
+ */
+- (void)testStopAndRestart {
+    std::mutex mutex;
+    std::vector<uint64_t> completed;
+    std::unique_ptr<VROFakePipeline> pipeline = createFakePipeline(nullptr, nullptr, nullptr, 1, &mutex, &completed);
+    VROFakePipeline *pipelinePtr = pipeline.get();
+
+    pipeline->start();
+    pipeline->submit(0);
+    XCTAssert(waitFor([pipelinePtr] { return pipelinePtr->getCompletedCount() == 1; }));
+    pipeline->stop();
+
+    XCTAssertFalse(pipeline->submit(1));
+    XCTAssertEqual(pipeline->getDroppedCount(), 1);
+
+    pipeline->start();
+    pipeline->submit(2);
+    XCTAssert(waitFor([pipelinePtr] { return pipelinePtr->getCompletedCount() == 2; }));
+    pipeline->stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    XCTAssert(completed == std::vector<uint64_t>({ 0, 2 }));
+}
+
+/*
+ A closed queue rejects pushes instead of holding them until it reopens.
+ */
+- (void)testClosedQueueRejectsPush {
+    VROBoundedQueue<int> queue(2);
+    queue.close();
+    XCTAssertFalse(queue.push(1));
+    XCTAssertEqual(queue.size(), 0);
+    XCTAssertEqual(queue.getDroppedCount(), 1);
+
+    queue.reopen();
+    XCTAssertTrue(queue.push(2));
+    int item = 0;
+    XCTAssertTrue(queue.pop(&item));
+    XCTAssertEqual(item, 2);
+}
+
+/*
+ Percentiles are within one bucket (a factor of sqrt(2)) of the exact value.
+ */
+- (void)testHistogramPercentiles {
+    VROLatencyHistogram histogram;
+    for (int i = 1; i <= 100; i++) {
+        histogram.record(i);
+    }
+    XCTAssertEqual(histogram.getCount(), 100);
+    XCTAssertEqualWithAccuracy(histogram.getMeanMs(), 50.5, 1e-9);
+    XCTAssertGreaterThanOrEqual(histogram.getPercentileMs(50), 50);
+    XCTAssertLessThanOrEqual(histogram.getPercentileMs(50), 50 * M_SQRT2);
+    XCTAssertGreaterThanOrEqual(histogram.getPercentileMs(95), 95);
+    XCTAssertEqual(histogram.getPercentileMs(100), 100);
+}
+
+/*
+ The last bucket ends at ~5.8 seconds; longer durations are counted in it
+ and the maximum is still exact.
+ */
+- (void)testHistogramRange {
+    XCTAssertEqualWithAccuracy(VROLatencyHistogram::getBucketUpperBound(VROLatencyHistogram::kNumBuckets - 1),
+                               5792.6, 0.1);
+    VROLatencyHistogram histogram;
+    histogram.record(10000);
+    XCTAssertEqual(histogram.getCount(), 1);
+    XCTAssertEqual(histogram.getMaxMs(), 10000);
+}
+
+/*
+ Scheduling overhead: 1,000 frames through stages that do no work, with
+ queues large enough that none are dropped.
+ */
+- (void)testPerformanceFrameThroughput {
+    std::mutex mutex;
+    std::vector<uint64_t> completed;
+    std::unique_ptr<VROFakePipeline> pipeline = createFakePipeline(nullptr, nullptr, nullptr, 1024, &mutex, &completed);
+    VROFakePipeline *pipelinePtr = pipeline.get();
+    pipeline->start();
+
+    [self measureBlock:^{
+        uint64_t target = pipelinePtr->getCompletedCount() + 1000;
+        for (uint64_t i = 0; i < 1000; i++) {
+            pipelinePtr->submit(i);
+        }
+        XCTAssert(waitFor([pipelinePtr, target] { return pipelinePtr->getCompletedCount() == target; }));
+    }];
+    pipeline->stop();
+    XCTAssertEqual(pipeline->getDroppedCount(), 0);
+}
+
+@end
@@ -0,0 +1,525 @@
+//
+//  VROMipChainBloomTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROBloomRenderPass.h>
+#include <ViroKit/VRORecordingDriver.h>
+#include <memory>
+#include <map>
+#include <vector>
+
+// Reference resolution for timing, so results compare across devices
+static const int kReferenceWidth = 1920;
+static const int kReferenceHeight = 1080;
+static const int kBenchmarkFrames = 10;
+
+/*
+ Gaussian pass that only counts the frames forwarded to it.
+ */
+class VROCountingGaussianPass : public VROGaussianBlurRenderPass {
+public:
+    int renders = 0;
+
+    void render(std::shared_ptr<VROScene> /* scene */,
+                std::shared_ptr<VROScene> /* outgoingScene */,
+                VRORenderPassInputOutput & /* inputs */,
+                VRORenderContext * /* context */, std::shared_ptr<VRODriver> & /* driver */) {
+        renders++;
+    }
+};
+
+/*
+ Recording render target backed by a GL framebuffer, so passes that bind
+ it through VROTestGLTargetDriver draw into it. Sized targets get one RGBA8
+ texture at attachment 0; attached textures are looked up in the driver's
+ table of GL names, and counted.
+ */
+class VROTestGLRenderTarget : public VRORecordingRenderTarget {
+public:
+    int attachedTextures = 0;
+
+    VROTestGLRenderTarget(VRORenderTargetType type, int numAttachments, int numImages,
+                          std::shared_ptr<VRODriverCommandLog> log,
+                          std::shared_ptr<std::map<const VROTexture *, GLuint>> names) :
+        VRORecordingRenderTarget(type, numAttachments, numImages, log),
+        _names(names), _texture(0) {
+        glGenFramebuffers(1, &_framebuffer);
+    }
+    virtual ~VROTestGLRenderTarget() {
+        glDeleteFramebuffers(1, &_framebuffer);
+        glDeleteTextures(1, &_texture);
+    }
+
+    GLuint getFramebuffer() const {
+        return _framebuffer;
+    }
+
+    void setViewport(VROViewport viewport) {
+        VRORecordingRenderTarget::setViewport(viewport);
+        glDeleteTextures(1, &_texture);
+        glGenTextures(1, &_texture);
+        glBindTexture(GL_TEXTURE_2D, _texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, viewport.getWidth(), viewport.getHeight());
+        attachName(_texture, 0);
+    }
+    bool bind() {
+        glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+        glViewport(0, 0, getWidth(), getHeight());
+        return true;
+    }
+    bool attachTexture(std::shared_ptr<VROTexture> texture, int attachment) {
+        auto name = _names->find(texture.get());
+        if (name == _names->end()) {
+            return false;
+        }
+        VRORecordingRenderTarget::attachTexture(texture, attachment);
+        attachName(name->second, attachment);
+        attachedTextures++;
+        return true;
+    }
+
+private:
+    std::shared_ptr<std::map<const VROTexture *, GLuint>> _names;
+    GLuint _framebuffer;
+    GLuint _texture;
+
+    void attachName(GLuint texture, int attachment) {
+        GLint bound = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+        glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + attachment, GL_TEXTURE_2D, texture, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, bound);
+    }
+};
+
+/*
+ Recording driver whose render targets are VROTestGLRenderTargets, bound in
+ GL when the bound target changes, as the GL driver does.
+ */
+class VROTestGLTargetDriver : public VRORecordingDriver {
+public:
+    std::vector<std::shared_ptr<VROTestGLRenderTarget>> targets;
+
+    VROTestGLTargetDriver() :
+        _names(std::make_shared<std::map<const VROTexture *, GLuint>>()) {}
+
+    /*
+     Return a texture that stands for the given GL texture when attached to
+     this driver's targets.
+     */
+    std::shared_ptr<VROTexture> wrapTexture(GLuint name) {
+        std::unique_ptr<VROTextureSubstrate> substrate(new VRORecordingTextureSubstrate());
+        std::shared_ptr<VROTexture> texture = std::make_shared<VROTexture>(VROTextureType::Texture2D,
+                                                                           VROTextureInternalFormat::RGBA8,
+                                                                           std::move(substrate));
+        (*_names)[texture.get()] = name;
+        return texture;
+    }
+
+    int getAttachedTextureCount() const {
+        int count = 0;
+        for (const std::shared_ptr<VROTestGLRenderTarget> &target : targets) {
+            count += target->attachedTextures;
+        }
+        return count;
+    }
+
+    std::shared_ptr<VRORenderTarget> newRenderTarget(VRORenderTargetType type, int numAttachments, int numImages,
+                                                     bool /* enableMipmaps */, bool /* needsDepthStencil */) {
+        getCommandLog()->record(VRODriverCommand::CreateRenderTarget, (int32_t) type, numAttachments);
+        std::shared_ptr<VROTestGLRenderTarget> target = std::make_shared<VROTestGLRenderTarget>(type, numAttachments, numImages,
+                                                                                                getCommandLog(), _names);
+        targets.push_back(target);
+        return target;
+    }
+    bool bindRenderTarget(std::shared_ptr<VRORenderTarget> target, VRORenderTargetUnbindOp unbindOp) {
+        bool bound = VRORecordingDriver::bindRenderTarget(target, unbindOp);
+        if (bound && target) {
+            target->bind();
+        }
+        return bound;
+    }
+
+private:
+    std::shared_ptr<std::map<const VROTexture *, GLuint>> _names;
+};
+
+/*
+ GL stand-in for the HDR render target: attachment 0 is the LDR color,
+ attachment 1 the bright colors, cleared to the given value. Only
+ attachment 0 is left as a draw buffer.
+ */
+struct VROTestHDRFramebuffer {
+    GLuint framebuffer = 0;
+    GLuint textures[2] = { 0, 0 };
+};
+
+static VROTestHDRFramebuffer createHDRFramebuffer(int width, int height, float brightness) {
+    VROTestHDRFramebuffer hdr;
+    const GLenum formats[2] = { GL_RGBA8, GL_RGBA16F };
+    glGenTextures(2, hdr.textures);
+    glGenFramebuffers(1, &hdr.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, hdr.framebuffer);
+    for (int i = 0; i < 2; i++) {
+        glBindTexture(GL_TEXTURE_2D, hdr.textures[i]);
+        glTexStorage2D(GL_TEXTURE_2D, 1, formats[i], width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, hdr.textures[i], 0);
+    }
+    const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+    const GLfloat black[4] = { 0, 0, 0, 1 };
+    const GLfloat bright[4] = { brightness, brightness, brightness, 1 };
+    glClearBufferfv(GL_COLOR, 0, black);
+    glClearBufferfv(GL_COLOR, 1, bright);
+    glDrawBuffers(1, drawBuffers);
+    glViewport(0, 0, width, height);
+    return hdr;
+}
+
+static void deleteHDRFramebuffer(VROTestHDRFramebuffer &hdr) {
+    glDeleteFramebuffers(1, &hdr.framebuffer);
+    glDeleteTextures(2, hdr.textures);
+}
+
+@interface VROMipChainBloomTests : XCTestCase
+
+@end
+
+@implementation VROMipChainBloomTests {
+    EAGLContext *_context;
+    std::shared_ptr<VROShaderProgramCache> _programs;
+    std::shared_ptr<VROTestGLTargetDriver> _driver;
+}
+
+- (void)setUp {
+    [super setUp];
+    _context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(_context);
+    [EAGLContext setCurrentContext:_context];
+
+    NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    _programs = std::make_shared<VROShaderProgramCache>(std::string([directory UTF8String]));
+    _driver = std::make_shared<VROTestGLTargetDriver>();
+}
+
+- (void)tearDown {
+    _driver.reset();
+    _programs.reset();
+    [EAGLContext setCurrentContext:nil];
+    _context = nil;
+    [super tearDown];
+}
+
+/*
+ Inputs for a VROBloomRenderPass, as the choreographer gives the Gaussian
+ pass: the HDR target's bright-color texture in textures[kGaussianInput].
+ */
+- (VRORenderPassInputOutput)createBloomInputs:(GLuint)brightTexture {
+    VRORenderPassInputOutput inputs;
+    inputs.textures[kGaussianInput] = _driver->wrapTexture(brightTexture);
+    return inputs;
+}
+
+/*
+ Each level halves the one above it, starting at half the viewport, until
+ the level would fall under 8 pixels or maxLevels is reached.
+ */
+- (void)testLevelSizes {
+    VROMipChainBloom bloom(_programs);
+    bloom.setViewport(kReferenceWidth, kReferenceHeight);
+    const int expected[6][2] = { { 960, 540 }, { 480, 270 }, { 240, 135 }, { 120, 67 }, { 60, 33 }, { 30, 16 } };
+    XCTAssertEqual(bloom.getNumLevels(), 6);
+    for (int i = 0; i < bloom.getNumLevels(); i++) {
+        XCTAssertEqual(bloom.getLevelWidth(i), expected[i][0]);
+        XCTAssertEqual(bloom.getLevelHeight(i), expected[i][1]);
+    }
+    XCTAssertEqual(VROMipChainBloom::estimateCost(kReferenceWidth, kReferenceHeight).passes, 11);
+
+    bloom.setViewport(64, 40);
+    XCTAssertEqual(bloom.getNumLevels(), 2);
+    XCTAssertEqual(bloom.getLevelWidth(1), 16);
+    XCTAssertEqual(bloom.getLevelHeight(1), 10);
+
+    VROMipChainBloom shallow(_programs, 3);
+    shallow.setViewport(kReferenceWidth, kReferenceHeight);
+    XCTAssertEqual(shallow.getNumLevels(), 3);
+    XCTAssertEqual(shallow.getLevelWidth(2), 240);
+
+    VROMipChainBloom tiny(_programs);
+    tiny.setViewport(10, 10);
+    XCTAssertEqual(tiny.getNumLevels(), 0);
+    XCTAssertEqual(tiny.render(0), 0);
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+}
+
+/*
+ GaussianPingPong, the default, forwards every frame to the Gaussian pass
+ and leaves the mip chain idle.
+ */
+- (void)testGaussianModeForwardsToGaussianPass {
+    std::shared_ptr<VROCountingGaussianPass> gaussian = std::make_shared<VROCountingGaussianPass>();
+    std::shared_ptr<VROMipChainBloom> mipChain = std::make_shared<VROMipChainBloom>(_programs);
+    VROBloomRenderPass pass(gaussian, mipChain);
+    XCTAssert(pass.getMode() == VROBloomMode::GaussianPingPong);
+
+    std::shared_ptr<VRODriver> driver = _driver;
+    pass.createRenderTargets(driver);
+    pass.setViewPort(VROViewport(0, 0, 256, 128), driver);
+    VROTestHDRFramebuffer hdr = createHDRFramebuffer(256, 128, 2.0);
+    VRORenderPassInputOutput inputs = [self createBloomInputs:hdr.textures[1]];
+    _driver->getCommandLog()->clear();
+    pass.render(nullptr, nullptr, inputs, nullptr, driver);
+
+    XCTAssertEqual(gaussian->renders, 1);
+    XCTAssertEqual(mipChain->getFrameStats().cost.passes, 0);
+    XCTAssertEqual(_driver->getCommandLog()->getCount(VRODriverCommand::BindRenderTarget), 0);
+    XCTAssertEqual(_driver->getAttachedTextureCount(), 0);
+    deleteHDRFramebuffer(hdr);
+}
+
+/*
+ MipChain reads the same input as the Gaussian pass, runs every level of
+ the chain, and sets outputTarget to the pass's own target holding the
+ bloom, without touching the Gaussian pass.
+ */
+- (void)testMipChainModeRendersChain {
+    const int width = 256, height = 128;
+    VROTestHDRFramebuffer hdr = createHDRFramebuffer(width, height, 2.0);
+
+    std::shared_ptr<VROCountingGaussianPass> gaussian = std::make_shared<VROCountingGaussianPass>();
+    std::shared_ptr<VROMipChainBloom> mipChain = std::make_shared<VROMipChainBloom>(_programs);
+    VROBloomRenderPass pass(gaussian, mipChain);
+    pass.setMode(VROBloomMode::MipChain);
+    XCTAssert(pass.getMode() == VROBloomMode::MipChain);
+
+    std::shared_ptr<VRODriver> driver = _driver;
+    pass.createRenderTargets(driver);
+    pass.setViewPort(VROViewport(0, 0, width, height), driver);
+    VRORenderPassInputOutput inputs = [self createBloomInputs:hdr.textures[1]];
+    _driver->getCommandLog()->clear();
+    pass.render(nullptr, nullptr, inputs, nullptr, driver);
+
+    XCTAssertEqual(gaussian->renders, 0);
+    XCTAssertEqual(mipChain->getNumLevels(), 4);
+    VROBloomCost expected = VROMipChainBloom::estimateCost(width, height);
+    XCTAssertEqual(mipChain->getFrameStats().cost.passes, 7);
+    XCTAssertEqual(mipChain->getFrameStats().cost.passes, expected.passes);
+    XCTAssertEqual(mipChain->getFrameStats().cost.pixelsWritten, expected.pixelsWritten);
+    XCTAssertEqual(mipChain->getLastFrameStats().cost.passes, 7);
+    XCTAssertEqual(_driver->getCommandLog()->getCount(VRODriverCommand::BindRenderTarget), 2);
+
+    std::shared_ptr<VROTestGLRenderTarget> output = std::dynamic_pointer_cast<VROTestGLRenderTarget>(inputs.outputTarget);
+    XCTAssert(output != nullptr);
+    XCTAssertEqual(output->getWidth(), width);
+    XCTAssertEqual(output->getHeight(), height);
+
+    GLint bound = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+    XCTAssertEqual(bound, (GLint) output->getFramebuffer());
+
+    uint8_t pixel[4] = { 0, 0, 0, 0 };
+    glReadPixels(width / 2, height / 2, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    XCTAssertGreaterThan(pixel[0], 0);
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+    deleteHDRFramebuffer(hdr);
+}
+
+/*
+ The input texture's GL name is read once, and read again only for a new
+ input texture or after the viewport changes.
+ */
+- (void)testInputNameIsReadOncePerTexture {
+    VROTestHDRFramebuffer hdr = createHDRFramebuffer(128, 128, 2.0);
+    std::shared_ptr<VROCountingGaussianPass> gaussian = std::make_shared<VROCountingGaussianPass>();
+    std::shared_ptr<VROMipChainBloom> mipChain = std::make_shared<VROMipChainBloom>(_programs);
+    VROBloomRenderPass pass(gaussian, mipChain);
+    pass.setMode(VROBloomMode::MipChain);
+
+    std::shared_ptr<VRODriver> driver = _driver;
+    pass.createRenderTargets(driver);
+    pass.setViewPort(VROViewport(0, 0, 128, 128), driver);
+    VRORenderPassInputOutput inputs = [self createBloomInputs:hdr.textures[1]];
+    _driver->getCommandLog()->clear();
+    for (int frame = 0; frame < 3; frame++) {
+        pass.render(nullptr, nullptr, inputs, nullptr, driver);
+    }
+    XCTAssertEqual(_driver->getAttachedTextureCount(), 1);
+    XCTAssertEqual(_driver->getCommandLog()->getCount(VRODriverCommand::BindRenderTarget), 4);
+
+    VRORenderPassInputOutput next = [self createBloomInputs:hdr.textures[1]];
+    pass.render(nullptr, nullptr, next, nullptr, driver);
+    XCTAssertEqual(_driver->getAttachedTextureCount(), 2);
+
+    pass.setViewPort(VROViewport(0, 0, 128, 128), driver);
+    pass.render(nullptr, nullptr, next, nullptr, driver);
+    XCTAssertEqual(_driver->getAttachedTextureCount(), 3);
+    XCTAssertEqual(gaussian->renders, 0);
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+    deleteHDRFramebuffer(hdr);
+}
+
+/*
+ MipChain falls back to the Gaussian pass for a frame without an input
+ texture, or when the chain has no levels.
+ */
+- (void)testMipChainModeFallsBackToGaussianPass {
+    std::shared_ptr<VROCountingGaussianPass> gaussian = std::make_shared<VROCountingGaussianPass>();
+    std::shared_ptr<VROMipChainBloom> mipChain = std::make_shared<VROMipChainBloom>(_programs);
+    VROBloomRenderPass pass(gaussian, mipChain);
+    pass.setMode(VROBloomMode::MipChain);
+    std::shared_ptr<VRODriver> driver = _driver;
+    pass.createRenderTargets(driver);
+    pass.setViewPort(VROViewport(0, 0, 64, 64), driver);
+
+    VRORenderPassInputOutput missing;
+    pass.render(nullptr, nullptr, missing, nullptr, driver);
+    XCTAssertEqual(gaussian->renders, 1);
+    XCTAssert(missing.outputTarget == nullptr);
+
+    VROTestHDRFramebuffer hdr = createHDRFramebuffer(8, 8, 2.0);
+    pass.setViewPort(VROViewport(0, 0, 8, 8), driver);
+    VRORenderPassInputOutput inputs = [self createBloomInputs:hdr.textures[1]];
+    pass.render(nullptr, nullptr, inputs, nullptr, driver);
+    XCTAssertEqual(gaussian->renders, 2);
+    XCTAssertEqual(mipChain->getFrameStats().cost.passes, 0);
+    XCTAssert(inputs.outputTarget == nullptr);
+    deleteHDRFramebuffer(hdr);
+}
+
+/*
+ Each pass's parameters are streamed as one uniform block and bound by
+ offset, and the uniform buffer bindings the passes change are restored.
+ */
+- (void)testPassParametersAreStreamed {
+    VROTestHDRFramebuffer hdr = createHDRFramebuffer(256, 160, 2.0);
+    VROMipChainBloom bloom(_programs);
+    bloom.setViewport(256, 160);
+
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, 256, nullptr, GL_STATIC_DRAW);
+    glBindBufferRange(GL_UNIFORM_BUFFER, kBloomPassUBOBindingPoint, buffer, 0, 64);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    XCTAssertNotEqual(bloom.render(hdr.textures[1]), 0);
+    int passes = bloom.getFrameStats().cost.passes;
+    XCTAssertEqual(passes, 7);
+    XCTAssertEqual(bloom.getPassUniformStats().allocations, passes);
+    XCTAssertEqual(bloom.getPassUniformStats().bindCalls, passes);
+    XCTAssertEqual(bloom.getPassUniformStats().overflows, 0);
+
+    GLint bound = -1, pointBuffer = 0;
+    GLint64 start = -1, size = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &bound);
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, kBloomPassUBOBindingPoint, &pointBuffer);
+    glGetInteger64i_v(GL_UNIFORM_BUFFER_START, kBloomPassUBOBindingPoint, &start);
+    glGetInteger64i_v(GL_UNIFORM_BUFFER_SIZE, kBloomPassUBOBindingPoint, &size);
+    XCTAssertEqual(bound, 0);
+    XCTAssertEqual(pointBuffer, (GLint) buffer);
+    XCTAssertEqual(start, 0);
+    XCTAssertEqual(size, 64);
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+
+    glDeleteBuffers(1, &buffer);
+    deleteHDRFramebuffer(hdr);
+}
+
+/*
+ iOS has no GPU timer queries, so gpuMs stays -1 and cpuMs covers only
+ issuing the passes. Timing one render between two glFinish calls, at the
+ reference resolution, gives the CPU-side measure of the GPU cost to use
+ in its place.
+ */
+- (void)testFinishedTimingAtReferenceResolution {
+    VROTestHDRFramebuffer hdr = createHDRFramebuffer(kReferenceWidth, kReferenceHeight, 2.0);
+    VROMipChainBloom timed(_programs);
+    timed.setViewport(kReferenceWidth, kReferenceHeight);
+
+    // Compile the programs outside the timed render
+    XCTAssertNotEqual(timed.render(hdr.textures[1]), 0);
+
+    VROBloomFrameStats issued = timed.getFrameStats();
+    glFinish();
+    double start = VROTimeCurrentMillis();
+    XCTAssertNotEqual(timed.render(hdr.textures[1]), 0);
+    glFinish();
+    double finishedMs = VROTimeCurrentMillis() - start;
+    double cpuMs = timed.getFrameStats().cpuMs - issued.cpuMs;
+
+    NSLog(@"Mip-chain bloom at %dx%d: %.3f ms to finish, %.3f ms to issue; %s",
+          kReferenceWidth, kReferenceHeight, finishedMs, cpuMs,
+          VROMipChainBloom::estimateCost(kReferenceWidth, kReferenceHeight).toString().c_str());
+    if (!VROMipChainBloom::isTimerQuerySupported()) {
+        XCTAssertEqual(timed.getFrameStats().gpuMs, -1);
+    }
+    XCTAssertGreaterThan(finishedMs, 0);
+    XCTAssertGreaterThanOrEqual(finishedMs, cpuMs);
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+    deleteHDRFramebuffer(hdr);
+}
+
+/*
+ MipChain mode through VROBloomRenderPass at the reference resolution,
+ including the blit into the output, with each frame finished so the GPU
+ work is in the measurement.
+ */
+- (void)testPerformanceMipChainModeAtReferenceResolution {
+    VROTestHDRFramebuffer hdr = createHDRFramebuffer(kReferenceWidth, kReferenceHeight, 2.0);
+    std::shared_ptr<VROCountingGaussianPass> gaussian = std::make_shared<VROCountingGaussianPass>();
+    std::shared_ptr<VROMipChainBloom> mipChain = std::make_shared<VROMipChainBloom>(_programs);
+    std::shared_ptr<VROBloomRenderPass> pass = std::make_shared<VROBloomRenderPass>(gaussian, mipChain);
+    pass->setMode(VROBloomMode::MipChain);
+
+    std::shared_ptr<VRODriver> driver = _driver;
+    pass->createRenderTargets(driver);
+    pass->setViewPort(VROViewport(0, 0, kReferenceWidth, kReferenceHeight), driver);
+    __block VRORenderPassInputOutput inputs = [self createBloomInputs:hdr.textures[1]];
+    pass->render(nullptr, nullptr, inputs, nullptr, driver);
+    glFinish();
+
+    __block double totalMs = 0;
+    __block int totalFrames = 0;
+    [self measureBlock:^{
+        std::shared_ptr<VRODriver> blockDriver = driver;
+        double start = VROTimeCurrentMillis();
+        for (int frame = 0; frame < kBenchmarkFrames; frame++) {
+            pass->render(nullptr, nullptr, inputs, nullptr, blockDriver);
+            glFinish();
+        }
+        totalMs += VROTimeCurrentMillis() - start;
+        totalFrames += kBenchmarkFrames;
+    }];
+    NSLog(@"Mip-chain bloom mode at %dx%d: %.3f ms per finished frame",
+          kReferenceWidth, kReferenceHeight, totalMs / totalFrames);
+    XCTAssertEqual(gaussian->renders, 0);
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+    deleteHDRFramebuffer(hdr);
+}
+
+@end
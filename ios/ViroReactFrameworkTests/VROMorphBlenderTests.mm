@@ -0,0 +1,132 @@
+//
+//  VROMorphBlenderTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROMorphBlender.h>
+#include <cmath>
+#include <vector>
+
+// A face mesh with the 52 ARKit blendshapes
+static const int kFaceVertices = 5000;
+static const int kBlendshapes = 52;
+
+static std::vector<float> createBase() {
+    std::vector<float> base(kFaceVertices * 3);
+    for (int v = 0; v < kFaceVertices; v++) {
+        base[v * 3 + 0] = sinf(v * 0.013f) * 0.08f;
+        base[v * 3 + 1] = cosf(v * 0.007f) * 0.1f;
+        base[v * 3 + 2] = 0.05f * sinf(v * 0.002f);
+    }
+    return base;
+}
+
+/*
+ Each blendshape moves a contiguous region of about a tenth of the face, as
+ a brow, lip or cheek shape does.
+ */
+static std::vector<std::vector<float>> createDeltas() {
+    std::vector<std::vector<float>> deltas(kBlendshapes, std::vector<float>(kFaceVertices * 3, 0));
+    for (int t = 0; t < kBlendshapes; t++) {
+        int first = (t * 977) % kFaceVertices;
+        for (int i = 0; i < kFaceVertices / 10; i++) {
+            int v = (first + i) % kFaceVertices;
+            deltas[t][v * 3 + 0] = 0.002f * sinf(t + i * 0.1f);
+            deltas[t][v * 3 + 1] = 0.003f * cosf(t + i * 0.1f);
+            deltas[t][v * 3 + 2] = 0.001f;
+        }
+    }
+    return deltas;
+}
+
+@interface VROMorphBlenderTests : XCTestCase
+
+@end
+
+@implementation VROMorphBlenderTests
+
+/*
+ The sparse, chunked blend matches a dense blend of every target, including
+ after only some weights change.
+ */
+- (void)testMatchesDenseBlend {
+    std::vector<float> base = createBase();
+    std::vector<std::vector<float>> deltas = createDeltas();
+    VROMorphBlender blender(base.data(), kFaceVertices, 3, 3, 256);
+    for (int t = 0; t < kBlendshapes; t++) {
+        XCTAssertEqual(blender.addTarget(deltas[t].data(), 3), t);
+    }
+
+    std::vector<float> weights(kBlendshapes, 0);
+    std::vector<float> output = base;
+    for (int frame = 0; frame < 3; frame++) {
+        for (int t = frame; t < kBlendshapes; t += 3) {
+            weights[t] = 0.2f + 0.1f * frame + 0.01f * t;
+            blender.setWeight(t, weights[t]);
+        }
+        blender.update();
+        blender.writeOutput(output.data(), 3);
+
+        float maxError = 0;
+        for (int v = 0; v < kFaceVertices; v++) {
+            for (int c = 0; c < 3; c++) {
+                float expected = base[v * 3 + c];
+                for (int t = 0; t < kBlendshapes; t++) {
+                    expected += weights[t] * deltas[t][v * 3 + c];
+                }
+                maxError = std::max(maxError, std::fabs(output[v * 3 + c] - expected));
+            }
+        }
+        XCTAssertLessThan(maxError, 1e-6f);
+    }
+}
+
+/*
+ One frame of face tracking: all 52 weights change, and the dirty ranges
+ are written back to the attribute.
+ */
+- (void)testPerformance52Blendshapes {
+    std::vector<float> base = createBase();
+    std::vector<std::vector<float>> deltas = createDeltas();
+    VROMorphBlender blender(base.data(), kFaceVertices, 3, 3);
+    for (int t = 0; t < kBlendshapes; t++) {
+        blender.addTarget(deltas[t].data(), 3);
+    }
+    std::vector<float> output = base;
+    VROMorphBlender *blenderPtr = &blender;
+    float *outputData = output.data();
+    __block int frame = 0;
+
+    [self measureBlock:^{
+        frame++;
+        for (int t = 0; t < kBlendshapes; t++) {
+            blenderPtr->setWeight(t, 0.5f + 0.5f * sinf(frame * 0.1f + t));
+        }
+        blenderPtr->update();
+        blenderPtr->writeOutput(outputData, 3);
+    }];
+}
+
+@end
@@ -0,0 +1,301 @@
+//
+//  VROPhysicsQueryTreeTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROPhysicsQueryTree.h>
+#include <ViroKit/VROThreadPool.h>
+#include <ViroKit/VROTime.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <stdlib.h>
+
+/*
+ VROPhysicsQueryTree with an analytic ray-sphere test standing in for the
+ exact test a caller would run on each candidate.
+ */
+
+static const int kSpheresPerSide = 32;
+static const int kQueries = 1000;
+static const float kRadius = 0.4f;
+
+struct TestRay {
+    VROVector3f from;
+    VROVector3f to;
+};
+
+struct TestSphere {
+    VROVector3f center;
+    float radius;
+};
+
+/*
+ 1,024 spheres of radius 0.4 on a 1 m grid in the z = -5 plane.
+ */
+static std::vector<TestSphere> createSphereGrid() {
+    std::vector<TestSphere> spheres;
+    for (int x = 0; x < kSpheresPerSide; x++) {
+        for (int y = 0; y < kSpheresPerSide; y++) {
+            spheres.push_back({ VROVector3f(x, y, -5), kRadius });
+        }
+    }
+    return spheres;
+}
+
+static VROPhysicsQueryBounds boundsOf(const TestSphere &sphere) {
+    const VROVector3f &c = sphere.center;
+    float r = sphere.radius;
+    return { { c.x - r, c.y - r, c.z - r }, { c.x + r, c.y + r, c.z + r } };
+}
+
+static void buildTree(const std::vector<TestSphere> &spheres, VROPhysicsQueryTree &tree) {
+    tree.clear();
+    for (const TestSphere &sphere : spheres) {
+        tree.addProxy(&sphere, boundsOf(sphere));
+    }
+    tree.build();
+}
+
+/*
+ Rays parallel to the z axis through the grid, jittered so that roughly
+ half of them pass between the spheres.
+ */
+static std::vector<TestRay> createRays() {
+    std::vector<TestRay> queries(kQueries);
+    srand(11);
+    for (int i = 0; i < kQueries; i++) {
+        float x = (kSpheresPerSide - 1) * (float) rand() / RAND_MAX;
+        float y = (kSpheresPerSide - 1) * (float) rand() / RAND_MAX;
+        queries[i].from = VROVector3f(x, y, 0);
+        queries[i].to = VROVector3f(x, y, -10);
+    }
+    return queries;
+}
+
+/*
+ Fraction along from -> to of the first intersection with the sphere, or
+ -1 if the segment misses it.
+ */
+static float intersectSphere(const TestRay &query, const TestSphere &sphere) {
+    VROVector3f d(query.to.x - query.from.x, query.to.y - query.from.y, query.to.z - query.from.z);
+    VROVector3f m(query.from.x - sphere.center.x, query.from.y - sphere.center.y, query.from.z - sphere.center.z);
+    float a = d.x * d.x + d.y * d.y + d.z * d.z;
+    float b = m.x * d.x + m.y * d.y + m.z * d.z;
+    float c = m.x * m.x + m.y * m.y + m.z * m.z - sphere.radius * sphere.radius;
+    float discriminant = b * b - a * c;
+    if (discriminant < 0) {
+        return -1;
+    }
+    float t = (-b - sqrtf(discriminant)) / a;
+    return (t >= 0 && t <= 1) ? t : -1;
+}
+
+/*
+ Closest sphere hit by the query through the tree, with the segment cut
+ short at each hit.
+ */
+static const TestSphere *closestThroughTree(const VROPhysicsQueryTree &tree, const TestRay &query,
+                                            int *visited) {
+    VROPhysicsQuerySegment segment(query.from, query.to);
+    float closest = 1;
+    const TestSphere *hit = nullptr;
+    tree.traverse([&](const VROPhysicsQueryBounds &bounds) {
+        return segment.intersects(bounds, closest);
+    }, [&](const VROPhysicsQueryTree::Proxy &proxy) {
+        (*visited)++;
+        const TestSphere *sphere = (const TestSphere *) proxy.object;
+        float t = intersectSphere(query, *sphere);
+        if (t >= 0 && t < closest) {
+            closest = t;
+            hit = sphere;
+        }
+    });
+    return hit;
+}
+
+static const TestSphere *closestBruteForce(const std::vector<TestSphere> &spheres, const TestRay &query) {
+    float closest = 1;
+    const TestSphere *hit = nullptr;
+    for (const TestSphere &sphere : spheres) {
+        float t = intersectSphere(query, sphere);
+        if (t >= 0 && t < closest) {
+            closest = t;
+            hit = &sphere;
+        }
+    }
+    return hit;
+}
+
+@interface VROPhysicsQueryTreeTests : XCTestCase
+
+@end
+
+@implementation VROPhysicsQueryTreeTests
+
+/*
+ The tree reports exactly the proxies whose bounds the segment crosses.
+ */
+- (void)testRayCandidatesMatchBruteForce {
+    std::vector<TestSphere> spheres = createSphereGrid();
+    VROPhysicsQueryTree tree;
+    buildTree(spheres, tree);
+    XCTAssertEqual((int) tree.getProxies().size(), (int) spheres.size());
+
+    std::vector<TestRay> queries = createRays();
+    int numWithCandidates = 0;
+    for (int i = 0; i < kQueries; i++) {
+        VROPhysicsQuerySegment segment(queries[i].from, queries[i].to);
+        std::vector<const void *> candidates;
+        tree.traverse([&](const VROPhysicsQueryBounds &bounds) {
+            return segment.intersects(bounds, 1);
+        }, [&](const VROPhysicsQueryTree::Proxy &proxy) {
+            if (segment.intersects(proxy.bounds, 1)) {
+                candidates.push_back(proxy.object);
+            }
+        });
+
+        std::vector<const void *> expected;
+        for (const TestSphere &sphere : spheres) {
+            if (segment.intersects(boundsOf(sphere), 1)) {
+                expected.push_back(&sphere);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        std::sort(expected.begin(), expected.end());
+        XCTAssert(candidates == expected, @"query %d", i);
+        numWithCandidates += !expected.empty();
+    }
+    XCTAssert(numWithCandidates > 0 && numWithCandidates < kQueries);
+}
+
+/*
+ Shrinking the segment to the closest hit so far finds the same closest
+ body as testing every body, while visiting only a few of them.
+ */
+- (void)testClosestHitMatchesBruteForce {
+    std::vector<TestSphere> spheres;
+    spheres.push_back({ VROVector3f(0, 0, -2), 0.5f });
+    spheres.push_back({ VROVector3f(0, 0, -6), 0.5f });
+    for (int i = 0; i < 64; i++) {
+        spheres.push_back({ VROVector3f(5 + i, 0, -4), 0.5f });
+    }
+    VROPhysicsQueryTree tree;
+    buildTree(spheres, tree);
+
+    TestRay query;
+    query.from = VROVector3f(0, 0, 0);
+    query.to = VROVector3f(0, 0, -10);
+    int visited = 0;
+    const TestSphere *hit = closestThroughTree(tree, query, &visited);
+    XCTAssert(hit == &spheres[0]);
+    XCTAssert(visited <= 4);
+
+    std::vector<TestSphere> grid = createSphereGrid();
+    buildTree(grid, tree);
+    for (const TestRay &ray : createRays()) {
+        XCTAssert(closestThroughTree(tree, ray, &visited) == closestBruteForce(grid, ray));
+    }
+}
+
+/*
+ Box traversal, used for sweeps, reports exactly the overlapping proxies.
+ */
+- (void)testBoundsCandidatesMatchBruteForce {
+    std::vector<TestSphere> spheres = createSphereGrid();
+    VROPhysicsQueryTree tree;
+    buildTree(spheres, tree);
+
+    VROPhysicsQueryBounds swept = VROPhysicsQueryBounds::fromPoints(VROVector3f(3.5f, 7.2f, 0),
+                                                                    VROVector3f(6.1f, 9.9f, -10));
+    std::vector<const void *> candidates;
+    tree.traverse([&](const VROPhysicsQueryBounds &bounds) {
+        return swept.overlaps(bounds);
+    }, [&](const VROPhysicsQueryTree::Proxy &proxy) {
+        if (swept.overlaps(proxy.bounds)) {
+            candidates.push_back(proxy.object);
+        }
+    });
+    std::vector<const void *> expected;
+    for (const TestSphere &sphere : spheres) {
+        if (swept.overlaps(boundsOf(sphere))) {
+            expected.push_back(&sphere);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    std::sort(expected.begin(), expected.end());
+    XCTAssertEqual((int) expected.size(), 12);
+    XCTAssert(candidates == expected);
+}
+
+- (void)testEmptyTree {
+    VROPhysicsQueryTree tree;
+    tree.build();
+    XCTAssertEqual(tree.getNodeCount(), 0);
+    int visited = 0;
+    TestRay query;
+    query.from = VROVector3f(0, 0, 0);
+    query.to = VROVector3f(0, 0, -10);
+    XCTAssert(closestThroughTree(tree, query, &visited) == nullptr);
+    XCTAssertEqual(visited, 0);
+}
+
+/*
+ 1,000 closest-hit rays against 1,024 bodies, traversing the tree on the
+ shared pool. Compare with
+ testPerformanceBruteForceRays, which tests every body for every ray.
+ */
+- (void)testPerformanceTreeRays {
+    std::vector<TestSphere> spheres = createSphereGrid();
+    std::vector<TestRay> queries = createRays();
+    std::vector<const TestSphere *> hits(kQueries);
+    std::vector<const TestSphere *> *hitsPtr = &hits;
+    [self measureBlock:^{
+        double start = VROTimeCurrentMillis();
+        VROPhysicsQueryTree tree;
+        buildTree(spheres, tree);
+        VROThreadPool::shared().parallelFor(kQueries, 8, [&](int begin, int end) {
+            int visited = 0;
+            for (int i = begin; i < end; i++) {
+                (*hitsPtr)[i] = closestThroughTree(tree, queries[i], &visited);
+            }
+        });
+        NSLog(@"Tree rays: %.1f queries/ms", kQueries / (VROTimeCurrentMillis() - start));
+    }];
+}
+
+- (void)testPerformanceBruteForceRays {
+    std::vector<TestSphere> spheres = createSphereGrid();
+    std::vector<TestRay> queries = createRays();
+    [self measureBlock:^{
+        double start = VROTimeCurrentMillis();
+        for (const TestRay &query : queries) {
+            closestBruteForce(spheres, query);
+        }
+        NSLog(@"Brute-force rays: %.1f queries/ms", kQueries / (VROTimeCurrentMillis() - start));
+    }];
+}
+
+@end
@@ -0,0 +1,328 @@
+//
+//  VROPhysicsSlotMapTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROPhysicsSlotMap.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ VROPhysicsSlotMap, and contact dispatch through it against dispatch through
+ string keys. Bullet is not part of the prebuilt framework, so the contact
+ manifolds of a 1,000-body pile are modelled: TestCollisionObject carries the
+ user pointer and user index a btCollisionObject would, and TestManifold the
+ contact points of a btPersistentManifold.
+ */
+
+static const int kBodies = 1000;
+static const int kPileSide = 10;
+static const int kPointsPerManifold = 4;
+static const int kFramesPerMeasure = 60;
+
+struct TestBody {
+    std::string key;
+};
+
+struct TestCollisionObject {
+    TestBody *userPointer;
+    int userIndex;
+};
+
+struct TestManifold {
+    const TestCollisionObject *body0;
+    const TestCollisionObject *body1;
+    VROVector3f points[kPointsPerManifold];
+    float distances[kPointsPerManifold];
+};
+
+static std::vector<std::shared_ptr<TestBody>> createBodies() {
+    std::vector<std::shared_ptr<TestBody>> bodies;
+    for (int i = 0; i < kBodies; i++) {
+        bodies.push_back(std::make_shared<TestBody>(TestBody { "body_" + std::to_string(i) }));
+    }
+    return bodies;
+}
+
+/*
+ The bodies of a 10x10x10 pile, each resting against its neighbours along
+ +x, +y and +z: 2,700 manifolds of 4 points, of which 3 are touching.
+ */
+static std::vector<TestManifold> createPileManifolds(const std::vector<TestCollisionObject> &objects) {
+    std::vector<TestManifold> manifolds;
+    for (int x = 0; x < kPileSide; x++) {
+        for (int y = 0; y < kPileSide; y++) {
+            for (int z = 0; z < kPileSide; z++) {
+                int a = (x * kPileSide + y) * kPileSide + z;
+                int neighbours[3] = { x + 1 < kPileSide ? a + kPileSide * kPileSide : -1,
+                                      y + 1 < kPileSide ? a + kPileSide : -1,
+                                      z + 1 < kPileSide ? a + 1 : -1 };
+                for (int b : neighbours) {
+                    if (b < 0) {
+                        continue;
+                    }
+                    TestManifold manifold;
+                    manifold.body0 = &objects[a];
+                    manifold.body1 = &objects[b];
+                    for (int p = 0; p < kPointsPerManifold; p++) {
+                        manifold.points[p] = VROVector3f(x, y, z + p * 0.25f);
+                        manifold.distances[p] = (p == kPointsPerManifold - 1) ? 0.01f : -0.001f;
+                    }
+                    manifolds.push_back(manifold);
+                }
+            }
+        }
+    }
+    return manifolds;
+}
+
+class TestContactListener : public VROPhysicsContactListener {
+public:
+    int contacts = 0;
+    void onContact(const VROPhysicsContact &contact) {
+        contacts++;
+    }
+};
+
+/*
+ Callback for contacts resolved by key, which reports the bodies themselves
+ since there is no handle to report.
+ */
+class TestKeyedContactListener {
+public:
+    int contacts = 0;
+    virtual ~TestKeyedContactListener() {}
+    virtual void onContact(TestBody *bodyA, TestBody *bodyB, VROVector3f point, float distance) {
+        contacts++;
+    }
+};
+
+/*
+ Resolve each manifold's bodies from the handles in their user indices, and
+ report the touching points.
+ */
+static void dispatchByHandle(const std::vector<TestManifold> &manifolds,
+                             const VROPhysicsSlotMap<TestBody> &slots,
+                             VROPhysicsContactListener &listener) {
+    for (const TestManifold &manifold : manifolds) {
+        VROPhysicsBodyHandle handleA = VROPhysicsBodyHandle::fromUserIndex(manifold.body0->userIndex);
+        VROPhysicsBodyHandle handleB = VROPhysicsBodyHandle::fromUserIndex(manifold.body1->userIndex);
+        if (!slots.get(handleA) || !slots.get(handleB)) {
+            continue;
+        }
+        for (int p = 0; p < kPointsPerManifold; p++) {
+            if (manifold.distances[p] > 0) {
+                continue;
+            }
+            VROPhysicsContact contact;
+            contact.bodyA = handleA;
+            contact.bodyB = handleB;
+            contact.point = manifold.points[p];
+            contact.penetrationDistance = manifold.distances[p];
+            listener.onContact(contact);
+        }
+    }
+}
+
+/*
+ Resolve each manifold's bodies the way VROPhysicsWorld does: through the
+ user pointer to the body's key, and from the key to the body's entry in
+ the world's std::map. Keys are stored on the bodies, not rebuilt.
+ */
+static void dispatchByKey(const std::vector<TestManifold> &manifolds,
+                          const std::map<std::string, std::shared_ptr<TestBody>> &bodies,
+                          TestKeyedContactListener &listener) {
+    for (const TestManifold &manifold : manifolds) {
+        auto itA = bodies.find(manifold.body0->userPointer->key);
+        auto itB = bodies.find(manifold.body1->userPointer->key);
+        if (itA == bodies.end() || itB == bodies.end()) {
+            continue;
+        }
+        for (int p = 0; p < kPointsPerManifold; p++) {
+            if (manifold.distances[p] > 0) {
+                continue;
+            }
+            listener.onContact(itA->second.get(), itB->second.get(), manifold.points[p],
+                               manifold.distances[p]);
+        }
+    }
+}
+
+@interface VROPhysicsSlotMapTests : XCTestCase
+
+@end
+
+@implementation VROPhysicsSlotMapTests
+
+- (void)testStaleHandle {
+    VROPhysicsSlotMap<TestBody> slots;
+    std::shared_ptr<TestBody> body = std::make_shared<TestBody>();
+
+    VROPhysicsBodyHandle handle = slots.add(body);
+    XCTAssert(slots.get(handle) == body.get());
+    XCTAssert(slots.remove(handle) == body);
+    XCTAssert(slots.get(handle) == nullptr);
+    XCTAssert(slots.remove(handle) == nullptr);
+
+    VROPhysicsBodyHandle reused = slots.add(body);
+    XCTAssertEqual(reused.getIndex(), handle.getIndex());
+    XCTAssertNotEqual(reused.getGeneration(), handle.getGeneration());
+    XCTAssert(slots.get(handle) == nullptr);
+    XCTAssert(slots.get(reused) == body.get());
+}
+
+- (void)testAddIsIdempotent {
+    VROPhysicsSlotMap<TestBody> slots;
+    std::shared_ptr<TestBody> body = std::make_shared<TestBody>();
+    VROPhysicsBodyHandle handle = slots.add(body);
+    XCTAssert(slots.add(body) == handle);
+    XCTAssert(slots.find(body.get()) == handle);
+    XCTAssertEqual(slots.getCount(), 1);
+    XCTAssert(slots.add(nullptr).isNull());
+}
+
+/*
+ Handles fit the non-negative user index of a btRigidBody, leaving -1 for
+ unstamped bodies and -2 for raw bodies.
+ */
+- (void)testHandlesAreNonNegative {
+    VROPhysicsSlotMap<TestBody> slots;
+    std::vector<std::shared_ptr<TestBody>> bodies = createBodies();
+    std::vector<VROPhysicsBodyHandle> handles;
+    for (int round = 0; round < 8; round++) {
+        handles.clear();
+        for (const std::shared_ptr<TestBody> &body : bodies) {
+            handles.push_back(slots.add(body));
+        }
+        for (VROPhysicsBodyHandle handle : handles) {
+            XCTAssert(handle.value >= 0);
+            XCTAssert(VROPhysicsBodyHandle::fromUserIndex(handle.value) == handle);
+        }
+        for (int i = 0; i < kBodies; i += 2) {
+            slots.remove(handles[i]);
+        }
+        for (int i = 1; i < kBodies; i += 2) {
+            XCTAssert(slots.get(handles[i]) == bodies[i].get());
+        }
+        for (int i = 1; i < kBodies; i += 2) {
+            slots.remove(handles[i]);
+        }
+        XCTAssertEqual(slots.getCount(), 0);
+    }
+}
+
+- (void)testGenerationWraps {
+    VROPhysicsSlotMap<TestBody> slots;
+    std::shared_ptr<TestBody> body = std::make_shared<TestBody>();
+    VROPhysicsBodyHandle first = slots.add(body);
+    slots.remove(first);
+    for (uint32_t i = 1; i < VROPhysicsBodyHandle::kGenerationMask + 1; i++) {
+        VROPhysicsBodyHandle handle = slots.add(body);
+        XCTAssert(handle.value >= 0);
+        slots.remove(handle);
+    }
+    VROPhysicsBodyHandle wrapped = slots.add(body);
+    XCTAssertEqual(wrapped.getGeneration(), first.getGeneration());
+}
+
+- (void)testDispatchByHandleMatchesDispatchByKey {
+    std::vector<std::shared_ptr<TestBody>> bodies = createBodies();
+    VROPhysicsSlotMap<TestBody> slots;
+    std::map<std::string, std::shared_ptr<TestBody>> bodiesByKey;
+    std::vector<TestCollisionObject> objects;
+    for (const std::shared_ptr<TestBody> &body : bodies) {
+        objects.push_back({ body.get(), slots.add(body).value });
+        bodiesByKey[body->key] = body;
+    }
+    std::vector<TestManifold> manifolds = createPileManifolds(objects);
+    XCTAssertEqual((int) manifolds.size(), 3 * kPileSide * kPileSide * (kPileSide - 1));
+
+    TestContactListener listener;
+    TestKeyedContactListener keyedListener;
+    dispatchByHandle(manifolds, slots, listener);
+    dispatchByKey(manifolds, bodiesByKey, keyedListener);
+    XCTAssertEqual(listener.contacts, (int) manifolds.size() * (kPointsPerManifold - 1));
+    XCTAssertEqual(listener.contacts, keyedListener.contacts);
+
+    // Removed bodies drop out of both
+    slots.remove(slots.find(bodies[0].get()));
+    bodiesByKey.erase(bodies[0]->key);
+    listener.contacts = 0;
+    keyedListener.contacts = 0;
+    dispatchByHandle(manifolds, slots, listener);
+    dispatchByKey(manifolds, bodiesByKey, keyedListener);
+    XCTAssertEqual(listener.contacts, ((int) manifolds.size() - 3) * (kPointsPerManifold - 1));
+    XCTAssertEqual(listener.contacts, keyedListener.contacts);
+}
+
+/*
+ Contact callbacks for 60 frames of a 1,000-body pile, resolving bodies by
+ handle. Compare with testPerformanceContactDispatch1000BodiesByKey, which
+ resolves the same manifolds through VROPhysicsWorld's string-keyed map.
+ */
+- (void)testPerformanceContactDispatch1000BodiesByHandle {
+    std::vector<std::shared_ptr<TestBody>> bodies = createBodies();
+    VROPhysicsSlotMap<TestBody> slots;
+    std::vector<TestCollisionObject> objects;
+    for (const std::shared_ptr<TestBody> &body : bodies) {
+        objects.push_back({ body.get(), slots.add(body).value });
+    }
+    std::vector<TestManifold> manifolds = createPileManifolds(objects);
+
+    VROPhysicsSlotMap<TestBody> *slotsPtr = &slots;
+    std::vector<TestManifold> *manifoldsPtr = &manifolds;
+    [self measureBlock:^{
+        TestContactListener listener;
+        for (int frame = 0; frame < kFramesPerMeasure; frame++) {
+            dispatchByHandle(*manifoldsPtr, *slotsPtr, listener);
+        }
+        XCTAssertEqual(listener.contacts, kFramesPerMeasure * (int) manifoldsPtr->size() * (kPointsPerManifold - 1));
+    }];
+}
+
+- (void)testPerformanceContactDispatch1000BodiesByKey {
+    std::vector<std::shared_ptr<TestBody>> bodies = createBodies();
+    std::map<std::string, std::shared_ptr<TestBody>> bodiesByKey;
+    std::vector<TestCollisionObject> objects;
+    for (const std::shared_ptr<TestBody> &body : bodies) {
+        objects.push_back({ body.get(), -1 });
+        bodiesByKey[body->key] = body;
+    }
+    std::vector<TestManifold> manifolds = createPileManifolds(objects);
+
+    std::map<std::string, std::shared_ptr<TestBody>> *bodiesPtr = &bodiesByKey;
+    std::vector<TestManifold> *manifoldsPtr = &manifolds;
+    [self measureBlock:^{
+        TestKeyedContactListener listener;
+        for (int frame = 0; frame < kFramesPerMeasure; frame++) {
+            dispatchByKey(*manifoldsPtr, *bodiesPtr, listener);
+        }
+        XCTAssertEqual(listener.contacts, kFramesPerMeasure * (int) manifoldsPtr->size() * (kPointsPerManifold - 1));
+    }];
+}
+
+@end
@@ -0,0 +1,240 @@
+//
+//  VROPlatformInterfaceTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VRORenderTarget.h>
+#include <ViroKit/VROGeometrySubstrate.h>
+#include <ViroKit/VROTextureSubstrate.h>
+#include <ViroKit/VROVertexBuffer.h>
+#include <ViroKit/VROImagePostProcess.h>
+#include <dlfcn.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ The platform interfaces (VRORenderTarget, VROGeometrySubstrate,
+ VROTextureSubstrate, VROVertexBuffer, VROImagePostProcess) are declared
+ in headers, but implemented and called inside ViroKit. These tests hold
+ the headers to the binary: each virtual function must land in the slot
+ where the OpenGL implementation's vtable has it, and each base member at
+ the offset the binary's constructors write it to.
+ */
+
+/*
+ A virtual function the header declares, and the symbol the OpenGL
+ implementation's vtable holds in its slot. Offsets are bytes from the
+ first virtual function; the destructors take the first two slots.
+ */
+struct VROVirtualSlot {
+    ptrdiff_t offset;
+    std::string symbol;
+};
+
+/*
+ The vtable byte offset of a virtual member function, or -1 if the
+ function is not virtual. ARM keeps the virtual flag in the adjustment
+ word of a member function pointer; the generic Itanium ABI keeps it in
+ the low bit of the pointer word.
+ */
+template <typename T>
+static ptrdiff_t getVirtualOffset(T function) {
+    struct {
+        uintptr_t ptr;
+        ptrdiff_t adj;
+    } parts;
+    static_assert(sizeof(function) == sizeof(parts), "Unexpected member function pointer size");
+    memcpy(&parts, &function, sizeof(parts));
+
+#if defined(__arm__) || defined(__aarch64__)
+    return (parts.adj & 1) ? (ptrdiff_t) parts.ptr : -1;
+#else
+    return (parts.ptr & 1) ? (ptrdiff_t) (parts.ptr - 1) : -1;
+#endif
+}
+
+/*
+ The byte offset of a data member: the Itanium ABI represents a data
+ member pointer as that offset.
+ */
+template <typename T>
+static ptrdiff_t getDataOffset(T member) {
+    ptrdiff_t offset;
+    static_assert(sizeof(member) == sizeof(offset), "Unexpected data member pointer size");
+    memcpy(&offset, &member, sizeof(offset));
+    return offset;
+}
+
+/*
+ The name of the symbol in the given slot of the vtable exported as
+ vtableSymbol, or an empty string if either can't be found.
+ */
+static std::string getVtableEntry(const char *vtableSymbol, ptrdiff_t offset) {
+    char *vtable = (char *) dlsym(RTLD_DEFAULT, vtableSymbol);
+    if (!vtable || offset < 0) {
+        return "";
+    }
+
+    // Skip offset-to-top and the typeinfo pointer
+    void *entry = *(void **) (vtable + 2 * sizeof(void *) + offset);
+    Dl_info info;
+    if (!dladdr(entry, &info) || !info.dli_sname) {
+        return "";
+    }
+    return info.dli_sname;
+}
+
+/*
+ Exposes the protected members of the platform interfaces.
+ */
+class VRORenderTargetLayout : public VRORenderTarget {
+public:
+    static ptrdiff_t getTypeOffset()      { return getDataOffset(&VRORenderTargetLayout::_type); }
+    static ptrdiff_t getNumImagesOffset() { return getDataOffset(&VRORenderTargetLayout::_numImages); }
+    static ptrdiff_t getClearColorOffset() { return getDataOffset(&VRORenderTargetLayout::_clearColor); }
+};
+
+class VROVertexBufferLayout : public VROVertexBuffer {
+public:
+    static ptrdiff_t getDataOffset() { return ::getDataOffset(&VROVertexBufferLayout::_data); }
+};
+
+@interface VROPlatformInterfaceTests : XCTestCase
+
+@end
+
+@implementation VROPlatformInterfaceTests
+
+- (void)assertVtable:(const char *)vtableSymbol destructor:(std::string)destructor
+               slots:(const std::vector<VROVirtualSlot> &)slots {
+    XCTAssert(dlsym(RTLD_DEFAULT, vtableSymbol) != nullptr, @"%s is not exported", vtableSymbol);
+    XCTAssert(getVtableEntry(vtableSymbol, 0) == destructor + "D1Ev");
+    XCTAssert(getVtableEntry(vtableSymbol, sizeof(void *)) == destructor + "D0Ev");
+
+    for (const VROVirtualSlot &slot : slots) {
+        std::string entry = getVtableEntry(vtableSymbol, slot.offset);
+        XCTAssert(entry == slot.symbol, @"Expected %s, found %s", slot.symbol.c_str(), entry.c_str());
+    }
+}
+
+- (void)testRenderTargetVtable {
+    std::vector<VROVirtualSlot> slots = {
+        { getVirtualOffset(&VRORenderTarget::setViewport), "_ZN21VRORenderTargetOpenGL11setViewportE11VROViewport" },
+        { getVirtualOffset(&VRORenderTarget::hydrate), "_ZN21VRORenderTargetOpenGL7hydrateEv" },
+        { getVirtualOffset(&VRORenderTarget::getWidth), "_ZNK21VRORenderTargetOpenGL8getWidthEv" },
+        { getVirtualOffset(&VRORenderTarget::getHeight), "_ZNK21VRORenderTargetOpenGL9getHeightEv" },
+        { getVirtualOffset(&VRORenderTarget::bind), "_ZN21VRORenderTargetOpenGL4bindEv" },
+        { getVirtualOffset(&VRORenderTarget::bindRead), "_ZN21VRORenderTargetOpenGL8bindReadEv" },
+        { getVirtualOffset(&VRORenderTarget::invalidate), "_ZN21VRORenderTargetOpenGL10invalidateEv" },
+        { getVirtualOffset(&VRORenderTarget::blitColor),
+          "_ZN21VRORenderTargetOpenGL9blitColorENSt3__110shared_ptrI15VRORenderTargetEEbNS1_I9VRODriverEE" },
+        { getVirtualOffset(&VRORenderTarget::blitStencil),
+          "_ZN21VRORenderTargetOpenGL11blitStencilENSt3__110shared_ptrI15VRORenderTargetEEbNS1_I9VRODriverEE" },
+        { getVirtualOffset(&VRORenderTarget::deleteFramebuffers), "_ZN21VRORenderTargetOpenGL18deleteFramebuffersEv" },
+        { getVirtualOffset(&VRORenderTarget::restoreFramebuffers), "_ZN21VRORenderTargetOpenGL19restoreFramebuffersEv" },
+        { getVirtualOffset(&VRORenderTarget::hasTextureAttached), "_ZN21VRORenderTargetOpenGL18hasTextureAttachedEi" },
+        { getVirtualOffset(&VRORenderTarget::clearTextures), "_ZN21VRORenderTargetOpenGL13clearTexturesEv" },
+        { getVirtualOffset(&VRORenderTarget::attachNewTextures), "_ZN21VRORenderTargetOpenGL17attachNewTexturesEv" },
+        { getVirtualOffset(&VRORenderTarget::setTextureImageIndex), "_ZN21VRORenderTargetOpenGL20setTextureImageIndexEii" },
+        { getVirtualOffset(&VRORenderTarget::setTextureCubeFace), "_ZN21VRORenderTargetOpenGL18setTextureCubeFaceEiii" },
+        { getVirtualOffset(&VRORenderTarget::setMipLevel), "_ZN21VRORenderTargetOpenGL11setMipLevelEii" },
+        { getVirtualOffset(&VRORenderTarget::attachTexture),
+          "_ZN21VRORenderTargetOpenGL13attachTextureENSt3__110shared_ptrI10VROTextureEEi" },
+        { getVirtualOffset(&VRORenderTarget::getTexture), "_ZNK21VRORenderTargetOpenGL10getTextureEi" },
+        { getVirtualOffset(&VRORenderTarget::clearStencil), "_ZN21VRORenderTargetOpenGL12clearStencilEv" },
+        { getVirtualOffset(&VRORenderTarget::clearDepth), "_ZN21VRORenderTargetOpenGL10clearDepthEv" },
+        { getVirtualOffset(&VRORenderTarget::clearColor), "_ZN21VRORenderTargetOpenGL10clearColorEv" },
+        { getVirtualOffset(&VRORenderTarget::clearDepthAndColor), "_ZN21VRORenderTargetOpenGL18clearDepthAndColorEv" },
+        { getVirtualOffset(&VRORenderTarget::enablePortalStencilWriting),
+          "_ZN21VRORenderTargetOpenGL26enablePortalStencilWritingE7VROFace" },
+        { getVirtualOffset(&VRORenderTarget::enablePortalStencilRemoval),
+          "_ZN21VRORenderTargetOpenGL26enablePortalStencilRemovalE7VROFace" },
+        { getVirtualOffset(&VRORenderTarget::disablePortalStencilWriting),
+          "_ZN21VRORenderTargetOpenGL27disablePortalStencilWritingE7VROFace" },
+        { getVirtualOffset(&VRORenderTarget::setPortalStencilPassFunction),
+          "_ZN21VRORenderTargetOpenGL28setPortalStencilPassFunctionE7VROFace14VROStencilFunci" },
+    };
+    [self assertVtable:"_ZTV21VRORenderTargetOpenGL" destructor:"_ZN21VRORenderTargetOpenGL" slots:slots];
+}
+
+- (void)testGeometrySubstrateVtable {
+    std::vector<VROVirtualSlot> slots = {
+        { getVirtualOffset(&VROGeometrySubstrate::update),
+          "_ZN26VROGeometrySubstrateOpenGL6updateERK11VROGeometryRNSt3__110shared_ptrI9VRODriverEE" },
+        { getVirtualOffset(&VROGeometrySubstrate::render),
+          "_ZN26VROGeometrySubstrateOpenGL6renderERK11VROGeometryi11VROMatrix4fS3_fRKNSt3__110shared_ptrI11VROMaterialEERK16VRORenderContextRNS5_I9VRODriverEE" },
+        { getVirtualOffset(&VROGeometrySubstrate::renderSilhouette),
+          "_ZN26VROGeometrySubstrateOpenGL16renderSilhouetteERK11VROGeometry11VROMatrix4fRNSt3__110shared_ptrI11VROMaterialEERK16VRORenderContextRNS5_I9VRODriverEE" },
+        { getVirtualOffset(&VROGeometrySubstrate::renderSilhouetteTextured),
+          "_ZN26VROGeometrySubstrateOpenGL24renderSilhouetteTexturedERK11VROGeometryi11VROMatrix4fRNSt3__110shared_ptrI11VROMaterialEERK16VRORenderContextRNS5_I9VRODriverEE" },
+    };
+    [self assertVtable:"_ZTV26VROGeometrySubstrateOpenGL" destructor:"_ZN26VROGeometrySubstrateOpenGL" slots:slots];
+}
+
+- (void)testTextureSubstrateVtable {
+    std::vector<VROVirtualSlot> slots = {
+        { getVirtualOffset(&VROTextureSubstrate::updateWrapMode),
+          "_ZN25VROTextureSubstrateOpenGL14updateWrapModeE11VROWrapModeS0_" },
+    };
+    [self assertVtable:"_ZTV25VROTextureSubstrateOpenGL" destructor:"_ZN25VROTextureSubstrateOpenGL" slots:slots];
+}
+
+- (void)testVertexBufferVtable {
+    std::vector<VROVirtualSlot> slots = {
+        { getVirtualOffset(&VROVertexBuffer::hydrate), "_ZN21VROVertexBufferOpenGL7hydrateEv" },
+    };
+    [self assertVtable:"_ZTV21VROVertexBufferOpenGL" destructor:"_ZN21VROVertexBufferOpenGL" slots:slots];
+}
+
+- (void)testImagePostProcessVtable {
+    std::vector<VROVirtualSlot> slots = {
+        { getVirtualOffset(&VROImagePostProcess::setVerticalFlip), "_ZN25VROImagePostProcessOpenGL15setVerticalFlipEb" },
+        { getVirtualOffset(&VROImagePostProcess::blit),
+          "_ZN25VROImagePostProcessOpenGL4blitENSt3__16vectorINS0_10shared_ptrI10VROTextureEENS0_9allocatorIS4_EEEERNS2_I9VRODriverEE" },
+        { getVirtualOffset(&VROImagePostProcess::begin),
+          "_ZN25VROImagePostProcessOpenGL5beginERNSt3__110shared_ptrI9VRODriverEE" },
+        { getVirtualOffset(&VROImagePostProcess::blitOpt),
+          "_ZN25VROImagePostProcessOpenGL7blitOptENSt3__16vectorINS0_10shared_ptrI10VROTextureEENS0_9allocatorIS4_EEEERNS2_I9VRODriverEE" },
+        { getVirtualOffset(&VROImagePostProcess::end),
+          "_ZN25VROImagePostProcessOpenGL3endERNSt3__110shared_ptrI9VRODriverEE" },
+    };
+    [self assertVtable:"_ZTV25VROImagePostProcessOpenGL" destructor:"_ZN25VROImagePostProcessOpenGL" slots:slots];
+}
+
+/*
+ VRORenderTarget's constructor in the binary stores the type and image
+ count as a pair right after the vtable pointer, then constructs the clear
+ color after them. VROVertexBufferOpenGL's constructor keeps the data
+ right after the vtable pointer.
+ */
+- (void)testBaseMemberLayout {
+    XCTAssertEqual(VRORenderTargetLayout::getTypeOffset(), 8);
+    XCTAssertEqual(VRORenderTargetLayout::getNumImagesOffset(), 12);
+    XCTAssertEqual(VRORenderTargetLayout::getClearColorOffset(), 16);
+    XCTAssertEqual(VROVertexBufferLayout::getDataOffset(), 8);
+}
+
+@end
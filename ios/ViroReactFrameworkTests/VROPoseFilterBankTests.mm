@@ -0,0 +1,160 @@
+//
+//  VROPoseFilterBankTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROPoseFilterBank.h>
+#include <ViroKit/VROOneEuroFilter.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+static const int kJoints = 6;
+static const int kFrames = 600;
+
+/*
+ Deterministic joint trajectory: slow sweeps with fast bursts and a little
+ jitter, in meters.
+ */
+static float sampleJoint(int joint, int frame, int axis) {
+    float t = frame / 30.0f;
+    float phase = joint * 0.7f + axis * 1.3f;
+    float jitter = 0.004f * sinf(frame * 12.9898f + joint * 78.233f + axis * 37.719f);
+    float burst = (frame / 90) % 2 == 0 ? 0.0f : 0.3f * sinf(t * 9.0f + phase);
+    return 0.5f * sinf(t * 0.8f + phase) + burst + jitter;
+}
+
+@interface VROPoseFilterBankTests : XCTestCase
+
+@end
+
+@implementation VROPoseFilterBankTests
+
+/*
+ The bank keeps its state in single precision where VROOneEuroFilter uses
+ double. Run both on the same irregularly timed input, with joints dropping
+ out, and bound the difference.
+ */
+- (void)testMatchesOneEuroFilter {
+    const double frequency = 30.0, minCutoff = 1.0, beta = 0.5, derivativeCutoff = 1.0;
+    VROPoseFilterBank bank(kJoints, frequency, minCutoff, beta, derivativeCutoff);
+    std::vector<std::unique_ptr<VROOneEuroFilter>> filters;
+    for (int j = 0; j < kJoints; j++) {
+        filters.emplace_back(new VROOneEuroFilter(frequency, minCutoff, beta, derivativeCutoff));
+    }
+
+    float x[kJoints], y[kJoints], z[kJoints], confidence[kJoints];
+    double timestamp = 10.0;
+    float maxError = 0;
+    for (int f = 0; f < kFrames; f++) {
+        // 25 to 40 Hz frame times
+        timestamp += 0.025 + 0.015 * ((f * 7) % 11) / 10.0;
+        for (int j = 0; j < kJoints; j++) {
+            x[j] = sampleJoint(j, f, 0);
+            y[j] = sampleJoint(j, f, 1);
+            z[j] = sampleJoint(j, f, 2) - 2.0f;
+            confidence[j] = ((f + j * 13) % 40) < 5 ? 0.0f : 0.9f;
+        }
+        bank.filter(x, y, z, confidence, timestamp);
+
+        for (int j = 0; j < kJoints; j++) {
+            if (confidence[j] == 0) {
+                continue;
+            }
+            VROVector3f expected = filters[j]->filter(VROVector3f(x[j], y[j], z[j]), timestamp);
+            maxError = std::max(maxError, fabsf(bank.getX()[j] - expected.x));
+            maxError = std::max(maxError, fabsf(bank.getY()[j] - expected.y));
+            maxError = std::max(maxError, fabsf(bank.getZ()[j] - expected.z));
+        }
+    }
+    XCTAssertLessThan(maxError, 1e-4f);
+}
+
+/*
+ Pose frames for every joint the body tracker reports, one candidate joint
+ per type, as the tracker's heatmap decoder produces them.
+ */
+static std::vector<VROPoseFrame> createBodyFrames() {
+    std::vector<VROPoseFrame> frames;
+    for (int f = 0; f < kFrames; f++) {
+        VROPoseFrame frame = newPoseFrame();
+        for (int j = 0; j < kNumBodyJoints; j++) {
+            VROInferredBodyJoint joint((VROBodyJointType) j);
+            joint.setCenter(VROVector3f(sampleJoint(j, f, 0), sampleJoint(j, f, 1), sampleJoint(j, f, 2) - 2.0f));
+            joint.setConfidence(((f + j * 13) % 40) < 5 ? 0.0f : 0.9f);
+            frame[j].push_back(joint);
+        }
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+/*
+ Filter 600 frames of a full body (kNumBodyJoints joints) through the bank,
+ including the conversion from and to VROPoseFrame.
+ */
+- (void)testPerformanceFilterBank {
+    std::vector<VROPoseFrame> frames = createBodyFrames();
+    std::vector<VROPoseFrame> *framesPtr = &frames;
+    [self measureBlock:^{
+        VROPoseFilterBank bank(kNumBodyJoints, 30.0, 1.0, 0.5, 1.0);
+        double timestamp = 10.0;
+        for (const VROPoseFrame &frame : *framesPtr) {
+            timestamp += 1.0 / 30.0;
+            bank.filterJoints(frame, timestamp);
+        }
+    }];
+}
+
+/*
+ The same frames through one VROOneEuroFilter per joint, as the bank's
+ baseline.
+ */
+- (void)testPerformanceOneEuroFilterPerJoint {
+    std::vector<VROPoseFrame> frames = createBodyFrames();
+    std::vector<VROPoseFrame> *framesPtr = &frames;
+    [self measureBlock:^{
+        std::vector<std::unique_ptr<VROOneEuroFilter>> filters;
+        for (int j = 0; j < kNumBodyJoints; j++) {
+            filters.emplace_back(new VROOneEuroFilter(30.0, 1.0, 0.5, 1.0));
+        }
+        double timestamp = 10.0;
+        for (const VROPoseFrame &frame : *framesPtr) {
+            timestamp += 1.0 / 30.0;
+            VROPoseFrame filtered = newPoseFrame();
+            for (int j = 0; j < kNumBodyJoints; j++) {
+                const VROInferredBodyJoint &joint = frame[j][0];
+                if (joint.getConfidence() > 0) {
+                    VROInferredBodyJoint result((VROBodyJointType) j);
+                    result.setCenter(filters[j]->filter(joint.getCenter(), timestamp));
+                    result.setConfidence(joint.getConfidence());
+                    filtered[j].push_back(result);
+                }
+            }
+        }
+    }];
+}
+
+@end
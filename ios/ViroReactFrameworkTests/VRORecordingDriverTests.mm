@@ -0,0 +1,433 @@
+//
+//  VRORecordingDriverTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VRORecordingDriver.h>
+#include <ViroKit/VROMaterial.h>
+#include <ViroKit/VRORenderer.h>
+#include <ViroKit/VRORenderDelegate.h>
+#include <ViroKit/VROViewScene.h>
+#include <ViroKit/VROInputControllerCardboardiOS.h>
+#include <ViroKit/VROReticle.h>
+#include <ViroKit/VROSceneController.h>
+#include <ViroKit/VROScene.h>
+#include <ViroKit/VROPortal.h>
+#include <ViroKit/VROBox.h>
+#include <ViroKit/VROTime.h>
+#include <new>
+
+static const int kViewportWidth = 1280;
+static const int kViewportHeight = 720;
+
+// VROEye.h is not public; the framework orders eyes Left, Right, Monocular
+static const VROEyeType kMonocularEye = (VROEyeType) 2;
+
+/*
+ A no-op deleter, so tests can hand out shared_ptrs to storage they reuse
+ and reproduce an address being recycled.
+ */
+static void releaseNothing(int *) {}
+
+/*
+ Keeps the platform driver a VROView sets its renderer up with, so the
+ recording driver can create typefaces through it.
+ */
+@interface VROPlatformDriverDelegate : NSObject <VRORenderDelegate>
+
+@property (readonly, nonatomic) std::shared_ptr<VRODriver> driver;
+
+@end
+
+@implementation VROPlatformDriverDelegate
+
+- (void)setupRendererWithDriver:(std::shared_ptr<VRODriver>)driver {
+    _driver = driver;
+}
+
+- (void)userDidRequestExitVR {}
+
+@end
+
+/*
+ Renders monocular frames of a scene through VRORenderer's prepareFrame(),
+ renderEye() and endFrame(). The reticle is turned off, so the scene is
+ all that draws.
+ */
+class VROHeadlessRenderer {
+public:
+
+    VROHeadlessRenderer(std::shared_ptr<VRODriver> driver, VRORendererConfiguration config,
+                        std::shared_ptr<VROSceneController> sceneController) :
+        _driver(driver) {
+        std::shared_ptr<VROInputControllerBase> inputController = std::make_shared<VROInputControllerCardboardiOS>(driver);
+        std::shared_ptr<VROReticle> reticle = inputController->getPresenter()->getReticle();
+        if (reticle) {
+            reticle->setEnabled(false);
+        }
+        _renderer = std::make_shared<VRORenderer>(config, inputController);
+        _renderer->setSceneController(sceneController, driver);
+    }
+
+    void renderFrame(int frame) {
+        VROViewport viewport(0, 0, kViewportWidth, kViewportHeight);
+        VROFieldOfView fov = VRORenderer::computeFOVFromMajorAxis(kFovMonoMajor, kViewportWidth, kViewportHeight);
+        VROMatrix4f projection = fov.toPerspectiveProjection(kZNear, kZFar);
+
+        _renderer->prepareFrame(frame, viewport, fov, VROMatrix4f::identity(), projection, _driver);
+        _renderer->renderEye(kMonocularEye, _renderer->getLookAtMatrix(), projection, viewport, _driver);
+        _renderer->endFrame(_driver);
+    }
+
+private:
+
+    std::shared_ptr<VRODriver> _driver;
+    std::shared_ptr<VRORenderer> _renderer;
+
+};
+
+/*
+ A grid of boxes in front of the camera, each with its own material.
+ */
+static std::shared_ptr<VROSceneController> createBoxScene(int numBoxes) {
+    std::shared_ptr<VROSceneController> sceneController = std::make_shared<VROSceneController>();
+    std::shared_ptr<VROPortal> root = sceneController->getScene()->getRootNode();
+    int columns = (int) ceil(sqrt((double) numBoxes));
+    for (int i = 0; i < numBoxes; i++) {
+        std::shared_ptr<VRONode> node = std::make_shared<VRONode>();
+        node->setGeometry(VROBox::createBox(0.2, 0.2, 0.2));
+        node->setPosition({ (i % columns - columns * 0.5f) * 0.3f, (i / columns - columns * 0.5f) * 0.3f, -5 });
+        root->addChildNode(node);
+    }
+    return sceneController;
+}
+
+static int getElementCount(std::shared_ptr<VROSceneController> sceneController) {
+    int count = 0;
+    for (std::shared_ptr<VRONode> &node : sceneController->getScene()->getRootNode()->getChildNodes()) {
+        count += (int) node->getGeometry()->getGeometryElements().size();
+    }
+    return count;
+}
+
+@interface VRORecordingDriverTests : XCTestCase
+
+@end
+
+@implementation VRORecordingDriverTests {
+    EAGLContext *_context;
+    VROViewScene *_view;
+    VROPlatformDriverDelegate *_delegate;
+}
+
+- (void)tearDown {
+    if (_view) {
+        [_view deleteGL];
+        _view = nil;
+    }
+    _delegate = nil;
+    [EAGLContext setCurrentContext:nil];
+    _context = nil;
+    [super tearDown];
+}
+
+/*
+ A recording driver for rendering through VRORenderer, with typefaces from
+ the platform driver of an offscreen VROViewScene. The view renders one
+ frame to set up its renderer, which hands the driver to its delegate.
+ */
+- (std::shared_ptr<VRORecordingDriver>)createRendererDriver {
+    _context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(_context);
+    [EAGLContext setCurrentContext:_context];
+
+    VRORendererConfiguration config;
+    _view = [[VROViewScene alloc] initWithFrame:CGRectMake(0, 0, 64, 64) config:config context:_context];
+    [_view setPaused:YES];
+    _delegate = [[VROPlatformDriverDelegate alloc] init];
+    _view.renderDelegate = _delegate;
+    [_view display];
+    XCTAssert(_delegate.driver != nullptr);
+
+    std::shared_ptr<VRORecordingDriver> driver = std::make_shared<VRORecordingDriver>();
+    driver->setTypefaceDriver(_delegate.driver);
+    return driver;
+}
+
+/*
+ IDs are assigned in order of first use and are stable while their object
+ lives.
+ */
+- (void)testIdsInFirstUseOrder {
+    VRODriverCommandLog log;
+    int a = 0, b = 0;
+    XCTAssertEqual(log.getId(&a), 0);
+    XCTAssertEqual(log.getId(&b), 1);
+    XCTAssertEqual(log.getId(&a), 0);
+    XCTAssertEqual(log.getId(nullptr), -1);
+}
+
+/*
+ A released address is given a new ID, rather than the one its previous
+ object had.
+ */
+- (void)testReleasedIdIsNotReused {
+    VRODriverCommandLog log;
+    int storage = 0;
+    XCTAssertEqual(log.getId(&storage), 0);
+    log.releaseId(&storage);
+    XCTAssertEqual(log.getId(&storage), 1);
+}
+
+/*
+ Shared objects need no release: once the owner expires, a new object at
+ the same address gets a new ID.
+ */
+- (void)testExpiredOwnerGetsNewId {
+    VRODriverCommandLog log;
+    int storage = 0;
+    std::shared_ptr<int> first(&storage, releaseNothing);
+    XCTAssertEqual(log.getId(first), 0);
+    XCTAssertEqual(log.getId(first), 0);
+    first.reset();
+
+    std::shared_ptr<int> second(&storage, releaseNothing);
+    XCTAssertEqual(log.getId(second), 1);
+    XCTAssertEqual(log.getId(second), 1);
+}
+
+/*
+ Material substrates release their ID when destroyed, so a substrate
+ allocated in the freed memory is logged as a different material.
+ */
+- (void)testMaterialSubstrateReleasesId {
+    std::shared_ptr<VRODriverCommandLog> log = std::make_shared<VRODriverCommandLog>();
+    std::shared_ptr<VRODriver> driver;
+    alignas(VRORecordingMaterialSubstrate) char storage[sizeof(VRORecordingMaterialSubstrate)];
+
+    VRORecordingMaterialSubstrate *first = new (storage) VRORecordingMaterialSubstrate(log);
+    first->bindProperties(driver);
+    first->~VRORecordingMaterialSubstrate();
+    VRORecordingMaterialSubstrate *second = new (storage) VRORecordingMaterialSubstrate(log);
+    second->~VRORecordingMaterialSubstrate();
+
+    const std::vector<VRODriverCommandRecord> &commands = log->getCommands();
+    XCTAssertEqual(commands.size(), 3);
+    XCTAssertEqual(commands[0].command, VRODriverCommand::CreateMaterial);
+    XCTAssertEqual(commands[0].a, 0);
+    XCTAssertEqual(commands[1].command, VRODriverCommand::BindMaterial);
+    XCTAssertEqual(commands[1].a, 0);
+    XCTAssertEqual(commands[2].command, VRODriverCommand::CreateMaterial);
+    XCTAssertEqual(commands[2].a, 1);
+}
+
+/*
+ Every state call is logged as issued by default; with state caching the
+ redundant ones are left out and counted as elided.
+ */
+- (void)testStateCaching {
+    VRORecordingDriver driver;
+    std::shared_ptr<VRODriverCommandLog> log = driver.getCommandLog();
+    for (int i = 0; i < 3; i++) {
+        driver.setDepthWritingEnabled(true);
+        driver.setCullMode(VROCullMode::Back);
+        driver.setActiveTextureUnit(GL_TEXTURE0);
+        driver.bindTexture(GL_TEXTURE_2D, 7);
+    }
+    XCTAssertEqual(log->getStateChangeCount(), 12);
+
+    log->clear();
+    driver.setStateCachingEnabled(true);
+    for (int i = 0; i < 3; i++) {
+        driver.setDepthWritingEnabled(true);
+        driver.setCullMode(VROCullMode::Back);
+        driver.setActiveTextureUnit(GL_TEXTURE0);
+        driver.bindTexture(GL_TEXTURE_2D, 7);
+    }
+    XCTAssertEqual(log->getStateChangeCount(), 4);
+    XCTAssertEqual(log->getCount(VRODriverCommand::BindTexture), 1);
+
+    const VRODriverStateStats &stats = driver.getStateCache().getFrameStats();
+    XCTAssertEqual(stats.getElided(VRODriverStateCategory::DepthWrite), 2);
+    XCTAssertEqual(stats.getElided(VRODriverStateCategory::Texture), 2);
+}
+
+/*
+ The display is a single render target for the life of the driver, and
+ offscreen targets get one texture per attachment once sized. Clears and
+ blits are logged against the target's ID.
+ */
+- (void)testRenderTargets {
+    std::shared_ptr<VRORecordingDriver> driver = std::make_shared<VRORecordingDriver>();
+    std::shared_ptr<VRODriverCommandLog> log = driver->getCommandLog();
+
+    std::shared_ptr<VRORenderTarget> display = driver->getDisplay();
+    XCTAssert(display != nullptr);
+    XCTAssert(driver->getDisplay() == display);
+    XCTAssert(display->getType() == kVRORenderTargetDisplay);
+
+    std::shared_ptr<VRORenderTarget> target = driver->newRenderTarget((VRORenderTargetType) 1, 2, 1, false, true);
+    XCTAssertFalse(target->hasTextureAttached(0));
+    target->setViewport({ 0, 0, 640, 480 });
+    XCTAssertEqual(target->getWidth(), 640);
+    XCTAssertEqual(target->getHeight(), 480);
+    XCTAssert(target->getTexture(0) != nullptr);
+    XCTAssert(target->getTexture(1) != nullptr);
+    XCTAssert(target->getTexture(2) == nullptr);
+
+    log->clear();
+    XCTAssert(driver->bindRenderTarget(target, VRORenderTargetUnbindOp::Invalidate));
+    XCTAssertFalse(driver->bindRenderTarget(target, VRORenderTargetUnbindOp::Invalidate));
+    target->clearDepthAndColor();
+    target->blitColor(display, false, driver);
+
+    const std::vector<VRODriverCommandRecord> &commands = log->getCommands();
+    XCTAssertEqual(commands.size(), 4);
+    int32_t targetId = commands[0].a;
+    XCTAssertEqual(commands[2].command, VRODriverCommand::Clear);
+    XCTAssertEqual(commands[2].a, targetId);
+    XCTAssertEqual(commands[2].b, VRORecordingClearDepth | VRORecordingClearColor);
+    XCTAssertEqual(commands[3].command, VRODriverCommand::Blit);
+    XCTAssertEqual(commands[3].a, targetId);
+    XCTAssertEqual(commands[3].b, log->getId(display));
+}
+
+/*
+ A post-process binds its shader through the driver on each blit, and a
+ begin() / blitOpt() / end() sequence binds it once.
+ */
+- (void)testImagePostProcess {
+    std::shared_ptr<VRODriver> driver = std::make_shared<VRORecordingDriver>();
+    std::shared_ptr<VRODriverCommandLog> log = std::dynamic_pointer_cast<VRORecordingDriver>(driver)->getCommandLog();
+    std::shared_ptr<VROImagePostProcess> postProcess = driver->newImagePostProcess(nullptr);
+    std::vector<std::shared_ptr<VROTexture>> textures(2);
+
+    postProcess->blit(textures, driver);
+    XCTAssertEqual(log->getCount(VRODriverCommand::PostProcess), 1);
+    XCTAssertEqual(log->getCommands().back().b, 2);
+
+    log->clear();
+    postProcess->begin(driver);
+    for (int i = 0; i < 3; i++) {
+        postProcess->blitOpt(textures, driver);
+    }
+    postProcess->end(driver);
+    XCTAssertEqual(log->getCount(VRODriverCommand::PostProcess), 3);
+    XCTAssertEqual(log->getCount(VRODriverCommand::BindShader), 1);
+}
+
+/*
+ A scene of boxes rendered headlessly through VRORenderer: every
+ element of every box is drawn once per frame, after its material's shader,
+ and the display is cleared each frame. The same scene logs the same
+ commands each frame.
+ */
+- (void)testHeadlessFrameDrawsScene {
+    const int kNumBoxes = 16;
+    const int kNumFrames = 3;
+    std::shared_ptr<VRORecordingDriver> driver = [self createRendererDriver];
+    std::shared_ptr<VRODriverCommandLog> log = driver->getCommandLog();
+    std::shared_ptr<VROSceneController> sceneController = createBoxScene(kNumBoxes);
+
+    VRORendererConfiguration config;
+    config.enableHDR = false;
+    config.enablePBR = false;
+    config.enableBloom = false;
+    config.enableShadows = false;
+    VROHeadlessRenderer renderer(driver, config, sceneController);
+
+    std::vector<size_t> frameSizes;
+    std::vector<uint64_t> frameDraws;
+    for (int f = 0; f < kNumFrames; f++) {
+        log->clear();
+        renderer.renderFrame(f);
+        frameSizes.push_back(log->getCommands().size());
+        frameDraws.push_back(log->getDrawCount());
+
+        XCTAssertEqual(log->getCount(VRODriverCommand::BeginFrame), 1);
+        XCTAssertEqual(log->getCount(VRODriverCommand::EndFrame), 1);
+        XCTAssertEqual(log->getCount(VRODriverCommand::BeginEye), 1);
+        XCTAssertGreaterThanOrEqual(log->getCount(VRODriverCommand::Clear), 1);
+        XCTAssertGreaterThanOrEqual(log->getCount(VRODriverCommand::BindMaterialShader), 1);
+    }
+    XCTAssertEqual(frameDraws[0], getElementCount(sceneController));
+    XCTAssertEqual(frameDraws[1], frameDraws[0]);
+    XCTAssertEqual(frameSizes[2], frameSizes[1]);
+    NSLog(@"Headless frame:\n%s", log->getSummary().c_str());
+}
+
+/*
+ With HDR and bloom the choreographer renders into offscreen targets and
+ resolves them with post-processes; the scene draws are unchanged.
+ */
+- (void)testHeadlessFrameWithHDR {
+    const int kNumBoxes = 16;
+    std::shared_ptr<VRORecordingDriver> driver = [self createRendererDriver];
+    std::shared_ptr<VRODriverCommandLog> log = driver->getCommandLog();
+    std::shared_ptr<VROSceneController> sceneController = createBoxScene(kNumBoxes);
+
+    VRORendererConfiguration config;
+    config.enableShadows = false;
+    VROHeadlessRenderer renderer(driver, config, sceneController);
+
+    renderer.renderFrame(0);
+    XCTAssertGreaterThan(log->getCount(VRODriverCommand::CreateRenderTarget), 0);
+    log->clear();
+    renderer.renderFrame(1);
+    XCTAssertEqual(log->getDrawCount(), getElementCount(sceneController));
+    XCTAssertGreaterThan(log->getCount(VRODriverCommand::PostProcess), 0);
+    XCTAssertGreaterThan(log->getCount(VRODriverCommand::BindRenderTarget), 1);
+}
+
+/*
+ Cost of a headless frame of 256 boxes, with only counts kept, so the
+ renderer's CPU work per frame can be tracked without drawing.
+ */
+- (void)testPerformanceHeadlessFrame {
+    const int kNumBoxes = 256;
+    const int kNumFrames = 60;
+    std::shared_ptr<VRORecordingDriver> driver = [self createRendererDriver];
+    std::shared_ptr<VRODriverCommandLog> log = driver->getCommandLog();
+    log->setRecording(false);
+    std::shared_ptr<VROSceneController> sceneController = createBoxScene(kNumBoxes);
+
+    VRORendererConfiguration config;
+    config.enableShadows = false;
+    __block VROHeadlessRenderer renderer(driver, config, sceneController);
+    renderer.renderFrame(0);
+
+    [self measureBlock:^{
+        log->clear();
+        double start = VROTimeCurrentMillis();
+        for (int f = 1; f <= kNumFrames; f++) {
+            renderer.renderFrame(f);
+        }
+        NSLog(@"Headless frame: %.3f ms, %llu draws, %llu state changes per frame",
+              (VROTimeCurrentMillis() - start) / kNumFrames,
+              log->getDrawCount() / kNumFrames, log->getStateChangeCount() / kNumFrames);
+    }];
+}
+
+@end
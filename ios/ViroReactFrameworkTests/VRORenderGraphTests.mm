@@ -0,0 +1,225 @@
+//
+//  VRORenderGraphTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VRORenderGraph.h>
+#include <memory>
+#include <vector>
+
+static const int kViewportWidth = 1920;
+static const int kViewportHeight = 1080;
+
+// Only the display's render target type is public (0 is the display), so the
+// color type is only used to compare descriptions here
+static const VRORenderTargetType kColorTexture = (VRORenderTargetType) 1;
+
+static VRORenderGraphTargetDesc createDesc(std::string name, int bytesPerPixel, int attachments = 1,
+                                           bool depthStencil = false) {
+    VRORenderGraphTargetDesc desc;
+    desc.name = name;
+    desc.type = kColorTexture;
+    desc.bytesPerPixel = bytesPerPixel;
+    desc.numAttachments = attachments;
+    desc.needsDepthStencil = depthStencil;
+    return desc;
+}
+
+/*
+ The choreographer's HDR frame with bloom (two blur iterations) and two
+ post-process effects, plus a debug pass whose result is never read.
+ */
+static void declareHDRBloomFrame(VRORenderGraph &graph, int *outDebugPass) {
+    VRORenderGraphPassFunction none = [](const VRORenderGraphContext &) {};
+    int hdr = graph.createTarget(createDesc("hdr", 8, 2, true));
+    int blur[4];
+    for (int i = 0; i < 4; i++) {
+        blur[i] = graph.createTarget(createDesc("blur", 8));
+    }
+    int composited = graph.createTarget(createDesc("composited", 8));
+    int tonemapped = graph.createTarget(createDesc("tonemapped", 4));
+    int post[2] = { graph.createTarget(createDesc("postA", 4)), graph.createTarget(createDesc("postB", 4)) };
+    int debug = graph.createTarget(createDesc("debug", 4));
+    int display = graph.importTarget("display", nullptr);
+
+    graph.addPass("scene", {}, { hdr }, none);
+    graph.addPass("blur", { hdr }, { blur[0] }, none);
+    for (int i = 1; i < 4; i++) {
+        graph.addPass("blur", { blur[i - 1] }, { blur[i] }, none);
+    }
+    graph.addPass("bloom composite", { hdr, blur[3] }, { composited }, none);
+    graph.addPass("tonemap", { composited }, { tonemapped }, none);
+    graph.addPass("post A", { tonemapped }, { post[0] }, none);
+    graph.addPass("post B", { post[0] }, { post[1] }, none);
+    *outDebugPass = graph.getPassCount();
+    graph.addPass("debug", { hdr }, { debug }, none);
+    graph.addPass("display", { post[1] }, { display }, none);
+}
+
+@interface VRORenderGraphTests : XCTestCase
+
+@end
+
+@implementation VRORenderGraphTests
+
+/*
+ Modelled memory before and after the graph, at 1080p: sizes are computed
+ from the target descriptions, not measured from GL allocations. Before is
+ the target set VROChoreographer::createRenderTargets() hard-codes for this
+ configuration: the HDR target, two blur targets, two post-process targets
+ and the HDR blit target. After is the graph's aliased targets. Expected
+ sizes are in bytes per pixel of the 1920x1080 viewport: the HDR target has
+ two 8-byte attachments and a 4-byte depth-stencil buffer, so 20.
+ */
+- (void)testHDRBloomPostProcessMemory {
+    VRORenderGraph graph;
+    int debugPass;
+    declareHDRBloomFrame(graph, &debugPass);
+    graph.compile();
+
+    const int64_t pixels = (int64_t) kViewportWidth * kViewportHeight;
+    int64_t hardCoded = createDesc("hdr", 8, 2, true).getBytes(kViewportWidth, kViewportHeight) +
+                        createDesc("blur", 8).getBytes(kViewportWidth, kViewportHeight) * 2 +
+                        createDesc("post", 4).getBytes(kViewportWidth, kViewportHeight) * 2 +
+                        createDesc("blit", 8).getBytes(kViewportWidth, kViewportHeight);
+    int64_t unaliased = graph.getUnaliasedBytes(kViewportWidth, kViewportHeight);
+    int64_t aliased = graph.getAliasedBytes(kViewportWidth, kViewportHeight);
+    NSLog(@"%s\n  modelled hard-coded targets %lld KB", graph.getReport(kViewportWidth, kViewportHeight).c_str(),
+          (long long) hardCoded / 1024);
+
+    XCTAssert(graph.isPassCulled(debugPass));
+    XCTAssertEqual(graph.getExecutedPassCount(), graph.getPassCount() - 1);
+    XCTAssertEqual(graph.getPhysicalTargetCount(), 5);
+
+    // Before: HDR 20 + blur 2 x 8 + post-process 2 x 4 + blit 8
+    XCTAssertEqual(hardCoded, 52 * pixels);
+    XCTAssertEqual(hardCoded, 107827200);
+
+    // Every executed pass's target on its own: HDR 20 + blur 4 x 8 +
+    // composited 8 + tonemapped 4 + post-process 2 x 4; the debug target
+    // is culled
+    XCTAssertEqual(unaliased, 72 * pixels);
+    XCTAssertEqual(unaliased, 149299200);
+
+    // After: HDR 20 + two 8-byte targets the blur chain and composite
+    // ping-pong between + two 4-byte targets for tonemapping and
+    // post-processing
+    XCTAssertEqual(aliased, 44 * pixels);
+    XCTAssertEqual(aliased, 91238400);
+    XCTAssertEqual(hardCoded - aliased, 16588800);
+}
+
+/*
+ Not reading the bloom result culls the blur passes and frees their
+ targets.
+ */
+- (void)testDisablingBloomCullsBlur {
+    VRORenderGraph graph;
+    VRORenderGraphPassFunction none = [](const VRORenderGraphContext &) {};
+    int hdr = graph.createTarget(createDesc("hdr", 8, 2, true));
+    int blur = graph.createTarget(createDesc("blur", 8));
+    int display = graph.importTarget("display", nullptr);
+    graph.addPass("scene", {}, { hdr }, none);
+    graph.addPass("blur", { hdr }, { blur }, none);
+    graph.addPass("tonemap", { hdr }, { display }, none);
+    graph.compile();
+
+    XCTAssert(graph.isPassCulled(1));
+    XCTAssertEqual(graph.getPhysicalTarget(blur), -1);
+    XCTAssertEqual(graph.getPhysicalTargetCount(), 1);
+}
+
+/*
+ An output lives to the end of the frame: a transient of the same format
+ written after the output's last pass gets a target of its own.
+ */
+- (void)testOutputIsNotAliased {
+    VRORenderGraph graph;
+    VRORenderGraphPassFunction none = [](const VRORenderGraphContext &) {};
+    int capture = graph.createTarget(createDesc("capture", 4));
+    int overlay = graph.createTarget(createDesc("overlay", 4));
+    int display = graph.importTarget("display", nullptr);
+    graph.addPass("capture", {}, { capture }, none);
+    graph.addPass("overlay", {}, { overlay }, none);
+    graph.addPass("display", { overlay }, { display }, none);
+    graph.markOutput(capture);
+    graph.compile();
+
+    XCTAssertFalse(graph.isPassCulled(0));
+    XCTAssertNotEqual(graph.getPhysicalTarget(capture), -1);
+    XCTAssertNotEqual(graph.getPhysicalTarget(capture), graph.getPhysicalTarget(overlay));
+    XCTAssertEqual(graph.getPhysicalTargetCount(), 2);
+}
+
+/*
+ A pass that draws over a target writes a version of it, which keeps the
+ target's physical slot; a compatible transient used while the target is
+ live, between its versions, gets a slot of its own.
+ */
+- (void)testLoadedTargetKeepsItsSlot {
+    VRORenderGraph graph;
+    VRORenderGraphPassFunction none = [](const VRORenderGraphContext &) {};
+    int opaque = graph.createTarget(createDesc("hdr", 8));
+    int blur = graph.createTarget(createDesc("blur", 8));
+    int transparent = graph.loadTarget(opaque);
+    int unused = graph.loadTarget(transparent);
+    int display = graph.importTarget("display", nullptr);
+    graph.addPass("scene", {}, { opaque }, none);
+    graph.addPass("blur", { opaque }, { blur }, none);
+    graph.addPass("transparent", { blur }, { transparent }, none);
+    graph.addPass("overlay", {}, { unused }, none);
+    graph.addPass("display", { transparent }, { display }, none);
+    graph.compile();
+
+    XCTAssertFalse(graph.isPassCulled(2));
+    XCTAssert(graph.isPassCulled(3));
+    XCTAssertEqual(graph.getPhysicalTargetCount(), 2);
+    XCTAssertEqual(graph.getPhysicalTarget(transparent), graph.getPhysicalTarget(opaque));
+    XCTAssertNotEqual(graph.getPhysicalTarget(blur), graph.getPhysicalTarget(opaque));
+    XCTAssertEqual(graph.getPhysicalTarget(unused), -1);
+    XCTAssertEqual(graph.getUnaliasedBytes(kViewportWidth, kViewportHeight),
+                   graph.getAliasedBytes(kViewportWidth, kViewportHeight));
+}
+
+/*
+ A version of an imported target is imported: it resolves to the imported
+ target, and the pass writing it is never culled.
+ */
+- (void)testLoadingImportedTarget {
+    VRORenderGraph graph;
+    VRORenderGraphPassFunction none = [](const VRORenderGraphContext &) {};
+    int display = graph.importTarget("display", nullptr);
+    int overlay = graph.loadTarget(display);
+    graph.addPass("tonemap", {}, { display }, none);
+    graph.addPass("overlay", {}, { overlay }, none);
+    graph.compile();
+
+    XCTAssertFalse(graph.isPassCulled(0));
+    XCTAssertFalse(graph.isPassCulled(1));
+    XCTAssertEqual(graph.getPhysicalTargetCount(), 0);
+    XCTAssertEqual(graph.getPhysicalTarget(overlay), -1);
+}
+
+@end
@@ -0,0 +1,311 @@
+//
+//  VROShaderPermutationTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROShaderPermutation.h>
+#include <ViroKit/VROShaderProgramCache.h>
+#include <ViroKit/VROUniform.h>
+#include <ViroKit/VROMaterial.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+static const int kMaterials = 1000;
+static const int kModifiersPerMaterial = 3;
+static const int kModifierPool = 40;
+
+/*
+ 1,000 materials, each with three modifiers drawn from a shared pool, as a
+ scene of many objects using a few lighting and surface effects would have.
+ Each modifier binds a uniform, so interning copies its uniform names.
+ */
+struct MaterialSet {
+    std::vector<std::shared_ptr<VROShaderModifier>> pool;
+    std::vector<std::vector<std::shared_ptr<VROShaderModifier>>> materials;
+
+    MaterialSet() {
+        for (int i = 0; i < kModifierPool; i++) {
+            std::string uniform = "uniform_" + std::to_string(i);
+            pool.push_back(std::make_shared<VROShaderModifier>(VROShaderEntryPoint::Surface, std::vector<std::string> {
+                "uniform lowp float " + uniform + ";",
+                "_surface.diffuse_color.rgb *= " + uniform + ";"
+            }));
+            pool.back()->setUniformBinder(uniform, VROShaderProperty::Float,
+                                          [](VROUniform *uniform, const VROGeometry * /* geometry */, const VROMaterial * /* material */) {
+                                              uniform->setFloat(1.0f);
+                                          });
+        }
+        for (int m = 0; m < kMaterials; m++) {
+            std::vector<std::shared_ptr<VROShaderModifier>> modifiers;
+            for (int k = 0; k < kModifiersPerMaterial; k++) {
+                modifiers.push_back(pool[(m * 7 + k * 13) % kModifierPool]);
+            }
+            materials.push_back(modifiers);
+        }
+    }
+};
+
+static std::shared_ptr<VROShaderModifier> createBoundModifier(const std::vector<std::string> &code,
+                                                              const std::string &uniform) {
+    std::shared_ptr<VROShaderModifier> modifier = std::make_shared<VROShaderModifier>(VROShaderEntryPoint::Surface, code);
+    modifier->setUniformBinder(uniform, VROShaderProperty::Float,
+                               [](VROUniform *uniform, const VROGeometry * /* geometry */, const VROMaterial * /* material */) {
+                                   uniform->setFloat(1.0f);
+                               });
+    return modifier;
+}
+
+static const char *const kPermutationVertexSource = R"(#version 300 es
+void main() {
+    gl_Position = vec4(float(gl_VertexID & 1), float(gl_VertexID >> 1), 0.0, 1.0);
+}
+)";
+
+/*
+ The linked program of a Surface permutation: a minimal fragment shader
+ with each modifier's uniforms at the top and its body in main(), in order.
+ */
+static VROShaderProgramSource createPermutationSource(const std::vector<std::shared_ptr<VROShaderModifier>> &modifiers) {
+    std::string uniforms, body;
+    for (const std::shared_ptr<VROShaderModifier> &modifier : modifiers) {
+        uniforms += modifier->getUniformsSource() + "\n";
+        body += modifier->getBodySource() + "\n";
+    }
+    VROShaderProgramSource source;
+    source.name = "permutation_fsh";
+    source.vertexSource = kPermutationVertexSource;
+    source.fragmentSource = "#version 300 es\n"
+                            "precision mediump float;\n"
+                            "struct VROSurface {\n"
+                            "    lowp vec4 diffuse_color;\n"
+                            "    lowp float alpha;\n"
+                            "};\n" + uniforms +
+                            "out vec4 frag_color;\n"
+                            "void main() {\n"
+                            "    VROSurface _surface;\n"
+                            "    _surface.diffuse_color = vec4(1.0);\n"
+                            "    _surface.alpha = 1.0;\n" + body +
+                            "    frag_color = vec4(_surface.diffuse_color.rgb, _surface.alpha);\n"
+                            "}\n";
+    source.modifierKey = VROShaderModifier::getShaderModifierKey(modifiers);
+    return source;
+}
+
+@interface VROShaderPermutationTests : XCTestCase
+
+@end
+
+@implementation VROShaderPermutationTests {
+    EAGLContext *_context;
+    NSString *_directory;
+}
+
+- (void)setUp {
+    [super setUp];
+    _context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(_context);
+    [EAGLContext setCurrentContext:_context];
+
+    _directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_directory error:nil];
+    [EAGLContext setCurrentContext:nil];
+    _context = nil;
+    [super tearDown];
+}
+
+/*
+ A key is 64 bits packed from its three IDs, and modifier lists are
+ interned by their order.
+ */
+- (void)testKeyPacksInternedIds {
+    XCTAssertEqual(sizeof(VROShaderPermutationKey), sizeof(uint64_t));
+
+    VROShaderModifierRegistry &registry = VROShaderModifierRegistry::shared();
+    std::shared_ptr<VROShaderModifier> a = createBoundModifier({ "uniform lowp float pack_a;", "_surface.alpha *= pack_a;" }, "pack_a");
+    std::shared_ptr<VROShaderModifier> b = createBoundModifier({ "uniform lowp float pack_b;", "_surface.alpha *= pack_b;" }, "pack_b");
+    uint32_t shader = registry.internShader("pack_test_fsh");
+    int attributes = (int) VROShaderMask::Tex | (int) VROShaderMask::Norm;
+
+    VROShaderPermutationKey ab = registry.createKey(shader, attributes, { a, b });
+    XCTAssertEqual(ab.getBaseShader(), shader);
+    XCTAssertEqual(ab.getAttributes(), (uint32_t) attributes);
+    XCTAssertEqual(ab.getKey() & 0xffffffff, ab.getModifierList());
+    XCTAssertTrue(ab == registry.createKey(shader, attributes, { a, b }));
+    XCTAssertTrue(ab != registry.createKey(shader, attributes, { b, a }));
+    XCTAssertTrue(ab != registry.createKey(shader, 0, { a, b }));
+    XCTAssertTrue(ab != registry.createKey(shader, attributes, { a }));
+    XCTAssertEqual(registry.createKey(shader, attributes, {}).getModifierList(), 0);
+    XCTAssertFalse(VROShaderPermutationKey().isValid());
+}
+
+- (void)testIdenticalModifiersShareKeys {
+    VROShaderModifierRegistry &registry = VROShaderModifierRegistry::shared();
+    std::vector<std::string> code = { "uniform lowp float shared_test;", "_surface.alpha *= shared_test;" };
+    std::shared_ptr<VROShaderModifier> a = std::make_shared<VROShaderModifier>(VROShaderEntryPoint::Surface, code);
+    std::shared_ptr<VROShaderModifier> b = std::make_shared<VROShaderModifier>(VROShaderEntryPoint::Surface, code);
+    XCTAssertEqual(registry.intern(a), registry.intern(b));
+
+    uint32_t shader = registry.internShader("standard_vsh");
+    XCTAssertTrue(registry.createKey(shader, 0, { a }) == registry.createKey(shader, 0, { b }));
+
+    b->addReplacement("_surface.alpha", "_surface.alpha * 0.5");
+    XCTAssertNotEqual(registry.intern(a), registry.intern(b));
+}
+
+/*
+ Destroyed modifiers are pruned from the registry, and a modifier created
+ afterward never inherits a destroyed one's ID.
+ */
+- (void)testDestroyedModifiersArePruned {
+    VROShaderModifierRegistry &registry = VROShaderModifierRegistry::shared();
+    std::vector<std::string> code = { "uniform lowp float prune_test;", "_surface.alpha *= prune_test;" };
+    std::shared_ptr<VROShaderModifier> survivor = createBoundModifier(code, "prune_test");
+    uint32_t survivorId = registry.intern(survivor);
+
+    std::set<uint32_t> destroyedIds;
+    for (int i = 0; i < 2000; i++) {
+        destroyedIds.insert(registry.intern(createBoundModifier(code, "prune_test")));
+    }
+    XCTAssertEqual((int) destroyedIds.size(), 2000);
+    XCTAssertLessThan((int) registry.getModifierCount(), 1000);
+    XCTAssertEqual(registry.intern(survivor), survivorId);
+
+    uint32_t laterId = registry.intern(createBoundModifier(code, "prune_test"));
+    XCTAssertEqual((int) destroyedIds.count(laterId), 0);
+    XCTAssertNotEqual(laterId, survivorId);
+
+    // Lists keyed with destroyed modifiers are pruned with them
+    uint32_t shader = registry.internShader("standard_fsh");
+    VROShaderPermutationKey survivorKey = registry.createKey(shader, 0, { survivor });
+    for (int i = 0; i < 2000; i++) {
+        registry.createKey(shader, 0, { survivor, createBoundModifier(code, "prune_test") });
+    }
+    XCTAssertLessThan((int) registry.getModifierListCount(), 1000);
+    XCTAssertTrue(registry.createKey(shader, 0, { survivor }) == survivorKey);
+}
+
+/*
+ The first lookup of each permutation links its program once; materials
+ with the same modifiers share it.
+ */
+- (void)testMaterialsSharePermutationPrograms {
+    MaterialSet set;
+    VROShaderProgramCache programs([_directory UTF8String]);
+    VROShaderModifierRegistry &registry = VROShaderModifierRegistry::shared();
+    uint32_t shader = registry.internShader("permutation_fsh");
+    VROShaderPermutationTable<GLuint> table;
+
+    std::set<std::string> distinct;
+    double start = VROTimeCurrentMillis();
+    for (int m = 0; m < kMaterials; m++) {
+        GLuint program = table.getOrCreate(registry.createKey(shader, 0, set.materials[m]), [&] {
+            return programs.getProgram(createPermutationSource(set.materials[m]));
+        });
+        XCTAssertNotEqual(program, 0);
+        distinct.insert(VROShaderModifier::getShaderModifierKey(set.materials[m]));
+    }
+    NSLog(@"%d materials resolved to %d linked programs in %.1f ms: %s", kMaterials, (int) table.size(),
+          VROTimeCurrentMillis() - start, programs.getSummary().c_str());
+    XCTAssertEqual(table.size(), distinct.size());
+    XCTAssertEqual(programs.getRecords().size(), distinct.size());
+}
+
+/*
+ Resolving the linked program of each of 1,000 materials, each with three
+ modifiers, and binding it, as a material substrate does when it is
+ created or rebound. The programs are compiled and linked before timing.
+ VROMaterialSubstrateOpenGL itself can't be created here: only
+ VRODriverOpenGL builds it, and that driver's symbols are local to the
+ framework binary. This times the part of its creation the permutation
+ key replaces: key construction, program lookup, and glUseProgram.
+ */
+- (void)testPerformanceMaterialProgramLookup {
+    MaterialSet set;
+    VROShaderProgramCache programs([_directory UTF8String]);
+    VROShaderModifierRegistry *registry = &VROShaderModifierRegistry::shared();
+    uint32_t shader = registry->internShader("permutation_fsh");
+    VROShaderPermutationTable<GLuint> table;
+    for (int m = 0; m < kMaterials; m++) {
+        table.getOrCreate(registry->createKey(shader, 0, set.materials[m]), [&] {
+            return programs.getProgram(createPermutationSource(set.materials[m]));
+        });
+    }
+
+    MaterialSet *setPtr = &set;
+    VROShaderPermutationTable<GLuint> *tablePtr = &table;
+    [self measureBlock:^{
+        int found = 0;
+        for (int m = 0; m < kMaterials; m++) {
+            const GLuint *program = tablePtr->find(registry->createKey(shader, 0, setPtr->materials[m]));
+            if (program) {
+                glUseProgram(*program);
+                found++;
+            }
+        }
+        glFinish();
+        XCTAssertEqual(found, kMaterials);
+    }];
+    glUseProgram(0);
+}
+
+/*
+ The string-keyed path the permutation keys replace, over the same linked
+ programs, for comparison.
+ */
+- (void)testPerformanceStringKeys {
+    MaterialSet set;
+    VROShaderProgramCache programs([_directory UTF8String]);
+    std::map<std::string, GLuint> table;
+    for (int m = 0; m < kMaterials; m++) {
+        std::string key = "permutation_fsh_" + VROShaderModifier::getShaderModifierKey(set.materials[m]);
+        if (table.find(key) == table.end()) {
+            table[key] = programs.getProgram(createPermutationSource(set.materials[m]));
+        }
+    }
+
+    MaterialSet *setPtr = &set;
+    std::map<std::string, GLuint> *tablePtr = &table;
+    [self measureBlock:^{
+        int found = 0;
+        for (int m = 0; m < kMaterials; m++) {
+            auto it = tablePtr->find("permutation_fsh_" + VROShaderModifier::getShaderModifierKey(setPtr->materials[m]));
+            if (it != tablePtr->end()) {
+                glUseProgram(it->second);
+                found++;
+            }
+        }
+        glFinish();
+        XCTAssertEqual(found, kMaterials);
+    }];
+    glUseProgram(0);
+}
+
+@end
@@ -0,0 +1,293 @@
+//
+//  VROShaderProgramCacheTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROShaderProgramCache.h>
+#include <thread>
+
+/*
+ A minimal program; each index gives a distinct permutation.
+ */
+static VROShaderProgramSource makeSource(int index) {
+    VROShaderProgramSource source;
+    source.name = "test_" + std::to_string(index);
+    source.vertexSource =
+        "#version 300 es\n"
+        "in vec3 position;\n"
+        "void main() { gl_Position = vec4(position, 1.0); }\n";
+    source.fragmentSource =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "out vec4 frag_color;\n"
+        "void main() { frag_color = vec4(" + std::to_string(index) + ".0 / 255.0); }\n";
+    source.attributeLocations = { { "position", 0 } };
+    return source;
+}
+
+static VROShaderProgramSource makeBrokenSource() {
+    VROShaderProgramSource source = makeSource(0);
+    source.name = "broken";
+    source.fragmentSource = "#version 300 es\nvoid main() { undeclared = 1; }\n";
+    return source;
+}
+
+@interface VROShaderProgramCacheTests : XCTestCase
+
+@end
+
+@implementation VROShaderProgramCacheTests {
+    EAGLContext *_context;
+    NSString *_directory;
+}
+
+- (void)setUp {
+    [super setUp];
+    _context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(_context);
+    [EAGLContext setCurrentContext:_context];
+
+    _directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_directory error:nil];
+    [EAGLContext setCurrentContext:nil];
+    _context = nil;
+    [super tearDown];
+}
+
+- (int)countFilesWithExtension:(NSString *)extension {
+    NSArray *files = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:_directory error:nil];
+    return (int) [[files filteredArrayUsingPredicate:
+                   [NSPredicate predicateWithFormat:@"self ENDSWITH %@", extension]] count];
+}
+
+/*
+ Every part of the source is in the key, and strings are delimited so that
+ moving text from one to the next changes it.
+ */
+- (void)testKeyCoversEverySourceField {
+    VROShaderProgramSource source = makeSource(1);
+    uint64_t key = VROShaderProgramCache::getKey(source);
+    XCTAssertEqual(key, VROShaderProgramCache::getKey(makeSource(1)));
+    XCTAssertNotEqual(key, VROShaderProgramCache::getKey(makeSource(2)));
+
+    VROShaderProgramSource changed = source;
+    changed.name = "renamed";
+    XCTAssertEqual(VROShaderProgramCache::getKey(changed), key);
+
+    changed = source;
+    changed.vertexSource += " ";
+    XCTAssertNotEqual(VROShaderProgramCache::getKey(changed), key);
+    changed = source;
+    changed.modifierKey = "lambert";
+    XCTAssertNotEqual(VROShaderProgramCache::getKey(changed), key);
+    changed = source;
+    changed.attributeLocations[0].second = 1;
+    XCTAssertNotEqual(VROShaderProgramCache::getKey(changed), key);
+    changed = source;
+    changed.attributeLocations[0].first = "normal";
+    XCTAssertNotEqual(VROShaderProgramCache::getKey(changed), key);
+
+    VROShaderProgramSource a = source, b = source;
+    a.vertexSource = "ab";
+    a.fragmentSource = "c";
+    b.vertexSource = "a";
+    b.fragmentSource = "bc";
+    XCTAssertNotEqual(VROShaderProgramCache::getKey(a), VROShaderProgramCache::getKey(b));
+}
+
+/*
+ A program is compiled once and then returned from memory; its source is
+ stored for the next launch.
+ */
+- (void)testProgramIsCompiledOnce {
+    VROShaderProgramCache cache([_directory UTF8String]);
+    VROShaderProgramSource source = makeSource(1);
+
+    GLuint program = cache.getProgram(source);
+    XCTAssertNotEqual(program, 0);
+    XCTAssertTrue(cache.hasProgram(source));
+    XCTAssertEqual(cache.getProgram(source), program);
+
+    std::vector<VROShaderCompileRecord> records = cache.getRecords();
+    XCTAssertEqual(records.size(), 1);
+    XCTAssertEqual(records[0].key, VROShaderProgramCache::getKey(source));
+    XCTAssertFalse(records[0].failed);
+    XCTAssertGreaterThan(records[0].compileMs + records[0].linkMs, 0);
+    XCTAssertEqual([self countFilesWithExtension:@".src"], 1);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    XCTAssertEqual(status, GL_TRUE);
+}
+
+/*
+ Failures are recorded but not cached or stored, so each request retries.
+ */
+- (void)testFailureIsNotCached {
+    VROShaderProgramCache cache([_directory UTF8String]);
+    VROShaderProgramSource source = makeBrokenSource();
+    XCTAssertEqual(cache.getProgram(source), 0);
+    XCTAssertEqual(cache.getProgram(source), 0);
+    XCTAssertFalse(cache.hasProgram(source));
+
+    std::vector<VROShaderCompileRecord> records = cache.getRecords();
+    XCTAssertEqual(records.size(), 2);
+    XCTAssertTrue(records[1].failed);
+    XCTAssertEqual([self countFilesWithExtension:@".src"], 0);
+    XCTAssertTrue(cache.getSummary().find("2 failed") != std::string::npos);
+}
+
+/*
+ No program binaries are stored: a second cache on the same directory
+ compiles the program again, and the directory holds only its source.
+ */
+- (void)testReloadCompilesAgain {
+    VROShaderProgramSource source = makeSource(1);
+    {
+        VROShaderProgramCache cache([_directory UTF8String]);
+        XCTAssertNotEqual(cache.getProgram(source), 0);
+        cache.evict(false);
+    }
+
+    VROShaderProgramCache cache([_directory UTF8String]);
+    XCTAssertFalse(cache.hasProgram(source));
+    XCTAssertNotEqual(cache.getProgram(source), 0);
+    std::vector<VROShaderCompileRecord> records = cache.getRecords();
+    XCTAssertEqual(records.size(), 1);
+    XCTAssertFalse(records[0].failed);
+    XCTAssertEqual([self countFilesWithExtension:@".src"], 1);
+    XCTAssertEqual([self countFilesWithExtension:@""], 1);
+    NSLog(@"Program cache reload: %s", cache.getSummary().c_str());
+}
+
+/*
+ The programs an earlier run linked are queued from their stored sources;
+ stored sources that are corrupt are deleted.
+ */
+- (void)testEnqueueStoredWarmUp {
+    const int kPrograms = 5;
+    {
+        VROShaderProgramCache cache([_directory UTF8String]);
+        for (int i = 0; i < kPrograms; i++) {
+            cache.getProgram(makeSource(i));
+        }
+    }
+    NSString *corrupt = [_directory stringByAppendingPathComponent:@"00000000deadbeef.src"];
+    [[NSData dataWithBytes:"VROC" length:4] writeToFile:corrupt atomically:NO];
+
+    VROShaderProgramCache cache([_directory UTF8String]);
+    XCTAssertEqual(cache.enqueueStoredWarmUp(), kPrograms);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:corrupt]);
+    XCTAssertEqual(cache.warmUp(10000), 0);
+    for (int i = 0; i < kPrograms; i++) {
+        XCTAssertTrue(cache.hasProgram(makeSource(i)));
+    }
+}
+
+/*
+ warmUp() stops when its budget is spent and picks up where it left off on
+ the next call.
+ */
+- (void)testWarmUpBudget {
+    const int kPrograms = 20;
+    VROShaderProgramCache cache([_directory UTF8String]);
+    std::vector<VROShaderProgramSource> sources;
+    for (int i = 0; i < kPrograms; i++) {
+        sources.push_back(makeSource(i));
+    }
+    cache.enqueueWarmUp(sources);
+
+    XCTAssertEqual(cache.warmUp(0), kPrograms);
+    XCTAssertEqual(cache.getRecords().size(), 0);
+
+    int remaining = kPrograms;
+    int calls = 0;
+    while (remaining > 0 && calls < kPrograms * 10) {
+        int previous = remaining;
+        remaining = cache.warmUp(1);
+        XCTAssertLessThanOrEqual(remaining, previous);
+        calls++;
+    }
+    XCTAssertEqual(remaining, 0);
+    XCTAssertGreaterThan(calls, 1);
+    XCTAssertEqual(cache.getRecords().size(), kPrograms);
+    XCTAssertTrue(cache.hasProgram(sources.back()));
+}
+
+/*
+ Only the most recent kMaxRecords records are kept; the summary counts
+ every acquisition.
+ */
+- (void)testRecordsAreCapped {
+    const int kAcquisitions = VROShaderProgramCache::kMaxRecords + 10;
+    VROShaderProgramCache cache([_directory UTF8String]);
+    VROShaderProgramSource source = makeBrokenSource();
+    for (int i = 0; i < kAcquisitions; i++) {
+        cache.getProgram(source);
+    }
+    XCTAssertEqual(cache.getRecords().size(), VROShaderProgramCache::kMaxRecords);
+    std::string failed = std::to_string(kAcquisitions) + " failed";
+    XCTAssertTrue(cache.getSummary().find(failed) != std::string::npos);
+}
+
+/*
+ warmUpAll() on a background thread with a context in the renderer's
+ share group leaves linked programs the renderer's context can use.
+ */
+- (void)testWarmUpAllOnSharedContext {
+    const int kPrograms = 8;
+    VROShaderProgramCache cache([_directory UTF8String]);
+    std::vector<VROShaderProgramSource> sources;
+    for (int i = 0; i < kPrograms; i++) {
+        sources.push_back(makeSource(i));
+    }
+    cache.enqueueWarmUp(sources);
+
+    EAGLContext *shared = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3
+                                                sharegroup:_context.sharegroup];
+    XCTAssertNotNil(shared);
+    std::thread loader([shared, &cache] {
+        [EAGLContext setCurrentContext:shared];
+        cache.warmUpAll();
+        [EAGLContext setCurrentContext:nil];
+    });
+    loader.join();
+
+    XCTAssertEqual(cache.warmUp(0), 0);
+    for (const VROShaderProgramSource &source : sources) {
+        XCTAssertTrue(cache.hasProgram(source));
+        GLuint program = cache.getProgram(source);
+        XCTAssertTrue(glIsProgram(program));
+        GLint status = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &status);
+        XCTAssertEqual(status, GL_TRUE);
+    }
+    XCTAssertEqual(cache.getRecords().size(), kPrograms);
+}
+
+@end
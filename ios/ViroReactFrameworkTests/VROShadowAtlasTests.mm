@@ -0,0 +1,369 @@
+//
+//  VROShadowAtlasTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROShadowAtlas.h>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+
+static const int kBenchmarkLights = 8;
+static const int kBenchmarkStaticCasters = 240;
+static const int kBenchmarkDynamicCasters = 16;
+static const int kBenchmarkFrames = 10;
+
+/*
+ A shadow-casting spot light whose shadow view and projection are identity,
+ so its frustum is the cube from -1 to 1.
+ */
+static std::shared_ptr<VROLight> createShadowLight(int shadowMapSize) {
+    std::shared_ptr<VROLight> light = std::make_shared<VROLight>(VROLightType::Spot);
+    light->setCastsShadow(true);
+    light->setShadowMapSize(shadowMapSize);
+    light->setInfluenceBitMask(1);
+    light->setShadowViewMatrix(VROMatrix4f::identity());
+    light->setShadowProjectionMatrix(VROMatrix4f::identity());
+    return light;
+}
+
+static VROShadowCaster createCaster(uint32_t id, bool isStatic) {
+    VROShadowCaster caster;
+    caster.id = id;
+    caster.bounds = VROBoundingBox(-0.25f, 0.25f, -0.25f, 0.25f, -0.25f, 0.25f);
+    caster.isStatic = isStatic;
+    caster.version = 0;
+    caster.shadowCastingBitMask = 1;
+    return caster;
+}
+
+/*
+ True if no two tiles of the plans overlap.
+ */
+static bool tilesDisjoint(const std::vector<VROShadowLightPlan> &plans) {
+    for (int i = 0; i < (int) plans.size(); i++) {
+        for (int j = i + 1; j < (int) plans.size(); j++) {
+            const VROShadowTile &a = plans[i].tile, &b = plans[j].tile;
+            if (a.x < b.x + b.size && b.x < a.x + a.size && a.y < b.y + b.size && b.y < a.y + a.size) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ Casters for the shadow pass benchmark: static casters scattered on a grid
+ that overhangs the lights' frusta, so some are culled, followed by a few
+ dynamic casters near the center. Caster IDs are their indices.
+ */
+static std::vector<VROShadowCaster> createBenchmarkCasters() {
+    std::vector<VROShadowCaster> casters;
+    for (int i = 0; i < kBenchmarkStaticCasters + kBenchmarkDynamicCasters; i++) {
+        bool isStatic = i < kBenchmarkStaticCasters;
+        float x, y, z;
+        if (isStatic) {
+            x = -1.5f + 3.0f * (i % 8) / 7.0f;
+            y = -1.5f + 3.0f * ((i / 8) % 6) / 5.0f;
+            z = -0.9f + 1.8f * (i / 48) / 4.0f;
+        } else {
+            x = -0.5f + (i % 4) * 0.33f;
+            y = -0.5f + ((i / 4) % 4) * 0.33f;
+            z = 0;
+        }
+        VROShadowCaster caster = createCaster((uint32_t) i, isStatic);
+        caster.bounds = VROBoundingBox(x - 0.1f, x + 0.1f, y - 0.1f, y + 0.1f, z - 0.1f, z + 0.1f);
+        casters.push_back(caster);
+    }
+    return casters;
+}
+
+/*
+ Shadow-casting lights for the benchmark, each looking at the casters from
+ a different offset so their caster sets differ.
+ */
+static std::vector<std::shared_ptr<VROLight>> createBenchmarkLights() {
+    std::vector<std::shared_ptr<VROLight>> lights;
+    for (int i = 0; i < kBenchmarkLights; i++) {
+        std::shared_ptr<VROLight> light = createShadowLight(512);
+        VROMatrix4f view = VROMatrix4f::identity();
+        view.translate((i - kBenchmarkLights / 2) * 0.125f, 0, 0);
+        light->setShadowViewMatrix(view);
+        lights.push_back(light);
+    }
+    return lights;
+}
+
+static GLuint compileShader(GLenum type, const char *source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+/*
+ A depth-only program that draws a unit cube scaled and offset into a
+ caster's bounds, with the cube's vertex array. Stands in for the depth
+ material of the shadow pass.
+ */
+static GLuint createDepthProgram(GLuint *outVertexArray, GLuint *outBuffer) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER,
+        "#version 300 es\n"
+        "in vec3 position;\n"
+        "uniform vec4 offset_scale;\n"
+        "void main() { gl_Position = vec4(position * offset_scale.w + offset_scale.xyz, 1.0); }\n");
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER,
+        "#version 300 es\n"
+        "void main() {}\n");
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glBindAttribLocation(program, 0, "position");
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    const float corners[6][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, -1 }, { 1, 1 }, { -1, 1 } };
+    std::vector<float> vertices;
+    for (int face = 0; face < 6; face++) {
+        int axis = face / 2;
+        for (const float *corner : corners) {
+            float vertex[3];
+            vertex[axis] = (face % 2 == 0) ? 1.0f : -1.0f;
+            vertex[(axis + 1) % 3] = corner[0];
+            vertex[(axis + 2) % 3] = corner[1];
+            vertices.insert(vertices.end(), vertex, vertex + 3);
+        }
+    }
+    glGenVertexArrays(1, outVertexArray);
+    glBindVertexArray(*outVertexArray);
+    glGenBuffers(1, outBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, *outBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    return program;
+}
+
+@interface VROShadowAtlasTests : XCTestCase
+
+@end
+
+@implementation VROShadowAtlasTests
+
+/*
+ A light's static depth is reused while nothing changes, and never by a
+ different light, even one allocated where the first one lived.
+ */
+- (void)testStaticCacheKeyedByLightId {
+    VROShadowAtlas atlas(1024);
+    std::vector<VROShadowCaster> casters = { createCaster(1, true), createCaster(2, false) };
+
+    std::shared_ptr<VROLight> light = createShadowLight(512);
+    atlas.plan({ light }, casters);
+    XCTAssertEqual(atlas.getStats().staticCacheHits, 0);
+    XCTAssertEqual(atlas.getStats().staticDraws, 1);
+    XCTAssertEqual(atlas.getStats().dynamicDraws, 1);
+
+    atlas.plan({ light }, casters);
+    XCTAssertEqual(atlas.getStats().staticCacheHits, 1);
+    XCTAssertEqual(atlas.getStats().staticDrawsSaved, 1);
+    XCTAssertEqual(atlas.getStats().staticDraws, 0);
+
+    light.reset();
+    std::shared_ptr<VROLight> replacement = createShadowLight(512);
+    atlas.plan({ replacement }, casters);
+    XCTAssertEqual(atlas.getStats().staticCacheHits, 0);
+    XCTAssertEqual(atlas.getStats().staticDraws, 1);
+}
+
+/*
+ When the requests exceed the atlas, the largest are halved so every light
+ still gets a tile.
+ */
+- (void)testFullAtlasDownscalesTiles {
+    VROShadowAtlas atlas(512, 128);
+    std::vector<std::shared_ptr<VROLight>> lights;
+    for (int i = 0; i < 5; i++) {
+        lights.push_back(createShadowLight(256));
+    }
+    const std::vector<VROShadowLightPlan> &plans = atlas.plan(lights, {});
+    XCTAssertEqual(atlas.getStats().lights, 5);
+    XCTAssertEqual(atlas.getStats().tilesDownscaled, 2);
+    XCTAssertEqual(atlas.getStats().lightsDropped, 0);
+    XCTAssertTrue(tilesDisjoint(plans));
+}
+
+/*
+ Lights that don't fit at the minimum tile size are counted as dropped, not
+ as downscaled.
+ */
+- (void)testDroppedLightsCountedSeparately {
+    VROShadowAtlas atlas(256, 128);
+    std::vector<std::shared_ptr<VROLight>> lights;
+    for (int i = 0; i < 5; i++) {
+        lights.push_back(createShadowLight(128));
+    }
+    const std::vector<VROShadowLightPlan> &plans = atlas.plan(lights, {});
+    XCTAssertEqual(atlas.getStats().lights, 4);
+    XCTAssertEqual(atlas.getStats().lightsDropped, 1);
+    XCTAssertEqual(atlas.getStats().tilesDownscaled, 0);
+    XCTAssertTrue(tilesDisjoint(plans));
+}
+
+/*
+ render() draws the static casters only on a miss, and times the passes.
+ */
+- (void)testRenderExecutesAndTimesPlan {
+    EAGLContext *context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(context);
+    [EAGLContext setCurrentContext:context];
+    {
+        VROShadowAtlas atlas(1024);
+        VROShadowAtlasTargets targets(atlas.getAtlasSize());
+        std::vector<VROShadowCaster> casters = { createCaster(1, true), createCaster(2, false) };
+        std::shared_ptr<VROLight> light = createShadowLight(512);
+
+        int draws = 0;
+        auto draw = [&draws](const VROShadowLightPlan & /* plan */, const std::vector<uint32_t> &casterIds) {
+            draws += (int) casterIds.size();
+            usleep(1000);
+        };
+
+        atlas.plan({ light }, casters);
+        atlas.render(&targets, draw);
+        XCTAssertEqual(draws, 2);
+        XCTAssertGreaterThan(atlas.getStats().renderTimeMs, 1.0);
+
+        draws = 0;
+        atlas.plan({ light }, casters);
+        atlas.render(&targets, draw);
+        XCTAssertEqual(draws, 1);
+        XCTAssertEqual(glGetError(), GL_NO_ERROR);
+    }
+    [EAGLContext setCurrentContext:nil];
+}
+
+/*
+ Plan and render kBenchmarkFrames frames of the benchmark scene, drawing
+ each caster with the depth program, and report the shadow draws and time
+ per frame. With the cache off every light's static depth is invalidated
+ each frame, as if the atlas had no static cache.
+ */
+- (void)shadowPassPerformanceWithCache:(BOOL)cached {
+    EAGLContext *context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(context);
+    [EAGLContext setCurrentContext:context];
+
+    {
+        std::shared_ptr<VROShadowAtlas> atlas = std::make_shared<VROShadowAtlas>(2048);
+        std::shared_ptr<VROShadowAtlasTargets> targets = std::make_shared<VROShadowAtlasTargets>(atlas->getAtlasSize());
+        std::vector<std::shared_ptr<VROLight>> lights = createBenchmarkLights();
+        std::vector<VROShadowCaster> casters = createBenchmarkCasters();
+
+        GLuint vertexArray, buffer;
+        GLuint program = createDepthProgram(&vertexArray, &buffer);
+        glUseProgram(program);
+        glEnable(GL_DEPTH_TEST);
+        GLint offsetScale = glGetUniformLocation(program, "offset_scale");
+
+        int draws = 0;
+        int *drawsPtr = &draws;
+        const std::vector<VROShadowCaster> *castersPtr = &casters;
+        auto draw = [&draws, castersPtr, offsetScale](const VROShadowLightPlan & /* plan */,
+                                                      const std::vector<uint32_t> &casterIds) {
+            for (uint32_t id : casterIds) {
+                const VROBoundingBox &bounds = (*castersPtr)[id].bounds;
+                VROVector3f center = bounds.getCenter();
+                glUniform4f(offsetScale, center.x, center.y, center.z, bounds.getSpanX() / 2);
+                glDrawArrays(GL_TRIANGLES, 0, 36);
+            }
+            draws += (int) casterIds.size();
+        };
+
+        // Warm the cache so the cached runs measure the steady state
+        atlas->plan(lights, casters);
+        atlas->render(targets.get(), draw);
+        glFinish();
+
+        __block double totalMs = 0;
+        __block int totalDraws = 0;
+        __block int totalFrames = 0;
+        [self measureBlock:^{
+            for (int frame = 0; frame < kBenchmarkFrames; frame++) {
+                double start = VROTimeCurrentMillis();
+                if (!cached) {
+                    atlas->invalidate();
+                }
+                *drawsPtr = 0;
+                atlas->plan(lights, casters);
+                atlas->render(targets.get(), draw);
+                glFinish();
+                totalMs += VROTimeCurrentMillis() - start;
+                totalDraws += *drawsPtr;
+                totalFrames++;
+            }
+        }];
+
+        const VROShadowAtlasStats &stats = atlas->getStats();
+        NSLog(@"Shadow pass, cache %s: %.1f draws/frame, %.3f ms/frame; last frame %s",
+              cached ? "on" : "off", (double) totalDraws / totalFrames, totalMs / totalFrames,
+              stats.toString().c_str());
+        XCTAssertEqual(stats.getTotalDraws(), draws);
+        XCTAssertEqual(stats.lights, kBenchmarkLights);
+        XCTAssertGreaterThan(stats.culledCasters, 0);
+        if (cached) {
+            XCTAssertEqual(stats.staticCacheHits, kBenchmarkLights);
+            XCTAssertEqual(stats.staticDraws, 0);
+        } else {
+            XCTAssertEqual(stats.staticCacheHits, 0);
+            XCTAssertGreaterThan(stats.staticDraws, 0);
+        }
+        XCTAssertEqual(glGetError(), GL_NO_ERROR);
+
+        glDeleteBuffers(1, &buffer);
+        glDeleteVertexArrays(1, &vertexArray);
+        glDeleteProgram(program);
+    }
+    [EAGLContext setCurrentContext:nil];
+}
+
+/*
+ Shadow pass cost of 8 lights over 256 casters with the static cache: only
+ the dynamic casters are drawn each frame.
+ */
+- (void)testPerformanceShadowPassCached {
+    [self shadowPassPerformanceWithCache:YES];
+}
+
+/*
+ The same shadow pass with the static cache invalidated every frame, for
+ comparison with testPerformanceShadowPassCached.
+ */
+- (void)testPerformanceShadowPassUncached {
+    [self shadowPassPerformanceWithCache:NO];
+}
+
+@end
@@ -0,0 +1,343 @@
+//
+//  VROSkinningPaletteTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROSkinningPalette.h>
+#include <ViroKit/VROQuaternion.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+static const int kBones = 60;
+static const int kCharacters = 50;
+
+/*
+ A humanoid-sized hierarchy: a spine of 10 bones with five 10-bone chains
+ (limbs and head) hanging off it.
+ */
+static std::shared_ptr<VROSkinningRig> createHumanoidRig() {
+    std::vector<int> parents(kBones);
+    std::vector<VROBonePose> rest(kBones);
+    for (int i = 0; i < kBones; i++) {
+        if (i < 10) {
+            parents[i] = i - 1;
+        } else {
+            parents[i] = (i % 10 == 0) ? (i / 10) * 2 - 1 : i - 1;
+        }
+        rest[i].translation[1] = 0.1f;
+    }
+    std::vector<VROMatrix4f> binds(kBones, VROMatrix4f::identity());
+    return VROSkinningRig::create(parents, rest, binds);
+}
+
+static void fillPoses(std::vector<VROBonePose> &poses, float phase) {
+    for (int i = 0; i < (int) poses.size(); i++) {
+        float angle = 0.3f * sinf(phase + i * 0.17f);
+        poses[i].translation[1] = 0.1f;
+        poses[i].rotation[0] = sinf(angle * 0.5f);
+        poses[i].rotation[3] = cosf(angle * 0.5f);
+    }
+}
+
+static VROBonePose createPose(float tx, float ty, float tz, VROQuaternion rotation, float sx, float sy, float sz) {
+    VROBonePose pose;
+    pose.translation[0] = tx;
+    pose.translation[1] = ty;
+    pose.translation[2] = tz;
+    pose.rotation[0] = rotation.X;
+    pose.rotation[1] = rotation.Y;
+    pose.rotation[2] = rotation.Z;
+    pose.rotation[3] = rotation.W;
+    pose.scale[0] = sx;
+    pose.scale[1] = sy;
+    pose.scale[2] = sz;
+    return pose;
+}
+
+static VROQuaternion axisAngle(float x, float y, float z, float angle) {
+    float length = sqrtf(x * x + y * y + z * z);
+    float s = sinf(angle * 0.5f) / length;
+    return VROQuaternion(x * s, y * s, z * s, cosf(angle * 0.5f));
+}
+
+/*
+ A branching eight-bone rig with rotated, translated bind transforms, and a
+ pose that rotates every bone about a different axis. Bone 7, a leaf, is
+ scaled non-uniformly and has a translation-only bind transform, so its
+ skinning transform has no shear.
+ */
+struct TestRig {
+    std::vector<int> parents = { -1, 0, 1, 1, 3, 0, 5, 6 };
+    std::vector<VROBonePose> poses;
+    std::vector<VROMatrix4f> binds;
+    std::shared_ptr<VROSkinningRig> rig;
+
+    TestRig() {
+        for (int i = 0; i < (int) parents.size(); i++) {
+            float uniform = 1.0f + 0.05f * (i % 3);
+            if (i == 7) {
+                poses.push_back(createPose(0.1f, 0.3f, 0, axisAngle(1, 1, 0, 0.4f), 1.5f, 0.5f, 2.0f));
+            } else {
+                poses.push_back(createPose(0.1f * i, 0.25f, -0.05f * i, axisAngle(i % 2, 1, i % 3, 0.2f + 0.15f * i),
+                                           uniform, uniform, uniform));
+            }
+            VROMatrix4f bind;
+            if (i != 7) {
+                bind.rotateY(0.3f * i);
+            }
+            bind.translate(0.02f * i, -0.25f * i, 0.05f);
+            binds.push_back(bind);
+        }
+        rig = VROSkinningRig::create(parents, poses, binds);
+    }
+};
+
+/*
+ The transform VROSkinner::getModelTransform() computes for a local bone:
+ the bone's local transform (T * R * S) concatenated with its ancestors',
+ then its bind transform. Built with VROMatrix4f and VROQuaternion rather
+ than the palette's affine code.
+ */
+static VROMatrix4f getLocalTransform(const VROBonePose &pose) {
+    VROMatrix4f translation, scale;
+    translation.translate(pose.translation[0], pose.translation[1], pose.translation[2]);
+    scale.scale(pose.scale[0], pose.scale[1], pose.scale[2]);
+    VROQuaternion rotation(pose.rotation[0], pose.rotation[1], pose.rotation[2], pose.rotation[3]);
+    return translation.multiply(rotation.getMatrix()).multiply(scale);
+}
+
+static VROMatrix4f getAnimatedTransform(const TestRig &test, int bone) {
+    VROMatrix4f transform = getLocalTransform(test.poses[bone]);
+    for (int parent = test.parents[bone]; parent >= 0; parent = test.parents[parent]) {
+        transform = getLocalTransform(test.poses[parent]).multiply(transform);
+    }
+    return transform;
+}
+
+/*
+ Decode a dual-quaternion palette entry and transform a point with it:
+ scale, then rotate by the real part, then translate by 2 * dual * conj(real).
+ */
+static VROVector3f transformDualQuaternion(const float *entry, VROVector3f point) {
+    float qx = entry[0], qy = entry[1], qz = entry[2], qw = entry[3];
+    float dx = entry[4], dy = entry[5], dz = entry[6], dw = entry[7];
+    float tx = 2 * (-dw * qx + dx * qw - dy * qz + dz * qy);
+    float ty = 2 * (-dw * qy + dx * qz + dy * qw - dz * qx);
+    float tz = 2 * (-dw * qz - dx * qy + dy * qx + dz * qw);
+    VROVector3f scaled(point.x * entry[8], point.y * entry[9], point.z * entry[10]);
+    VROVector3f rotated = VROQuaternion(qx, qy, qz, qw).getMatrix().multiply(scaled);
+    return VROVector3f(rotated.x + tx, rotated.y + ty, rotated.z + tz);
+}
+
+static VROVector3f transformMatrixEntry(const float *entry, VROVector3f point) {
+    return VROVector3f(entry[0] * point.x + entry[1] * point.y + entry[2] * point.z + entry[3],
+                       entry[4] * point.x + entry[5] * point.y + entry[6] * point.z + entry[7],
+                       entry[8] * point.x + entry[9] * point.y + entry[10] * point.z + entry[11]);
+}
+
+@interface VROSkinningPaletteTests : XCTestCase
+
+@end
+
+@implementation VROSkinningPaletteTests
+
+/*
+ With identity bind transforms and untransformed local bones, each bone's
+ palette translation is the sum of its ancestors' local translations.
+ */
+- (void)testChainAccumulatesTranslation {
+    std::vector<int> parents = { -1, 0, 1, 2 };
+    std::vector<VROBonePose> rest(4);
+    for (int i = 0; i < 4; i++) {
+        rest[i].translation[0] = 1.0f + i;
+    }
+    std::vector<VROMatrix4f> binds(4, VROMatrix4f::identity());
+    std::shared_ptr<VROSkinningRig> rig = VROSkinningRig::create(parents, rest, binds);
+    XCTAssert(rig != nullptr);
+
+    VROSkinningPalette palette(rig);
+    palette.compute(nullptr, 0);
+    const float *out = palette.getPalette();
+    float expected = 0;
+    for (int i = 0; i < 4; i++) {
+        expected += 1.0f + i;
+        XCTAssertEqualWithAccuracy(out[i * kSkinningPaletteFloatsPerBone + 3], expected, 1e-5);
+    }
+}
+
+/*
+ For local bones, each palette entry matches the transform
+ VROSkinner::getModelTransform() builds: ancestors' local transforms, the
+ bone's own, then its bind transform.
+ */
+- (void)testMatchesSkinnerModelTransform {
+    TestRig test;
+    XCTAssert(test.rig != nullptr);
+    std::vector<float> weights = test.rig->createLayerWeights(1.0f, {});
+    VROSkinningLayer layer = { test.poses.data(), weights.data() };
+
+    VROSkinningPalette palette(test.rig);
+    palette.compute(&layer, 1);
+    for (int bone = 0; bone < (int) test.parents.size(); bone++) {
+        VROMatrix4f animated = getAnimatedTransform(test, bone);
+        VROMatrix4f expected = animated.multiply(test.binds[bone]);
+        const float *entry = &palette.getPalette()[bone * kSkinningPaletteFloatsPerBone];
+        VROMatrix4f model = palette.getModelTransform(bone);
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 4; c++) {
+                XCTAssertEqualWithAccuracy(entry[r * 4 + c], expected[c * 4 + r], 1e-5, @"bone %d", bone);
+                XCTAssertEqualWithAccuracy(model[c * 4 + r], animated[c * 4 + r], 1e-5, @"bone %d", bone);
+            }
+        }
+    }
+}
+
+/*
+ The dual-quaternion palette moves points exactly as the matrix palette
+ does, including the non-uniformly scaled leaf, and each entry is a unit
+ dual quaternion (unit real part, orthogonal to the dual part).
+ */
+- (void)testDualQuaternionMatchesMatrix {
+    TestRig test;
+    std::vector<float> weights = test.rig->createLayerWeights(1.0f, {});
+    VROSkinningLayer layer = { test.poses.data(), weights.data() };
+
+    VROSkinningPalette matrices(test.rig, VROSkinningPaletteFormat::Matrix);
+    VROSkinningPalette dualQuaternions(test.rig, VROSkinningPaletteFormat::DualQuaternion);
+    matrices.compute(&layer, 1);
+    dualQuaternions.compute(&layer, 1);
+    XCTAssertEqual(dualQuaternions.getPaletteSize(), matrices.getPaletteSize());
+
+    const VROVector3f points[] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, -0.5f, 0.25f }, { 0.3f, 0.7f, -1.2f } };
+    for (int bone = 0; bone < (int) test.parents.size(); bone++) {
+        const float *matrix = &matrices.getPalette()[bone * kSkinningPaletteFloatsPerBone];
+        const float *dq = &dualQuaternions.getPalette()[bone * kSkinningPaletteFloatsPerBone];
+
+        float realLength = dq[0] * dq[0] + dq[1] * dq[1] + dq[2] * dq[2] + dq[3] * dq[3];
+        float realDotDual = dq[0] * dq[4] + dq[1] * dq[5] + dq[2] * dq[6] + dq[3] * dq[7];
+        XCTAssertEqualWithAccuracy(realLength, 1.0f, 1e-5, @"bone %d", bone);
+        XCTAssertEqualWithAccuracy(realDotDual, 0.0f, 1e-5, @"bone %d", bone);
+        XCTAssertEqual(dq[11], 0.0f);
+
+        for (VROVector3f point : points) {
+            VROVector3f expected = transformMatrixEntry(matrix, point);
+            VROVector3f actual = transformDualQuaternion(dq, point);
+            XCTAssertEqualWithAccuracy(actual.x, expected.x, 1e-4, @"bone %d", bone);
+            XCTAssertEqualWithAccuracy(actual.y, expected.y, 1e-4, @"bone %d", bone);
+            XCTAssertEqualWithAccuracy(actual.z, expected.z, 1e-4, @"bone %d", bone);
+        }
+    }
+}
+
+/*
+ Two layers weighted 1 and 3: translations average linearly, rotations are
+ normalized-lerped (0 and 90 degrees about z blend to 2 * atan(3 sin 45 /
+ (1 + 3 cos 45)) = 68.4 degrees), and a layer given the opposite-sign
+ quaternion for the same rotation blends identically. A per-bone weight of
+ zero leaves bone 1 on the first layer, and bones no layer weights keep the
+ rest pose.
+ */
+- (void)testLayerBlending {
+    std::vector<int> parents = { -1, 0, 1 };
+    std::vector<VROBonePose> rest(3, createPose(0, 0.5f, 0, VROQuaternion(0, 0, 0, 1), 1, 1, 1));
+    std::vector<VROMatrix4f> binds(3, VROMatrix4f::identity());
+    std::shared_ptr<VROSkinningRig> rig = VROSkinningRig::create(parents, rest, binds);
+
+    std::vector<VROBonePose> still(3, createPose(1, 0, 0, VROQuaternion(0, 0, 0, 1), 1, 1, 1));
+    std::vector<VROBonePose> turned(3, createPose(3, 0, 0, axisAngle(0, 0, 1, M_PI_2), 1, 1, 1));
+    std::vector<VROBonePose> turnedNegated = turned;
+    for (VROBonePose &pose : turnedNegated) {
+        for (int i = 0; i < 4; i++) {
+            pose.rotation[i] = -pose.rotation[i];
+        }
+    }
+    std::vector<float> stillWeights = rig->createLayerWeights(1.0f, { { 2, 0.0f } });
+    std::vector<float> turnedWeights = rig->createLayerWeights(3.0f, { { 1, 0.0f }, { 2, 0.0f } });
+
+    const float angle = 2 * atanf(3 * sinf(M_PI_4) / (1 + 3 * cosf(M_PI_4)));
+    XCTAssertEqualWithAccuracy(angle * 180 / M_PI, 68.4, 0.1);
+
+    for (const std::vector<VROBonePose> *second : { &turned, &turnedNegated }) {
+        VROSkinningLayer layers[2] = { { still.data(), stillWeights.data() }, { second->data(), turnedWeights.data() } };
+        VROSkinningPalette palette(rig);
+        palette.compute(layers, 2);
+
+        // Bone 0 blends both layers
+        VROMatrix4f root = palette.getModelTransform(0);
+        XCTAssertEqualWithAccuracy(root[12], 2.5f, 1e-5);
+        XCTAssertEqualWithAccuracy(root[13], 0.0f, 1e-5);
+        XCTAssertEqualWithAccuracy(root[0], cosf(angle), 1e-5);
+        XCTAssertEqualWithAccuracy(root[1], sinf(angle), 1e-5);
+
+        // Bone 1 follows only the first layer: one unit along the root's x axis
+        VROMatrix4f child = palette.getModelTransform(1);
+        XCTAssertEqualWithAccuracy(child[12], 2.5f + cosf(angle), 1e-5);
+        XCTAssertEqualWithAccuracy(child[13], sinf(angle), 1e-5);
+        XCTAssertEqualWithAccuracy(child[0], cosf(angle), 1e-5);
+
+        // Bone 2 has no weight in either layer: rest pose, half a unit along the child's y axis
+        VROMatrix4f leaf = palette.getModelTransform(2);
+        XCTAssertEqualWithAccuracy(leaf[12], child[12] - 0.5f * sinf(angle), 1e-5);
+        XCTAssertEqualWithAccuracy(leaf[13], child[13] + 0.5f * cosf(angle), 1e-5);
+    }
+}
+
+- (void)testRejectsCycle {
+    std::vector<int> parents = { 1, 0 };
+    std::vector<VROBonePose> rest(2);
+    std::vector<VROMatrix4f> binds(2, VROMatrix4f::identity());
+    XCTAssert(VROSkinningRig::create(parents, rest, binds) == nullptr);
+}
+
+/*
+ Palettes for 50 characters of 60 bones, each blending two layers, per
+ frame.
+ */
+- (void)testPerformance50Characters {
+    std::shared_ptr<VROSkinningRig> rig = createHumanoidRig();
+    XCTAssert(rig != nullptr);
+
+    std::vector<float> fullWeights = rig->createLayerWeights(1.0f, {});
+    std::vector<float> halfWeights = rig->createLayerWeights(0.5f, {});
+    std::vector<std::vector<VROBonePose>> walk(kCharacters, std::vector<VROBonePose>(kBones));
+    std::vector<std::vector<VROBonePose>> wave(kCharacters, std::vector<VROBonePose>(kBones));
+    std::vector<std::unique_ptr<VROSkinningPalette>> palettes;
+    std::vector<std::vector<VROSkinningLayer>> layers(kCharacters);
+    std::vector<VROSkinningPalette::Job> jobs;
+    for (int c = 0; c < kCharacters; c++) {
+        fillPoses(walk[c], c * 0.1f);
+        fillPoses(wave[c], c * 0.3f + 1.0f);
+        palettes.emplace_back(new VROSkinningPalette(rig));
+        layers[c] = { { walk[c].data(), fullWeights.data() }, { wave[c].data(), halfWeights.data() } };
+        jobs.push_back({ palettes[c].get(), layers[c].data(), 2 });
+    }
+
+    [self measureBlock:^{
+        VROSkinningPalette::computeAll(jobs);
+    }];
+}
+
+@end
@@ -0,0 +1,169 @@
+//
+//  VROTSDFVolumeTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROTSDFVolume.h>
+#include <ViroKit/VRODepthSequence.h>
+#include <cmath>
+#include <algorithm>
+
+// room_orbit.vrds: 24 frames orbiting the cube, then 6 facing the +x wall
+static const int kOrbitFrames = 24;
+
+/*
+ Distance from a point to the nearest surface of the scene the fixture was
+ rendered from (see Fixtures/generate_depth_sequence.py): a 4 x 2.5 x 4 m
+ room with its floor at y = 0 and a 0.6 m cube standing at its center.
+ */
+static float sceneDistance(VROVector3f p) {
+    float room = std::min({ 2.0f - fabsf(p.x), 2.0f - fabsf(p.z), p.y, 2.5f - p.y });
+    float dx = fabsf(p.x) - 0.3f;
+    float dy = fabsf(p.y - 0.3f) - 0.3f;
+    float dz = fabsf(p.z) - 0.3f;
+    float ox = std::max(dx, 0.0f), oy = std::max(dy, 0.0f), oz = std::max(dz, 0.0f);
+    float cube = sqrtf(ox * ox + oy * oy + oz * oz) + std::min(std::max({ dx, dy, dz }), 0.0f);
+    return std::min(fabsf(room), fabsf(cube));
+}
+
+static bool onCube(VROVector3f p) {
+    return fabsf(p.x) < 0.35f && p.y > 0.05f && p.y < 0.65f && fabsf(p.z) < 0.35f;
+}
+
+static int countCubeVertices(const VROTSDFVolume &volume) {
+    int count = 0;
+    volume.forEachBlockMesh([&count](int64_t key, const VROTSDFBlockMesh &mesh) {
+        for (const VROVector3f &v : mesh.vertices) {
+            if (onCube(v)) {
+                count++;
+            }
+        }
+    });
+    return count;
+}
+
+@interface VROTSDFVolumeTests : XCTestCase
+
+@end
+
+@implementation VROTSDFVolumeTests {
+    std::shared_ptr<VRODepthSequence> _sequence;
+}
+
+- (void)setUp {
+    [super setUp];
+    NSString *path = [[NSBundle bundleForClass:[self class]] pathForResource:@"room_orbit" ofType:@"vrds"];
+    XCTAssertNotNil(path);
+    _sequence = VRODepthSequence::open(std::string([path UTF8String]));
+    XCTAssert(_sequence);
+    XCTAssertEqual(_sequence->getFrameCount(), 30);
+}
+
+/*
+ The fused mesh lies on the analytic surfaces the depth was rendered from.
+ Vertices are within a voxel of the scene on average; the few outliers sit
+ on the room's corners and the cube's silhouette.
+ */
+- (void)testMeshMatchesScene {
+    VROTSDFVolume volume;
+    for (int f = 0; f < kOrbitFrames; f++) {
+        volume.integrate(_sequence->getFrame(f));
+    }
+    volume.extractMeshes();
+    XCTAssert(volume.getStats().triangleCount > 0);
+
+    int count = 0, outliers = 0;
+    float total = 0;
+    volume.forEachBlockMesh([&](int64_t key, const VROTSDFBlockMesh &mesh) {
+        for (const VROVector3f &v : mesh.vertices) {
+            float distance = sceneDistance(v);
+            total += distance;
+            count++;
+            if (distance > volume.getConfig().voxelSize) {
+                outliers++;
+            }
+        }
+    });
+    XCTAssert(count > 0);
+    XCTAssertLessThan(total / count, 0.01f);
+    XCTAssertLessThan(outliers, count / 50);
+
+    // Inside the cube is behind the surface, above it is in front
+    XCTAssertLessThan(volume.getDistance(VROVector3f(0.02f, 0.56f, 0.02f)), 0.0f);
+    XCTAssertGreaterThan(volume.getDistance(VROVector3f(0.02f, 0.66f, 0.02f)), 0.0f);
+}
+
+/*
+ The cube keeps its geometry after the camera turns away from it.
+ */
+- (void)testSurfacePersistsWhenLookingAway {
+    VROTSDFVolume volume;
+    for (int f = 0; f < kOrbitFrames; f++) {
+        volume.integrate(_sequence->getFrame(f));
+    }
+    volume.extractMeshes();
+    int before = countCubeVertices(volume);
+    float distance = volume.getDistance(VROVector3f(0.02f, 0.56f, 0.02f));
+    XCTAssert(before > 0);
+
+    for (int f = kOrbitFrames; f < _sequence->getFrameCount(); f++) {
+        volume.integrate(_sequence->getFrame(f));
+    }
+    volume.extractMeshes();
+    XCTAssertEqual(countCubeVertices(volume), before);
+    XCTAssertEqual(volume.getDistance(VROVector3f(0.02f, 0.56f, 0.02f)), distance);
+}
+
+/*
+ A small block budget is never exceeded; the oldest blocks are evicted.
+ */
+- (void)testBlockBudget {
+    VROTSDFConfig config;
+    config.maxBlocks = 64;
+    VROTSDFVolume volume(config);
+
+    int evicted = 0;
+    for (int f = 0; f < _sequence->getFrameCount(); f++) {
+        volume.integrate(_sequence->getFrame(f));
+        XCTAssertLessThanOrEqual(volume.getStats().residentBlocks, config.maxBlocks);
+        evicted += volume.getStats().evictedBlocks;
+    }
+    XCTAssert(evicted > 0);
+}
+
+/*
+ Integration time per frame over the recorded orbit.
+ */
+- (void)testPerformanceIntegrateSequence {
+    VRODepthSequence *sequence = _sequence.get();
+    [self measureBlock:^{
+        VROTSDFVolume volume;
+        for (int f = 0; f < kOrbitFrames; f++) {
+            volume.integrate(sequence->getFrame(f));
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,70 @@
+//
+//  VROThreadPoolTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROThreadPool.h>
+#include <atomic>
+#include <vector>
+
+@interface VROThreadPoolTests : XCTestCase
+
+@end
+
+@implementation VROThreadPoolTests
+
+- (void)testCoversRange {
+    VROThreadPool pool(3);
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(1000, 1, [&](int start, int end) {
+        for (int i = start; i < end; i++) {
+            visits[i]++;
+        }
+    });
+    for (int i = 0; i < 1000; i++) {
+        XCTAssertEqual(visits[i].load(), 1);
+    }
+}
+
+/*
+ Nested calls run serially, including those made from chunks that run on
+ the submitting thread rather than on a worker.
+ */
+- (void)testNestedParallelFor {
+    VROThreadPool pool(3);
+    std::atomic<int> total(0);
+    for (int r = 0; r < 100; r++) {
+        pool.parallelFor(64, 1, [&](int start, int end) {
+            for (int i = start; i < end; i++) {
+                pool.parallelFor(64, 1, [&](int innerStart, int innerEnd) {
+                    total += innerEnd - innerStart;
+                });
+            }
+        });
+    }
+    XCTAssertEqual(total.load(), 100 * 64 * 64);
+}
+
+@end
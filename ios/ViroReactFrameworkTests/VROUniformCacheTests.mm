@@ -0,0 +1,239 @@
+//
+//  VROUniformCacheTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROUniformCache.h>
+
+/*
+ Uniform that records what was set on it instead of calling GL.
+ */
+class VROFakeUniform : public VROUniform {
+public:
+
+    VROFakeUniform(const std::string &name, int size) :
+        VROUniform(name),
+        _value(size, 0),
+        _sets(0),
+        _resets(0) {
+        setLocation(3);
+    }
+    virtual ~VROFakeUniform() {}
+
+    void set(const void *value) {
+        memcpy(_value.data(), value, _value.size());
+        _sets++;
+    }
+    void reset() {
+        _resets++;
+    }
+
+    template <typename T>
+    T get(int index = 0) const {
+        return ((const T *) _value.data())[index];
+    }
+    int getSets() const { return _sets; }
+    int getResets() const { return _resets; }
+
+private:
+
+    std::vector<uint8_t> _value;
+    int _sets;
+    int _resets;
+
+};
+
+@interface VROUniformCacheTests : XCTestCase
+
+@end
+
+@implementation VROUniformCacheTests
+
+/*
+ Setting the value already set is skipped and counted; a new value is
+ passed through.
+ */
+- (void)testRepeatedValueIsSkipped {
+    VROUniformCacheStats stats;
+    VROFakeUniform uniform("opacity", sizeof(float));
+    VROCachedUniform cached(&uniform, VROShaderProperty::Float, 1, VROUniformFrequency::PerMaterial, &stats);
+    XCTAssertEqual(cached.getLocation(), 3);
+
+    for (int i = 0; i < 4; i++) {
+        cached.setFloat(0.5);
+    }
+    cached.setFloat(0.25);
+    XCTAssertEqual(uniform.getSets(), 2);
+    XCTAssertEqual(uniform.get<float>(), 0.25);
+    XCTAssertEqual(stats.uploads, 2);
+    XCTAssertEqual(stats.uploadsAvoided, 3);
+}
+
+/*
+ Every element of an array uniform is compared, not just the first.
+ */
+- (void)testArrayElementsAreCompared {
+    VROUniformCacheStats stats;
+    const int kLights = 4;
+    VROFakeUniform uniform("light_positions", kLights * 3 * sizeof(float));
+    VROCachedUniform cached(&uniform, VROShaderProperty::Vec3, kLights, VROUniformFrequency::PerDraw, &stats);
+
+    float positions[kLights * 3] = { 0 };
+    cached.set(positions);
+    cached.set(positions);
+    XCTAssertEqual(stats.uploadsAvoided, 1);
+
+    positions[kLights * 3 - 1] = 1;
+    cached.set(positions);
+    XCTAssertEqual(uniform.getSets(), 2);
+    XCTAssertEqual(uniform.get<float>(kLights * 3 - 1), 1);
+}
+
+/*
+ setInt() on the wrapper is cached, so integer uniforms (samplers included)
+ are not re-issued.
+ */
+- (void)testSetIntIsCached {
+    VROUniformCacheStats stats;
+    VROFakeUniform uniform("diffuse_texture", sizeof(int));
+    VROCachedUniform cached(&uniform, VROShaderProperty::Int, 1, VROUniformFrequency::PerPass, &stats);
+
+    cached.setInt(2);
+    cached.setInt(2);
+    cached.setInt(2);
+    XCTAssertEqual(uniform.getSets(), 1);
+    XCTAssertEqual(uniform.get<int>(), 2);
+    XCTAssertEqual(stats.uploadsAvoided, 2);
+}
+
+/*
+ A typed setter on an array uniform compares only the element it sets, and
+ the uniform is given the whole cached array rather than the caller's
+ single element.
+ */
+- (void)testTypedSetterComparesItsOwnSize {
+    VROUniformCacheStats stats;
+    const int kLights = 4;
+    VROFakeUniform uniform("light_positions", kLights * 3 * sizeof(float));
+    VROCachedUniform cached(&uniform, VROShaderProperty::Vec3, kLights, VROUniformFrequency::PerDraw, &stats);
+
+    float positions[kLights * 3] = { 0 };
+    positions[kLights * 3 - 1] = 7;
+    cached.set(positions);
+
+    cached.setVec3({ 0, 0, 0 });
+    XCTAssertEqual(stats.uploadsAvoided, 1);
+
+    cached.setVec3({ 1, 2, 3 });
+    XCTAssertEqual(uniform.getSets(), 2);
+    XCTAssertEqual(uniform.get<float>(2), 3);
+    XCTAssertEqual(uniform.get<float>(kLights * 3 - 1), 7);
+}
+
+/*
+ A uniform without a location is never set, so nothing is cached for it.
+ */
+- (void)testNoLocationSetsNothing {
+    VROUniformCacheStats stats;
+    VROFakeUniform uniform("unused", sizeof(float));
+    uniform.setLocation(-1);
+    VROCachedUniform cached(&uniform, VROShaderProperty::Float, 1, VROUniformFrequency::PerDraw, &stats);
+
+    cached.setFloat(1);
+    cached.setInt(1);
+    XCTAssertEqual(uniform.getSets(), 0);
+    XCTAssertEqual(stats.uploads + stats.uploadsAvoided, 0);
+}
+
+/*
+ reset() forgets the cached value, resets the wrapped uniform and picks up
+ its new location.
+ */
+- (void)testReset {
+    VROUniformCacheStats stats;
+    VROFakeUniform uniform("roughness", sizeof(float));
+    VROCachedUniform cached(&uniform, VROShaderProperty::Float, 1, VROUniformFrequency::PerMaterial, &stats);
+    cached.setFloat(0.5);
+
+    uniform.setLocation(7);
+    cached.reset();
+    XCTAssertEqual(uniform.getResets(), 1);
+    XCTAssertEqual(cached.getLocation(), 7);
+
+    cached.setFloat(0.5);
+    XCTAssertEqual(uniform.getSets(), 2);
+    XCTAssertEqual(stats.uploadsAvoided, 0);
+}
+
+/*
+ Setting the wrapped uniform directly, as the compiled shader program's
+ binders do, leaves the wrapper's copy stale: setting the wrapper's last
+ value again is skipped although the uniform now holds another. reset()
+ recovers.
+ */
+- (void)testDirectSetLeavesCacheStale {
+    VROUniformCacheStats stats;
+    VROFakeUniform uniform("metalness", sizeof(float));
+    VROCachedUniform cached(&uniform, VROShaderProperty::Float, 1, VROUniformFrequency::PerMaterial, &stats);
+
+    cached.setFloat(1);
+    uniform.setFloat(0);
+    cached.setFloat(1);
+    XCTAssertEqual(uniform.get<float>(), 0);
+    XCTAssertEqual(stats.uploadsAvoided, 1);
+
+    cached.reset();
+    cached.setFloat(1);
+    XCTAssertEqual(uniform.get<float>(), 1);
+}
+
+/*
+ Cost of setting 64 mat4 uniforms to unchanged values for 1,000 draws:
+ after the first, each set is a compare and no upload.
+ */
+- (void)testPerformanceUnchangedValues {
+    const int kUniforms = 64;
+    const int kDraws = 1000;
+    VROUniformCacheStats stats;
+    std::vector<std::shared_ptr<VROFakeUniform>> uniforms;
+    std::vector<std::shared_ptr<VROCachedUniform>> cached;
+    for (int i = 0; i < kUniforms; i++) {
+        uniforms.push_back(std::make_shared<VROFakeUniform>("transform", 16 * sizeof(float)));
+        cached.push_back(std::make_shared<VROCachedUniform>(uniforms.back().get(), VROShaderProperty::Mat4, 1,
+                                                            VROUniformFrequency::PerDraw, &stats));
+    }
+    VROMatrix4f transform = VROMatrix4f::identity();
+
+    [self measureBlock:^{
+        for (int d = 0; d < kDraws; d++) {
+            for (int i = 0; i < kUniforms; i++) {
+                cached[i]->setMat4(transform);
+            }
+        }
+    }];
+    XCTAssertEqual(uniforms[0]->getSets(), 1);
+}
+
+@end
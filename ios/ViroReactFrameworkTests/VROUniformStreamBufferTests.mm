@@ -0,0 +1,203 @@
+//
+//  VROUniformStreamBufferTests.mm
+//  ViroReactFrameworkTests
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#import <XCTest/XCTest.h>
+#include <ViroKit/VROUniformStreamBuffer.h>
+#include <cstring>
+#include <vector>
+
+/*
+ Read back a block from the buffer bound to the given binding point.
+ */
+static std::vector<float> readBlock(int bindingPoint, const VROUniformAllocation &allocation) {
+    GLint buffer = 0;
+    glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, bindingPoint, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+
+    std::vector<float> values(allocation.size / sizeof(float));
+    void *data = glMapBufferRange(GL_UNIFORM_BUFFER, allocation.offset, allocation.size, GL_MAP_READ_BIT);
+    if (data) {
+        memcpy(values.data(), data, allocation.size);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    return values;
+}
+
+/*
+ One draw's transforms (three mat4s) and material parameters (two vec4s).
+ */
+static void writeDraw(VROUniformStreamBuffer &stream, int draw,
+                      VROUniformAllocation *outTransforms, VROUniformAllocation *outMaterial) {
+    *outTransforms = stream.allocate(3 * 64);
+    *outMaterial = stream.allocate(2 * 16);
+    if (!outTransforms->isValid() || !outMaterial->isValid()) {
+        return;
+    }
+    VROStd140Writer transforms(*outTransforms);
+    VROMatrix4f model = VROMatrix4f::identity();
+    model.translate((float) draw, 0, 0);
+    transforms.writeMat4(model);
+    transforms.writeMat4(VROMatrix4f::identity());
+    transforms.writeMat4(VROMatrix4f::identity());
+
+    VROStd140Writer material(*outMaterial);
+    material.writeVec4(VROVector4f(1, 0, 0, 1));
+    material.writeVec4(VROVector4f((float) draw, 0.5f, 0, 0));
+}
+
+@interface VROUniformStreamBufferTests : XCTestCase
+
+@end
+
+@implementation VROUniformStreamBufferTests {
+    EAGLContext *_context;
+}
+
+- (void)setUp {
+    [super setUp];
+    _context = [[EAGLContext alloc] initWithAPI:kEAGLRenderingAPIOpenGLES3];
+    XCTAssertNotNil(_context);
+    [EAGLContext setCurrentContext:_context];
+}
+
+- (void)tearDown {
+    [EAGLContext setCurrentContext:nil];
+    _context = nil;
+    [super tearDown];
+}
+
+/*
+ Blocks are aligned, uploaded on commit and readable from the bound range;
+ rebinding the bound range is elided.
+ */
+- (void)testStreamsBlocks {
+    VROUniformStreamBuffer stream;
+    stream.beginFrame();
+    VROUniformAllocation transforms, material;
+    writeDraw(stream, 7, &transforms, &material);
+    XCTAssert(transforms.isValid() && material.isValid());
+    XCTAssertEqual(transforms.offset % stream.getAlignment(), 0);
+    XCTAssertEqual(material.offset % stream.getAlignment(), 0);
+
+    stream.commit();
+    stream.bind(transforms, kStreamedTransformsUBOBindingPoint);
+    stream.bind(material, kStreamedMaterialUBOBindingPoint);
+    stream.bind(material, kStreamedMaterialUBOBindingPoint);
+    XCTAssertEqual(stream.getStats().bindCalls, 2);
+    XCTAssertEqual(stream.getStats().bindsElided, 1);
+    XCTAssertEqual(glGetError(), GL_NO_ERROR);
+
+    std::vector<float> model = readBlock(kStreamedTransformsUBOBindingPoint, transforms);
+    XCTAssertEqual(model[12], 7.0f);
+    XCTAssertEqual(model[15], 1.0f);
+    std::vector<float> parameters = readBlock(kStreamedMaterialUBOBindingPoint, material);
+    XCTAssertEqual(parameters[0], 1.0f);
+    XCTAssertEqual(parameters[4], 7.0f);
+    XCTAssertEqual(parameters[5], 0.5f);
+    stream.endFrame();
+}
+
+/*
+ Uploading the frame's blocks leaves no buffer bound to GL_UNIFORM_BUFFER.
+ */
+- (void)testCommitUnbindsBuffer {
+    VROUniformStreamBuffer stream;
+    stream.beginFrame();
+    VROUniformAllocation transforms, material;
+    writeDraw(stream, 0, &transforms, &material);
+    stream.commit();
+
+    GLint bound = -1;
+    glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &bound);
+    XCTAssertEqual(bound, 0);
+    XCTAssertEqual(stream.getStats().fenceTimeouts, 0);
+    stream.endFrame();
+}
+
+/*
+ A frame that overflows its segment gets invalid allocations, and the
+ buffer grows at the next frame.
+ */
+- (void)testOverflowGrowsBuffer {
+    VROUniformStreamBuffer stream(1024);
+    stream.beginFrame();
+    int segmentSize = stream.getSegmentSize();
+    XCTAssertFalse(stream.allocate(segmentSize * 2).isValid());
+    XCTAssertEqual(stream.getStats().overflows, 1);
+    stream.endFrame();
+
+    stream.beginFrame();
+    XCTAssertGreaterThanOrEqual(stream.getSegmentSize(), segmentSize * 2);
+    XCTAssert(stream.allocate(segmentSize * 2).isValid());
+    stream.endFrame();
+}
+
+/*
+ Successive frames rotate through the segments without stalling once the
+ GPU has finished with them.
+ */
+- (void)testSegmentsRotate {
+    VROUniformStreamBuffer stream;
+    std::vector<int> offsets;
+    for (int frame = 0; frame < kUniformStreamSegments + 1; frame++) {
+        stream.beginFrame();
+        VROUniformAllocation transforms, material;
+        writeDraw(stream, frame, &transforms, &material);
+        offsets.push_back(transforms.offset);
+        stream.endFrame();
+        glFinish();
+    }
+    XCTAssertEqual(offsets[1] - offsets[0], stream.getSegmentSize());
+    XCTAssertEqual(offsets[kUniformStreamSegments], offsets[0]);
+    XCTAssertEqual(stream.getLastFrameStats().fenceWaits, 0);
+}
+
+/*
+ CPU submit cost of 500 draws per frame on a real context: allocation,
+ std140 writes, one upload and two binds per draw.
+ */
+- (void)testPerformance500Draws {
+    VROUniformStreamBuffer stream(512 * 1024);
+    VROUniformStreamBuffer *streamPtr = &stream;
+    [self measureBlock:^{
+        for (int frame = 0; frame < 10; frame++) {
+            streamPtr->beginFrame();
+            std::vector<VROUniformAllocation> allocations(1000);
+            for (int draw = 0; draw < 500; draw++) {
+                writeDraw(*streamPtr, draw, &allocations[draw * 2], &allocations[draw * 2 + 1]);
+            }
+            streamPtr->commit();
+            for (int draw = 0; draw < 500; draw++) {
+                streamPtr->bind(allocations[draw * 2], kStreamedTransformsUBOBindingPoint);
+                streamPtr->bind(allocations[draw * 2 + 1], kStreamedMaterialUBOBindingPoint);
+            }
+            streamPtr->endFrame();
+        }
+        glFinish();
+    }];
+}
+
+@end
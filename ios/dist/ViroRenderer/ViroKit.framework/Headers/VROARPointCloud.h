@@ -28,6 +28,7 @@
 
 #include <cstdint>
 #include <vector>
+#include <utility>
 #include "VROVector4f.h"
 
 class VROMatrix3f;
@@ -37,8 +38,8 @@ class VROARPointCloud {
 public:
     VROARPointCloud() {}
     VROARPointCloud(std::vector<VROVector4f> points, std::vector<uint64_t> identifiers) :
-    _points(points),
-    _identifiers(identifiers) {}
+    _points(std::move(points)),
+    _identifiers(std::move(identifiers)) {}
     
     ~VROARPointCloud() {}
     
@@ -46,7 +47,7 @@ public:
      Retrieves the point that make up this point cloud. Note: the 4th value in the
      vector is a "confidence" value only available on Android.
      */
-    std::vector<VROVector4f> getPoints() {
+    const std::vector<VROVector4f> &getPoints() const {
         return _points;
     }
     
@@ -54,7 +55,7 @@ public:
      Retrieves the identifiers corresponding to each point. Note: iOS only (it's empty
      on Android).
      */
-    std::vector<uint64_t> getIdentifiers() {
+    const std::vector<uint64_t> &getIdentifiers() const {
         return _identifiers;
     }
     
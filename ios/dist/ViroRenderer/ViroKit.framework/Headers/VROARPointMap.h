@@ -0,0 +1,394 @@
+//
+//  VROARPointMap.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROARPointMap_h
+#define VROARPointMap_h
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include "VROARPointCloud.h"
+#include "VROVector3f.h"
+#include "VROTime.h"
+
+/**
+ * Configuration for VROARPointMap.
+ */
+struct VROARPointMapConfig {
+    float cellSize = 0.1f;              // Edge length of a spatial hash cell in meters
+    float mergeDistance = 0.01f;        // Points without identifiers closer than this are merged
+    int maxAgeFrames = 120;             // Points unseen for this many updates are removed
+    int maxPoints = 20000;              // Oldest points are removed beyond this count
+};
+
+/**
+ * Statistics from the last VROARPointMap update.
+ */
+struct VROARPointMapStats {
+    int pointCount = 0;                 // Points in the map
+    int cellCount = 0;                  // Occupied spatial hash cells
+    int insertedPoints = 0;             // New points added by the last update
+    int mergedPoints = 0;               // Observations folded into existing points
+    int removedPoints = 0;              // Points aged out or evicted by the last update
+    double updateTimeMs = 0.0;          // Time spent in the last update
+};
+
+/**
+ * VROARPointMap accumulates the feature points of successive
+ * VROARPointClouds into a persistent map, indexed by a spatial hash grid.
+ *
+ * On iOS, points are deduplicated by their ARKit identifier and their position
+ * is refined as a running average. On Android, where there are no identifiers,
+ * observations within mergeDistance of an existing point are merged into it.
+ * Points that are not observed for maxAgeFrames updates are removed.
+ *
+ * Points are stored in dense, parallel arrays that are exposed by const
+ * reference, so consumers (hit-test fallback, capture) read them without
+ * per-frame copies. Removal swaps the last point into the freed slot, so
+ * indices are only stable until the next update().
+ *
+ * Not thread-safe; update and query from the same thread.
+ */
+class VROARPointMap {
+public:
+
+    VROARPointMap(VROARPointMapConfig config = VROARPointMapConfig()) :
+        _config(config), _frame(0), _nextSyntheticIdentifier(kSyntheticIdentifierBit) {}
+    virtual ~VROARPointMap() {}
+
+    /**
+     * Merge the given point cloud into the map. Points are in world space.
+     */
+    void update(const VROARPointCloud &cloud) {
+        double startTime = VROTimeCurrentMillis();
+        _frame++;
+        _stats.insertedPoints = 0;
+        _stats.mergedPoints = 0;
+        _stats.removedPoints = 0;
+
+        const std::vector<VROVector4f> &points = cloud.getPoints();
+        const std::vector<uint64_t> &identifiers = cloud.getIdentifiers();
+        bool hasIdentifiers = identifiers.size() == points.size();
+
+        for (size_t i = 0; i < points.size(); i++) {
+            const VROVector4f &p = points[i];
+            VROVector3f position(p.x, p.y, p.z);
+            float confidence = hasIdentifiers ? 1.0f : p.w;
+
+            int index = -1;
+            if (hasIdentifiers) {
+                auto it = _identifierIndex.find(identifiers[i]);
+                if (it != _identifierIndex.end()) {
+                    index = it->second;
+                }
+            }
+            else {
+                index = findNearest(position, _config.mergeDistance);
+            }
+
+            if (index >= 0) {
+                mergePoint(index, position, confidence);
+                _stats.mergedPoints++;
+            }
+            else {
+                uint64_t identifier = hasIdentifiers ? identifiers[i] : _nextSyntheticIdentifier++;
+                insertPoint(identifier, position, confidence);
+                _stats.insertedPoints++;
+            }
+        }
+
+        removeStalePoints();
+
+        _stats.pointCount = (int) _positions.size();
+        _stats.cellCount = (int) _cells.size();
+        _stats.updateTimeMs = VROTimeCurrentMillis() - startTime;
+    }
+
+    /**
+     * Append to outIndices the index of every point within radius of center.
+     */
+    void findWithinRadius(VROVector3f center, float radius, std::vector<int> &outIndices) const {
+        float radiusSquared = radius * radius;
+        int minX = cellCoordinate(center.x - radius), maxX = cellCoordinate(center.x + radius);
+        int minY = cellCoordinate(center.y - radius), maxY = cellCoordinate(center.y + radius);
+        int minZ = cellCoordinate(center.z - radius), maxZ = cellCoordinate(center.z + radius);
+
+        for (int z = minZ; z <= maxZ; z++) {
+            for (int y = minY; y <= maxY; y++) {
+                for (int x = minX; x <= maxX; x++) {
+                    auto it = _cells.find(packCell(x, y, z));
+                    if (it == _cells.end()) {
+                        continue;
+                    }
+                    for (int index : it->second) {
+                        if (distanceSquared(_positions[index], center) <= radiusSquared) {
+                            outIndices.push_back(index);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Find the k points nearest to center, no farther than maxDistance. The
+     * indices are written to outIndices sorted by increasing distance.
+     */
+    void findNearest(VROVector3f center, int k, float maxDistance, std::vector<int> &outIndices) const {
+        outIndices.clear();
+        if (k <= 0 || _positions.empty()) {
+            return;
+        }
+
+        // Search growing shells of cells around the center cell, stopping once
+        // the next shell is farther than the current k-th candidate
+        std::vector<std::pair<float, int>> &candidates = _candidates;
+        candidates.clear();
+        int cx = cellCoordinate(center.x), cy = cellCoordinate(center.y), cz = cellCoordinate(center.z);
+        int maxRing = (int) ceilf(maxDistance / _config.cellSize);
+        float maxDistanceSquared = maxDistance * maxDistance;
+
+        for (int ring = 0; ring <= maxRing; ring++) {
+            if ((int) candidates.size() >= k) {
+                std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+                float shellDistance = (ring - 1) * _config.cellSize;
+                if (candidates[k - 1].first <= shellDistance * shellDistance) {
+                    break;
+                }
+            }
+            for (int z = cz - ring; z <= cz + ring; z++) {
+                for (int y = cy - ring; y <= cy + ring; y++) {
+                    bool faceYZ = (z == cz - ring || z == cz + ring || y == cy - ring || y == cy + ring);
+                    for (int x = cx - ring; x <= cx + ring; x += (faceYZ ? 1 : 2 * ring)) {
+                        auto it = _cells.find(packCell(x, y, z));
+                        if (it != _cells.end()) {
+                            for (int index : it->second) {
+                                float d = distanceSquared(_positions[index], center);
+                                if (d <= maxDistanceSquared) {
+                                    candidates.push_back({ d, index });
+                                }
+                            }
+                        }
+                        if (ring == 0) {
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        int count = std::min(k, (int) candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+        for (int i = 0; i < count; i++) {
+            outIndices.push_back(candidates[i].second);
+        }
+    }
+
+    /**
+     * Index of the nearest point within maxDistance of center, or -1.
+     */
+    int findNearest(VROVector3f center, float maxDistance) const {
+        std::vector<int> &result = _nearest;
+        findNearest(center, 1, maxDistance, result);
+        return result.empty() ? -1 : result[0];
+    }
+
+    int getPointCount() const { return (int) _positions.size(); }
+
+    /*
+     Dense per-point arrays. Index i refers to the same point in each.
+     */
+    const std::vector<VROVector3f> &getPositions() const { return _positions; }
+    const std::vector<uint64_t> &getIdentifiers() const { return _identifiers; }
+    const std::vector<float> &getConfidences() const { return _confidences; }
+    const std::vector<int> &getObservationCounts() const { return _observations; }
+
+    void clear() {
+        _positions.clear();
+        _identifiers.clear();
+        _confidences.clear();
+        _observations.clear();
+        _lastSeenFrames.clear();
+        _cellSlots.clear();
+        _identifierIndex.clear();
+        _cells.clear();
+        _stats = VROARPointMapStats();
+    }
+
+    const VROARPointMapStats &getStats() const { return _stats; }
+
+private:
+
+    /*
+     Identifiers assigned to points from clouds without identifiers (Android)
+     have the high bit set so they do not collide with ARKit identifiers.
+     */
+    static const uint64_t kSyntheticIdentifierBit = 1ULL << 63;
+
+    VROARPointMapConfig _config;
+    uint64_t _frame;
+    uint64_t _nextSyntheticIdentifier;
+
+    std::vector<VROVector3f> _positions;
+    std::vector<uint64_t> _identifiers;
+    std::vector<float> _confidences;
+    std::vector<int> _observations;
+    std::vector<uint64_t> _lastSeenFrames;
+
+    /*
+     Cell of each point, and the point's position within that cell's list.
+     */
+    std::vector<std::pair<int64_t, int>> _cellSlots;
+
+    std::unordered_map<uint64_t, int> _identifierIndex;
+    std::unordered_map<int64_t, std::vector<int>> _cells;
+
+    /*
+     Scratch storage reused across queries.
+     */
+    mutable std::vector<std::pair<float, int>> _candidates;
+    mutable std::vector<int> _nearest;
+
+    VROARPointMapStats _stats;
+
+    int cellCoordinate(float v) const {
+        return (int) floorf(v / _config.cellSize);
+    }
+
+    int64_t cellOf(VROVector3f p) const {
+        return packCell(cellCoordinate(p.x), cellCoordinate(p.y), cellCoordinate(p.z));
+    }
+
+    static int64_t packCell(int x, int y, int z) {
+        const int64_t mask = (1 << 21) - 1;
+        return ((int64_t) (x & mask) << 42) | ((int64_t) (y & mask) << 21) | (int64_t) (z & mask);
+    }
+
+    static float distanceSquared(const VROVector3f &a, const VROVector3f &b) {
+        float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    void insertPoint(uint64_t identifier, VROVector3f position, float confidence) {
+        int index = (int) _positions.size();
+        _positions.push_back(position);
+        _identifiers.push_back(identifier);
+        _confidences.push_back(confidence);
+        _observations.push_back(1);
+        _lastSeenFrames.push_back(_frame);
+        _cellSlots.push_back({ 0, 0 });
+        _identifierIndex[identifier] = index;
+        addToCell(index);
+    }
+
+    void mergePoint(int index, VROVector3f position, float confidence) {
+        int observations = std::min(_observations[index], 255);
+        float weight = 1.0f / (observations + 1);
+        VROVector3f &current = _positions[index];
+        current = current + (position - current) * weight;
+        _confidences[index] = std::max(_confidences[index], confidence);
+        _observations[index] = observations + 1;
+        _lastSeenFrames[index] = _frame;
+
+        if (cellOf(current) != _cellSlots[index].first) {
+            removeFromCell(index);
+            addToCell(index);
+        }
+    }
+
+    void addToCell(int index) {
+        int64_t cell = cellOf(_positions[index]);
+        std::vector<int> &list = _cells[cell];
+        _cellSlots[index] = { cell, (int) list.size() };
+        list.push_back(index);
+    }
+
+    void removeFromCell(int index) {
+        auto it = _cells.find(_cellSlots[index].first);
+        std::vector<int> &list = it->second;
+        int slot = _cellSlots[index].second;
+        int moved = list.back();
+        list[slot] = moved;
+        _cellSlots[moved].second = slot;
+        list.pop_back();
+        if (list.empty()) {
+            _cells.erase(it);
+        }
+    }
+
+    /*
+     Remove the point at index by moving the last point into its slot.
+     */
+    void removePoint(int index) {
+        removeFromCell(index);
+        _identifierIndex.erase(_identifiers[index]);
+
+        int last = (int) _positions.size() - 1;
+        if (index != last) {
+            _positions[index] = _positions[last];
+            _identifiers[index] = _identifiers[last];
+            _confidences[index] = _confidences[last];
+            _observations[index] = _observations[last];
+            _lastSeenFrames[index] = _lastSeenFrames[last];
+            _cellSlots[index] = _cellSlots[last];
+
+            _identifierIndex[_identifiers[index]] = index;
+            _cells[_cellSlots[index].first][_cellSlots[index].second] = index;
+        }
+        _positions.pop_back();
+        _identifiers.pop_back();
+        _confidences.pop_back();
+        _observations.pop_back();
+        _lastSeenFrames.pop_back();
+        _cellSlots.pop_back();
+        _stats.removedPoints++;
+    }
+
+    void removeStalePoints() {
+        for (int i = (int) _positions.size() - 1; i >= 0; i--) {
+            if (_frame - _lastSeenFrames[i] > (uint64_t) _config.maxAgeFrames) {
+                removePoint(i);
+            }
+        }
+
+        int overflow = (int) _positions.size() - _config.maxPoints;
+        if (overflow <= 0) {
+            return;
+        }
+        std::vector<std::pair<uint64_t, uint64_t>> oldest;
+        for (int i = 0; i < (int) _positions.size(); i++) {
+            oldest.push_back({ _lastSeenFrames[i], _identifiers[i] });
+        }
+        std::partial_sort(oldest.begin(), oldest.begin() + overflow, oldest.end());
+        for (int i = 0; i < overflow; i++) {
+            removePoint(_identifierIndex[oldest[i].second]);
+        }
+    }
+
+};
+
+#endif /* VROARPointMap_h */
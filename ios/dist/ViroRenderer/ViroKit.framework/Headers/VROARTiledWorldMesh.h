@@ -0,0 +1,895 @@
+//
+//  VROARTiledWorldMesh.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROARTiledWorldMesh_h
+#define VROARTiledWorldMesh_h
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include "VROARDepthMesh.h"
+#include "VROARWorldMesh.h"
+#include "VRODefines.h"
+#include "VRODepthImage.h"
+#include "VROLog.h"
+#include "VROPhysicsWorld.h"
+#include "VROPhysicsShape.h"
+#include "VROPhysicsRawBody.h"
+#include "VROThreadPool.h"
+#include "VROTime.h"
+#if VRO_PHYSICS_BULLET
+#include <btBulletDynamicsCommon.h>
+#endif
+
+/**
+ * Configuration for the tiled world mesh. Extends the world mesh settings
+ * with the tiling and change-detection parameters.
+ */
+struct VROTiledWorldMeshConfig {
+    VROWorldMeshConfig mesh;            // Stride, confidence, depth, update timing and physics settings
+
+    float tileExtent = 0.5f;            // Edge of the world-space cube each tile covers (meters)
+    float changeThreshold = 0.02f;      // Re-mesh a tile when the observed surface departs from it by more than this (meters)
+    float maxDepthDiscontinuity = 0.1f; // Reject quads whose depth range exceeds this fraction of their depth
+    int maxTiles = 1024;                // Least recently observed tiles beyond this are evicted
+};
+
+/**
+ * Statistics about the last tiled world mesh update.
+ */
+struct VROTiledWorldMeshStats {
+    int tileCount = 0;                  // Tiles created so far
+    int activeTileCount = 0;            // Tiles that currently have a collision body
+    int meshedTileCount = 0;            // Tiles that currently have triangles
+    int rebuiltTileCount = 0;           // Tiles re-meshed in the last update
+    int evictedTileCount = 0;           // Tiles evicted in the last update
+    int vertexCount = 0;                // Vertices across all tiles
+    int triangleCount = 0;              // Triangles across all tiles
+    double sampleTimeMs = 0.0;          // Time to unproject, reproject and compare depth samples
+    double rebuildTimeMs = 0.0;         // Time to re-mesh tiles and swap their collision shapes
+    bool isStale = false;               // True if depth data hasn't been received recently
+};
+
+/**
+ * VROARTiledWorldMesh is an incremental alternative to VROARWorldMesh. Space
+ * is divided into fixed world-space cubes of tileExtent, each tile with its
+ * own VROARDepthMesh, triangle-mesh VROPhysicsShape and static rigid body.
+ * Tiles stay where they are as the camera moves, and keep their geometry
+ * while out of view.
+ *
+ * On each update the sampled depth grid is unprojected (in parallel) and
+ * every tile's current mesh is reprojected into the new view. A tile is
+ * re-meshed only where the two disagree by more than changeThreshold: the
+ * camera now sees past its surface, something new appears in front of it, or
+ * part of its cube is seen that it has no geometry for. Camera motion alone
+ * re-meshes nothing. A rebuilt tile keeps only the triangles this frame does
+ * not see at all (out of view or occluded), and replaces every triangle it
+ * does see with the triangles now seen in its cube, so repeated rebuilds never
+ * stack surfaces. Small per-tile BVHs are much cheaper to rebuild than the
+ * single whole-frame BVH, and unchanged tiles cost nothing in the physics
+ * world. Both the sampling and the change detection run on VROThreadPool.
+ *
+ * Updates follow the mesh config's timing like VROARWorldMesh: update() runs
+ * at most once per updateIntervalMs, and every tile is discarded once no
+ * valid depth has arrived for meshPersistenceMs. Tiles not observed recently
+ * are evicted, least recently observed first, when there are more than
+ * maxTiles.
+ *
+ * Each triangle of the frame's grid is meshed into every tile whose cube its
+ * bounds overlap, so a tile covers all of the surface it saw in its cube,
+ * up to and past the cube's faces. Neighbouring tiles therefore overlap by
+ * up to one grid cell along their shared face instead of meeting at an edge.
+ * Tiles rebuilt in the same frame hold the same triangles there. A tile
+ * rebuilt against a neighbour from an earlier frame still overlaps it, so
+ * there is no gap between them: the two surfaces can only be offset, by no
+ * more than changeThreshold, or the neighbour would have been rebuilt too.
+ *
+ * Where VRO_PHYSICS_BULLET is set, tile bodies are raw Bullet bodies stamped
+ * through VROPhysicsRawBody, with the mesh config's collisionTag and this
+ * mesh as owner, so ray, sweep and contact results can tell them apart from
+ * VROPhysicsBodies. Elsewhere, Bullet is not available and tiles carry only
+ * their VROARDepthMesh.
+ *
+ * Must be used on the rendering thread, like VROARWorldMesh.
+ */
+class VROARTiledWorldMesh {
+public:
+
+    VROARTiledWorldMesh(std::shared_ptr<VROPhysicsWorld> physicsWorld,
+                        VROTiledWorldMeshConfig config = VROTiledWorldMeshConfig()) :
+        _physicsWorld(physicsWorld), _config(config), _enabled(true),
+        _updateCount(0), _lastUpdateTimeMs(0), _lastDepthTimeMs(0),
+        _stride(1), _gridWidth(0), _gridHeight(0) {
+        passert_msg(_config.tileExtent > 0, "Tile extent must be positive, was %f", _config.tileExtent);
+        _bodyInfo.tag = _config.mesh.collisionTag;
+        _bodyInfo.owner = this;
+    }
+
+    ~VROARTiledWorldMesh() {
+        clear();
+    }
+
+    // Tile bodies point back at this mesh through _bodyInfo
+    VROARTiledWorldMesh(const VROARTiledWorldMesh &) = delete;
+    VROARTiledWorldMesh &operator=(const VROARTiledWorldMesh &) = delete;
+
+    /**
+     * Update the mesh from the given depth image. This should be called each
+     * frame; the tiles are only updated if updateIntervalMs has passed since
+     * the last update, and then rebuilt only where the observed surface
+     * changed.
+     */
+    void update(const VRODepthImage &image) {
+        if (!_enabled) {
+            return;
+        }
+        double now = VROTimeCurrentMillis();
+        if (!image.isValid()) {
+            expireIfStale(now);
+            return;
+        }
+        _lastDepthTimeMs = now;
+        _stats.isStale = false;
+        if (_lastUpdateTimeMs > 0 && now - _lastUpdateTimeMs < _config.mesh.updateIntervalMs) {
+            return;
+        }
+        forceUpdate(image);
+    }
+
+    /**
+     * Update the mesh immediately, ignoring the update interval.
+     */
+    void forceUpdate(const VRODepthImage &image) {
+        if (!_enabled) {
+            return;
+        }
+        double startTime = VROTimeCurrentMillis();
+        if (!image.isValid()) {
+            expireIfStale(startTime);
+            return;
+        }
+        _lastDepthTimeMs = startTime;
+        _lastUpdateTimeMs = startTime;
+        _stats.isStale = false;
+        _updateCount++;
+
+        int stride = std::max(1, _config.mesh.stride);
+        int gridWidth  = (image.width  - 1) / stride + 1;
+        int gridHeight = (image.height - 1) / stride + 1;
+        if (gridWidth < 2 || gridHeight < 2) {
+            return;
+        }
+        if (gridWidth != _gridWidth || gridHeight != _gridHeight) {
+            resize(gridWidth, gridHeight);
+        }
+        _stride = stride;
+        _image = image;
+        _worldToCamera = image.cameraToWorld.invert();
+
+        sampleGrid(image, stride);
+        assignTriangles();
+        detectChanges();
+        double sampleEndTime = VROTimeCurrentMillis();
+
+        std::vector<int> dirty;
+        for (int t = 0; t < (int) _tiles.size(); t++) {
+            if (_tiles[t].dirty) {
+                dirty.push_back(t);
+            }
+        }
+        VROThreadPool::shared().parallelFor((int) dirty.size(), 1, [this, &dirty](int start, int end) {
+            for (int i = start; i < end; i++) {
+                rebuild(_tiles[dirty[i]]);
+            }
+        });
+
+        // Bullet world modifications stay on the calling (rendering) thread
+        for (int t : dirty) {
+            applyTileToPhysics(_tiles[t]);
+            _tiles[t].dirty = false;
+        }
+
+        // The image's buffers are only valid during this call
+        _image = VRODepthImage();
+
+        _stats.evictedTileCount = evictTiles();
+        _stats.rebuiltTileCount = (int) dirty.size();
+        _stats.sampleTimeMs = sampleEndTime - startTime;
+        _stats.rebuildTimeMs = VROTimeCurrentMillis() - sampleEndTime;
+        updateStats();
+    }
+
+    /**
+     * Enable or disable the mesh. When disabled, all tile bodies are removed
+     * from the physics world.
+     */
+    void setEnabled(bool enabled) {
+        if (_enabled == enabled) {
+            return;
+        }
+        _enabled = enabled;
+        if (!enabled) {
+            clear();
+        }
+    }
+    bool isEnabled() const { return _enabled; }
+
+    /**
+     * Changing the tile extent discards every tile; the new tiling is built
+     * on the next update.
+     */
+    void setConfig(const VROTiledWorldMeshConfig &config) {
+        passert_msg(config.tileExtent > 0, "Tile extent must be positive, was %f", config.tileExtent);
+        bool tilingChanged = config.tileExtent != _config.tileExtent;
+        _config = config;
+        _bodyInfo.tag = config.mesh.collisionTag;
+        if (tilingChanged) {
+            clear();
+        }
+    }
+    const VROTiledWorldMeshConfig &getConfig() const { return _config; }
+
+    const VROTiledWorldMeshStats &getStats() const { return _stats; }
+
+    int getTileCount() const { return (int) _tiles.size(); }
+
+    /**
+     * The mesh of the given tile, or nullptr if the tile has no valid triangles.
+     */
+    std::shared_ptr<VROARDepthMesh> getTileMesh(int tile) const {
+        return _tiles[tile].mesh;
+    }
+
+private:
+
+    struct Tile {
+        int bx, by, bz;                         // Cube coordinates, in units of tileExtent
+
+        std::vector<VROVector3f> vertices;      // Current mesh, in world space
+        std::vector<int> indices;
+        std::vector<float> confidences;
+
+        std::vector<int> triangles;             // This frame's triangles whose bounds overlap the cube
+
+        std::shared_ptr<VROARDepthMesh> mesh;
+#if VRO_PHYSICS_BULLET
+        std::shared_ptr<VROPhysicsShape> shape;
+        std::unique_ptr<btRigidBody> rigidBody;
+        std::unique_ptr<btDefaultMotionState> motionState;
+#endif
+        bool dirty = false;
+        uint32_t lastObservedUpdate = 0;        // Last update whose frame saw this tile
+
+        Tile() {}
+        Tile(Tile &&) = default;
+        Tile &operator=(Tile &&) = default;
+        Tile(const Tile &) = delete;
+        Tile &operator=(const Tile &) = delete;
+    };
+
+    std::weak_ptr<VROPhysicsWorld> _physicsWorld;
+    VROTiledWorldMeshConfig _config;
+    bool _enabled;
+
+    uint32_t _updateCount;
+    double _lastUpdateTimeMs;
+    double _lastDepthTimeMs;
+
+    std::vector<Tile> _tiles;
+    std::unordered_map<int64_t, int> _tileIndex;
+    VROPhysicsRawBodyInfo _bodyInfo;
+
+    /*
+     The image being processed and its grid, valid during update().
+     */
+    VRODepthImage _image;
+    VROMatrix4f _worldToCamera;
+    int _stride;
+    int _gridWidth, _gridHeight;
+
+    /*
+     Current frame's samples, persistent across updates to avoid
+     reallocation. Keys are the tile cube holding each valid sample.
+     */
+    std::vector<VROVector3f> _gridPositions;
+    std::vector<float> _gridDepths;
+    std::vector<float> _gridConfidences;
+    std::vector<uint8_t> _gridValid;
+    std::vector<uint8_t> _quadValid;
+
+    /*
+     This frame's triangles, two per quad: the first is (00, 01, 10), the
+     second (10, 01, 11). Each has the range of cubes its bounds overlap,
+     valid where its quad is.
+     */
+    struct CubeRange {
+        int min[3];
+        int max[3];
+    };
+    std::vector<CubeRange> _triangleCubes;
+
+    /*
+     Existing tile meshes splatted into the current view: nearest depth and
+     its tile per grid sample, or -1 where no tile projects. Tiles are
+     splatted in parallel into _splats, which packs depth and tile so that
+     one atomic minimum keeps the nearest.
+     */
+    std::vector<float> _reprojectedDepths;
+    std::vector<int> _reprojectedTiles;
+    std::unique_ptr<std::atomic<uint64_t>[]> _splats;
+
+    VROTiledWorldMeshStats _stats;
+
+    void resize(int gridWidth, int gridHeight) {
+        _gridWidth = gridWidth;
+        _gridHeight = gridHeight;
+
+        size_t count = (size_t) gridWidth * gridHeight;
+        _gridPositions.resize(count);
+        _gridDepths.resize(count);
+        _gridConfidences.resize(count);
+        _gridValid.resize(count);
+        _reprojectedDepths.resize(count);
+        _reprojectedTiles.resize(count);
+        _splats.reset(new std::atomic<uint64_t>[count]);
+
+        size_t quadCount = (size_t) (gridWidth - 1) * (gridHeight - 1);
+        _quadValid.resize(quadCount);
+        _triangleCubes.resize(quadCount * 2);
+    }
+
+    void clear() {
+        for (Tile &tile : _tiles) {
+            removeTileFromPhysics(tile);
+        }
+        _tiles.clear();
+        _tileIndex.clear();
+        _stats = VROTiledWorldMeshStats();
+    }
+
+    /*
+     Discard every tile once no valid depth has arrived for
+     meshPersistenceMs, as VROARWorldMesh does with its mesh.
+     */
+    void expireIfStale(double now) {
+        if (_lastDepthTimeMs == 0 || now - _lastDepthTimeMs <= _config.mesh.meshPersistenceMs) {
+            return;
+        }
+        if (!_tiles.empty()) {
+            clear();
+        }
+        _stats.isStale = true;
+    }
+
+    /*
+     Remove the least recently observed tiles until no more than maxTiles
+     remain. Tiles seen in this update are never evicted. Returns the number
+     of tiles removed.
+     */
+    int evictTiles() {
+        int excess = (int) _tiles.size() - std::max(0, _config.maxTiles);
+        if (excess <= 0) {
+            return 0;
+        }
+        std::vector<int> candidates;
+        for (int t = 0; t < (int) _tiles.size(); t++) {
+            if (_tiles[t].lastObservedUpdate != _updateCount) {
+                candidates.push_back(t);
+            }
+        }
+        excess = std::min(excess, (int) candidates.size());
+        if (excess == 0) {
+            return 0;
+        }
+        std::nth_element(candidates.begin(), candidates.begin() + (excess - 1), candidates.end(), [this](int a, int b) {
+            return _tiles[a].lastObservedUpdate < _tiles[b].lastObservedUpdate;
+        });
+
+        std::vector<uint8_t> evict(_tiles.size(), 0);
+        for (int i = 0; i < excess; i++) {
+            evict[candidates[i]] = 1;
+            removeTileFromPhysics(_tiles[candidates[i]]);
+        }
+
+        // Compact the survivors and re-index them
+        int kept = 0;
+        _tileIndex.clear();
+        for (int t = 0; t < (int) _tiles.size(); t++) {
+            if (evict[t]) {
+                continue;
+            }
+            if (kept != t) {
+                _tiles[kept] = std::move(_tiles[t]);
+            }
+            const Tile &tile = _tiles[kept];
+            _tileIndex[packKey(tile.bx, tile.by, tile.bz)] = kept;
+            kept++;
+        }
+        _tiles.resize(kept);
+        return excess;
+    }
+
+    static int64_t packKey(int bx, int by, int bz) {
+        const int64_t mask = (1 << 21) - 1;
+        return ((int64_t) (bx & mask) << 42) | ((int64_t) (by & mask) << 21) | (int64_t) (bz & mask);
+    }
+
+    CubeRange cubesForTriangle(const VROVector3f &a, const VROVector3f &b, const VROVector3f &c) const {
+        float extent = _config.tileExtent;
+        CubeRange range;
+        range.min[0] = (int) floorf(std::min(std::min(a.x, b.x), c.x) / extent);
+        range.min[1] = (int) floorf(std::min(std::min(a.y, b.y), c.y) / extent);
+        range.min[2] = (int) floorf(std::min(std::min(a.z, b.z), c.z) / extent);
+        range.max[0] = (int) floorf(std::max(std::max(a.x, b.x), c.x) / extent);
+        range.max[1] = (int) floorf(std::max(std::max(a.y, b.y), c.y) / extent);
+        range.max[2] = (int) floorf(std::max(std::max(a.z, b.z), c.z) / extent);
+        return range;
+    }
+
+    int findTile(int64_t key) const {
+        auto it = _tileIndex.find(key);
+        return it == _tileIndex.end() ? -1 : it->second;
+    }
+
+    /*
+     Return the tile for the given cube, creating it (dirty, so it is meshed
+     this update) if needed.
+     */
+    int findOrCreateTile(int bx, int by, int bz) {
+        int64_t key = packKey(bx, by, bz);
+        int t = findTile(key);
+        if (t >= 0) {
+            return t;
+        }
+        Tile tile;
+        tile.bx = bx;
+        tile.by = by;
+        tile.bz = bz;
+        tile.dirty = true;
+
+        t = (int) _tiles.size();
+        _tiles.push_back(std::move(tile));
+        _tileIndex[key] = t;
+        return t;
+    }
+
+    void sampleGrid(const VRODepthImage &image, int stride) {
+        VROThreadPool::shared().parallelFor(_gridHeight, 4, [&](int start, int end) {
+            for (int gy = start; gy < end; gy++) {
+                int py = std::min(gy * stride, image.height - 1);
+                for (int gx = 0; gx < _gridWidth; gx++) {
+                    int px = std::min(gx * stride, image.width - 1);
+                    int i = gy * _gridWidth + gx;
+
+                    float depth = image.getDepth(px, py);
+                    float confidence = image.getConfidence(px, py);
+                    bool valid = std::isfinite(depth) && depth > 0 && depth <= _config.mesh.maxDepth &&
+                                 confidence >= _config.mesh.minConfidence;
+
+                    _gridDepths[i] = depth;
+                    _gridConfidences[i] = confidence;
+                    _gridValid[i] = valid;
+                    if (valid) {
+                        _gridPositions[i] = image.unprojectToWorld((float) px, (float) py, depth);
+                    }
+                }
+            }
+        });
+    }
+
+    /*
+     Validate this frame's quads, then hand each of their two triangles to
+     every tile whose cube its bounds overlap. Tiles are created here, on the
+     calling thread.
+     */
+    void assignTriangles() {
+        const int quadsX = _gridWidth - 1;
+        const float maxDiscontinuity = _config.maxDepthDiscontinuity;
+
+        VROThreadPool::shared().parallelFor(_gridHeight - 1, 4, [&](int start, int end) {
+            for (int y = start; y < end; y++) {
+                for (int x = 0; x < quadsX; x++) {
+                    int g00 = y * _gridWidth + x;
+                    int g10 = g00 + 1;
+                    int g01 = g00 + _gridWidth;
+                    int g11 = g01 + 1;
+
+                    bool valid = _gridValid[g00] && _gridValid[g10] && _gridValid[g01] && _gridValid[g11];
+                    if (valid) {
+                        float d00 = _gridDepths[g00], d10 = _gridDepths[g10];
+                        float d01 = _gridDepths[g01], d11 = _gridDepths[g11];
+                        float dMin = std::min(std::min(d00, d10), std::min(d01, d11));
+                        float dMax = std::max(std::max(d00, d10), std::max(d01, d11));
+                        valid = dMax - dMin <= maxDiscontinuity * dMin;
+                    }
+                    int q = y * quadsX + x;
+                    _quadValid[q] = valid;
+                    if (!valid) {
+                        continue;
+                    }
+
+                    const VROVector3f &p00 = _gridPositions[g00], &p10 = _gridPositions[g10];
+                    const VROVector3f &p01 = _gridPositions[g01], &p11 = _gridPositions[g11];
+                    _triangleCubes[q * 2] = cubesForTriangle(p00, p01, p10);
+                    _triangleCubes[q * 2 + 1] = cubesForTriangle(p10, p01, p11);
+                }
+            }
+        });
+
+        for (Tile &tile : _tiles) {
+            tile.triangles.clear();
+        }
+        for (int q = 0; q < (int) _quadValid.size(); q++) {
+            if (!_quadValid[q]) {
+                continue;
+            }
+            for (int triangle = q * 2; triangle < q * 2 + 2; triangle++) {
+                const CubeRange &cubes = _triangleCubes[triangle];
+                for (int bx = cubes.min[0]; bx <= cubes.max[0]; bx++) {
+                    for (int by = cubes.min[1]; by <= cubes.max[1]; by++) {
+                        for (int bz = cubes.min[2]; bz <= cubes.max[2]; bz++) {
+                            int t = findOrCreateTile(bx, by, bz);
+                            _tiles[t].triangles.push_back(triangle);
+                            _tiles[t].lastObservedUpdate = _updateCount;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+     Project a world position into the current grid. Returns false if it is
+     behind the camera or outside the image.
+     */
+    bool project(const VROVector3f &world, int *g, float *depth) const {
+        VROVector3f c = VRODepthImage::transformPoint(_worldToCamera, world);
+        float d = -c.z;
+        if (d <= 0) {
+            return false;
+        }
+        int gx = (int) floorf((_image.fx * c.x / d + _image.cx) / _stride + 0.5f);
+        int gy = (int) floorf((-_image.fy * c.y / d + _image.cy) / _stride + 0.5f);
+        if (gx < 0 || gy < 0 || gx >= _gridWidth || gy >= _gridHeight) {
+            return false;
+        }
+        *g = gy * _gridWidth + gx;
+        *depth = d;
+        return true;
+    }
+
+    /*
+     True if the current frame sees the given world position: it projects
+     into the image, the depth there is valid, and nothing is in front of it.
+     */
+    bool isObserved(const VROVector3f &world) const {
+        int g;
+        float d;
+        if (!project(world, &g, &d)) {
+            return false;
+        }
+        return _gridValid[g] && _gridDepths[g] >= d - _config.changeThreshold;
+    }
+
+    /*
+     Mark tiles dirty where the current samples disagree with the existing
+     meshes reprojected into this view. Comparing in the current view rather
+     than by grid index keeps camera motion from dirtying every tile.
+
+     Tiles are splatted in parallel, and the view is then compared in
+     parallel by rows. Each chunk collects the tiles it dirties or observes,
+     and the lists are merged once the chunk finishes.
+     */
+    void detectChanges() {
+        const int count = _gridWidth * _gridHeight;
+        const uint64_t empty = std::numeric_limits<uint64_t>::max();
+        VROThreadPool::shared().parallelFor(count, 1024, [this, empty](int start, int end) {
+            for (int g = start; g < end; g++) {
+                _splats[g].store(empty, std::memory_order_relaxed);
+            }
+        });
+
+        VROVector3f cameraPosition(_image.cameraToWorld[12], _image.cameraToWorld[13], _image.cameraToWorld[14]);
+        float extent = _config.tileExtent;
+        float cullDistance = _config.mesh.maxDepth + extent * 0.87f;
+
+        std::vector<int> visible;
+        for (int t = 0; t < (int) _tiles.size(); t++) {
+            const Tile &tile = _tiles[t];
+            VROVector3f center((tile.bx + 0.5f) * extent, (tile.by + 0.5f) * extent, (tile.bz + 0.5f) * extent);
+            if (!tile.vertices.empty() && (center - cameraPosition).magnitude() <= cullDistance) {
+                visible.push_back(t);
+            }
+        }
+        VROThreadPool::shared().parallelFor((int) visible.size(), 1, [this, &visible](int start, int end) {
+            for (int i = start; i < end; i++) {
+                int t = visible[i];
+                for (const VROVector3f &vertex : _tiles[t].vertices) {
+                    int g;
+                    float d;
+                    if (project(vertex, &g, &d)) {
+                        splat(g, d, t);
+                    }
+                }
+            }
+        });
+        VROThreadPool::shared().parallelFor(count, 1024, [this, empty](int start, int end) {
+            for (int g = start; g < end; g++) {
+                uint64_t value = _splats[g].load(std::memory_order_relaxed);
+                if (value == empty) {
+                    _reprojectedDepths[g] = std::numeric_limits<float>::max();
+                    _reprojectedTiles[g] = -1;
+                }
+                else {
+                    uint32_t depthBits = (uint32_t) (value >> 32);
+                    memcpy(&_reprojectedDepths[g], &depthBits, sizeof(float));
+                    _reprojectedTiles[g] = (int) (uint32_t) value;
+                }
+            }
+        });
+
+        std::vector<int> dirty;
+        std::vector<int> observed;
+        std::mutex mutex;
+        float threshold = _config.changeThreshold;
+        VROThreadPool::shared().parallelFor(_gridHeight, 4, [&](int start, int end) {
+            std::vector<int> chunkDirty;
+            std::vector<int> chunkObserved;
+            for (int gy = start; gy < end; gy++) {
+                for (int gx = 0; gx < _gridWidth; gx++) {
+                    int g = gy * _gridWidth + gx;
+                    if (!_gridValid[g]) {
+                        continue;
+                    }
+                    int previous = _reprojectedTiles[g];
+                    if (previous >= 0) {
+                        chunkObserved.push_back(previous);
+                        float observedDepth = _gridDepths[g];
+                        float expectedDepth = _reprojectedDepths[g];
+                        if (observedDepth > expectedDepth + threshold) {
+                            // The camera sees past the previous surface
+                            chunkDirty.push_back(previous);
+                            collectTilesAround(gx, gy, chunkDirty);
+                        } else if (observedDepth < expectedDepth - threshold) {
+                            // New surface in front of the previous one
+                            collectTilesAround(gx, gy, chunkDirty);
+                        }
+                    } else if (!isCoveredNearby(gx, gy)) {
+                        // Part of the view no tile has geometry for; isolated
+                        // gaps between reprojected vertices are ignored
+                        collectTilesAround(gx, gy, chunkDirty);
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            dirty.insert(dirty.end(), chunkDirty.begin(), chunkDirty.end());
+            observed.insert(observed.end(), chunkObserved.begin(), chunkObserved.end());
+        });
+
+        for (int t : observed) {
+            _tiles[t].lastObservedUpdate = _updateCount;
+        }
+        for (int t : dirty) {
+            _tiles[t].dirty = true;
+        }
+    }
+
+    /*
+     Keep the nearer of the splat already at g and depth d of tile t. Depths
+     are positive, so their bit patterns order like the floats, and the
+     packed values can be compared as integers.
+     */
+    void splat(int g, float d, int t) {
+        uint32_t depthBits;
+        memcpy(&depthBits, &d, sizeof(float));
+        uint64_t value = ((uint64_t) depthBits << 32) | (uint32_t) t;
+        uint64_t current = _splats[g].load(std::memory_order_relaxed);
+        while (value < current && !_splats[g].compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /*
+     Append the tiles holding this frame's triangles that touch the given
+     grid sample: those of the up to four quads that share it.
+     */
+    void collectTilesAround(int gx, int gy, std::vector<int> &tiles) const {
+        const int quadsX = _gridWidth - 1;
+        for (int y = std::max(0, gy - 1); y <= std::min(_gridHeight - 2, gy); y++) {
+            for (int x = std::max(0, gx - 1); x <= std::min(quadsX - 1, gx); x++) {
+                int q = y * quadsX + x;
+                if (!_quadValid[q]) {
+                    continue;
+                }
+                for (int triangle = q * 2; triangle < q * 2 + 2; triangle++) {
+                    const CubeRange &cubes = _triangleCubes[triangle];
+                    for (int bx = cubes.min[0]; bx <= cubes.max[0]; bx++) {
+                        for (int by = cubes.min[1]; by <= cubes.max[1]; by++) {
+                            for (int bz = cubes.min[2]; bz <= cubes.max[2]; bz++) {
+                                int t = findTile(packKey(bx, by, bz));
+                                if (t >= 0) {
+                                    tiles.push_back(t);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    bool isCoveredNearby(int gx, int gy) const {
+        for (int y = std::max(0, gy - 1); y <= std::min(_gridHeight - 1, gy + 1); y++) {
+            for (int x = std::max(0, gx - 1); x <= std::min(_gridWidth - 1, gx + 1); x++) {
+                if (_reprojectedTiles[y * _gridWidth + x] >= 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /*
+     Rebuild the tile's mesh: keep only its triangles that this frame does
+     not observe at all (out of view or occluded), and replace the rest with
+     this frame's triangles whose bounds overlap the cube. A triangle with
+     any observed vertex is dropped rather than kept alongside the new
+     triangles covering the same surface, so rebuilds do not accumulate
+     duplicate geometry.
+     */
+    void rebuild(Tile &tile) {
+        std::vector<VROVector3f> vertices;
+        std::vector<int> indices;
+        std::vector<float> confidences;
+
+        std::vector<uint8_t> observed(tile.vertices.size());
+        for (size_t v = 0; v < tile.vertices.size(); v++) {
+            observed[v] = isObserved(tile.vertices[v]);
+        }
+        std::vector<int> remap(tile.vertices.size(), -1);
+        for (size_t i = 0; i + 2 < tile.indices.size(); i += 3) {
+            const int *triangle = &tile.indices[i];
+            if (observed[triangle[0]] || observed[triangle[1]] || observed[triangle[2]]) {
+                continue;
+            }
+            for (int c = 0; c < 3; c++) {
+                int v = triangle[c];
+                if (remap[v] < 0) {
+                    remap[v] = (int) vertices.size();
+                    vertices.push_back(tile.vertices[v]);
+                    confidences.push_back(tile.confidences[v]);
+                }
+                indices.push_back(remap[v]);
+            }
+        }
+
+        const int quadsX = _gridWidth - 1;
+        std::unordered_map<int, int> gridRemap;
+        auto vertexFor = [&](int g) {
+            auto it = gridRemap.find(g);
+            if (it != gridRemap.end()) {
+                return it->second;
+            }
+            int index = (int) vertices.size();
+            vertices.push_back(_gridPositions[g]);
+            confidences.push_back(_gridConfidences[g]);
+            gridRemap[g] = index;
+            return index;
+        };
+        for (int triangle : tile.triangles) {
+            int q = triangle / 2;
+            int g00 = (q / quadsX) * _gridWidth + q % quadsX;
+            if (triangle % 2 == 0) {
+                indices.push_back(vertexFor(g00));
+                indices.push_back(vertexFor(g00 + _gridWidth));
+                indices.push_back(vertexFor(g00 + 1));
+            }
+            else {
+                indices.push_back(vertexFor(g00 + 1));
+                indices.push_back(vertexFor(g00 + _gridWidth));
+                indices.push_back(vertexFor(g00 + _gridWidth + 1));
+            }
+        }
+
+        tile.vertices.swap(vertices);
+        tile.indices.swap(indices);
+        tile.confidences.swap(confidences);
+    }
+
+    void applyTileToPhysics(Tile &tile) {
+        removeTileFromPhysics(tile);
+        if (tile.indices.empty()) {
+            tile.mesh.reset();
+            return;
+        }
+        tile.mesh = std::make_shared<VROARDepthMesh>(tile.vertices, tile.indices, tile.confidences);
+
+#if VRO_PHYSICS_BULLET
+        std::shared_ptr<VROPhysicsWorld> world = _physicsWorld.lock();
+        if (!world) {
+            return;
+        }
+        tile.shape = std::make_shared<VROPhysicsShape>(tile.vertices, tile.indices);
+        if (!tile.shape->getBulletShape()) {
+            tile.shape.reset();
+            return;
+        }
+
+        btTransform identity;
+        identity.setIdentity();
+        tile.motionState.reset(new btDefaultMotionState(identity));
+
+        btRigidBody::btRigidBodyConstructionInfo info(0, tile.motionState.get(), tile.shape->getBulletShape(),
+                                                      btVector3(0, 0, 0));
+        info.m_friction = _config.mesh.friction;
+        info.m_restitution = _config.mesh.restitution;
+        tile.rigidBody.reset(new btRigidBody(info));
+        VROPhysicsRawBody::tag(tile.rigidBody.get(), &_bodyInfo);
+        world->addRigidBody(tile.rigidBody.get());
+#endif
+    }
+
+    void removeTileFromPhysics(Tile &tile) {
+#if VRO_PHYSICS_BULLET
+        if (tile.rigidBody) {
+            std::shared_ptr<VROPhysicsWorld> world = _physicsWorld.lock();
+            if (world) {
+                world->removeRigidBody(tile.rigidBody.get());
+            }
+            tile.rigidBody.reset();
+        }
+        tile.motionState.reset();
+        tile.shape.reset();
+#endif
+    }
+
+    void updateStats() {
+        _stats.tileCount = (int) _tiles.size();
+        _stats.activeTileCount = 0;
+        _stats.meshedTileCount = 0;
+        _stats.vertexCount = 0;
+        _stats.triangleCount = 0;
+        for (const Tile &tile : _tiles) {
+#if VRO_PHYSICS_BULLET
+            if (tile.rigidBody) {
+                _stats.activeTileCount++;
+            }
+#endif
+            if (tile.mesh) {
+                _stats.meshedTileCount++;
+            }
+            _stats.vertexCount += (int) tile.vertices.size();
+            _stats.triangleCount += (int) tile.indices.size() / 3;
+        }
+    }
+
+};
+
+#endif /* VROARTiledWorldMesh_h */
@@ -0,0 +1,336 @@
+//
+//  VROAnimationClip.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROAnimationClip_h
+#define VROAnimationClip_h
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "VROThreadPool.h"
+#include "VROLog.h"
+
+enum class VROAnimationTrackType {
+    Float = 1,         // Scalars, e.g. morph weights
+    Vector3 = 3,       // Positions and scales
+    Quaternion = 4,    // Rotations (x, y, z, w), interpolated spherically
+};
+
+enum class VROAnimationInterpolation {
+    Linear,
+    Step,
+};
+
+/*
+ A track animates one property of one target (e.g. the rotation of node 7).
+ Its keyframes are a range of the owning clip's contiguous time and value
+ arrays.
+ */
+struct VROAnimationTrack {
+    int target;                              // Index of the animated node or channel
+    int property;                            // Caller-defined property identifier
+    VROAnimationTrackType type;
+    VROAnimationInterpolation interpolation;
+    int firstKey;                            // Offset into the clip's times
+    int keyCount;
+    int valueOffset;                         // Offset into the clip's values
+    int outputOffset;                        // Offset into each instance's output
+};
+
+/*
+ Immutable keyframe data for one animation (e.g. a glTF or FBX animation),
+ shared by every instance that plays it. All tracks' key times are stored in
+ one array and all key values in another, so sampling a clip walks a few
+ contiguous buffers instead of one heap-allocated animation object per
+ animated property. Clips are created with VROAnimationClipBuilder and
+ cannot change once built.
+ */
+class VROAnimationClip {
+public:
+
+    const std::string &getName() const { return _name; }
+    float getDuration() const { return _duration; }
+    const std::vector<VROAnimationTrack> &getTracks() const { return _tracks; }
+
+    /*
+     Number of floats an instance's output holds: the sum of every track's
+     components.
+     */
+    int getOutputSize() const { return _outputSize; }
+
+    const float *getTimes() const { return _times.data(); }
+    const float *getValues() const { return _values.data(); }
+
+private:
+
+    friend class VROAnimationClipBuilder;
+
+    std::string _name;
+    float _duration;
+    int _outputSize;
+    std::vector<VROAnimationTrack> _tracks;
+    std::vector<float> _times;
+    std::vector<float> _values;
+
+    VROAnimationClip(std::string name) :
+        _name(name), _duration(0), _outputSize(0) {}
+
+};
+
+/*
+ Accumulates the tracks of a VROAnimationClip. build() hands the clip over
+ as immutable, so instances never see it change.
+ */
+class VROAnimationClipBuilder {
+public:
+
+    VROAnimationClipBuilder(std::string name) :
+        _clip(new VROAnimationClip(name)) {}
+
+    /*
+     Append a track. Times are in seconds and must be increasing; values hold
+     one key per time, with the number of floats given by the track type.
+     Must not be called after build().
+     */
+    void addTrack(int target, int property, VROAnimationTrackType type, VROAnimationInterpolation interpolation,
+                  const std::vector<float> &times, const std::vector<float> &values) {
+        passert (_clip);
+        VROAnimationClip &clip = *_clip;
+        const int components = (int) type;
+        const int keys = (int) std::min(times.size(), values.size() / components);
+
+        VROAnimationTrack track;
+        track.target = target;
+        track.property = property;
+        track.type = type;
+        track.interpolation = interpolation;
+        track.firstKey = (int) clip._times.size();
+        track.keyCount = keys;
+        track.valueOffset = (int) clip._values.size();
+        track.outputOffset = clip._outputSize;
+
+        clip._times.insert(clip._times.end(), times.begin(), times.begin() + keys);
+        clip._values.insert(clip._values.end(), values.begin(), values.begin() + keys * components);
+        clip._outputSize += components;
+        if (keys > 0) {
+            clip._duration = std::max(clip._duration, times[keys - 1]);
+        }
+        clip._tracks.push_back(track);
+    }
+
+    /*
+     Return the finished clip. The builder is empty afterward.
+     */
+    std::shared_ptr<const VROAnimationClip> build() {
+        std::shared_ptr<const VROAnimationClip> clip(_clip.release());
+        return clip;
+    }
+
+private:
+
+    std::unique_ptr<VROAnimationClip> _clip;
+
+};
+
+/*
+ One playback of a shared VROAnimationClip: its time, speed and looping,
+ the sampled value of every track, and a cached keyframe cursor per track.
+ Playback normally moves forward a little each frame, so the cursor usually
+ stays on the same key or advances by one, and the binary search is skipped.
+ */
+class VROAnimationInstance {
+public:
+
+    VROAnimationInstance(std::shared_ptr<const VROAnimationClip> clip) :
+        _clip(clip), _time(0), _speed(1), _looping(true), _paused(false),
+        _output(clip->getOutputSize(), 0),
+        _cursors(clip->getTracks().size(), 0) {}
+
+    const std::shared_ptr<const VROAnimationClip> &getClip() const { return _clip; }
+
+    void setTime(float time) { _time = time; }
+    float getTime() const { return _time; }
+    void setSpeed(float speed) { _speed = speed; }
+    void setLooping(bool looping) { _looping = looping; }
+    void setPaused(bool paused) { _paused = paused; }
+
+    bool isFinished() const {
+        return !_looping && _time >= _clip->getDuration();
+    }
+
+    /*
+     Sampled values, laid out by VROAnimationTrack::outputOffset.
+     */
+    const float *getOutput() const { return _output.data(); }
+    const float *getOutput(const VROAnimationTrack &track) const { return &_output[track.outputOffset]; }
+
+    /*
+     Advance by deltaSeconds (scaled by speed, wrapped or clamped to the clip)
+     and sample every track.
+     */
+    void advance(float deltaSeconds) {
+        if (!_paused) {
+            _time += deltaSeconds * _speed;
+        }
+        float duration = _clip->getDuration();
+        if (_looping && duration > 0) {
+            _time = fmodf(_time, duration);
+            if (_time < 0) {
+                _time += duration;
+            }
+        } else {
+            _time = std::max(0.0f, std::min(_time, duration));
+        }
+        sample();
+    }
+
+    /*
+     Sample every track at the current time.
+     */
+    void sample() {
+        const VROAnimationClip &clip = *_clip;
+        const std::vector<VROAnimationTrack> &tracks = clip.getTracks();
+        const float *allTimes = clip.getTimes();
+        const float *allValues = clip.getValues();
+
+        for (size_t i = 0; i < tracks.size(); i++) {
+            const VROAnimationTrack &track = tracks[i];
+            const int components = (int) track.type;
+            const float *times = allTimes + track.firstKey;
+            const float *values = allValues + track.valueOffset;
+            float *out = &_output[track.outputOffset];
+
+            if (track.keyCount == 0) {
+                continue;
+            }
+            if (track.keyCount == 1 || _time <= times[0]) {
+                std::copy(values, values + components, out);
+                continue;
+            }
+            if (_time >= times[track.keyCount - 1]) {
+                const float *last = values + (track.keyCount - 1) * components;
+                std::copy(last, last + components, out);
+                continue;
+            }
+
+            int key = findKey(times, track.keyCount, _cursors[i]);
+            _cursors[i] = key;
+
+            const float *a = values + key * components;
+            const float *b = a + components;
+            if (track.interpolation == VROAnimationInterpolation::Step) {
+                std::copy(a, a + components, out);
+                continue;
+            }
+            float t = (_time - times[key]) / (times[key + 1] - times[key]);
+            if (track.type == VROAnimationTrackType::Quaternion) {
+                slerp(a, b, t, out);
+            } else {
+                for (int c = 0; c < components; c++) {
+                    out[c] = a[c] + (b[c] - a[c]) * t;
+                }
+            }
+        }
+    }
+
+private:
+
+    std::shared_ptr<const VROAnimationClip> _clip;
+    float _time;
+    float _speed;
+    bool _looping;
+    bool _paused;
+    std::vector<float> _output;
+    std::vector<int> _cursors;
+
+    /*
+     Return the key k with times[k] <= time < times[k + 1], given that
+     times[0] < time < times[count - 1]. Checks the cached key and its
+     successor before falling back to binary search.
+     */
+    int findKey(const float *times, int count, int cached) const {
+        if (cached < count - 1 && times[cached] <= _time) {
+            if (_time < times[cached + 1]) {
+                return cached;
+            }
+            if (cached + 2 < count && _time < times[cached + 2]) {
+                return cached + 1;
+            }
+        }
+        return (int) (std::upper_bound(times, times + count, _time) - times) - 1;
+    }
+
+    static void slerp(const float *a, const float *b, float t, float *out) {
+        float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        float sign = 1;
+        if (dot < 0) {
+            dot = -dot;
+            sign = -1;
+        }
+        float wa, wb;
+        if (dot > 0.9995f) {
+            // Nearly parallel: linear interpolation, normalized below
+            wa = 1 - t;
+            wb = t * sign;
+        } else {
+            float theta = acosf(dot);
+            float inverseSin = 1.0f / sinf(theta);
+            wa = sinf((1 - t) * theta) * inverseSin;
+            wb = sinf(t * theta) * inverseSin * sign;
+        }
+        float length = 0;
+        for (int c = 0; c < 4; c++) {
+            out[c] = a[c] * wa + b[c] * wb;
+            length += out[c] * out[c];
+        }
+        float inverseLength = 1.0f / sqrtf(length);
+        for (int c = 0; c < 4; c++) {
+            out[c] *= inverseLength;
+        }
+    }
+
+};
+
+/*
+ Advances and samples many animation instances in one pass, in parallel on
+ the shared VROThreadPool. Instances are independent, so they may share clips
+ freely; the caller then applies each instance's output to its nodes.
+ */
+class VROAnimationSampler {
+public:
+
+    static void advance(const std::vector<VROAnimationInstance *> &instances, float deltaSeconds) {
+        VROThreadPool::shared().parallelFor((int) instances.size(), 16, [&](int start, int end) {
+            for (int i = start; i < end; i++) {
+                instances[i]->advance(deltaSeconds);
+            }
+        });
+    }
+
+};
+
+#endif /* VROAnimationClip_h */
@@ -0,0 +1,210 @@
+//
+//  VROBloomRenderPass.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROBloomRenderPass_h
+#define VROBloomRenderPass_h
+
+#include <memory>
+#include "VRORenderPass.h"
+#include "VRORenderTarget.h"
+#include "VROGaussianBlurRenderPass.h"
+#include "VROMipChainBloom.h"
+#include "VRODriver.h"
+#include "VROViewport.h"
+#include "VROOpenGL.h"
+#include "VROLog.h"
+
+/*
+ Type of the bloom pass's render targets: ColorTextureHDR16 in the
+ platform drivers' VRORenderTargetType, so the bloom keeps values over 1.
+ */
+static const VRORenderTargetType kBloomTargetType = (VRORenderTargetType) 3;
+
+/*
+ Bloom pass that runs either the existing VROGaussianBlurRenderPass or a
+ VROMipChainBloom, selected with setMode(), and takes the Gaussian pass's
+ place in a pass chain. It has the Gaussian pass's interface: both modes
+ read the bright colors from textures[kGaussianInput] and set outputTarget
+ to a render target the pass owns, holding the blurred result at the
+ viewport's size. createRenderTargets(), setViewPort() and
+ resetRenderTargets() are forwarded to the Gaussian pass as well.
+
+ In MipChain mode the input texture is attached to a private render target
+ and bound through the driver once, to read its GL name from the
+ framebuffer (VROTexture exposes none); the name is kept until the input
+ texture or the viewport changes. The chain's half-resolution result is
+ then stretched into the pass's output target. A frame without an input
+ texture, or one the mip chain cannot render, falls back to the Gaussian
+ pass, which sets outputTarget to its own target.
+ */
+class VROBloomRenderPass : public VRORenderPass {
+public:
+
+    VROBloomRenderPass(std::shared_ptr<VROGaussianBlurRenderPass> gaussian,
+                       std::shared_ptr<VROMipChainBloom> mipChain) :
+        _gaussian(gaussian),
+        _mipChain(mipChain),
+        _mode(VROBloomMode::GaussianPingPong),
+        _inputName(0) {}
+    virtual ~VROBloomRenderPass() {}
+
+    void setMode(VROBloomMode mode) {
+        _mode = mode;
+    }
+    VROBloomMode getMode() const {
+        return _mode;
+    }
+
+    std::shared_ptr<VROGaussianBlurRenderPass> getGaussianPass() const { return _gaussian; }
+    std::shared_ptr<VROMipChainBloom> getMipChain() const { return _mipChain; }
+
+    /*
+     Functions for handling the render targets of both modes.
+     */
+    void createRenderTargets(std::shared_ptr<VRODriver> &driver) {
+        _gaussian->createRenderTargets(driver);
+        _inputTarget = driver->newRenderTarget(kBloomTargetType, 1, 1, false, false);
+        _outputTarget = driver->newRenderTarget(kBloomTargetType, 1, 1, false, false);
+        if (_viewport.getWidth() > 0 && _viewport.getHeight() > 0) {
+            _inputTarget->setViewport(_viewport);
+            _outputTarget->setViewport(_viewport);
+        }
+        _inputTexture.reset();
+        _inputName = 0;
+    }
+    void resetRenderTargets() {
+        _gaussian->resetRenderTargets();
+        _inputTarget.reset();
+        _outputTarget.reset();
+        _inputTexture.reset();
+        _inputName = 0;
+    }
+    void setViewPort(VROViewport viewport, std::shared_ptr<VRODriver> &driver) {
+        _gaussian->setViewPort(viewport, driver);
+        _viewport = viewport;
+        _mipChain->setViewport(viewport.getWidth(), viewport.getHeight());
+        if (_inputTarget) {
+            _inputTarget->setViewport(viewport);
+            _outputTarget->setViewport(viewport);
+        }
+        _inputTexture.reset();
+        _inputName = 0;
+    }
+
+    void render(std::shared_ptr<VROScene> scene,
+                std::shared_ptr<VROScene> outgoingScene,
+                VRORenderPassInputOutput &inputs,
+                VRORenderContext *context, std::shared_ptr<VRODriver> &driver) {
+        if (_mode == VROBloomMode::MipChain && renderMipChain(inputs, driver)) {
+            return;
+        }
+        _gaussian->render(scene, outgoingScene, inputs, context, driver);
+    }
+
+private:
+
+    std::shared_ptr<VROGaussianBlurRenderPass> _gaussian;
+    std::shared_ptr<VROMipChainBloom> _mipChain;
+    VROBloomMode _mode;
+    VROViewport _viewport;
+
+    /*
+     The target the input texture is attached to, to read its GL name, and
+     the target the bloom is stretched into.
+     */
+    std::shared_ptr<VRORenderTarget> _inputTarget;
+    std::shared_ptr<VRORenderTarget> _outputTarget;
+
+    /*
+     The last input texture and its GL name.
+     */
+    std::weak_ptr<VROTexture> _inputTexture;
+    GLuint _inputName;
+
+    GLuint getInputName(std::shared_ptr<VROTexture> texture, std::shared_ptr<VRODriver> &driver) {
+        if (_inputName != 0 && _inputTexture.lock() == texture) {
+            return _inputName;
+        }
+        _inputTexture = texture;
+        _inputName = 0;
+        if (!_inputTarget->attachTexture(texture, 0)) {
+            return 0;
+        }
+        driver->bindRenderTarget(_inputTarget, VRORenderTargetUnbindOp::None);
+        GLint name = 0;
+        GL( glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                                  GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &name) );
+        _inputName = (GLuint) name;
+        return _inputName;
+    }
+
+    bool renderMipChain(VRORenderPassInputOutput &inputs, std::shared_ptr<VRODriver> &driver) {
+        auto input = inputs.textures.find(kGaussianInput);
+        if (!_mipChain || input == inputs.textures.end() || !input->second) {
+            pinfo("Bloom has no input texture, using Gaussian bloom");
+            return false;
+        }
+        if (!_outputTarget) {
+            createRenderTargets(driver);
+        }
+
+        GLuint texture = getInputName(input->second, driver);
+        if (texture == 0) {
+            pinfo("Bloom input texture has no GL name, using Gaussian bloom");
+            return false;
+        }
+
+        _mipChain->beginFrame();
+        GLuint bloom = _mipChain->render(texture);
+        _mipChain->endFrame();
+        if (bloom == 0) {
+            pinfo("Mip-chain bloom could not render, using Gaussian bloom");
+            return false;
+        }
+
+        // Stretch the half-resolution result over the output; the blit is
+        // clipped by the scissor test, so that is disabled around it
+        driver->bindRenderTarget(_outputTarget, VRORenderTargetUnbindOp::None);
+        GLint output = 0;
+        GL( glGetIntegerv(GL_FRAMEBUFFER_BINDING, &output) );
+        GLboolean scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+        GL( glDisable(GL_SCISSOR_TEST) );
+
+        const VROMipChainBloom &chain = *_mipChain;
+        GL( glBindFramebuffer(GL_READ_FRAMEBUFFER, chain.getOutputFramebuffer()) );
+        GL( glBlitFramebuffer(0, 0, chain.getViewportWidth() / 2, chain.getViewportHeight() / 2,
+                              0, 0, chain.getViewportWidth(), chain.getViewportHeight(),
+                              GL_COLOR_BUFFER_BIT, GL_LINEAR) );
+        GL( glBindFramebuffer(GL_FRAMEBUFFER, output) );
+        if (scissorTest) {
+            GL( glEnable(GL_SCISSOR_TEST) );
+        }
+        inputs.outputTarget = _outputTarget;
+        return true;
+    }
+
+};
+
+#endif /* VROBloomRenderPass_h */
@@ -0,0 +1,663 @@
+//
+//  VROBodyAnimStream.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROBodyAnimStream_h
+#define VROBodyAnimStream_h
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "VROBodyPlayer.h"
+#include "VROBodyAnimData.h"
+#include "VROTime.h"
+#include "VROLog.h"
+
+/*
+ Binary body animation format (.vrba). Columnar and little-endian: after the
+ header come the metadata (version string and bone lengths), then one column
+ per field across all rows:
+
+   timestamps   double[rows]          Milliseconds from the start.
+   presence     uint32_t[rows]        Bit j set if joint j was recorded.
+   ranges       float[joints * 3][2]  Per joint and axis: minimum, step.
+   positions    uint16_t[joints * 3][rows]
+                                      Quantized position = min + q * step.
+   keyframes    double[keyframes]     Timestamp of every keyframeInterval'th
+                                      row, for seeking without touching the
+                                      full timestamp column.
+
+ Each column starts on an 8-byte boundary, so the file can be memory mapped
+ and read in place. With 16 bits per axis, the quantization error is at most
+ (max - min) / 131070 per axis: ~0.03 mm for a joint that moves 4 meters.
+ */
+static const char kBodyAnimStreamMagic[4] = { 'V', 'R', 'B', 'A' };
+static const uint32_t kBodyAnimStreamFormatVersion = 1;
+static const uint32_t kBodyAnimStreamKeyframeInterval = 64;
+
+struct VROBodyAnimStreamHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t rowCount;
+    uint32_t jointCount;
+    uint32_t keyframeInterval;
+    uint32_t keyframeCount;
+    double totalTime;
+    float worldStartMatrix[16];
+    uint64_t metadataOffset;
+    uint64_t timestampsOffset;
+    uint64_t presenceOffset;
+    uint64_t rangesOffset;
+    uint64_t positionsOffset;
+    uint64_t keyframesOffset;
+    uint64_t fileSize;
+};
+
+/*
+ Converts VROBodyAnimData (e.g. as read from JSON by VROBodyAnimDataReader)
+ to the binary format. Rows are written in timestamp order, as readers
+ require; rows with a non-finite timestamp are dropped.
+ */
+class VROBodyAnimStreamWriter {
+public:
+
+    static std::vector<uint8_t> encode(const std::shared_ptr<VROBodyAnimData> &data) {
+        // Recordings are normally in order already; the stable sort keeps
+        // rows with equal timestamps in their recorded order
+        std::vector<uint32_t> order;
+        order.reserve(data->getTotalRows());
+        for (uint32_t r = 0; r < (uint32_t) data->getTotalRows(); r++) {
+            if (std::isfinite(data->getAnimRowTimestamp(r))) {
+                order.push_back(r);
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [&data](uint32_t a, uint32_t b) {
+            return data->getAnimRowTimestamp(a) < data->getAnimRowTimestamp(b);
+        });
+
+        const uint32_t rows = (uint32_t) order.size();
+        const uint32_t joints = kNumBodyJoints;
+        const uint32_t keyframes = (rows + kBodyAnimStreamKeyframeInterval - 1) / kBodyAnimStreamKeyframeInterval;
+
+        // Gather the rows once into columns, and find the range of each axis
+        std::vector<double> timestamps(rows);
+        std::vector<uint32_t> presence(rows, 0);
+        std::vector<float> positions((size_t) joints * 3 * rows, 0);
+        std::vector<float> ranges(joints * 3 * 2, 0);
+        std::vector<float> minimum(joints * 3, INFINITY), maximum(joints * 3, -INFINITY);
+
+        for (uint32_t r = 0; r < rows; r++) {
+            timestamps[r] = data->getAnimRowTimestamp(order[r]);
+            for (const auto &kv : data->getAnimRowJoints(order[r])) {
+                int j = (int) kv.first;
+                if (j < 0 || j >= (int) joints) {
+                    continue;
+                }
+                presence[r] |= (1u << j);
+                const float value[3] = { kv.second.x, kv.second.y, kv.second.z };
+                for (int a = 0; a < 3; a++) {
+                    positions[(size_t) (j * 3 + a) * rows + r] = value[a];
+                    minimum[j * 3 + a] = std::min(minimum[j * 3 + a], value[a]);
+                    maximum[j * 3 + a] = std::max(maximum[j * 3 + a], value[a]);
+                }
+            }
+        }
+        for (uint32_t c = 0; c < joints * 3; c++) {
+            if (minimum[c] > maximum[c]) {
+                minimum[c] = maximum[c] = 0;
+            }
+            ranges[c * 2] = minimum[c];
+            ranges[c * 2 + 1] = (maximum[c] - minimum[c]) / 65535.0f;
+        }
+
+        std::vector<uint8_t> metadata;
+        appendString(data->getVersion(), &metadata);
+        std::map<std::string, float> boneLengths = data->getBoneLengths();
+        appendPOD((uint32_t) boneLengths.size(), &metadata);
+        for (const auto &kv : boneLengths) {
+            appendString(kv.first, &metadata);
+            appendPOD(kv.second, &metadata);
+        }
+
+        VROBodyAnimStreamHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, kBodyAnimStreamMagic, 4);
+        header.formatVersion = kBodyAnimStreamFormatVersion;
+        header.rowCount = rows;
+        header.jointCount = joints;
+        header.keyframeInterval = kBodyAnimStreamKeyframeInterval;
+        header.keyframeCount = keyframes;
+        header.totalTime = data->getTotalTime();
+        memcpy(header.worldStartMatrix, data->getModelStartWorldMatrix().getArray(), sizeof(header.worldStartMatrix));
+
+        header.metadataOffset   = align(sizeof(header));
+        header.timestampsOffset = align(header.metadataOffset + metadata.size());
+        header.presenceOffset   = align(header.timestampsOffset + rows * sizeof(double));
+        header.rangesOffset     = align(header.presenceOffset + rows * sizeof(uint32_t));
+        header.positionsOffset  = align(header.rangesOffset + ranges.size() * sizeof(float));
+        header.keyframesOffset  = align(header.positionsOffset + positions.size() * sizeof(uint16_t));
+        header.fileSize         = align(header.keyframesOffset + keyframes * sizeof(double));
+
+        std::vector<uint8_t> out(header.fileSize, 0);
+        memcpy(&out[0], &header, sizeof(header));
+        memcpy(&out[header.metadataOffset], metadata.data(), metadata.size());
+        memcpy(&out[header.timestampsOffset], timestamps.data(), rows * sizeof(double));
+        memcpy(&out[header.presenceOffset], presence.data(), rows * sizeof(uint32_t));
+        memcpy(&out[header.rangesOffset], ranges.data(), ranges.size() * sizeof(float));
+
+        uint16_t *quantized = (uint16_t *) &out[header.positionsOffset];
+        for (uint32_t c = 0; c < joints * 3; c++) {
+            float min = ranges[c * 2];
+            float step = ranges[c * 2 + 1];
+            float inverseStep = step > 0 ? 1.0f / step : 0;
+            const float *column = &positions[(size_t) c * rows];
+            for (uint32_t r = 0; r < rows; r++) {
+                float q = std::round((column[r] - min) * inverseStep);
+                quantized[(size_t) c * rows + r] = (uint16_t) std::max(0.0f, std::min(65535.0f, q));
+            }
+        }
+
+        double *keyframeTimestamps = (double *) &out[header.keyframesOffset];
+        for (uint32_t k = 0; k < keyframes; k++) {
+            keyframeTimestamps[k] = timestamps[k * kBodyAnimStreamKeyframeInterval];
+        }
+        return out;
+    }
+
+    static bool write(const std::shared_ptr<VROBodyAnimData> &data, std::string path) {
+        std::vector<uint8_t> encoded = encode(data);
+        FILE *file = fopen(path.c_str(), "wb");
+        if (!file) {
+            pwarn("Failed to open body animation file %s for writing", path.c_str());
+            return false;
+        }
+        bool success = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+        success = (fclose(file) == 0) && success;
+        if (!success) {
+            pwarn("Failed to write body animation file %s", path.c_str());
+        }
+        return success;
+    }
+
+private:
+
+    template <typename T>
+    static void appendPOD(T value, std::vector<uint8_t> *out) {
+        const uint8_t *bytes = (const uint8_t *) &value;
+        out->insert(out->end(), bytes, bytes + sizeof(T));
+    }
+
+    static void appendString(const std::string &value, std::vector<uint8_t> *out) {
+        appendPOD((uint32_t) value.size(), out);
+        out->insert(out->end(), value.begin(), value.end());
+    }
+
+    static uint64_t align(uint64_t offset) {
+        return (offset + 7) & ~(uint64_t) 7;
+    }
+
+};
+
+/*
+ Read-only view of a binary body animation, either memory mapped from a file
+ or over an in-memory buffer. Opening validates the header and reads the
+ timestamp and keyframe columns once, checking that they are ordered so that
+ findRow() can binary search them; that is linear in the row count, but at
+ 8 bytes per row it is a small fraction of the file. Joint positions, the
+ bulk of the file, are decoded on demand, so only the pages that playback
+ touches are brought into memory.
+ */
+class VROBodyAnimStream {
+public:
+
+    /*
+     Memory map the given file. Returns nullptr if the file cannot be opened
+     or is not a valid body animation.
+     */
+    static std::shared_ptr<VROBodyAnimStream> open(std::string path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            pwarn("Failed to open body animation file %s", path.c_str());
+            return nullptr;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(VROBodyAnimStreamHeader)) {
+            ::close(fd);
+            pwarn("Body animation file %s is truncated", path.c_str());
+            return nullptr;
+        }
+        void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            pwarn("Failed to map body animation file %s", path.c_str());
+            return nullptr;
+        }
+
+        std::shared_ptr<VROBodyAnimStream> stream(new VROBodyAnimStream());
+        stream->_mapped = mapped;
+        stream->_mappedSize = info.st_size;
+        if (!stream->parse((const uint8_t *) mapped, info.st_size)) {
+            pwarn("Body animation file %s is invalid", path.c_str());
+            return nullptr;
+        }
+        return stream;
+    }
+
+    /*
+     Read a binary body animation from memory. The buffer is moved into the
+     stream.
+     */
+    static std::shared_ptr<VROBodyAnimStream> open(std::vector<uint8_t> buffer) {
+        std::shared_ptr<VROBodyAnimStream> stream(new VROBodyAnimStream());
+        stream->_buffer = std::move(buffer);
+        if (!stream->parse(stream->_buffer.data(), stream->_buffer.size())) {
+            pwarn("Body animation buffer is invalid");
+            return nullptr;
+        }
+        return stream;
+    }
+
+    ~VROBodyAnimStream() {
+        if (_mapped) {
+            munmap(_mapped, _mappedSize);
+        }
+    }
+
+    unsigned long getTotalRows() const { return _header->rowCount; }
+    double getTotalTime() const { return _header->totalTime; }
+    const std::string &getVersion() const { return _version; }
+    VROMatrix4f getModelStartWorldMatrix() const { return VROMatrix4f(_header->worldStartMatrix); }
+    const std::map<std::string, float> &getBoneLengths() const { return _boneLengths; }
+
+    double getAnimRowTimestamp(long row) const {
+        return _timestamps[row];
+    }
+
+    /*
+     Decode the joints of the given row into outPositions, indexed by
+     VROBodyJointType (kNumBodyJoints entries). Returns the bitmask of joints
+     recorded in the row; positions of other joints are left untouched.
+     */
+    uint32_t getAnimRowJoints(long row, VROVector3f *outPositions) const {
+        uint32_t present = _presence[row];
+        const uint32_t rows = _header->rowCount;
+        for (uint32_t j = 0; j < _header->jointCount; j++) {
+            if (!(present & (1u << j))) {
+                continue;
+            }
+            float value[3];
+            for (int a = 0; a < 3; a++) {
+                int c = j * 3 + a;
+                value[a] = _ranges[c * 2] + _positions[(size_t) c * rows + row] * _ranges[c * 2 + 1];
+            }
+            outPositions[j] = { value[0], value[1], value[2] };
+        }
+        return present;
+    }
+
+    std::map<VROBodyJointType, VROVector3f> getAnimRowJoints(long row) const {
+        VROVector3f positions[kNumBodyJoints];
+        uint32_t present = getAnimRowJoints(row, positions);
+
+        std::map<VROBodyJointType, VROVector3f> joints;
+        for (int j = 0; j < kNumBodyJoints; j++) {
+            if (present & (1u << j)) {
+                joints[(VROBodyJointType) j] = positions[j];
+            }
+        }
+        return joints;
+    }
+
+    /*
+     Return the first row at or after the given time, or the last row if the
+     time is past the end. Binary searches the keyframe index, then the
+     timestamps within one keyframe interval.
+     */
+    long findRow(double time) const {
+        const uint32_t rows = _header->rowCount;
+        if (rows == 0) {
+            return 0;
+        }
+        const double *keyframesEnd = _keyframes + _header->keyframeCount;
+        long keyframe = (long) (std::lower_bound(_keyframes, keyframesEnd, time) - _keyframes);
+
+        // The row is in the interval that ends with this keyframe
+        long begin = std::max(0L, keyframe - 1) * _header->keyframeInterval;
+        long end = std::min<long>(rows, (long) keyframe * _header->keyframeInterval + 1);
+        long row = (long) (std::lower_bound(_timestamps + begin, _timestamps + end, time) - _timestamps);
+        return std::min<long>(row, rows - 1);
+    }
+
+    /*
+     Decode the entire animation into a VROBodyAnimData.
+     */
+    std::shared_ptr<VROBodyAnimData> toAnimData() const {
+        std::shared_ptr<VROBodyAnimData> data = createMetadata();
+        for (uint32_t r = 0; r < _header->rowCount; r++) {
+            data->addAnimRow(_timestamps[r], getAnimRowJoints(r));
+        }
+        return data;
+    }
+
+    /*
+     A VROBodyAnimData with this animation's metadata (total time, version,
+     start matrix and bone lengths) but no rows.
+     */
+    std::shared_ptr<VROBodyAnimData> createMetadata() const {
+        std::shared_ptr<VROBodyAnimData> data = std::make_shared<VROBodyAnimData>();
+        data->setTotalTime(getTotalTime());
+        data->setVersion(getVersion());
+        data->setModelStartWorldMatrix(getModelStartWorldMatrix());
+        data->setBoneLengths(getBoneLengths());
+        return data;
+    }
+
+    /*
+     Size of the encoded animation in bytes, whether mapped or in memory.
+     */
+    size_t getSize() const {
+        return _header->fileSize;
+    }
+
+private:
+
+    void *_mapped = nullptr;
+    size_t _mappedSize = 0;
+    std::vector<uint8_t> _buffer;
+
+    const VROBodyAnimStreamHeader *_header = nullptr;
+    const double *_timestamps = nullptr;
+    const uint32_t *_presence = nullptr;
+    const float *_ranges = nullptr;
+    const uint16_t *_positions = nullptr;
+    const double *_keyframes = nullptr;
+    std::string _version;
+    std::map<std::string, float> _boneLengths;
+
+    VROBodyAnimStream() {}
+
+    bool parse(const uint8_t *bytes, size_t size) {
+        if (size < sizeof(VROBodyAnimStreamHeader)) {
+            return false;
+        }
+        _header = (const VROBodyAnimStreamHeader *) bytes;
+        if (memcmp(_header->magic, kBodyAnimStreamMagic, 4) != 0 ||
+            _header->formatVersion != kBodyAnimStreamFormatVersion ||
+            _header->jointCount != kNumBodyJoints ||
+            _header->keyframeInterval == 0 ||
+            _header->fileSize > size) {
+            return false;
+        }
+
+        // Bounds are checked as count <= (size - offset) / elementSize, which
+        // cannot wrap for any header values
+        const uint64_t rows = _header->rowCount;
+        const uint64_t columns = _header->jointCount * 3;
+        if (!isColumnInBounds(_header->timestampsOffset, rows, sizeof(double), size) ||
+            !isColumnInBounds(_header->presenceOffset, rows, sizeof(uint32_t), size) ||
+            !isColumnInBounds(_header->rangesOffset, columns * 2, sizeof(float), size) ||
+            !isColumnInBounds(_header->positionsOffset, columns * rows, sizeof(uint16_t), size) ||
+            !isColumnInBounds(_header->keyframesOffset, _header->keyframeCount, sizeof(double), size) ||
+            _header->metadataOffset < sizeof(VROBodyAnimStreamHeader) ||
+            _header->metadataOffset > _header->timestampsOffset ||
+            _header->keyframeCount != (rows + _header->keyframeInterval - 1) / _header->keyframeInterval) {
+            return false;
+        }
+        _timestamps = (const double *) (bytes + _header->timestampsOffset);
+        _presence = (const uint32_t *) (bytes + _header->presenceOffset);
+        _ranges = (const float *) (bytes + _header->rangesOffset);
+        _positions = (const uint16_t *) (bytes + _header->positionsOffset);
+        _keyframes = (const double *) (bytes + _header->keyframesOffset);
+
+        // findRow() binary searches the timestamps and keyframes, which is
+        // only correct if they are ordered
+        for (uint64_t r = 0; r < rows; r++) {
+            if (!std::isfinite(_timestamps[r]) || (r > 0 && _timestamps[r] < _timestamps[r - 1])) {
+                return false;
+            }
+        }
+        for (uint64_t k = 0; k < _header->keyframeCount; k++) {
+            if (_keyframes[k] != _timestamps[k * _header->keyframeInterval]) {
+                return false;
+            }
+        }
+
+        const uint8_t *cursor = bytes + _header->metadataOffset;
+        const uint8_t *end = bytes + _header->timestampsOffset;
+        uint32_t boneCount = 0;
+        if (!readString(&cursor, end, &_version) || !readPOD(&cursor, end, &boneCount)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < boneCount; i++) {
+            std::string name;
+            float length;
+            if (!readString(&cursor, end, &name) || !readPOD(&cursor, end, &length)) {
+                return false;
+            }
+            _boneLengths[name] = length;
+        }
+        return true;
+    }
+
+    /*
+     True if count elements starting at offset lie within size bytes, and
+     the column starts on the 8-byte boundary the format requires.
+     */
+    static bool isColumnInBounds(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t size) {
+        return offset % 8 == 0 && offset <= size && count <= (size - offset) / elementSize;
+    }
+
+    template <typename T>
+    static bool readPOD(const uint8_t **cursor, const uint8_t *end, T *outValue) {
+        if (end - *cursor < (long) sizeof(T)) {
+            return false;
+        }
+        memcpy(outValue, *cursor, sizeof(T));
+        *cursor += sizeof(T);
+        return true;
+    }
+
+    static bool readString(const uint8_t **cursor, const uint8_t *end, std::string *outValue) {
+        uint32_t length;
+        if (!readPOD(cursor, end, &length) || end - *cursor < (long) length) {
+            return false;
+        }
+        outValue->assign((const char *) *cursor, length);
+        *cursor += length;
+        return true;
+    }
+
+};
+
+/*
+ VROBodyPlayer that streams rows from a VROBodyAnimStream instead of holding
+ the whole animation as VROBodyAnimData. setTime() is a binary search, and
+ playback advances a cursor, so per-frame cost is independent of the
+ recording's length.
+
+ JSON animations are still supported through loadAnimation(): they are read
+ with the platform's VROBodyAnimDataReader and converted to the binary format
+ in memory. loadRecording() maps a binary file directly.
+ */
+class VROBodyStreamPlayer : public VROBodyPlayer {
+public:
+
+    VROBodyStreamPlayer(std::shared_ptr<VROBodyAnimDataReader> jsonReader = nullptr) :
+        _jsonReader(jsonReader) {
+        resetPlayback();
+    }
+    virtual ~VROBodyStreamPlayer() {}
+
+    /*
+     Parse and load a JSON animation. On failure a warning is logged and the
+     current animation, if any, is kept.
+     */
+    void loadAnimation(std::string jsonAnim) {
+        if (!_jsonReader) {
+            pwarn("Unable to load JSON body animation: no reader provided");
+            return;
+        }
+        std::shared_ptr<VROBodyAnimData> data = _jsonReader->fromJSON(jsonAnim);
+        if (!data) {
+            pwarn("Unable to load JSON body animation: failed to parse");
+            return;
+        }
+        std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(VROBodyAnimStreamWriter::encode(data));
+        if (!stream) {
+            pwarn("Unable to load JSON body animation: failed to convert");
+            return;
+        }
+        setStream(stream);
+    }
+
+    /*
+     Memory map and load a binary animation written by VROBodyAnimStreamWriter.
+     Returns false if the file could not be loaded.
+     */
+    bool loadRecording(std::string path) {
+        std::shared_ptr<VROBodyAnimStream> stream = VROBodyAnimStream::open(path);
+        if (!stream) {
+            return false;
+        }
+        setStream(stream);
+        return true;
+    }
+
+    std::shared_ptr<VROBodyAnimStream> getStream() const {
+        return _stream;
+    }
+
+    void start() {
+        if (!_stream) {
+            return;
+        }
+        if (_status == VROBodyPlayerStatus::Initialized || _status == VROBodyPlayerStatus::Finished) {
+            _row = 0;
+            _startTime = VROTimeCurrentMillis();
+            _status = VROBodyPlayerStatus::Start;
+
+            std::shared_ptr<VROBodyPlayerDelegate> delegate = _bodyMeshDelegate_w.lock();
+            if (delegate) {
+                delegate->onBodyPlaybackStarting(_stream->createMetadata());
+            }
+        } else if (_status == VROBodyPlayerStatus::Paused) {
+            _startTime = VROTimeCurrentMillis() - _pausedTime;
+            _status = VROBodyPlayerStatus::Playing;
+        }
+    }
+
+    void pause() {
+        _pausedTime = VROTimeCurrentMillis() - _startTime;
+        _status = VROBodyPlayerStatus::Paused;
+    }
+
+    void setLooping(bool looping) {
+        _looping = looping;
+    }
+
+    void setTime(double time) {
+        if (!_stream || _stream->getTotalRows() == 0) {
+            return;
+        }
+        _row = _stream->findRow(time);
+        _startTime = VROTimeCurrentMillis() - _stream->getAnimRowTimestamp(_row);
+        _pausedTime = _stream->getAnimRowTimestamp(_row);
+    }
+
+    void onFrameWillRender(const VRORenderContext & /* context */) {
+        if (!_stream || (_status != VROBodyPlayerStatus::Start && _status != VROBodyPlayerStatus::Playing)) {
+            return;
+        }
+        const long rows = (long) _stream->getTotalRows();
+        if (rows == 0) {
+            return;
+        }
+
+        // Advance to the latest row whose timestamp has elapsed
+        double elapsed = VROTimeCurrentMillis() - _startTime;
+        while (_row + 1 < rows && _stream->getAnimRowTimestamp(_row + 1) <= elapsed) {
+            _row++;
+        }
+
+        VROBodyPlayerStatus status = _status;
+        if (_row + 1 >= rows && elapsed >= _stream->getAnimRowTimestamp(rows - 1)) {
+            status = VROBodyPlayerStatus::Finished;
+        }
+        std::shared_ptr<VROBodyPlayerDelegate> delegate = _bodyMeshDelegate_w.lock();
+        if (delegate) {
+            delegate->onBodyJointsPlayback(_stream->getAnimRowJoints(_row), status);
+        }
+
+        if (status == VROBodyPlayerStatus::Finished) {
+            if (_looping) {
+                _row = 0;
+                _startTime = VROTimeCurrentMillis();
+                _status = VROBodyPlayerStatus::Start;
+            } else {
+                _status = VROBodyPlayerStatus::Finished;
+            }
+        } else if (_status == VROBodyPlayerStatus::Start) {
+            _status = VROBodyPlayerStatus::Playing;
+        }
+    }
+
+    void onFrameDidRender(const VRORenderContext & /* context */) {}
+
+private:
+
+    std::shared_ptr<VROBodyAnimDataReader> _jsonReader;
+    std::shared_ptr<VROBodyAnimStream> _stream;
+
+    VROBodyPlayerStatus _status;
+    long _row;
+    bool _looping;
+    double _startTime;
+    double _pausedTime;
+
+    void setStream(std::shared_ptr<VROBodyAnimStream> stream) {
+        _stream = stream;
+        resetPlayback();
+    }
+
+    void resetPlayback() {
+        _status = VROBodyPlayerStatus::Initialized;
+        _row = 0;
+        _looping = false;
+        _startTime = 0;
+        _pausedTime = 0;
+    }
+
+};
+
+#endif /* VROBodyAnimStream_h */
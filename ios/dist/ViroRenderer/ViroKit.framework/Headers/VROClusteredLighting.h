@@ -0,0 +1,704 @@
+//
+//  VROClusteredLighting.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROClusteredLighting_h
+#define VROClusteredLighting_h
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <stdint.h>
+#include "VRODriver.h"
+#include "VROLight.h"
+#include "VROMath.h"
+#include "VROMatrix4f.h"
+#include "VROOpenGL.h"
+#include "VRORenderContext.h"
+#include "VROShaderModifier.h"
+#include "VROThreadPool.h"
+#include "VROTime.h"
+#include "VROUniform.h"
+
+struct VROClusterGridConfig {
+    int tilesX = 16;
+    int tilesY = 9;
+    int slices = 24;                  // Exponentially spaced depth slices between near and far
+    int maxLightsPerCluster = 128;    // Further lights in a cluster are dropped (and counted)
+};
+
+struct VROClusterStats {
+    int lights = 0;                   // Point and spot lights binned
+    int occupiedClusters = 0;
+    int maxClusterLights = 0;
+    int totalIndices = 0;             // Sum of every cluster's light count
+    int droppedIndices = 0;           // Indices beyond maxLightsPerCluster
+    double assignTimeMs = 0;
+};
+
+/*
+ A point or spot light in view space, reduced to what light assignment
+ needs. Spot lights are bounded by the smallest sphere around their cone.
+ */
+struct VROClusterLight {
+    float position[3];
+    float radius;                     // Attenuation end distance
+    float direction[3];
+    float cosOuterAngle;              // -1 for point lights
+    float boundsCenter[3];
+    float boundsRadius;
+};
+
+/*
+ Clustered (froxel) light assignment on the CPU. The view frustum is
+ divided into tilesX x tilesY screen tiles and exponentially spaced depth
+ slices. Each frame the point and spot lights are binned into the clusters
+ their bounds intersect, in parallel over slices, producing a compact list
+ of light indices per cluster. A fragment then evaluates only the lights of
+ its own cluster, rather than every light affecting its draw.
+
+ The output is two arrays: per cluster an (offset, count) pair into the
+ index list, ordered x-fastest then y then slice, and the index list
+ itself. Ambient and directional lights affect every cluster and are left
+ to the existing lighting path.
+
+ Assignment has no GL dependency and can run and be benchmarked headlessly;
+ VROClusteredLightUploader uploads the output for the GL driver, and
+ VROClusteredLighting runs both each frame for the materials it lights.
+ */
+class VROClusteredLightGrid {
+public:
+
+    VROClusteredLightGrid(VROClusterGridConfig config = VROClusterGridConfig()) :
+        _config(config), _near(0), _far(0) {
+        for (int i = 0; i < 16; i++) {
+            _projection[i] = 0;
+        }
+    }
+    virtual ~VROClusteredLightGrid() {}
+
+    const VROClusterGridConfig &getConfig() const { return _config; }
+    int getClusterCount() const { return _config.tilesX * _config.tilesY * _config.slices; }
+
+    /*
+     Set the camera projection (column-major) and its near and far planes.
+     The cluster bounds are only rebuilt when these change.
+     */
+    void setProjection(const float *projection, float near, float far) {
+        if (near == _near && far == _far && memcmp(projection, _projection, sizeof(_projection)) == 0) {
+            return;
+        }
+        memcpy(_projection, projection, sizeof(_projection));
+        _near = near;
+        _far = far;
+        buildClusterBounds();
+    }
+    void setProjection(const VROMatrix4f &projection, float near, float far) {
+        setProjection(projection.getArray(), near, far);
+    }
+
+    /*
+     Convert the scene's point and spot lights to view space with the given
+     view matrix (column-major). Returns the number of lights added; the
+     order defines the indices in the output.
+     */
+    int setLights(const std::vector<std::shared_ptr<VROLight>> &lights, const float *view) {
+        _lights.clear();
+        _sourceLights.clear();
+        for (const std::shared_ptr<VROLight> &light : lights) {
+            VROLightType type = light->getType();
+            if (type != VROLightType::Omni && type != VROLightType::Spot) {
+                continue;
+            }
+            VROVector3f p = light->getTransformedPosition();
+            VROVector3f d = light->getTransformedDirection();
+            float position[3], direction[3];
+            transformPoint(view, p.x, p.y, p.z, position);
+            transformDirection(view, d.x, d.y, d.z, direction);
+
+            float cosOuter = -1;
+            if (type == VROLightType::Spot) {
+                cosOuter = getSpotCosine(light->getSpotOuterAngle());
+            }
+            addLight(position, light->getAttenuationEndDistance(), direction, cosOuter);
+            _sourceLights.push_back(light.get());
+        }
+        return (int) _lights.size();
+    }
+
+    /*
+     Add a light already in view space. A cosOuterAngle of -1 (or any cone
+     wider than a hemisphere) is treated as a point light.
+     */
+    void addLight(const float *position, float radius, const float *direction, float cosOuterAngle) {
+        VROClusterLight light;
+        for (int c = 0; c < 3; c++) {
+            light.position[c] = position[c];
+            light.direction[c] = direction[c];
+            light.boundsCenter[c] = position[c];
+        }
+        light.radius = radius;
+        light.cosOuterAngle = cosOuterAngle;
+        light.boundsRadius = radius;
+
+        if (cosOuterAngle > 0) {
+            float length = sqrtf(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+            float inverseLength = length > 0 ? 1.0f / length : 0;
+            if (cosOuterAngle < 0.70710678f) {
+                // Wider than 45 degrees: bound the cone's base disk
+                float sinOuter = sqrtf(1 - cosOuterAngle * cosOuterAngle);
+                for (int c = 0; c < 3; c++) {
+                    light.boundsCenter[c] = position[c] + direction[c] * inverseLength * radius * cosOuterAngle;
+                }
+                light.boundsRadius = radius * sinOuter;
+            } else {
+                float r = radius / (2 * cosOuterAngle);
+                for (int c = 0; c < 3; c++) {
+                    light.boundsCenter[c] = position[c] + direction[c] * inverseLength * r;
+                }
+                light.boundsRadius = r;
+            }
+        }
+        _lights.push_back(light);
+    }
+
+    /*
+     Cosine of a spot cone's half-angle. VROLight's inner and outer angles
+     are full, edge-to-edge angles in degrees.
+     */
+    static float getSpotCosine(float angleDegrees) {
+        return cosf(toRadians(angleDegrees * 0.5f));
+    }
+
+    void clearLights() {
+        _lights.clear();
+        _sourceLights.clear();
+    }
+
+    const std::vector<VROClusterLight> &getLights() const { return _lights; }
+
+    /*
+     Source VROLight of each index, when lights were set with setLights().
+     */
+    const std::vector<VROLight *> &getSourceLights() const { return _sourceLights; }
+
+    /*
+     Bin the lights into clusters. setProjection() must have been called.
+     */
+    void assign() {
+        double start = VROTimeCurrentMillis();
+        const int slices = _config.slices;
+        const int tiles = _config.tilesX * _config.tilesY;
+        _sliceIndices.resize(slices);
+        _sliceDropped.assign(slices, 0);
+        _clusters.assign((size_t) getClusterCount() * 2, 0);
+
+        VROThreadPool::shared().parallelFor(slices, 1, [this](int begin, int end) {
+            std::vector<int> candidates;
+            for (int slice = begin; slice < end; slice++) {
+                assignSlice(slice, candidates);
+            }
+        });
+
+        // Concatenate the per-slice lists, offsetting each cluster's range
+        _indices.clear();
+        _stats = VROClusterStats();
+        _stats.lights = (int) _lights.size();
+        for (int slice = 0; slice < slices; slice++) {
+            uint32_t base = (uint32_t) _indices.size();
+            _indices.insert(_indices.end(), _sliceIndices[slice].begin(), _sliceIndices[slice].end());
+            for (int tile = 0; tile < tiles; tile++) {
+                size_t cluster = (size_t) slice * tiles + tile;
+                _clusters[cluster * 2] += base;
+                uint32_t count = _clusters[cluster * 2 + 1];
+                if (count > 0) {
+                    _stats.occupiedClusters++;
+                    _stats.maxClusterLights = std::max(_stats.maxClusterLights, (int) count);
+                }
+            }
+            _stats.droppedIndices += _sliceDropped[slice];
+        }
+        _stats.totalIndices = (int) _indices.size();
+        _stats.assignTimeMs = VROTimeCurrentMillis() - start;
+    }
+
+    /*
+     (offset, count) into getLightIndices() for each cluster.
+     */
+    const std::vector<uint32_t> &getClusters() const { return _clusters; }
+    const std::vector<uint32_t> &getLightIndices() const { return _indices; }
+    const VROClusterStats &getStats() const { return _stats; }
+
+    /*
+     Index of the cluster containing the given view-space point, or -1 if
+     it is outside the frustum.
+     */
+    int getClusterIndex(float x, float y, float z) const {
+        float depth = -z;
+        if (depth < _near || depth >= _far) {
+            return -1;
+        }
+        float ndcX = (_projection[0] * x - _projection[8] * depth) / depth;
+        float ndcY = (_projection[5] * y - _projection[9] * depth) / depth;
+        if (ndcX < -1 || ndcX >= 1 || ndcY < -1 || ndcY >= 1) {
+            return -1;
+        }
+        int tileX = std::min((int) ((ndcX + 1) * 0.5f * _config.tilesX), _config.tilesX - 1);
+        int tileY = std::min((int) ((ndcY + 1) * 0.5f * _config.tilesY), _config.tilesY - 1);
+        int slice = getSlice(depth);
+        return (slice * _config.tilesY + tileY) * _config.tilesX + tileX;
+    }
+
+    /*
+     Depth slice containing the given positive view distance, matching the
+     slice computation in the shader.
+     */
+    int getSlice(float depth) const {
+        float slice = logf(depth / _near) / logf(_far / _near) * _config.slices;
+        return std::max(0, std::min((int) slice, _config.slices - 1));
+    }
+
+private:
+
+    VROClusterGridConfig _config;
+    float _projection[16];
+    float _near, _far;
+
+    /*
+     View-space AABB (min xyz, max xyz) of every cluster.
+     */
+    std::vector<float> _bounds;
+    std::vector<float> _sliceDepths;
+
+    std::vector<VROClusterLight> _lights;
+    std::vector<VROLight *> _sourceLights;
+
+    std::vector<std::vector<uint32_t>> _sliceIndices;
+    std::vector<int> _sliceDropped;
+    std::vector<uint32_t> _clusters;
+    std::vector<uint32_t> _indices;
+    VROClusterStats _stats;
+
+    static void transformPoint(const float *m, float x, float y, float z, float *out) {
+        out[0] = m[0] * x + m[4] * y + m[8]  * z + m[12];
+        out[1] = m[1] * x + m[5] * y + m[9]  * z + m[13];
+        out[2] = m[2] * x + m[6] * y + m[10] * z + m[14];
+    }
+    static void transformDirection(const float *m, float x, float y, float z, float *out) {
+        out[0] = m[0] * x + m[4] * y + m[8]  * z;
+        out[1] = m[1] * x + m[5] * y + m[9]  * z;
+        out[2] = m[2] * x + m[6] * y + m[10] * z;
+    }
+
+    void buildClusterBounds() {
+        const int tilesX = _config.tilesX, tilesY = _config.tilesY, slices = _config.slices;
+        _sliceDepths.resize(slices + 1);
+        for (int k = 0; k <= slices; k++) {
+            _sliceDepths[k] = _near * powf(_far / _near, (float) k / slices);
+        }
+
+        _bounds.resize((size_t) getClusterCount() * 6);
+        for (int k = 0; k < slices; k++) {
+            const float depths[2] = { _sliceDepths[k], _sliceDepths[k + 1] };
+            for (int j = 0; j < tilesY; j++) {
+                const float ndcY[2] = { -1 + 2.0f * j / tilesY, -1 + 2.0f * (j + 1) / tilesY };
+                for (int i = 0; i < tilesX; i++) {
+                    const float ndcX[2] = { -1 + 2.0f * i / tilesX, -1 + 2.0f * (i + 1) / tilesX };
+                    float *bounds = &_bounds[(((size_t) k * tilesY + j) * tilesX + i) * 6];
+                    bounds[0] = bounds[1] = INFINITY;
+                    bounds[3] = bounds[4] = -INFINITY;
+                    bounds[2] = -depths[1];
+                    bounds[5] = -depths[0];
+
+                    // The tile's corners at the slice's near and far depths
+                    for (float d : depths) {
+                        for (float nx : ndcX) {
+                            float x = (nx + _projection[8]) * d / _projection[0];
+                            bounds[0] = std::min(bounds[0], x);
+                            bounds[3] = std::max(bounds[3], x);
+                        }
+                        for (float ny : ndcY) {
+                            float y = (ny + _projection[9]) * d / _projection[5];
+                            bounds[1] = std::min(bounds[1], y);
+                            bounds[4] = std::max(bounds[4], y);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static bool intersects(const float *bounds, const float *center, float radius) {
+        float distance = 0;
+        for (int c = 0; c < 3; c++) {
+            float v = center[c];
+            if (v < bounds[c]) {
+                distance += (bounds[c] - v) * (bounds[c] - v);
+            } else if (v > bounds[c + 3]) {
+                distance += (v - bounds[c + 3]) * (v - bounds[c + 3]);
+            }
+        }
+        return distance <= radius * radius;
+    }
+
+    void assignSlice(int slice, std::vector<int> &candidates) {
+        const int tiles = _config.tilesX * _config.tilesY;
+        const float sliceNear = _sliceDepths[slice];
+        const float sliceFar = _sliceDepths[slice + 1];
+
+        // Lights whose bounds overlap the slice's depth range
+        candidates.clear();
+        for (int l = 0; l < (int) _lights.size(); l++) {
+            const VROClusterLight &light = _lights[l];
+            float depth = -light.boundsCenter[2];
+            if (depth + light.boundsRadius >= sliceNear && depth - light.boundsRadius <= sliceFar) {
+                candidates.push_back(l);
+            }
+        }
+
+        std::vector<uint32_t> &indices = _sliceIndices[slice];
+        indices.clear();
+        int dropped = 0;
+        for (int tile = 0; tile < tiles; tile++) {
+            size_t cluster = (size_t) slice * tiles + tile;
+            const float *bounds = &_bounds[cluster * 6];
+            uint32_t offset = (uint32_t) indices.size();
+            uint32_t count = 0;
+            for (int l : candidates) {
+                const VROClusterLight &light = _lights[l];
+                if (!intersects(bounds, light.boundsCenter, light.boundsRadius)) {
+                    continue;
+                }
+                if ((int) count == _config.maxLightsPerCluster) {
+                    dropped++;
+                    continue;
+                }
+                indices.push_back((uint32_t) l);
+                count++;
+            }
+            _clusters[cluster * 2] = offset;
+            _clusters[cluster * 2 + 1] = count;
+        }
+        _sliceDropped[slice] = dropped;
+    }
+
+};
+
+/*
+ GLSL, one line per string, for a Fragment entry VROShaderModifier that lights
+ the fragment with the point and spot lights of its cluster. The cluster
+ grid is an RG32UI texture (tilesX * tilesY wide, one row per slice), the
+ index list an R32UI texture kClusterIndexTextureWidth texels wide (emitted
+ into the source as cluster_index_width), and the light data an RGBA32F
+ texture with four texels per light (see VROClusteredLightUploader).
+
+ Each light is evaluated with the attenuation of the standard lighting
+ functions and the Blinn terms, and added to _output_color scaled by the
+ surface's diffuse and specular colors. It runs at the Fragment entry rather
+ than the LightingModel entry because the latter is spliced into the loop
+ over the lights uniform block: once per light there, and not at all when
+ the block is empty.
+ */
+static const int kClusterIndexTextureWidth = 1024;
+inline std::vector<std::string> VROClusteredLightingShaderSource() {
+    return {
+        "uniform highp usampler2D cluster_grid;",
+        "uniform highp usampler2D cluster_indices;",
+        "uniform highp sampler2D cluster_lights;",
+        "uniform highp vec4 cluster_viewport;",        // x, y, width, height
+        "uniform highp vec4 cluster_params;",          // tilesX, tilesY, slices, 0
+        "uniform highp vec2 cluster_depth;",           // near, slices / log(far / near)
+        "uniform highp mat4 cluster_view_matrix;",
+        "const highp int cluster_index_width = " + std::to_string(kClusterIndexTextureWidth) + ";",
+        "highp vec3 cluster_position = (cluster_view_matrix * vec4(_surface.position, 1.0)).xyz;",
+        "highp vec3 cluster_normal = normalize(mat3(cluster_view_matrix) * _surface.normal);",
+        "highp vec3 cluster_view = normalize(-cluster_position);",
+        "highp vec2 cluster_uv = (gl_FragCoord.xy - cluster_viewport.xy) / cluster_viewport.zw;",
+        "highp ivec2 cluster_tile = clamp(ivec2(cluster_uv * cluster_params.xy), ivec2(0), ivec2(cluster_params.xy) - 1);",
+        "highp int cluster_slice = clamp(int(log(-cluster_position.z / cluster_depth.x) * cluster_depth.y), 0, int(cluster_params.z) - 1);",
+        "highp uvec2 cluster_range = texelFetch(cluster_grid, ivec2(cluster_tile.y * int(cluster_params.x) + cluster_tile.x, cluster_slice), 0).rg;",
+        "highp vec3 cluster_diffuse = vec3(0.0);",
+        "highp vec3 cluster_specular = vec3(0.0);",
+        "for (highp uint cluster_i = 0u; cluster_i < cluster_range.y; cluster_i++) {",
+        "    highp int cluster_index = int(cluster_range.x + cluster_i);",
+        "    highp int cluster_light = int(texelFetch(cluster_indices, ivec2(cluster_index % cluster_index_width, cluster_index / cluster_index_width), 0).r);",
+        "    highp vec4 cluster_position_radius = texelFetch(cluster_lights, ivec2(0, cluster_light), 0);",
+        "    highp vec4 cluster_color_start = texelFetch(cluster_lights, ivec2(1, cluster_light), 0);",
+        "    highp vec4 cluster_direction_outer = texelFetch(cluster_lights, ivec2(2, cluster_light), 0);",
+        "    highp vec4 cluster_inner_falloff = texelFetch(cluster_lights, ivec2(3, cluster_light), 0);",
+        "    highp vec3 cluster_to_light = cluster_position_radius.xyz - cluster_position;",
+        "    highp float cluster_distance = length(cluster_to_light);",
+        "    highp vec3 cluster_L = cluster_to_light / max(cluster_distance, 0.0001);",
+        "    highp float cluster_d = clamp((cluster_distance - cluster_color_start.w) / max(cluster_position_radius.w - cluster_color_start.w, 0.0001), 0.0, 1.0);",
+        "    highp float cluster_attenuation = 1.0 - pow(cluster_d, 1.0 / cluster_inner_falloff.y);",
+        "    if (cluster_direction_outer.w > -1.0) {",
+        "        highp float cluster_theta = dot(cluster_L, normalize(-cluster_direction_outer.xyz));",
+        "        cluster_attenuation *= clamp((cluster_theta - cluster_direction_outer.w) / max(0.0001, cluster_inner_falloff.x - cluster_direction_outer.w), 0.0, 1.0);",
+        "    }",
+        "    highp float cluster_lambert = max(dot(cluster_normal, cluster_L), 0.0);",
+        "    highp vec3 cluster_H = normalize(cluster_L + cluster_view);",
+        "    cluster_diffuse += cluster_color_start.rgb * cluster_lambert * cluster_attenuation;",
+        "    cluster_specular += cluster_color_start.rgb * pow(max(dot(cluster_normal, cluster_H), 0.0), _surface.shininess) * cluster_attenuation;",
+        "}",
+        "_output_color.rgb += cluster_diffuse * _surface.diffuse_color.xyz * _surface.diffuse_intensity + cluster_specular * _surface.specular_color;",
+    };
+}
+
+/*
+ Uploads a VROClusteredLightGrid's output to the three textures read by
+ VROClusteredLightingShaderSource(). Light data is four texels per light:
+ position and radius; color (premultiplied by intensity) and attenuation
+ start; direction and cos outer angle; cos inner angle and falloff
+ exponent. Must be used on the rendering thread.
+
+ Textures are bound through the driver rather than with glBindTexture, so
+ the driver's record of what is bound on each unit stays valid and binds of
+ textures already in place are dropped.
+ */
+class VROClusteredLightUploader {
+public:
+
+    VROClusteredLightUploader() {
+        for (int i = 0; i < 3; i++) {
+            _textures[i] = 0;
+            _width[i] = _height[i] = 0;
+        }
+    }
+    virtual ~VROClusteredLightUploader() {
+        if (_textures[0]) {
+            GL( glDeleteTextures(3, _textures) );
+        }
+    }
+
+    void upload(const VROClusteredLightGrid &grid, std::shared_ptr<VRODriver> &driver) {
+        if (!_textures[0]) {
+            GL( glGenTextures(3, _textures) );
+        }
+        const VROClusterGridConfig &config = grid.getConfig();
+        uploadTexture(0, GL_RG32UI, GL_RG_INTEGER, GL_UNSIGNED_INT, config.tilesX * config.tilesY, config.slices,
+                      grid.getClusters().data(), driver);
+
+        _indices = grid.getLightIndices();
+        int rows = std::max(1, (int) (_indices.size() + kClusterIndexTextureWidth - 1) / kClusterIndexTextureWidth);
+        _indices.resize((size_t) rows * kClusterIndexTextureWidth, 0);
+        uploadTexture(1, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, kClusterIndexTextureWidth, rows, _indices.data(),
+                      driver);
+
+        const std::vector<VROClusterLight> &lights = grid.getLights();
+        const std::vector<VROLight *> &sources = grid.getSourceLights();
+        _lightData.assign(std::max<size_t>(1, lights.size()) * 16, 0);
+        for (size_t l = 0; l < lights.size(); l++) {
+            const VROClusterLight &light = lights[l];
+            float *texels = &_lightData[l * 16];
+            texels[0] = light.position[0];
+            texels[1] = light.position[1];
+            texels[2] = light.position[2];
+            texels[3] = light.radius;
+            texels[8] = light.direction[0];
+            texels[9] = light.direction[1];
+            texels[10] = light.direction[2];
+            texels[11] = light.cosOuterAngle;
+            if (l < sources.size()) {
+                const VROLight *source = sources[l];
+                VROVector3f color = source->getColor();
+                float intensity = source->getIntensity() / 1000.0f;
+                texels[4] = color.x * intensity;
+                texels[5] = color.y * intensity;
+                texels[6] = color.z * intensity;
+                texels[7] = source->getAttenuationStartDistance();
+                texels[12] = source->getType() == VROLightType::Spot ?
+                             VROClusteredLightGrid::getSpotCosine(source->getSpotInnerAngle()) : -1;
+                texels[13] = source->getAttenuationFalloffExponent();
+            }
+        }
+        uploadTexture(2, GL_RGBA32F, GL_RGBA, GL_FLOAT, 4, (int) std::max<size_t>(1, lights.size()), _lightData.data(),
+                      driver);
+    }
+
+    /*
+     Bind the grid, index and light textures to the given texture units
+     (0-based indices).
+     */
+    void bind(int gridUnit, int indicesUnit, int lightsUnit, std::shared_ptr<VRODriver> &driver) {
+        const int units[3] = { gridUnit, indicesUnit, lightsUnit };
+        for (int i = 0; i < 3; i++) {
+            driver->setActiveTextureUnit(GL_TEXTURE0 + units[i]);
+            driver->bindTexture(GL_TEXTURE_2D, _textures[i]);
+        }
+    }
+
+private:
+
+    GLuint _textures[3];
+    int _width[3], _height[3];
+    std::vector<uint32_t> _indices;
+    std::vector<float> _lightData;
+
+    void uploadTexture(int i, GLenum internalFormat, GLenum format, GLenum type, int width, int height,
+                       const void *data, std::shared_ptr<VRODriver> &driver) {
+        driver->bindTexture(GL_TEXTURE_2D, _textures[i]);
+        if (width != _width[i] || height != _height[i]) {
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST) );
+            GL( glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, data) );
+            _width[i] = width;
+            _height[i] = height;
+        } else {
+            GL( glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, data) );
+        }
+    }
+
+};
+
+/*
+ Lights materials with clustered point and spot lights. Add the shader
+ modifier to each material to be lit this way, then call update() once per
+ frame on the rendering thread, before the scene is drawn, with the lights
+ and the frame's context. update() assigns the lights to the clusters,
+ uploads the result, and binds the three textures on the units starting at
+ firstTextureUnit; the modifier's uniform binders point the samplers at
+ those units and pass the frame's viewport, projection and view.
+
+ The textures stay bound on their units for the whole frame, so the units
+ must not be used by the materials' own textures. The defaults are the last
+ three of the sixteen units OpenGL ES 3.0 guarantees.
+
+ The lights passed to update() should not also be in the materials' lights
+ uniform block, or they would be applied twice. Ambient and directional
+ lights are not clustered and stay in the block.
+ */
+class VROClusteredLighting {
+public:
+
+    VROClusteredLighting(VROClusterGridConfig config = VROClusterGridConfig(), int firstTextureUnit = 13) :
+        _grid(config),
+        _firstTextureUnit(firstTextureUnit),
+        _frame(std::make_shared<FrameUniforms>()) {
+
+        _modifier = std::make_shared<VROShaderModifier>(VROShaderEntryPoint::Fragment,
+                                                        VROClusteredLightingShaderSource());
+        _modifier->setName("clustered");
+
+        static const char *samplers[3] = { "cluster_grid", "cluster_indices", "cluster_lights" };
+        for (int i = 0; i < 3; i++) {
+            int unit = firstTextureUnit + i;
+            _modifier->setUniformBinder(samplers[i], VROShaderProperty::Int,
+                                        [unit](VROUniform *uniform, const VROGeometry *geometry, const VROMaterial *material) {
+                                            uniform->setInt(unit);
+                                        });
+        }
+
+        std::shared_ptr<FrameUniforms> frame = _frame;
+        _modifier->setUniformBinder("cluster_viewport", VROShaderProperty::Vec4,
+                                    [frame](VROUniform *uniform, const VROGeometry *geometry, const VROMaterial *material) {
+                                        uniform->set(frame->viewport);
+                                    });
+        _modifier->setUniformBinder("cluster_params", VROShaderProperty::Vec4,
+                                    [frame](VROUniform *uniform, const VROGeometry *geometry, const VROMaterial *material) {
+                                        uniform->set(frame->params);
+                                    });
+        _modifier->setUniformBinder("cluster_depth", VROShaderProperty::Vec2,
+                                    [frame](VROUniform *uniform, const VROGeometry *geometry, const VROMaterial *material) {
+                                        uniform->set(frame->depth);
+                                    });
+        _modifier->setUniformBinder("cluster_view_matrix", VROShaderProperty::Mat4,
+                                    [frame](VROUniform *uniform, const VROGeometry *geometry, const VROMaterial *material) {
+                                        uniform->set(frame->view);
+                                    });
+    }
+    virtual ~VROClusteredLighting() {}
+
+    /*
+     The modifier to add to each material lit by the clusters, through
+     VROMaterial::addShaderModifier.
+     */
+    std::shared_ptr<VROShaderModifier> getShaderModifier() const {
+        return _modifier;
+    }
+
+    /*
+     Assign the given lights for the frame described by the context, upload
+     the result and bind it for the frame's draws.
+     */
+    void update(const std::vector<std::shared_ptr<VROLight>> &lights, const VRORenderContext &context,
+                std::shared_ptr<VRODriver> &driver) {
+        float near = context.getZNear();
+        float far = context.getZFar();
+        VROMatrix4f view = context.getViewMatrix();
+
+        _grid.setProjection(context.getProjectionMatrix(), near, far);
+        _grid.setLights(lights, view.getArray());
+        _grid.assign();
+        _uploader.upload(_grid, driver);
+        _uploader.bind(_firstTextureUnit, _firstTextureUnit + 1, _firstTextureUnit + 2, driver);
+
+        // Leave unit 0 active, so textures created later in the frame are
+        // not bound over the cluster textures
+        driver->setActiveTextureUnit(GL_TEXTURE0);
+
+        const VROClusterGridConfig &config = _grid.getConfig();
+        VROViewport viewport = context.getViewport();
+        _frame->viewport[0] = viewport.getX();
+        _frame->viewport[1] = viewport.getY();
+        _frame->viewport[2] = viewport.getWidth();
+        _frame->viewport[3] = viewport.getHeight();
+        _frame->params[0] = config.tilesX;
+        _frame->params[1] = config.tilesY;
+        _frame->params[2] = config.slices;
+        _frame->params[3] = 0;
+        _frame->depth[0] = near;
+        _frame->depth[1] = config.slices / logf(far / near);
+        memcpy(_frame->view, view.getArray(), sizeof(_frame->view));
+    }
+
+    const VROClusteredLightGrid &getGrid() const {
+        return _grid;
+    }
+
+private:
+
+    /*
+     Values for the modifier's uniforms, written by update() and read by the
+     binders whenever a program with the modifier is bound. Shared with the
+     binders, which may outlive this object through the modifier.
+     */
+    struct FrameUniforms {
+        float viewport[4] = {};
+        float params[4] = {};
+        float depth[2] = {};
+        float view[16] = {};
+    };
+
+    VROClusteredLightGrid _grid;
+    VROClusteredLightUploader _uploader;
+    int _firstTextureUnit;
+    std::shared_ptr<FrameUniforms> _frame;
+    std::shared_ptr<VROShaderModifier> _modifier;
+
+};
+
+#endif /* VROClusteredLighting_h */
@@ -62,6 +62,13 @@
 
 #define VRO_METAL 0
 
+// True when compiled together with Bullet, as the renderer itself is. The
+// prebuilt framework ships neither Bullet's headers nor its symbols, so code
+// that calls into Bullet directly is compiled out everywhere else.
+#ifndef VRO_PHYSICS_BULLET
+#define VRO_PHYSICS_BULLET 0
+#endif
+
 // True if building for Posemoji
 #define VRO_POSEMOJI 1
 
@@ -0,0 +1,568 @@
+//
+//  VRODepthFilter.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VRODepthFilter_h
+#define VRODepthFilter_h
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include "VRODepthImage.h"
+#include "VROSIMD.h"
+#include "VROThreadPool.h"
+#include "VROTime.h"
+
+/**
+ * An 8-bit luma plane, such as the Y plane of the camera's NV12 image. Used
+ * as the guide for edge-aware upsampling. Not owned.
+ */
+struct VROLumaImage {
+    int width = 0;
+    int height = 0;
+    int bytesPerRow = 0;
+    const uint8_t *luma = nullptr;
+
+    bool isValid() const {
+        return width > 0 && height > 0 && bytesPerRow >= width && luma != nullptr;
+    }
+};
+
+/**
+ * Settings for VRODepthFilter.
+ */
+struct VRODepthFilterConfig {
+    float minConfidence = 0.2f;         // Input depth below this confidence (0.0-1.0) is ignored
+    float maxDepth = 8.0f;              // Input depth beyond this distance in meters is ignored
+
+    /**
+     * Temporal filtering. History is reprojected into the current frame using
+     * the camera pose delta, and is only blended where it agrees with the new
+     * depth to within temporalAgreement (relative), so moving objects and
+     * disocclusions reset instead of ghosting. maxHistory caps the
+     * accumulated weight, in frames of full-confidence depth. It is internal
+     * to the blend and does not scale the output confidence.
+     */
+    bool temporalEnabled = true;
+    float temporalAgreement = 0.05f;
+    float maxHistory = 8.0f;
+
+    /**
+     * Joint-bilateral upsampling to the guide resolution. spatialSigma is in
+     * depth pixels, rangeSigma in luma levels (0-255).
+     */
+    bool upsampleEnabled = true;
+    float spatialSigma = 1.0f;
+    float rangeSigma = 12.0f;
+};
+
+/**
+ * Timings and counters from the last VRODepthFilter::process().
+ */
+struct VRODepthFilterStats {
+    int outputWidth = 0;
+    int outputHeight = 0;
+    int validPixels = 0;                // Input pixels that passed the depth and confidence filters
+    int reprojectedPixels = 0;          // Pixels blended with reprojected history
+    double temporalTimeMs = 0.0;
+    double upsampleTimeMs = 0.0;
+    double totalTimeMs = 0.0;
+};
+
+/**
+ * VRODepthFilter is a reusable CPU stage that cleans up depth before it is
+ * consumed (occlusion textures, world meshing, TSDF fusion, detection
+ * resolving). It is independent of the depth source: LiDAR, ARCore depth and
+ * VROMonocularDepthEstimator output all arrive as VRODepthImages.
+ *
+ * Each process() call runs two passes, both vectorized with VROFloat4 and
+ * parallelized over rows on the VROThreadPool:
+ *
+ * 1. Temporal filtering and confidence fusion, at depth resolution. Each
+ *    valid pixel is unprojected, moved into the previous camera with the pose
+ *    delta, and compared against the filtered depth there. Agreeing history
+ *    is blended in, weighted by its accumulated confidence against the
+ *    current pixel's sensor confidence. The output confidence is the fused
+ *    weight clamped to 1, so a single full-confidence frame is already fully
+ *    confident; the maxHistory cap only bounds how much history outweighs
+ *    new depth.
+ *
+ * 2. Joint-bilateral upsampling to the resolution of a luma guide image.
+ *    Each output pixel takes a 4x4 low-resolution neighborhood, weighted by
+ *    spatial distance, by the luma difference between the output pixel and
+ *    each neighbor (so depth edges snap to image edges) and by confidence.
+ *    Polynomial kernels are used instead of Gaussians to avoid per-lane
+ *    exponentials.
+ *
+ * The guide must cover the same field of view as the depth image, as with
+ * ARKit's sceneDepth and capturedImage. Buffers are reused across frames.
+ * Not thread-safe; process from a single thread.
+ */
+class VRODepthFilter {
+public:
+
+    VRODepthFilter(VRODepthFilterConfig config = VRODepthFilterConfig()) :
+        _config(config), _width(0), _height(0), _rowStride(0),
+        _hasHistory(false), _outputWidth(0), _outputHeight(0) {}
+    virtual ~VRODepthFilter() {}
+
+    /**
+     * Filter the given depth frame. If guide is non-null and upsampling is
+     * enabled, the output is at the guide's resolution; otherwise it is at
+     * the depth resolution.
+     */
+    void process(const VRODepthImage &depth, const VROLumaImage *guide = nullptr) {
+        double startTime = VROTimeCurrentMillis();
+        _stats = VRODepthFilterStats();
+        if (!depth.isValid()) {
+            return;
+        }
+
+        if (depth.width != _width || depth.height != _height) {
+            _width = depth.width;
+            _height = depth.height;
+            _rowStride = (depth.width + 3) & ~3;
+            for (std::vector<float> *buffer : { &_depth, &_weight, &_previousDepth, &_previousWeight }) {
+                buffer->assign((size_t) _rowStride * _height, 0.0f);
+            }
+            _hasHistory = false;
+        }
+        std::swap(_depth, _previousDepth);
+        std::swap(_weight, _previousWeight);
+
+        double temporalStart = VROTimeCurrentMillis();
+        filterTemporal(depth);
+        _stats.temporalTimeMs = VROTimeCurrentMillis() - temporalStart;
+
+        _previousCameraToWorld = depth.cameraToWorld;
+        _previousIntrinsics[0] = depth.fx;
+        _previousIntrinsics[1] = depth.fy;
+        _previousIntrinsics[2] = depth.cx;
+        _previousIntrinsics[3] = depth.cy;
+        _hasHistory = true;
+
+        _output = depth;
+        if (guide && guide->isValid() && _config.upsampleEnabled) {
+            double upsampleStart = VROTimeCurrentMillis();
+            upsample(*guide);
+            _stats.upsampleTimeMs = VROTimeCurrentMillis() - upsampleStart;
+
+            float sx = (float) guide->width / _width;
+            float sy = (float) guide->height / _height;
+            _output.fx = depth.fx * sx;
+            _output.fy = depth.fy * sy;
+            _output.cx = (depth.cx + 0.5f) * sx - 0.5f;
+            _output.cy = (depth.cy + 0.5f) * sy - 0.5f;
+        }
+        else {
+            copyLowResolutionOutput();
+        }
+
+        _output.width = _outputWidth;
+        _output.height = _outputHeight;
+        _output.depth = _outputDepth.data();
+        _output.confidence = _outputConfidence.data();
+
+        _stats.outputWidth = _outputWidth;
+        _stats.outputHeight = _outputHeight;
+        _stats.totalTimeMs = VROTimeCurrentMillis() - startTime;
+    }
+
+    /**
+     * The filtered depth as a VRODepthImage (same pose, intrinsics scaled to
+     * the output resolution), valid until the next process() call.
+     */
+    const VRODepthImage &getOutput() const {
+        return _output;
+    }
+
+    /**
+     * Drop the temporal history, e.g. on tracking loss or session reset.
+     */
+    void resetHistory() {
+        _hasHistory = false;
+    }
+
+    void setConfig(VRODepthFilterConfig config) { _config = config; }
+    const VRODepthFilterConfig &getConfig() const { return _config; }
+    const VRODepthFilterStats &getStats() const { return _stats; }
+
+private:
+
+    VRODepthFilterConfig _config;
+
+    /*
+     Depth-resolution buffers, rows padded to a multiple of 4. _weight is the
+     fused confidence weight (0 for invalid pixels).
+     */
+    int _width, _height, _rowStride;
+    std::vector<float> _depth, _weight;
+    std::vector<float> _previousDepth, _previousWeight;
+
+    /*
+     Previous frame's pose and intrinsics (fx, fy, cx, cy).
+     */
+    VROMatrix4f _previousCameraToWorld;
+    float _previousIntrinsics[4];
+    bool _hasHistory;
+
+    /*
+     Padded low-resolution depth, weight and guide luma for upsampling, with
+     zero-weight borders so each 4x4 window loads without bounds checks.
+     */
+    std::vector<float> _paddedDepth, _paddedWeight, _paddedLuma;
+
+    /*
+     Per output column: the window's low-resolution origin and its four
+     horizontal spatial weights.
+     */
+    std::vector<int> _columnOrigins;
+    std::vector<float> _columnWeights;
+
+    int _outputWidth, _outputHeight;
+    std::vector<float> _outputDepth;
+    std::vector<uint8_t> _outputConfidence;
+    VRODepthImage _output;
+
+    VRODepthFilterStats _stats;
+
+#pragma mark - Temporal Filtering
+
+    static int countLanes(int mask) {
+        return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+    }
+
+    /*
+     Row-major 3x4 rigid transform from the current camera to the previous
+     camera: previous world-to-camera (the transpose-inverse of the rigid
+     pose) times the current camera-to-world.
+     */
+    void computeCurrentToPrevious(const VROMatrix4f &current, float *out) const {
+        const VROMatrix4f &p = _previousCameraToWorld;
+        for (int row = 0; row < 3; row++) {
+            // Row of R_prev^T is column 'row' of the previous pose
+            float r0 = p[row * 4 + 0], r1 = p[row * 4 + 1], r2 = p[row * 4 + 2];
+            for (int col = 0; col < 4; col++) {
+                float v0 = current[col * 4 + 0], v1 = current[col * 4 + 1], v2 = current[col * 4 + 2];
+                if (col == 3) {
+                    v0 -= p[12];
+                    v1 -= p[13];
+                    v2 -= p[14];
+                }
+                out[row * 4 + col] = r0 * v0 + r1 * v1 + r2 * v2;
+            }
+        }
+    }
+
+    void filterTemporal(const VRODepthImage &image) {
+        bool temporal = _config.temporalEnabled && _hasHistory;
+        float transform[12];
+        if (temporal) {
+            computeCurrentToPrevious(image.cameraToWorld, transform);
+        }
+
+        std::vector<int> valid(_height, 0), reprojected(_height, 0);
+        VROThreadPool::shared().parallelFor(_height, 4, [&](int start, int end) {
+            for (int y = start; y < end; y++) {
+                filterTemporalRow(image, y, temporal ? transform : nullptr, &valid[y], &reprojected[y]);
+            }
+        });
+        for (int y = 0; y < _height; y++) {
+            _stats.validPixels += valid[y];
+            _stats.reprojectedPixels += reprojected[y];
+        }
+    }
+
+    void filterTemporalRow(const VRODepthImage &image, int y, const float *m,
+                           int *outValid, int *outReprojected) {
+        float rowDepth[4], rowConfidence[4];
+        float *depthOut = &_depth[(size_t) y * _rowStride];
+        float *weightOut = &_weight[(size_t) y * _rowStride];
+
+        const VROFloat4 zero = VROFloat4::splat(0.0f);
+        const VROFloat4 one = VROFloat4::splat(1.0f);
+        const VROFloat4 minWeight = VROFloat4::splat(1e-3f);
+        const VROFloat4 minConfidence = VROFloat4::splat(_config.minConfidence);
+        const VROFloat4 maxDepth = VROFloat4::splat(_config.maxDepth);
+        const VROFloat4 maxHistory = VROFloat4::splat(_config.maxHistory);
+        const VROFloat4 agreement = VROFloat4::splat(_config.temporalAgreement);
+        const VROFloat4 laneOffsets = VROFloat4::make(0, 1, 2, 3);
+        const VROFloat4 py = VROFloat4::splat(-(y - image.cy) / image.fy);
+
+        for (int x = 0; x < _rowStride; x += 4) {
+            for (int i = 0; i < 4; i++) {
+                int px = x + i;
+                float d = px < _width ? image.getDepth(px, y) : 0.0f;
+                rowDepth[i] = std::isfinite(d) ? d : 0.0f;
+                rowConfidence[i] = px < _width ? image.getConfidence(px, y) : 0.0f;
+            }
+            VROFloat4 d = VROFloat4::load(rowDepth);
+            VROFloat4 c = VROFloat4Max(VROFloat4::load(rowConfidence), minWeight);
+            VROFloat4 valid = VROFloat4And(VROFloat4And(VROFloat4Greater(d, zero), VROFloat4LessEqual(d, maxDepth)),
+                                           VROFloat4GreaterEqual(VROFloat4::load(rowConfidence), minConfidence));
+            *outValid += countLanes(valid.getMask());
+
+            VROFloat4 fused = d;
+            VROFloat4 weight = c;
+
+            if (m && valid.getMask()) {
+                // Unproject and move into the previous camera
+                VROFloat4 xs = VROFloat4::splat((float) x) + laneOffsets;
+                VROFloat4 cx = (xs - VROFloat4::splat(image.cx)) * VROFloat4::splat(1.0f / image.fx) * d;
+                VROFloat4 cy = py * d;
+                VROFloat4 cz = zero - d;
+                VROFloat4 qx = VROFloat4MulAdd(VROFloat4::splat(m[0]), cx, VROFloat4MulAdd(VROFloat4::splat(m[1]), cy,
+                               VROFloat4MulAdd(VROFloat4::splat(m[2]), cz, VROFloat4::splat(m[3]))));
+                VROFloat4 qy = VROFloat4MulAdd(VROFloat4::splat(m[4]), cx, VROFloat4MulAdd(VROFloat4::splat(m[5]), cy,
+                               VROFloat4MulAdd(VROFloat4::splat(m[6]), cz, VROFloat4::splat(m[7]))));
+                VROFloat4 qz = VROFloat4MulAdd(VROFloat4::splat(m[8]), cx, VROFloat4MulAdd(VROFloat4::splat(m[9]), cy,
+                               VROFloat4MulAdd(VROFloat4::splat(m[10]), cz, VROFloat4::splat(m[11]))));
+                VROFloat4 expected = zero - qz;
+                VROFloat4 inFront = VROFloat4Greater(expected, VROFloat4::splat(1e-3f));
+                VROFloat4 inverseZ = one / VROFloat4Select(inFront, expected, one);
+
+                VROFloat4 u = VROFloat4MulAdd(VROFloat4::splat(_previousIntrinsics[0]) * qx, inverseZ,
+                                              VROFloat4::splat(_previousIntrinsics[2] + 0.5f));
+                VROFloat4 v = VROFloat4MulAdd(VROFloat4::splat(-_previousIntrinsics[1]) * qy, inverseZ,
+                                              VROFloat4::splat(_previousIntrinsics[3] + 0.5f));
+
+                // Gather the history at the reprojected pixels
+                float historyDepth[4], historyWeight[4];
+                int sampleMask = VROFloat4And(valid, inFront).getMask();
+                for (int i = 0; i < 4; i++) {
+                    historyDepth[i] = 0.0f;
+                    historyWeight[i] = 0.0f;
+                    if (!(sampleMask & (1 << i))) {
+                        continue;
+                    }
+                    sampleHistory(u[i], v[i], &historyDepth[i], &historyWeight[i]);
+                }
+
+                VROFloat4 previous = VROFloat4::load(historyDepth);
+                VROFloat4 agrees = VROFloat4And(VROFloat4Greater(previous, zero),
+                                                VROFloat4LessEqual(VROFloat4Abs(previous - expected), agreement * expected));
+                VROFloat4 previousWeight = VROFloat4Select(agrees, VROFloat4::load(historyWeight), zero);
+                *outReprojected += countLanes(VROFloat4And(agrees, valid).getMask());
+
+                // The history's error in the previous camera, carried along the current ray
+                VROFloat4 compensated = d + (previous - expected);
+                VROFloat4 total = c + previousWeight;
+                fused = VROFloat4MulAdd(d, c, compensated * previousWeight) / total;
+                weight = VROFloat4Min(total, maxHistory);
+            }
+
+            VROFloat4Select(valid, fused, zero).store(depthOut + x);
+            VROFloat4Select(valid, weight, zero).store(weightOut + x);
+        }
+    }
+
+    /*
+     Sample the history at a reprojected position (pixel units, centers at
+     +0.5). History is interpolated bilinearly between pixel centers when all
+     four neighbours hold depth: sampling the nearest pixel instead reads a
+     sloped surface up to half a pixel away from where it is expected, and
+     that offset is fused into the history every frame the camera rotates.
+     Near holes and edges the nearest pixel is used so depth is never
+     interpolated across a discontinuity.
+     */
+    void sampleHistory(float fu, float fv, float *outDepth, float *outWeight) const {
+        if (!(fu >= 0.0f && fv >= 0.0f && fu < _width && fv < _height)) {
+            return;
+        }
+        float su = std::min(std::max(fu - 0.5f, 0.0f), (float) (_width - 1));
+        float sv = std::min(std::max(fv - 0.5f, 0.0f), (float) (_height - 1));
+        int x0 = (int) su, y0 = (int) sv;
+        int x1 = std::min(x0 + 1, _width - 1), y1 = std::min(y0 + 1, _height - 1);
+        float ax = su - x0, ay = sv - y0;
+
+        size_t i00 = (size_t) y0 * _rowStride + x0, i10 = (size_t) y0 * _rowStride + x1;
+        size_t i01 = (size_t) y1 * _rowStride + x0, i11 = (size_t) y1 * _rowStride + x1;
+        float d00 = _previousDepth[i00], d10 = _previousDepth[i10];
+        float d01 = _previousDepth[i01], d11 = _previousDepth[i11];
+
+        float lo = std::min(std::min(d00, d10), std::min(d01, d11));
+        float hi = std::max(std::max(d00, d10), std::max(d01, d11));
+        if (lo > 0.0f && hi - lo <= _config.temporalAgreement * lo) {
+            float w00 = (1 - ax) * (1 - ay), w10 = ax * (1 - ay), w01 = (1 - ax) * ay, w11 = ax * ay;
+            *outDepth = d00 * w00 + d10 * w10 + d01 * w01 + d11 * w11;
+            *outWeight = _previousWeight[i00] * w00 + _previousWeight[i10] * w10 +
+                         _previousWeight[i01] * w01 + _previousWeight[i11] * w11;
+            return;
+        }
+        size_t index = (size_t) ((int) fv) * _rowStride + (int) fu;
+        *outDepth = _previousDepth[index];
+        *outWeight = _previousWeight[index];
+    }
+
+    /*
+     Output confidence for a fused weight. Weights above 1 are accumulated
+     history, which makes the depth no more confident than one
+     full-confidence frame.
+     */
+    static uint8_t toConfidence(float weight) {
+        return (uint8_t) (std::min(1.0f, weight) * 255.0f);
+    }
+
+#pragma mark - Upsampling
+
+    void copyLowResolutionOutput() {
+        _outputWidth = _width;
+        _outputHeight = _height;
+        _outputDepth.resize((size_t) _width * _height);
+        _outputConfidence.resize((size_t) _width * _height);
+
+        for (int y = 0; y < _height; y++) {
+            const float *depth = &_depth[(size_t) y * _rowStride];
+            const float *weight = &_weight[(size_t) y * _rowStride];
+            for (int x = 0; x < _width; x++) {
+                _outputDepth[(size_t) y * _width + x] = depth[x];
+                _outputConfidence[(size_t) y * _width + x] = toConfidence(weight[x]);
+            }
+        }
+    }
+
+    void preparePaddedInputs(const VROLumaImage &guide) {
+        int paddedWidth = _width + 4;
+        size_t paddedSize = (size_t) paddedWidth * (_height + 4);
+        _paddedDepth.assign(paddedSize, 0.0f);
+        _paddedWeight.assign(paddedSize, 0.0f);
+        _paddedLuma.assign(paddedSize, 0.0f);
+
+        float sx = (float) guide.width / _width;
+        float sy = (float) guide.height / _height;
+        for (int y = 0; y < _height; y++) {
+            size_t row = (size_t) (y + 1) * paddedWidth + 1;
+            int gy = std::min(guide.height - 1, (int) ((y + 0.5f) * sy));
+            const uint8_t *lumaRow = guide.luma + (size_t) gy * guide.bytesPerRow;
+            for (int x = 0; x < _width; x++) {
+                int gx = std::min(guide.width - 1, (int) ((x + 0.5f) * sx));
+                _paddedDepth[row + x] = _depth[(size_t) y * _rowStride + x];
+                _paddedWeight[row + x] = _weight[(size_t) y * _rowStride + x];
+                _paddedLuma[row + x] = lumaRow[gx];
+            }
+        }
+    }
+
+    void upsample(const VROLumaImage &guide) {
+        preparePaddedInputs(guide);
+
+        _outputWidth = guide.width;
+        _outputHeight = guide.height;
+        _outputDepth.resize((size_t) _outputWidth * _outputHeight);
+        _outputConfidence.resize((size_t) _outputWidth * _outputHeight);
+
+        // The window origin and horizontal spatial weights only depend on the
+        // output column, so they are computed once per frame
+        float inverseSpatial = 1.0f / (_config.spatialSigma * _config.spatialSigma);
+        float inverseScaleX = (float) _width / _outputWidth;
+        _columnOrigins.resize(_outputWidth);
+        _columnWeights.resize((size_t) _outputWidth * 4);
+        for (int x = 0; x < _outputWidth; x++) {
+            float fx = (x + 0.5f) * inverseScaleX - 0.5f;
+            int x0 = std::max(0, std::min(_width - 1, (int) floorf(fx)));
+            _columnOrigins[x] = x0;
+            for (int i = 0; i < 4; i++) {
+                float dx = (x0 - 1 + i) - fx;
+                _columnWeights[(size_t) x * 4 + i] = 1.0f / (1.0f + dx * dx * inverseSpatial);
+            }
+        }
+
+        VROThreadPool::shared().parallelFor(_outputHeight, 8, [&](int start, int end) {
+            for (int y = start; y < end; y++) {
+                upsampleRow(guide, y);
+            }
+        });
+    }
+
+    void upsampleRow(const VROLumaImage &guide, int y) {
+        int paddedWidth = _width + 4;
+        float inverseScaleY = (float) _height / _outputHeight;
+        float inverseSpatial = 1.0f / (_config.spatialSigma * _config.spatialSigma);
+
+        const VROFloat4 zero = VROFloat4::splat(0.0f);
+        const VROFloat4 one = VROFloat4::splat(1.0f);
+        const VROFloat4 rangeScale = VROFloat4::splat(1.0f / (4.0f * _config.rangeSigma * _config.rangeSigma));
+
+        // Low-resolution row position and the vertical spatial weights of the window
+        float fy = (y + 0.5f) * inverseScaleY - 0.5f;
+        int y0 = std::max(0, std::min(_height - 1, (int) floorf(fy)));
+        VROFloat4 rowWeights[4];
+        for (int j = 0; j < 4; j++) {
+            float dy = (y0 - 1 + j) - fy;
+            rowWeights[j] = VROFloat4::splat(1.0f / (1.0f + dy * dy * inverseSpatial));
+        }
+
+        const uint8_t *lumaRow = guide.luma + (size_t) y * guide.bytesPerRow;
+        float *depthOut = &_outputDepth[(size_t) y * _outputWidth];
+        uint8_t *confidenceOut = &_outputConfidence[(size_t) y * _outputWidth];
+
+        for (int x = 0; x < _outputWidth; x++) {
+            VROFloat4 columnWeights = VROFloat4::load(&_columnWeights[(size_t) x * 4]);
+            VROFloat4 center = VROFloat4::splat((float) lumaRow[x]);
+
+            VROFloat4 depthSum = zero, weightSum = zero;
+            VROFloat4 fallbackDepthSum = zero, confidenceSum = zero, spatialSum = zero;
+
+            // Padded index of window element (x0 - 1, y0 - 1 + j) is (x0, y0 + j)
+            const size_t origin = (size_t) y0 * paddedWidth + _columnOrigins[x];
+            for (int j = 0; j < 4; j++) {
+                size_t offset = origin + (size_t) j * paddedWidth;
+                VROFloat4 depth = VROFloat4::load(&_paddedDepth[offset]);
+                VROFloat4 confidence = VROFloat4::load(&_paddedWeight[offset]);
+                VROFloat4 dl = VROFloat4::load(&_paddedLuma[offset]) - center;
+
+                // Range kernel (1 - dl^2 / 4 sigma^2)^2, zero beyond 2 sigma
+                VROFloat4 r = VROFloat4Max(zero, one - dl * dl * rangeScale);
+                VROFloat4 spatial = columnWeights * rowWeights[j];
+                VROFloat4 spatialConfidence = spatial * confidence;
+                VROFloat4 w = spatialConfidence * r * r;
+
+                depthSum = VROFloat4MulAdd(w, depth, depthSum);
+                weightSum = weightSum + w;
+                fallbackDepthSum = VROFloat4MulAdd(spatialConfidence, depth, fallbackDepthSum);
+                confidenceSum = confidenceSum + spatialConfidence;
+                spatialSum = spatialSum + spatial;
+            }
+
+            float totalWeight = VROFloat4HorizontalSum(weightSum);
+            float totalConfidence = VROFloat4HorizontalSum(confidenceSum);
+            if (totalWeight > 1e-6f) {
+                depthOut[x] = VROFloat4HorizontalSum(depthSum) / totalWeight;
+            }
+            else if (totalConfidence > 1e-6f) {
+                // No neighbor matches the pixel's luma: fall back to spatial weights
+                depthOut[x] = VROFloat4HorizontalSum(fallbackDepthSum) / totalConfidence;
+            }
+            else {
+                depthOut[x] = 0.0f;
+            }
+            float confidence = totalConfidence / VROFloat4HorizontalSum(spatialSum);
+            confidenceOut[x] = toConfidence(confidence);
+        }
+    }
+
+};
+
+#endif /* VRODepthFilter_h */
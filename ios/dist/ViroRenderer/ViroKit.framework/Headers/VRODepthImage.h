@@ -0,0 +1,114 @@
+//
+//  VRODepthImage.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VRODepthImage_h
+#define VRODepthImage_h
+
+#include <stdint.h>
+#include "VROVector3f.h"
+#include "VROMatrix4f.h"
+
+/**
+ * A CPU view of one depth frame: depth in meters, optional per-pixel
+ * confidence, the pinhole intrinsics of the depth image and the camera pose
+ * it was captured from.
+ *
+ * VRODepthImage does not own its pixels. It can wrap the depth buffer of a
+ * live AR frame (ARKit sceneDepth, ARCore raw depth converted to meters),
+ * the output of VROMonocularDepthEstimator, or a recorded sequence loaded
+ * from disk, which lets the depth consumers (world mesh, fusion) run
+ * headlessly.
+ */
+struct VRODepthImage {
+    int width = 0;
+    int height = 0;
+
+    /**
+     * Row-major depth in meters, width * height values. Zero or non-finite
+     * values are treated as missing.
+     */
+    const float *depth = nullptr;
+
+    /**
+     * Optional row-major confidence, width * height values in 0-255.
+     */
+    const uint8_t *confidence = nullptr;
+
+    /**
+     * Pinhole intrinsics in depth-image pixels.
+     */
+    float fx = 0;
+    float fy = 0;
+    float cx = 0;
+    float cy = 0;
+
+    /**
+     * Transform from camera space (Y up, looking down -Z) to world space.
+     */
+    VROMatrix4f cameraToWorld;
+
+    double timestamp = 0;
+
+    bool isValid() const {
+        return width > 0 && height > 0 && depth != nullptr && fx > 0 && fy > 0;
+    }
+
+    float getDepth(int x, int y) const {
+        return depth[y * width + x];
+    }
+
+    /**
+     * Confidence at the given pixel in [0, 1]; 1 if no confidence is available.
+     */
+    float getConfidence(int x, int y) const {
+        return confidence ? confidence[y * width + x] * (1.0f / 255.0f) : 1.0f;
+    }
+
+    /**
+     * Unproject the pixel at the given depth into camera space.
+     */
+    VROVector3f unprojectToCamera(float x, float y, float d) const {
+        return VROVector3f((x - cx) * d / fx, -(y - cy) * d / fy, -d);
+    }
+
+    /**
+     * Unproject the pixel at the given depth into world space.
+     */
+    VROVector3f unprojectToWorld(float x, float y, float d) const {
+        return transformPoint(cameraToWorld, unprojectToCamera(x, y, d));
+    }
+
+    /**
+     * Inline affine transform of a point by a column-major matrix, used by
+     * the per-pixel loops to avoid a call per sample.
+     */
+    static VROVector3f transformPoint(const VROMatrix4f &m, const VROVector3f &p) {
+        return VROVector3f(m[0] * p.x + m[4] * p.y + m[8]  * p.z + m[12],
+                           m[1] * p.x + m[5] * p.y + m[9]  * p.z + m[13],
+                           m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+    }
+};
+
+#endif /* VRODepthImage_h */
@@ -0,0 +1,498 @@
+//
+//  VRODepthMeshKernel.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VRODepthMeshKernel_h
+#define VRODepthMeshKernel_h
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdint.h>
+#include "VROARDepthMesh.h"
+#include "VRODepthImage.h"
+#include "VROSIMD.h"
+#include "VROThreadPool.h"
+#include "VROTime.h"
+
+/**
+ * Settings for VRODepthMeshKernel. stride, minConfidence and maxDepth have
+ * the same meaning as in VROWorldMeshConfig.
+ */
+struct VRODepthMeshKernelConfig {
+    int stride = 4;                     // Sample every Nth pixel
+    float minConfidence = 0.3f;         // Minimum confidence threshold (0.0-1.0)
+    float maxDepth = 5.0f;              // Maximum depth in meters
+
+    /**
+     * Edge-discontinuity rejection: a triangle is dropped if its longest edge
+     * is longer than this many sample spacings at the triangle's nearest
+     * depth. This removes the long, skinny triangles that otherwise bridge
+     * foreground and background at object silhouettes.
+     */
+    float maxEdgeRatio = 4.0f;
+};
+
+/**
+ * VRODepthMeshKernel converts a VRODepthImage into a world-space triangle
+ * mesh. It is a vectorized replacement for the scalar sample / unproject /
+ * filter / triangulate loop used to build VROARDepthMeshes:
+ *
+ * 1. Samples are unprojected four at a time (VROFloat4) into structure-of-
+ *    arrays position buffers, with the depth and confidence filters computed
+ *    as lane masks.
+ * 2. Quads are classified four at a time: validity, diagonal choice (the
+ *    shorter diagonal is used) and the edge-length test for each triangle.
+ * 3. Referenced samples are compacted into the vertex buffer and triangles are
+ *    written using per-row prefix sums, so every row is processed in parallel
+ *    on the VROThreadPool without synchronization.
+ *
+ * All buffers are owned by the kernel and reused across runs, so steady-state
+ * updates do not allocate. Indices are emitted as 16-bit whenever the vertex
+ * count allows it (stride 4 on a 256x192 LiDAR map is ~3K vertices), and as
+ * 32-bit otherwise.
+ *
+ * Building with VRO_SIMD_DISABLE selects the scalar path, which must produce
+ * identical output. VRODepthMeshKernelTests benchmarks one synthetic
+ * LiDAR-sized frame and the recorded room_orbit.vrds sequence.
+ */
+class VRODepthMeshKernel {
+public:
+
+    VRODepthMeshKernel() : _gridWidth(0), _gridHeight(0), _vertexCount(0), _triangleCount(0),
+        _uses16BitIndices(true), _lastRunTimeMs(0) {}
+    virtual ~VRODepthMeshKernel() {}
+
+    /**
+     * Mesh the given depth image. Results remain valid until the next run.
+     */
+    void run(const VRODepthImage &image, const VRODepthMeshKernelConfig &config) {
+        double startTime = VROTimeCurrentMillis();
+        _vertexCount = 0;
+        _triangleCount = 0;
+        if (!image.isValid()) {
+            return;
+        }
+
+        int stride = std::max(1, config.stride);
+        _gridWidth  = (image.width  - 1) / stride + 1;
+        _gridHeight = (image.height - 1) / stride + 1;
+        if (_gridWidth < 2 || _gridHeight < 2) {
+            return;
+        }
+
+        size_t samples = (size_t) _gridWidth * _gridHeight;
+        size_t quads = (size_t) (_gridWidth - 1) * (_gridHeight - 1);
+        for (std::vector<float> *buffer : { &_x, &_y, &_z, &_depth, &_confidence, &_valid }) {
+            // Padded so the 4-wide quad pass can read one past the final sample
+            buffer->resize(samples + 4);
+        }
+        _quadFlags.resize(quads);
+        _vertexIndex.resize(samples);
+        _rowVertexOffset.resize(_gridHeight + 1);
+        _rowTriangleOffset.resize(_gridHeight);
+
+        VROThreadPool &pool = VROThreadPool::shared();
+        pool.parallelFor(_gridHeight, 4, [&](int start, int end) {
+            for (int gy = start; gy < end; gy++) {
+                unprojectRow(image, config, stride, gy);
+            }
+        });
+
+        float spacingScale = config.maxEdgeRatio * stride / std::min(image.fx, image.fy);
+        pool.parallelFor(_gridHeight - 1, 4, [&](int start, int end) {
+            for (int qy = start; qy < end; qy++) {
+                classifyQuadRow(qy, spacingScale);
+            }
+        });
+
+        // Per-row vertex counts, then prefix sums
+        pool.parallelFor(_gridHeight, 8, [&](int start, int end) {
+            for (int gy = start; gy < end; gy++) {
+                _rowVertexOffset[gy + 1] = markUsedSamples(gy);
+            }
+        });
+        _rowVertexOffset[0] = 0;
+        for (int gy = 0; gy < _gridHeight; gy++) {
+            _rowVertexOffset[gy + 1] += _rowVertexOffset[gy];
+        }
+        _vertexCount = _rowVertexOffset[_gridHeight];
+
+        int triangles = 0;
+        for (int qy = 0; qy < _gridHeight - 1; qy++) {
+            _rowTriangleOffset[qy] = triangles;
+            triangles += countTriangles(qy);
+        }
+        _triangleCount = triangles;
+
+        _vertices.resize(_vertexCount);
+        _vertexConfidences.resize(_vertexCount);
+        _uses16BitIndices = _vertexCount <= 0xFFFF;
+        if (_uses16BitIndices) {
+            _indices16.resize(_triangleCount * 3);
+        }
+        else {
+            _indices32.resize(_triangleCount * 3);
+        }
+
+        pool.parallelFor(_gridHeight, 8, [&](int start, int end) {
+            for (int gy = start; gy < end; gy++) {
+                writeVertices(gy);
+            }
+        });
+        pool.parallelFor(_gridHeight - 1, 8, [&](int start, int end) {
+            for (int qy = start; qy < end; qy++) {
+                if (_uses16BitIndices) {
+                    writeTriangles<uint16_t>(qy, _indices16.data());
+                }
+                else {
+                    writeTriangles<uint32_t>(qy, _indices32.data());
+                }
+            }
+        });
+
+        _lastRunTimeMs = VROTimeCurrentMillis() - startTime;
+    }
+
+    int getVertexCount() const { return _vertexCount; }
+    int getTriangleCount() const { return _triangleCount; }
+
+    /**
+     * Vertex positions in world space, and their confidence. Only the first
+     * getVertexCount() entries are valid.
+     */
+    const std::vector<VROVector3f> &getVertices() const { return _vertices; }
+    const std::vector<float> &getConfidences() const { return _vertexConfidences; }
+
+    /**
+     * Triangle indices; use the 16-bit array if uses16BitIndices() is true,
+     * otherwise the 32-bit array. Only the first getTriangleCount() * 3
+     * entries are valid.
+     */
+    bool uses16BitIndices() const { return _uses16BitIndices; }
+    const std::vector<uint16_t> &getIndices16() const { return _indices16; }
+    const std::vector<uint32_t> &getIndices32() const { return _indices32; }
+
+    /**
+     * Copy the result into a VROARDepthMesh, for consumers (physics shapes,
+     * VROARWorldMesh) that take int indices. Returns nullptr if the last run
+     * produced no triangles.
+     */
+    std::shared_ptr<VROARDepthMesh> createDepthMesh() const {
+        if (_triangleCount == 0) {
+            return nullptr;
+        }
+        std::vector<int> indices(_triangleCount * 3);
+        for (int i = 0; i < _triangleCount * 3; i++) {
+            indices[i] = _uses16BitIndices ? (int) _indices16[i] : (int) _indices32[i];
+        }
+        return std::make_shared<VROARDepthMesh>(
+            std::vector<VROVector3f>(_vertices.begin(), _vertices.begin() + _vertexCount),
+            indices,
+            std::vector<float>(_vertexConfidences.begin(), _vertexConfidences.begin() + _vertexCount));
+    }
+
+    double getLastRunTimeMs() const { return _lastRunTimeMs; }
+
+private:
+
+    /*
+     Quad flag bits: which of the quad's two triangles were accepted, which
+     diagonal was used, and which corners the accepted triangles reference.
+     */
+    static const uint8_t kTriangleA = 1 << 0;
+    static const uint8_t kTriangleB = 1 << 1;
+    static const uint8_t kDiagonal00To11 = 1 << 2;
+    static const uint8_t kCorner00 = 1 << 4;
+    static const uint8_t kCorner10 = 1 << 5;
+    static const uint8_t kCorner01 = 1 << 6;
+    static const uint8_t kCorner11 = 1 << 7;
+
+    int _gridWidth, _gridHeight;
+
+    /*
+     Structure-of-arrays sample grid; _valid is 1.0 or 0.0 so it can be
+     combined with SIMD arithmetic.
+     */
+    std::vector<float> _x, _y, _z, _depth, _confidence, _valid;
+    std::vector<uint8_t> _quadFlags;
+    std::vector<int> _vertexIndex;
+    std::vector<int> _rowVertexOffset;
+    std::vector<int> _rowTriangleOffset;
+
+    std::vector<VROVector3f> _vertices;
+    std::vector<float> _vertexConfidences;
+    std::vector<uint16_t> _indices16;
+    std::vector<uint32_t> _indices32;
+    int _vertexCount, _triangleCount;
+    bool _uses16BitIndices;
+    double _lastRunTimeMs;
+
+    void unprojectRow(const VRODepthImage &image, const VRODepthMeshKernelConfig &config, int stride, int gy) {
+        const VROMatrix4f &m = image.cameraToWorld;
+        int py = std::min(gy * stride, image.height - 1);
+        const float *depthRow = image.depth + (size_t) py * image.width;
+        const uint8_t *confidenceRow = image.confidence ? image.confidence + (size_t) py * image.width : nullptr;
+        int rowStart = gy * _gridWidth;
+
+        VROFloat4 zero = VROFloat4::splat(0);
+        VROFloat4 one = VROFloat4::splat(1);
+        VROFloat4 maxDepth = VROFloat4::splat(config.maxDepth);
+        VROFloat4 minConfidence = VROFloat4::splat(config.minConfidence);
+        VROFloat4 camY = VROFloat4::splat(-(py - image.cy) / image.fy);
+        VROFloat4 invFx = VROFloat4::splat(1.0f / image.fx);
+        VROFloat4 cx = VROFloat4::splat(image.cx);
+        VROFloat4 m0 = VROFloat4::splat(m[0]), m1 = VROFloat4::splat(m[1]), m2 = VROFloat4::splat(m[2]);
+        VROFloat4 m4 = VROFloat4::splat(m[4]), m5 = VROFloat4::splat(m[5]), m6 = VROFloat4::splat(m[6]);
+        VROFloat4 m8 = VROFloat4::splat(m[8]), m9 = VROFloat4::splat(m[9]), m10 = VROFloat4::splat(m[10]);
+        VROFloat4 m12 = VROFloat4::splat(m[12]), m13 = VROFloat4::splat(m[13]), m14 = VROFloat4::splat(m[14]);
+
+        int gx = 0;
+        for (; gx + 4 <= _gridWidth; gx += 4) {
+            int px[4];
+            float d[4], c[4], pxf[4];
+            for (int lane = 0; lane < 4; lane++) {
+                px[lane] = std::min((gx + lane) * stride, image.width - 1);
+                pxf[lane] = (float) px[lane];
+                d[lane] = depthRow[px[lane]];
+                c[lane] = confidenceRow ? confidenceRow[px[lane]] * (1.0f / 255.0f) : 1.0f;
+            }
+            VROFloat4 depth = VROFloat4::load(d);
+            VROFloat4 confidence = VROFloat4::load(c);
+
+            // NaN depth fails every comparison and is rejected here
+            VROFloat4 valid = VROFloat4And(VROFloat4And(VROFloat4Greater(depth, zero),
+                                                        VROFloat4LessEqual(depth, maxDepth)),
+                                           VROFloat4GreaterEqual(confidence, minConfidence));
+            depth = VROFloat4Select(valid, depth, zero);
+
+            VROFloat4 cameraX = (VROFloat4::load(pxf) - cx) * invFx * depth;
+            VROFloat4 cameraY = camY * depth;
+            VROFloat4 cameraZ = zero - depth;
+
+            int i = rowStart + gx;
+            VROFloat4MulAdd(m0, cameraX, VROFloat4MulAdd(m4, cameraY, VROFloat4MulAdd(m8, cameraZ, m12))).store(&_x[i]);
+            VROFloat4MulAdd(m1, cameraX, VROFloat4MulAdd(m5, cameraY, VROFloat4MulAdd(m9, cameraZ, m13))).store(&_y[i]);
+            VROFloat4MulAdd(m2, cameraX, VROFloat4MulAdd(m6, cameraY, VROFloat4MulAdd(m10, cameraZ, m14))).store(&_z[i]);
+            depth.store(&_depth[i]);
+            confidence.store(&_confidence[i]);
+            VROFloat4Select(valid, one, zero).store(&_valid[i]);
+        }
+
+        for (; gx < _gridWidth; gx++) {
+            int px = std::min(gx * stride, image.width - 1);
+            float depth = depthRow[px];
+            float confidence = confidenceRow ? confidenceRow[px] * (1.0f / 255.0f) : 1.0f;
+            bool valid = depth > 0 && depth <= config.maxDepth && confidence >= config.minConfidence;
+
+            int i = rowStart + gx;
+            VROVector3f world = image.unprojectToWorld((float) px, (float) py, valid ? depth : 0);
+            _x[i] = world.x;
+            _y[i] = world.y;
+            _z[i] = world.z;
+            _depth[i] = valid ? depth : 0;
+            _confidence[i] = confidence;
+            _valid[i] = valid ? 1.0f : 0.0f;
+        }
+    }
+
+    static VROFloat4 distanceSquared(const VROFloat4 *a, const VROFloat4 *b) {
+        VROFloat4 dx = a[0] - b[0];
+        VROFloat4 dy = a[1] - b[1];
+        VROFloat4 dz = a[2] - b[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    void loadCorner(int i, VROFloat4 *p) const {
+        p[0] = VROFloat4::load(&_x[i]);
+        p[1] = VROFloat4::load(&_y[i]);
+        p[2] = VROFloat4::load(&_z[i]);
+    }
+
+    /*
+     Classify four quads at a time. Quad (qx, qy) has corners 00 = (qx, qy),
+     10 = (qx + 1, qy), 01 = (qx, qy + 1) and 11 = (qx + 1, qy + 1).
+     */
+    void classifyQuadRow(int qy, float spacingScale) {
+        int quadsPerRow = _gridWidth - 1;
+        int rowStart = qy * _gridWidth;
+        uint8_t *flags = &_quadFlags[(size_t) qy * quadsPerRow];
+        VROFloat4 half = VROFloat4::splat(0.5f);
+        VROFloat4 spacing = VROFloat4::splat(spacingScale);
+
+        for (int qx = 0; qx < quadsPerRow; qx += 4) {
+            int i00 = rowStart + qx;
+            int i10 = i00 + 1;
+            int i01 = i00 + _gridWidth;
+            int i11 = i01 + 1;
+
+            VROFloat4 valid = VROFloat4::load(&_valid[i00]) * VROFloat4::load(&_valid[i10]) *
+                              VROFloat4::load(&_valid[i01]) * VROFloat4::load(&_valid[i11]);
+            int validMask = VROFloat4Greater(valid, half).getMask();
+            if (validMask == 0) {
+                for (int lane = 0; lane < 4 && qx + lane < quadsPerRow; lane++) {
+                    flags[qx + lane] = 0;
+                }
+                continue;
+            }
+
+            VROFloat4 p00[3], p10[3], p01[3], p11[3];
+            loadCorner(i00, p00);
+            loadCorner(i10, p10);
+            loadCorner(i01, p01);
+            loadCorner(i11, p11);
+
+            VROFloat4 e00_10 = distanceSquared(p00, p10);
+            VROFloat4 e00_01 = distanceSquared(p00, p01);
+            VROFloat4 e10_11 = distanceSquared(p10, p11);
+            VROFloat4 e01_11 = distanceSquared(p01, p11);
+            VROFloat4 e00_11 = distanceSquared(p00, p11);
+            VROFloat4 e10_01 = distanceSquared(p10, p01);
+
+            // Maximum allowed squared edge length scales with the nearest corner depth
+            VROFloat4 nearest = VROFloat4Min(VROFloat4Min(VROFloat4::load(&_depth[i00]), VROFloat4::load(&_depth[i10])),
+                                             VROFloat4Min(VROFloat4::load(&_depth[i01]), VROFloat4::load(&_depth[i11])));
+            VROFloat4 limit = nearest * spacing;
+            limit = limit * limit;
+
+            int diagonal0011 = VROFloat4LessEqual(e00_11, e10_01).getMask();
+
+            // Diagonal 00-11: A = (00, 01, 11), B = (00, 11, 10)
+            VROFloat4 longestA0 = VROFloat4Max(VROFloat4Max(e00_01, e01_11), e00_11);
+            VROFloat4 longestB0 = VROFloat4Max(VROFloat4Max(e00_11, e10_11), e00_10);
+
+            // Diagonal 10-01: A = (00, 01, 10), B = (10, 01, 11)
+            VROFloat4 longestA1 = VROFloat4Max(VROFloat4Max(e00_01, e10_01), e00_10);
+            VROFloat4 longestB1 = VROFloat4Max(VROFloat4Max(e10_01, e01_11), e10_11);
+
+            int acceptA0 = VROFloat4LessEqual(longestA0, limit).getMask();
+            int acceptB0 = VROFloat4LessEqual(longestB0, limit).getMask();
+            int acceptA1 = VROFloat4LessEqual(longestA1, limit).getMask();
+            int acceptB1 = VROFloat4LessEqual(longestB1, limit).getMask();
+
+            for (int lane = 0; lane < 4 && qx + lane < quadsPerRow; lane++) {
+                int bit = 1 << lane;
+                uint8_t f = 0;
+                if (validMask & bit) {
+                    if (diagonal0011 & bit) {
+                        f |= kDiagonal00To11;
+                        if (acceptA0 & bit) { f |= kTriangleA | kCorner00 | kCorner01 | kCorner11; }
+                        if (acceptB0 & bit) { f |= kTriangleB | kCorner00 | kCorner11 | kCorner10; }
+                    }
+                    else {
+                        if (acceptA1 & bit) { f |= kTriangleA | kCorner00 | kCorner01 | kCorner10; }
+                        if (acceptB1 & bit) { f |= kTriangleB | kCorner10 | kCorner01 | kCorner11; }
+                    }
+                }
+                flags[qx + lane] = f;
+            }
+        }
+    }
+
+    /*
+     A sample is emitted as a vertex if an accepted triangle of any of its
+     (up to four) adjacent quads references it. Returns the row's vertex count.
+     */
+    int markUsedSamples(int gy) {
+        int quadsPerRow = _gridWidth - 1;
+        const uint8_t *above = gy > 0 ? &_quadFlags[(size_t) (gy - 1) * quadsPerRow] : nullptr;
+        const uint8_t *below = gy < _gridHeight - 1 ? &_quadFlags[(size_t) gy * quadsPerRow] : nullptr;
+
+        int count = 0;
+        int *vertexIndex = &_vertexIndex[(size_t) gy * _gridWidth];
+        for (int gx = 0; gx < _gridWidth; gx++) {
+            bool used = false;
+            if (above) {
+                used |= gx > 0 && (above[gx - 1] & kCorner11);
+                used |= gx < quadsPerRow && (above[gx] & kCorner01);
+            }
+            if (below) {
+                used |= gx > 0 && (below[gx - 1] & kCorner10);
+                used |= gx < quadsPerRow && (below[gx] & kCorner00);
+            }
+            vertexIndex[gx] = used ? count++ : -1;
+        }
+        return count;
+    }
+
+    int countTriangles(int qy) const {
+        int quadsPerRow = _gridWidth - 1;
+        const uint8_t *flags = &_quadFlags[(size_t) qy * quadsPerRow];
+        int count = 0;
+        for (int qx = 0; qx < quadsPerRow; qx++) {
+            count += ((flags[qx] & kTriangleA) ? 1 : 0) + ((flags[qx] & kTriangleB) ? 1 : 0);
+        }
+        return count;
+    }
+
+    void writeVertices(int gy) {
+        int rowStart = gy * _gridWidth;
+        int offset = _rowVertexOffset[gy];
+        for (int gx = 0; gx < _gridWidth; gx++) {
+            int i = rowStart + gx;
+            if (_vertexIndex[i] >= 0) {
+                int v = offset + _vertexIndex[i];
+                _vertices[v].x = _x[i];
+                _vertices[v].y = _y[i];
+                _vertices[v].z = _z[i];
+                _vertexConfidences[v] = _confidence[i];
+            }
+        }
+    }
+
+    template <typename T>
+    void writeTriangles(int qy, T *indices) const {
+        int quadsPerRow = _gridWidth - 1;
+        const uint8_t *flags = &_quadFlags[(size_t) qy * quadsPerRow];
+        int offsetTop = _rowVertexOffset[qy];
+        int offsetBottom = _rowVertexOffset[qy + 1];
+        const int *top = &_vertexIndex[(size_t) qy * _gridWidth];
+        const int *bottom = top + _gridWidth;
+
+        T *out = indices + (size_t) _rowTriangleOffset[qy] * 3;
+        for (int qx = 0; qx < quadsPerRow; qx++) {
+            uint8_t f = flags[qx];
+            if (!(f & (kTriangleA | kTriangleB))) {
+                continue;
+            }
+            // Corners that are not referenced have index -1 and are never emitted
+            T v00 = (T) (offsetTop + top[qx]);
+            T v10 = (T) (offsetTop + top[qx + 1]);
+            T v01 = (T) (offsetBottom + bottom[qx]);
+            T v11 = (T) (offsetBottom + bottom[qx + 1]);
+
+            if (f & kDiagonal00To11) {
+                if (f & kTriangleA) { *out++ = v00; *out++ = v01; *out++ = v11; }
+                if (f & kTriangleB) { *out++ = v00; *out++ = v11; *out++ = v10; }
+            }
+            else {
+                if (f & kTriangleA) { *out++ = v00; *out++ = v01; *out++ = v10; }
+                if (f & kTriangleB) { *out++ = v10; *out++ = v01; *out++ = v11; }
+            }
+        }
+    }
+
+};
+
+#endif /* VRODepthMeshKernel_h */
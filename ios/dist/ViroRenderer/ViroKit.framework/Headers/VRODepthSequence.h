@@ -0,0 +1,256 @@
+//
+//  VRODepthSequence.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef VRODepthSequence_h
+#define VRODepthSequence_h
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include "VRODepthImage.h"
+#include "VROLog.h"
+
+/*
+ Binary depth sequence format (.vrds): a recording of depth frames and the
+ camera poses they were captured from, for driving the depth consumers
+ (VROTSDFVolume, VROARTiledWorldMesh, VRODepthFilter) offline. Little-endian:
+ after the header, each frame is
+
+   timestamp      double
+   cameraToWorld  float[16]           Column-major, as VRODepthImage.
+   depth          uint16_t[w * h]     Millimeters; 0 is missing.
+   confidence     uint8_t[w * h]      Only if the header's hasConfidence is set.
+
+ All frames share the header's size and intrinsics.
+ */
+static const char kDepthSequenceMagic[4] = { 'V', 'R', 'D', 'S' };
+static const uint32_t kDepthSequenceFormatVersion = 1;
+
+struct VRODepthSequenceHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t width;
+    uint32_t height;
+    float fx, fy, cx, cy;
+    uint32_t frameCount;
+    uint32_t hasConfidence;
+};
+
+/*
+ A depth sequence decoded into memory. Frames are returned as VRODepthImages
+ that point into the sequence, so they are valid for its lifetime.
+ */
+class VRODepthSequence {
+public:
+
+    /*
+     Encode the given frames. Every frame must have the size and intrinsics
+     of the first; returns an empty buffer otherwise.
+     */
+    static std::vector<uint8_t> encode(const std::vector<VRODepthImage> &frames) {
+        std::vector<uint8_t> out;
+        if (frames.empty() || !frames[0].isValid()) {
+            return out;
+        }
+        const VRODepthImage &first = frames[0];
+        VRODepthSequenceHeader header;
+        memcpy(header.magic, kDepthSequenceMagic, 4);
+        header.formatVersion = kDepthSequenceFormatVersion;
+        header.width = first.width;
+        header.height = first.height;
+        header.fx = first.fx;
+        header.fy = first.fy;
+        header.cx = first.cx;
+        header.cy = first.cy;
+        header.frameCount = (uint32_t) frames.size();
+        header.hasConfidence = first.confidence != nullptr;
+
+        size_t pixels = (size_t) first.width * first.height;
+        out.resize(sizeof(header) + frames.size() * getFrameSize(header));
+        memcpy(out.data(), &header, sizeof(header));
+        uint8_t *cursor = out.data() + sizeof(header);
+
+        std::vector<uint16_t> millimeters(pixels);
+        for (const VRODepthImage &frame : frames) {
+            if (frame.width != first.width || frame.height != first.height || frame.fx != first.fx ||
+                frame.fy != first.fy || frame.cx != first.cx || frame.cy != first.cy ||
+                (frame.confidence != nullptr) != (first.confidence != nullptr) || !frame.depth) {
+                pwarn("Unable to encode depth sequence: frames differ in size or intrinsics");
+                return std::vector<uint8_t>();
+            }
+            for (size_t i = 0; i < pixels; i++) {
+                float d = frame.depth[i];
+                millimeters[i] = (std::isfinite(d) && d > 0) ? (uint16_t) std::min(65535.0f, roundf(d * 1000.0f)) : 0;
+            }
+            memcpy(cursor, &frame.timestamp, sizeof(double));
+            cursor += sizeof(double);
+            memcpy(cursor, frame.cameraToWorld.getArray(), 16 * sizeof(float));
+            cursor += 16 * sizeof(float);
+            memcpy(cursor, millimeters.data(), pixels * sizeof(uint16_t));
+            cursor += pixels * sizeof(uint16_t);
+            if (header.hasConfidence) {
+                memcpy(cursor, frame.confidence, pixels);
+                cursor += pixels;
+            }
+        }
+        return out;
+    }
+
+    static bool write(const std::vector<VRODepthImage> &frames, std::string path) {
+        std::vector<uint8_t> encoded = encode(frames);
+        if (encoded.empty()) {
+            return false;
+        }
+        FILE *file = fopen(path.c_str(), "wb");
+        if (!file) {
+            pwarn("Failed to open depth sequence file %s for writing", path.c_str());
+            return false;
+        }
+        bool success = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+        success = (fclose(file) == 0) && success;
+        if (!success) {
+            pwarn("Failed to write depth sequence file %s", path.c_str());
+        }
+        return success;
+    }
+
+    /*
+     Read the given file. Returns nullptr if it cannot be read or is not a
+     valid depth sequence.
+     */
+    static std::shared_ptr<VRODepthSequence> open(std::string path) {
+        FILE *file = fopen(path.c_str(), "rb");
+        if (!file) {
+            pwarn("Failed to open depth sequence file %s", path.c_str());
+            return nullptr;
+        }
+        std::vector<uint8_t> buffer;
+        uint8_t chunk[65536];
+        size_t read;
+        while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            buffer.insert(buffer.end(), chunk, chunk + read);
+        }
+        fclose(file);
+
+        std::shared_ptr<VRODepthSequence> sequence = open(buffer);
+        if (!sequence) {
+            pwarn("Depth sequence file %s is invalid", path.c_str());
+        }
+        return sequence;
+    }
+
+    static std::shared_ptr<VRODepthSequence> open(const std::vector<uint8_t> &buffer) {
+        VRODepthSequenceHeader header;
+        if (buffer.size() < sizeof(header)) {
+            return nullptr;
+        }
+        memcpy(&header, buffer.data(), sizeof(header));
+        if (memcmp(header.magic, kDepthSequenceMagic, 4) != 0 ||
+            header.formatVersion != kDepthSequenceFormatVersion ||
+            header.width == 0 || header.height == 0 || header.width > 65536 || header.height > 65536 ||
+            !(header.fx > 0) || !(header.fy > 0) ||
+            (buffer.size() - sizeof(header)) / getFrameSize(header) < header.frameCount) {
+            return nullptr;
+        }
+
+        std::shared_ptr<VRODepthSequence> sequence(new VRODepthSequence());
+        sequence->_header = header;
+        size_t pixels = (size_t) header.width * header.height;
+        sequence->_depth.resize(pixels * header.frameCount);
+        sequence->_poses.resize(header.frameCount);
+        sequence->_timestamps.resize(header.frameCount);
+        if (header.hasConfidence) {
+            sequence->_confidence.resize(pixels * header.frameCount);
+        }
+
+        const uint8_t *cursor = buffer.data() + sizeof(header);
+        std::vector<uint16_t> millimeters(pixels);
+        for (uint32_t f = 0; f < header.frameCount; f++) {
+            float pose[16];
+            memcpy(&sequence->_timestamps[f], cursor, sizeof(double));
+            cursor += sizeof(double);
+            memcpy(pose, cursor, sizeof(pose));
+            cursor += sizeof(pose);
+            sequence->_poses[f] = VROMatrix4f(pose);
+
+            memcpy(millimeters.data(), cursor, pixels * sizeof(uint16_t));
+            cursor += pixels * sizeof(uint16_t);
+            float *depth = &sequence->_depth[pixels * f];
+            for (size_t i = 0; i < pixels; i++) {
+                depth[i] = millimeters[i] * 0.001f;
+            }
+            if (header.hasConfidence) {
+                memcpy(&sequence->_confidence[pixels * f], cursor, pixels);
+                cursor += pixels;
+            }
+        }
+        return sequence;
+    }
+
+    int getFrameCount() const { return (int) _header.frameCount; }
+    int getWidth() const { return (int) _header.width; }
+    int getHeight() const { return (int) _header.height; }
+
+    VRODepthImage getFrame(int index) const {
+        size_t pixels = (size_t) _header.width * _header.height;
+        VRODepthImage image;
+        image.width = _header.width;
+        image.height = _header.height;
+        image.depth = &_depth[pixels * index];
+        image.confidence = _confidence.empty() ? nullptr : &_confidence[pixels * index];
+        image.fx = _header.fx;
+        image.fy = _header.fy;
+        image.cx = _header.cx;
+        image.cy = _header.cy;
+        image.cameraToWorld = _poses[index];
+        image.timestamp = _timestamps[index];
+        return image;
+    }
+
+private:
+
+    VRODepthSequenceHeader _header;
+    std::vector<float> _depth;
+    std::vector<uint8_t> _confidence;
+    std::vector<VROMatrix4f> _poses;
+    std::vector<double> _timestamps;
+
+    VRODepthSequence() {}
+
+    static size_t getFrameSize(const VRODepthSequenceHeader &header) {
+        size_t pixels = (size_t) header.width * header.height;
+        return sizeof(double) + 16 * sizeof(float) + pixels * sizeof(uint16_t) +
+               (header.hasConfidence ? pixels : 0);
+    }
+
+};
+
+#endif /* VRODepthSequence_h */
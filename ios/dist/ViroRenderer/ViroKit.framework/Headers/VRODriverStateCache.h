@@ -0,0 +1,299 @@
+//
+//  VRODriverStateCache.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VRODriverStateCache_h
+#define VRODriverStateCache_h
+
+#include <string>
+#include <sstream>
+#include <stdint.h>
+#include "VRODriver.h"
+#include "VROShaderProgram.h"
+
+enum class VRODriverStateCategory {
+    ActiveTextureUnit = 0,
+    Texture,
+    DepthWrite,
+    DepthRead,
+    StencilTest,
+    CullMode,
+    ColorMask,
+    BlendMode,
+    Shader,
+    RenderTarget,
+    NumCategories,
+};
+
+/*
+ Per-frame counts of state calls the driver issued and calls it dropped
+ because the state was already set (elided), by category.
+ */
+struct VRODriverStateStats {
+    uint32_t issued[(int) VRODriverStateCategory::NumCategories] = {};
+    uint32_t elided[(int) VRODriverStateCategory::NumCategories] = {};
+
+    uint32_t getIssued(VRODriverStateCategory category) const { return issued[(int) category]; }
+    uint32_t getElided(VRODriverStateCategory category) const { return elided[(int) category]; }
+
+    uint32_t getTotalIssued() const {
+        uint32_t total = 0;
+        for (uint32_t count : issued) {
+            total += count;
+        }
+        return total;
+    }
+    uint32_t getTotalElided() const {
+        uint32_t total = 0;
+        for (uint32_t count : elided) {
+            total += count;
+        }
+        return total;
+    }
+
+    std::string toString() const {
+        static const char *names[] = {
+            "active unit", "texture", "depth write", "depth read", "stencil", "cull", "color mask",
+            "blend", "shader", "render target",
+        };
+        std::stringstream ss;
+        for (int c = 0; c < (int) VRODriverStateCategory::NumCategories; c++) {
+            ss << names[c] << ": " << issued[c] << " issued, " << elided[c] << " elided\n";
+        }
+        return ss.str();
+    }
+};
+
+/*
+ Shadow copy of context state for a concrete driver to consult at the top of
+ its own state and bind methods, so that calls setting state that is already
+ set are dropped: the active texture unit, the texture bound to each unit,
+ depth, stencil, cull, color mask and blend state, and the bound shader.
+ Each method returns true if the call must be issued, and counts it as
+ issued or elided.
+
+ This lives inside the driver rather than in a VRODriver wrapper because the
+ compiled material, geometry and texture substrates bind through their
+ concrete driver (VROShaderProgram, for instance, takes a VRODriverOpenGL)
+ or call GL directly; a wrapper in front of the driver would never see those
+ binds, and its shadow state would go stale.
+
+ VRORecordingDriver is the only driver that consults it, so it drops no GL
+ call in a rendered frame: it counts and elides the calls of frames recorded
+ through VRORecordingDriver. The compiled GL driver keeps the same shadow
+ state itself (the active unit, a target-to-texture map per unit, depth,
+ stencil, cull and blend state and the bound shader) and already drops
+ redundant calls the same way, but keeps no counts; recording a frame with
+ caching on gives the counts the GL driver would see.
+
+ Texture state is one binding per unit: the last target and texture bound
+ on it. Binding a different target on a unit counts as a change, so a unit
+ alternating between 2D and cube textures is reissued rather than elided.
+
+ The shadow state is only valid while every state change goes through the
+ owning driver. Call invalidate() after anything modifies context state
+ directly (e.g. third-party rendering, a context loss, or texture creation,
+ which binds the new texture on the active unit).
+
+ Elimination can be switched off with setEnabled(false) for A/B comparison;
+ counters are kept either way, and the previous frame's are returned by
+ getLastFrameStats(), reached through VRORecordingDriver::getStateCache().
+ They are not reported through VRORenderMetadata or VRORenderer: both are
+ compiled into the framework and allocated there, so adding counters to
+ them from these headers would change their layout underneath the binary.
+ */
+class VRODriverStateCache {
+public:
+
+    static const int kMaxTextureUnits = 32;
+
+    VRODriverStateCache() :
+        _enabled(true) {
+        invalidate();
+    }
+
+    /*
+     Enable or disable redundant call elimination. Disabling issues every
+     call; re-enabling starts from unknown state.
+     */
+    void setEnabled(bool enabled) {
+        _enabled = enabled;
+        invalidate();
+    }
+    bool isEnabled() const {
+        return _enabled;
+    }
+
+    /*
+     Forget the shadow state, so the next call of each kind is issued.
+     */
+    void invalidate() {
+        invalidateTextures();
+        _depthWrite = _depthRead = _stencilTest = kUnknown;
+        _cullMode = _renderTargetColorMask = _materialColorMask = _blendMode = kUnknown;
+        _shader = kUnknown;
+    }
+
+    /*
+     Forget the active unit and texture bindings only.
+     */
+    void invalidateTextures() {
+        _activeUnit = kUnknown;
+        for (int i = 0; i < kMaxTextureUnits; i++) {
+            _textures[i] = { kUnknown, kUnknown };
+        }
+    }
+
+    /*
+     Call from the driver's willRenderFrame() and didRenderFrame().
+     */
+    void beginFrame() {
+        _frameStats = VRODriverStateStats();
+    }
+    void endFrame() {
+        _lastFrameStats = _frameStats;
+    }
+
+    const VRODriverStateStats &getFrameStats() const { return _frameStats; }
+    const VRODriverStateStats &getLastFrameStats() const { return _lastFrameStats; }
+
+#pragma mark - State
+
+    bool setActiveTextureUnit(int unit) {
+        return shouldIssue(VRODriverStateCategory::ActiveTextureUnit, &_activeUnit, unit);
+    }
+
+    /*
+     Bind on the active unit.
+     */
+    bool bindTexture(int target, int texture) {
+        return bindTexture(_activeUnit, target, texture);
+    }
+
+    /*
+     Bind on the given unit. A driver that switches the active unit to bind
+     must report the switch through setActiveTextureUnit().
+     */
+    bool bindTexture(int unit, int target, int texture) {
+        if (unit < 0 || unit >= kMaxTextureUnits) {
+            count(VRODriverStateCategory::Texture, true);
+            return true;
+        }
+        TextureBinding &binding = _textures[unit];
+        bool redundant = _enabled && binding.target == target && binding.texture == texture;
+        count(VRODriverStateCategory::Texture, !redundant);
+        binding = { target, texture };
+        return !redundant;
+    }
+
+    bool setDepthWritingEnabled(bool enabled) {
+        return shouldIssue(VRODriverStateCategory::DepthWrite, &_depthWrite, enabled);
+    }
+    bool setDepthReadingEnabled(bool enabled) {
+        return shouldIssue(VRODriverStateCategory::DepthRead, &_depthRead, enabled);
+    }
+    bool setStencilTestEnabled(bool enabled) {
+        return shouldIssue(VRODriverStateCategory::StencilTest, &_stencilTest, enabled);
+    }
+    bool setCullMode(VROCullMode cullMode) {
+        return shouldIssue(VRODriverStateCategory::CullMode, &_cullMode, (int) cullMode);
+    }
+    bool setRenderTargetColorWritingMask(VROColorMask mask) {
+        return shouldIssue(VRODriverStateCategory::ColorMask, &_renderTargetColorMask, (int) mask);
+    }
+    bool setMaterialColorWritingMask(VROColorMask mask) {
+        return shouldIssue(VRODriverStateCategory::ColorMask, &_materialColorMask, (int) mask);
+    }
+    bool setBlendingMode(VROBlendMode mode) {
+        return shouldIssue(VRODriverStateCategory::BlendMode, &_blendMode, (int) mode);
+    }
+
+    /*
+     Pass null for unbindShader(). Programs are compared by shader ID rather
+     than address, so a new program allocated where a destroyed one lived is
+     still bound.
+     */
+    bool bindShader(const VROShaderProgram *program) {
+        int64_t shader = program ? (int64_t) program->getShaderId() : kUnknown - 1;
+        bool redundant = _enabled && _shader == shader;
+        count(VRODriverStateCategory::Shader, !redundant);
+        _shader = shader;
+        return !redundant;
+    }
+
+    /*
+     Render targets are deduplicated by the driver itself, which knows
+     whether a bind took effect; that result is only counted here.
+     */
+    void countRenderTargetBind(bool bound) {
+        count(VRODriverStateCategory::RenderTarget, bound);
+    }
+
+private:
+
+    static const int kUnknown = -1;
+
+    struct TextureBinding {
+        int target;
+        int texture;
+    };
+
+    bool _enabled;
+
+    /*
+     Shadow state; kUnknown where the state has not been set through the
+     driver since the last invalidation. _shader is the bound program's
+     shader ID, or kUnknown - 1 when no program is bound.
+     */
+    int _activeUnit;
+    TextureBinding _textures[kMaxTextureUnits];
+    int _depthWrite, _depthRead, _stencilTest;
+    int _cullMode, _renderTargetColorMask, _materialColorMask, _blendMode;
+    int64_t _shader;
+
+    VRODriverStateStats _frameStats;
+    VRODriverStateStats _lastFrameStats;
+
+    void count(VRODriverStateCategory category, bool issued) {
+        if (issued) {
+            _frameStats.issued[(int) category]++;
+        } else {
+            _frameStats.elided[(int) category]++;
+        }
+    }
+
+    /*
+     Count the call and return true if it must be issued, updating the
+     shadow value.
+     */
+    bool shouldIssue(VRODriverStateCategory category, int *shadow, int value) {
+        bool redundant = _enabled && *shadow == value;
+        count(category, !redundant);
+        *shadow = value;
+        return !redundant;
+    }
+
+};
+
+#endif /* VRODriverStateCache_h */
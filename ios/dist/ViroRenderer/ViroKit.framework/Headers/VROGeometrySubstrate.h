@@ -0,0 +1,84 @@
+//
+//  VROGeometrySubstrate.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROGeometrySubstrate_h
+#define VROGeometrySubstrate_h
+
+#include <memory>
+#include "VROMatrix4f.h"
+
+class VROGeometry;
+class VROMaterial;
+class VRORenderContext;
+class VRODriver;
+
+/*
+ Platform representation of a VROGeometry: its vertex buffers and the draw
+ calls for each element. Created by VRODriver::newGeometrySubstrate and
+ owned by the geometry. The framework calls it through this interface, so
+ the virtual functions keep their order (checked against the binary by
+ VROPlatformInterfaceTests).
+ */
+class VROGeometrySubstrate {
+public:
+    virtual ~VROGeometrySubstrate() {}
+
+    /*
+     Re-read the geometry's sources and elements after they change.
+     */
+    virtual void update(const VROGeometry &geometry, std::shared_ptr<VRODriver> &driver) = 0;
+
+    /*
+     Draw the given element. The material's shader and properties are
+     already bound; the substrate binds the geometry and view and issues
+     the draw.
+     */
+    virtual void render(const VROGeometry &geometry,
+                        int elementIndex,
+                        VROMatrix4f transform,
+                        VROMatrix4f normalMatrix,
+                        float opacity,
+                        const std::shared_ptr<VROMaterial> &material,
+                        const VRORenderContext &context,
+                        std::shared_ptr<VRODriver> &driver) = 0;
+
+    /*
+     Draw every element (or the given element) with the silhouette material,
+     for stencil and shadow passes.
+     */
+    virtual void renderSilhouette(const VROGeometry &geometry,
+                                  VROMatrix4f transform,
+                                  std::shared_ptr<VROMaterial> &material,
+                                  const VRORenderContext &context,
+                                  std::shared_ptr<VRODriver> &driver) = 0;
+    virtual void renderSilhouetteTextured(const VROGeometry &geometry,
+                                          int element,
+                                          VROMatrix4f transform,
+                                          std::shared_ptr<VROMaterial> &material,
+                                          const VRORenderContext &context,
+                                          std::shared_ptr<VRODriver> &driver) = 0;
+};
+
+#endif /* VROGeometrySubstrate_h */
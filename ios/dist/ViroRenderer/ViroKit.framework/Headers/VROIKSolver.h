@@ -0,0 +1,439 @@
+//
+//  VROIKSolver.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROIKSolver_h
+#define VROIKSolver_h
+
+#include <memory>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "VROIKRig.h"
+#include "VROThreadPool.h"
+
+struct VROIKSolverConfig {
+    float tolerance = 0.001f;     // Stop once every effector is this close to its target
+    int maxIterations = 10;       // Upper bound on FABRIK iterations per solve
+};
+
+/*
+ Immutable, index-based form of an IK joint tree, built once and shared by
+ any number of VROIKRigInstances. Joints are numbered so that parents precede
+ their children; the tree is split into chains at the root, at effectors, and
+ at branching joints, as VROIKRig::formChains() does. Each chain is stored as
+ a run of joint indices from its start (root or branch) to its end (effector
+ or branch), and chains are ordered so that a parent chain precedes its
+ children. Bone lengths are measured from the rest positions at compile time.
+ */
+class VROIKCompiledRig {
+public:
+
+    /*
+     Compile a rig from parent indices (-1 for the root; parents must precede
+     children), rest positions and the joints that act as effectors. Joints
+     that are not on the path from the root to an effector do not take part in
+     the solve. Returns nullptr if the hierarchy is invalid.
+     */
+    static std::shared_ptr<VROIKCompiledRig> compile(const std::vector<int> &parents,
+                                                     const std::vector<VROVector3f> &restPositions,
+                                                     const std::vector<int> &effectors) {
+        const int count = (int) parents.size();
+        if (count == 0 || (int) restPositions.size() != count || parents[0] != -1) {
+            return nullptr;
+        }
+        std::shared_ptr<VROIKCompiledRig> rig(new VROIKCompiledRig());
+        rig->_parents = parents;
+        rig->_effectors = effectors;
+        rig->_boneLengths.assign(count, 0);
+        rig->_effectorIndex.assign(count, -1);
+
+        for (int i = 1; i < count; i++) {
+            if (parents[i] < 0 || parents[i] >= i) {
+                return nullptr;
+            }
+            rig->_boneLengths[i] = restPositions[i].distance(restPositions[parents[i]]);
+        }
+
+        // Only joints between the root and an effector are solved
+        std::vector<bool> active(count, false);
+        for (int e = 0; e < (int) effectors.size(); e++) {
+            int joint = effectors[e];
+            if (joint < 0 || joint >= count) {
+                return nullptr;
+            }
+            rig->_effectorIndex[joint] = e;
+            for (; joint >= 0 && !active[joint]; joint = parents[joint]) {
+                active[joint] = true;
+            }
+        }
+
+        std::vector<int> activeChildren(count, 0);
+        for (int i = 1; i < count; i++) {
+            if (active[i]) {
+                activeChildren[parents[i]]++;
+            }
+        }
+        std::vector<std::vector<int>> children(count);
+        for (int i = 1; i < count; i++) {
+            if (active[i]) {
+                children[parents[i]].push_back(i);
+            }
+        }
+
+        // Walk chains depth-first from the root, so parent chains come first
+        std::vector<int> endChain(count, -1);
+        std::vector<int> pending = { 0 };
+        while (!pending.empty()) {
+            int start = pending.back();
+            pending.pop_back();
+
+            for (int first : children[start]) {
+                int chain = (int) rig->_chainOffsets.size();
+                rig->_chainOffsets.push_back((int) rig->_chainJoints.size());
+                rig->_chainJoints.push_back(start);
+
+                int joint = first;
+                while (true) {
+                    rig->_chainJoints.push_back(joint);
+                    if (activeChildren[joint] != 1 || rig->_effectorIndex[joint] >= 0) {
+                        break;
+                    }
+                    joint = children[joint][0];
+                }
+                endChain[joint] = chain;
+                if (activeChildren[joint] > 0) {
+                    pending.push_back(joint);
+                }
+            }
+        }
+        rig->_chainOffsets.push_back((int) rig->_chainJoints.size());
+
+        // For each chain, the chains that branch from its end joint
+        const int chainCount = rig->getChainCount();
+        std::vector<std::vector<int>> childChains(chainCount);
+        for (int c = 0; c < chainCount; c++) {
+            int start = rig->_chainJoints[rig->_chainOffsets[c]];
+            if (endChain[start] >= 0) {
+                childChains[endChain[start]].push_back(c);
+            }
+        }
+        for (int c = 0; c < chainCount; c++) {
+            rig->_childChainOffsets.push_back((int) rig->_childChains.size());
+            rig->_childChains.insert(rig->_childChains.end(), childChains[c].begin(), childChains[c].end());
+        }
+        rig->_childChainOffsets.push_back((int) rig->_childChains.size());
+        return rig;
+    }
+
+    /*
+     Compile a rig from an existing VROIKJoint tree. The joints reachable from
+     root through children are numbered in breadth-first order; outJoints
+     receives the joint for each index, so solved positions can be written
+     back with VROIKRigInstance::writePositions(). Returns nullptr if root or
+     outJoints is null, or an effector is not in the tree.
+     */
+    static std::shared_ptr<VROIKCompiledRig> compile(std::shared_ptr<VROIKJoint> root,
+                                                     const std::vector<std::shared_ptr<VROIKJoint>> &effectors,
+                                                     std::vector<std::shared_ptr<VROIKJoint>> *outJoints) {
+        if (!root || !outJoints) {
+            return nullptr;
+        }
+        std::vector<std::shared_ptr<VROIKJoint>> &joints = *outJoints;
+        joints.clear();
+        joints.push_back(root);
+
+        std::map<VROIKJoint *, int> indices;
+        std::vector<int> parents = { -1 };
+        std::vector<VROVector3f> positions = { root->position };
+        indices[root.get()] = 0;
+        for (int i = 0; i < (int) joints.size(); i++) {
+            for (const std::shared_ptr<VROIKJoint> &child : joints[i]->children) {
+                if (indices.count(child.get())) {
+                    continue;
+                }
+                indices[child.get()] = (int) joints.size();
+                joints.push_back(child);
+                parents.push_back(i);
+                positions.push_back(child->position);
+            }
+        }
+
+        std::vector<int> effectorIndices;
+        for (const std::shared_ptr<VROIKJoint> &effector : effectors) {
+            auto it = indices.find(effector.get());
+            if (it == indices.end()) {
+                return nullptr;
+            }
+            effectorIndices.push_back(it->second);
+        }
+        return compile(parents, positions, effectorIndices);
+    }
+
+    int getJointCount() const { return (int) _parents.size(); }
+    int getEffectorCount() const { return (int) _effectors.size(); }
+    int getChainCount() const { return (int) _chainOffsets.size() - 1; }
+    int getParent(int joint) const { return _parents[joint]; }
+    int getEffectorJoint(int effector) const { return _effectors[effector]; }
+    float getBoneLength(int joint) const { return _boneLengths[joint]; }
+
+private:
+
+    friend class VROIKSolver;
+
+    std::vector<int> _parents;
+    std::vector<float> _boneLengths;
+    std::vector<int> _effectors;
+    std::vector<int> _effectorIndex;
+
+    /*
+     Joints of chain c are _chainJoints[_chainOffsets[c] .. _chainOffsets[c + 1]),
+     starting with the shared root or branch joint.
+     */
+    std::vector<int> _chainJoints;
+    std::vector<int> _chainOffsets;
+
+    /*
+     Chains that start at the end joint of chain c are
+     _childChains[_childChainOffsets[c] .. _childChainOffsets[c + 1]).
+     */
+    std::vector<int> _childChains;
+    std::vector<int> _childChainOffsets;
+
+    VROIKCompiledRig() {}
+
+};
+
+/*
+ Per-rig solver state: joint positions (xyz interleaved, initialized to the
+ current pose), effector targets, and scratch space, so solving allocates
+ nothing. Many instances can share one VROIKCompiledRig.
+ */
+class VROIKRigInstance {
+public:
+
+    VROIKRigInstance(std::shared_ptr<const VROIKCompiledRig> rig) :
+        _rig(rig),
+        _positions(rig->getJointCount() * 3, 0),
+        _targets(rig->getEffectorCount() * 3, 0),
+        _subLocations(rig->getChainCount() * 3, 0),
+        _iterations(0), _error(0) {}
+
+    const std::shared_ptr<const VROIKCompiledRig> &getRig() const { return _rig; }
+
+    void setPosition(int joint, VROVector3f position) {
+        _positions[joint * 3 + 0] = position.x;
+        _positions[joint * 3 + 1] = position.y;
+        _positions[joint * 3 + 2] = position.z;
+    }
+    VROVector3f getPosition(int joint) const {
+        return { _positions[joint * 3], _positions[joint * 3 + 1], _positions[joint * 3 + 2] };
+    }
+
+    void setTarget(int effector, VROVector3f target) {
+        _targets[effector * 3 + 0] = target.x;
+        _targets[effector * 3 + 1] = target.y;
+        _targets[effector * 3 + 2] = target.z;
+    }
+
+    /*
+     Copy positions from or to the joints returned by
+     VROIKCompiledRig::compile(). Only position is written: each joint's
+     rotation, and the lockedJoints that VROIKRig excludes from the solve,
+     are left as they were (see VROIKSolver).
+     */
+    void readPositions(const std::vector<std::shared_ptr<VROIKJoint>> &joints) {
+        for (int i = 0; i < (int) joints.size(); i++) {
+            setPosition(i, joints[i]->position);
+        }
+    }
+    void writePositions(const std::vector<std::shared_ptr<VROIKJoint>> &joints) const {
+        for (int i = 0; i < (int) joints.size(); i++) {
+            joints[i]->position = getPosition(i);
+        }
+    }
+
+    /*
+     Results of the last solve: iterations run, and the largest remaining
+     distance between an effector and its target.
+     */
+    int getIterations() const { return _iterations; }
+    float getError() const { return _error; }
+
+private:
+
+    friend class VROIKSolver;
+
+    std::shared_ptr<const VROIKCompiledRig> _rig;
+    std::vector<float> _positions;
+    std::vector<float> _targets;
+    std::vector<float> _subLocations;
+    int _iterations;
+    float _error;
+
+};
+
+/*
+ Multi-effector FABRIK over compiled rigs. Each iteration runs a backward
+ pass over the chains from the leaves to the root, placing each effector at
+ its target and each branching joint at the centroid of the positions
+ proposed by its child chains, followed by a forward pass from the fixed root
+ that restores bone lengths. Iteration stops when every effector is within
+ tolerance of its target or after maxIterations.
+
+ The solver produces joint positions only. It is not a replacement for
+ VROIKRig::processRig(), which also derives each joint's rotation from the
+ solved positions and re-applies lockedJointLocalTransforms to the locked
+ intermediary joints before syncing nodes or bones; that step lives in the
+ prebuilt VROIKRig and is not reproduced here. Callers that need rotations
+ must compute them from the solved positions themselves. The passes follow
+ VROIKRig's FABRIK. VROIKSolverTests (testMatchesIKRig) compares the solved
+ positions against the prebuilt class on a branching rig; like the rest of
+ the unit-test target it runs on device only, as ViroKit ships an arm64
+ device slice only.
+ */
+class VROIKSolver {
+public:
+
+    static void solve(VROIKRigInstance *instance, const VROIKSolverConfig &config = VROIKSolverConfig()) {
+        const VROIKCompiledRig &rig = *instance->_rig;
+        float *p = instance->_positions.data();
+        const float *targets = instance->_targets.data();
+        float *subLocations = instance->_subLocations.data();
+        const int chainCount = rig.getChainCount();
+
+        instance->_iterations = 0;
+        instance->_error = computeError(rig, p, targets);
+        if (chainCount == 0) {
+            return;
+        }
+        const float root[3] = { p[0], p[1], p[2] };
+
+        while (instance->_error > config.tolerance && instance->_iterations < config.maxIterations) {
+            // Backward: leaf chains first, moving each toward its effector
+            for (int c = chainCount - 1; c >= 0; c--) {
+                const int *joints = &rig._chainJoints[rig._chainOffsets[c]];
+                const int length = rig._chainOffsets[c + 1] - rig._chainOffsets[c];
+
+                int end = joints[length - 1];
+                int effector = rig._effectorIndex[end];
+                if (effector >= 0) {
+                    copy(&targets[effector * 3], &p[end * 3]);
+                } else {
+                    centroid(rig, c, subLocations, &p[end * 3]);
+                }
+                for (int k = length - 2; k > 0; k--) {
+                    place(&p[joints[k + 1] * 3], &p[joints[k] * 3], rig._boneLengths[joints[k + 1]], &p[joints[k] * 3]);
+                }
+                // The chain's proposal for its start joint, resolved by the parent chain
+                place(&p[joints[1] * 3], &p[joints[0] * 3], rig._boneLengths[joints[1]], &subLocations[c * 3]);
+            }
+
+            // Forward: from the fixed root, restore each bone's length
+            copy(root, p);
+            for (int c = 0; c < chainCount; c++) {
+                const int *joints = &rig._chainJoints[rig._chainOffsets[c]];
+                const int length = rig._chainOffsets[c + 1] - rig._chainOffsets[c];
+                for (int k = 1; k < length; k++) {
+                    place(&p[joints[k - 1] * 3], &p[joints[k] * 3], rig._boneLengths[joints[k]], &p[joints[k] * 3]);
+                }
+            }
+
+            instance->_iterations++;
+            instance->_error = computeError(rig, p, targets);
+        }
+    }
+
+    /*
+     Solve many rigs, in parallel on the shared VROThreadPool. Instances must
+     be distinct; they may share compiled rigs.
+     */
+    static void solve(const std::vector<VROIKRigInstance *> &instances,
+                      const VROIKSolverConfig &config = VROIKSolverConfig()) {
+        VROThreadPool::shared().parallelFor((int) instances.size(), 4, [&](int start, int end) {
+            for (int i = start; i < end; i++) {
+                solve(instances[i], config);
+            }
+        });
+    }
+
+private:
+
+    static void copy(const float *from, float *to) {
+        to[0] = from[0];
+        to[1] = from[1];
+        to[2] = from[2];
+    }
+
+    /*
+     Write to out the point at the given distance from anchor, in the
+     direction of toward. If toward coincides with anchor, the point is left
+     on the anchor.
+     */
+    static void place(const float *anchor, const float *toward, float distance, float *out) {
+        float dx = toward[0] - anchor[0];
+        float dy = toward[1] - anchor[1];
+        float dz = toward[2] - anchor[2];
+        float length = sqrtf(dx * dx + dy * dy + dz * dz);
+        float scale = length > 1e-9f ? distance / length : 0;
+        out[0] = anchor[0] + dx * scale;
+        out[1] = anchor[1] + dy * scale;
+        out[2] = anchor[2] + dz * scale;
+    }
+
+    static void centroid(const VROIKCompiledRig &rig, int chain, const float *subLocations, float *out) {
+        int begin = rig._childChainOffsets[chain];
+        int end = rig._childChainOffsets[chain + 1];
+        if (begin == end) {
+            return;
+        }
+        float sum[3] = { 0, 0, 0 };
+        for (int i = begin; i < end; i++) {
+            const float *location = &subLocations[rig._childChains[i] * 3];
+            sum[0] += location[0];
+            sum[1] += location[1];
+            sum[2] += location[2];
+        }
+        float inverse = 1.0f / (end - begin);
+        out[0] = sum[0] * inverse;
+        out[1] = sum[1] * inverse;
+        out[2] = sum[2] * inverse;
+    }
+
+    static float computeError(const VROIKCompiledRig &rig, const float *p, const float *targets) {
+        float error = 0;
+        for (int e = 0; e < (int) rig._effectors.size(); e++) {
+            const float *position = &p[rig._effectors[e] * 3];
+            float dx = position[0] - targets[e * 3];
+            float dy = position[1] - targets[e * 3 + 1];
+            float dz = position[2] - targets[e * 3 + 2];
+            error = std::max(error, sqrtf(dx * dx + dy * dy + dz * dz));
+        }
+        return error;
+    }
+
+};
+
+#endif /* VROIKSolver_h */
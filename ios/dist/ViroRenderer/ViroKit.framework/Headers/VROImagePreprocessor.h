@@ -0,0 +1,542 @@
+//
+//  VROImagePreprocessor.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROImagePreprocessor_h
+#define VROImagePreprocessor_h
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+#include "VROCameraTexture.h"
+#include "VROSIMD.h"
+#include "VROThreadPool.h"
+#include "VROTime.h"
+
+/**
+ * A bi-planar 4:2:0 YCbCr image (kCVPixelFormatType_420YpCbCr8BiPlanar*,
+ * Android YUV_420_888 with interleaved chroma). Not owned.
+ */
+struct VRONV12Image {
+    int width = 0;
+    int height = 0;
+    const uint8_t *luma = nullptr;
+    int lumaBytesPerRow = 0;
+    const uint8_t *chroma = nullptr;     // Interleaved Cb, Cr at half resolution
+    int chromaBytesPerRow = 0;
+    bool fullRange = true;               // Full (0-255) or video (16-235) range
+    bool bt709 = false;                  // BT.709 coefficients instead of BT.601
+
+    bool isValid() const {
+        return width > 1 && height > 1 && luma && chroma &&
+               lumaBytesPerRow >= width && chromaBytesPerRow >= (width & ~1);
+    }
+};
+
+/**
+ * A rectangle in pixels.
+ */
+struct VROImageRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    VROImageRect() {}
+    VROImageRect(int x, int y, int width, int height) : x(x), y(y), width(width), height(height) {}
+};
+
+enum class VROResizeFilter {
+    Bilinear,       // Two taps per axis; best for upscaling and mild downscaling
+    Area,           // Box filter over the covered source pixels; best for large downscales
+};
+
+enum class VROTensorLayout {
+    CHW,            // Planar: all R, then all G, then all B
+    HWC,            // Interleaved: RGB per pixel
+};
+
+enum class VROTensorType {
+    Float32,
+    Float16,
+};
+
+/**
+ * Description of a preallocated model input tensor.
+ */
+struct VROTensorFormat {
+    int width = 0;
+    int height = 0;
+    VROTensorLayout layout = VROTensorLayout::CHW;
+    VROTensorType type = VROTensorType::Float32;
+    bool bgr = false;
+
+    /*
+     Normalization: out = (rgb / 255 - mean) / std, per channel in RGB order.
+     The defaults map to [0, 1].
+     */
+    float mean[3] = { 0, 0, 0 };
+    float std[3] = { 1, 1, 1 };
+
+    /*
+     Region of the tensor the image is written to (e.g. for aspect-fit with
+     padding); the rest is filled with padding. An empty rect means the whole
+     tensor.
+     */
+    VROImageRect destination;
+    float padding[3] = { 0, 0, 0 };      // Padding color in RGB, before normalization (0-255)
+
+    size_t getByteSize() const {
+        return (size_t) width * height * 3 * (type == VROTensorType::Float32 ? 4 : 2);
+    }
+};
+
+/**
+ * Number of clockwise quarter turns that bring the camera image upright for
+ * the given orientation. Camera sensors are mounted in landscape-right.
+ */
+inline int VROImageRotationForOrientation(VROCameraOrientation orientation) {
+    switch (orientation) {
+        case VROCameraOrientation::Portrait:           return 1;
+        case VROCameraOrientation::LandscapeLeft:      return 2;
+        case VROCameraOrientation::PortraitUpsideDown: return 3;
+        case VROCameraOrientation::LandscapeRight:
+        default:                                       return 0;
+    }
+}
+
+/**
+ * VROImagePreprocessor converts a crop of a camera NV12 image into a model
+ * input tensor, writing directly into the caller's preallocated buffer (e.g.
+ * an MLMultiArray's data pointer). It replaces the generic crop / scale / color
+ * convert path used by VROVisionEngine's VROCropAndScaleOptions and by
+ * VROMonocularDepthEstimator.
+ *
+ * The work is split into passes that are each either contiguous or SIMD:
+ *
+ * 1. Separable resampling of the cropped luma and chroma planes to the
+ *    destination size (before rotation). Filter taps are precomputed per
+ *    axis: two for bilinear, and fractional-coverage box taps for area
+ *    filtering. The horizontal pass works on source rows; the vertical pass
+ *    is a weighted sum of rows, vectorized with VROFloat4.
+ * 2. Color conversion, rotation and normalization, four output pixels at a
+ *    time, written as float32 or float16 in CHW or HWC layout.
+ *
+ * Rows of each pass run in parallel on the VROThreadPool. Scratch buffers
+ * and taps are cached across calls with the same geometry, so steady-state
+ * calls do not allocate. Not thread-safe; use one instance per pipeline.
+ *
+ * VROImagePreprocessorTests checks the output against golden values and a
+ * direct per-pixel reference of the crop / scale / color convert path, and
+ * benchmarks a camera frame to a 256x256 tensor.
+ */
+class VROImagePreprocessor {
+public:
+
+    VROImagePreprocessor() : _lastTimeMs(0) {}
+    virtual ~VROImagePreprocessor() {}
+
+    /**
+     * Crop, resize, rotate by the given number of clockwise quarter turns,
+     * color convert and normalize the image into output, which must hold
+     * format.getByteSize() bytes. Returns false if the arguments are invalid.
+     */
+    bool process(const VRONV12Image &image, VROImageRect crop, int rotation, VROResizeFilter filter,
+                 const VROTensorFormat &format, void *output) {
+        double startTime = VROTimeCurrentMillis();
+        rotation = ((rotation % 4) + 4) % 4;
+        _fullRange = image.fullRange;
+        _bt709 = image.bt709;
+
+        VROImageRect destination = format.destination;
+        if (destination.width <= 0 || destination.height <= 0) {
+            destination = VROImageRect(0, 0, format.width, format.height);
+        }
+        crop = clampRect(crop, image.width, image.height);
+        if (!image.isValid() || !output || crop.width < 2 || crop.height < 2 ||
+            destination.x < 0 || destination.y < 0 ||
+            destination.x + destination.width > format.width ||
+            destination.y + destination.height > format.height) {
+            return false;
+        }
+
+        // Size of the resampled image before rotation
+        bool swapAxes = (rotation & 1);
+        int resampledWidth = swapAxes ? destination.height : destination.width;
+        int resampledHeight = swapAxes ? destination.width : destination.height;
+
+        resamplePlanes(image, crop, resampledWidth, resampledHeight, filter);
+
+        fillPadding(format, destination, output);
+        VROThreadPool::shared().parallelFor(destination.height, 8, [&](int start, int end) {
+            for (int y = start; y < end; y++) {
+                convertRow(format, destination, rotation, y, output);
+            }
+        });
+
+        _lastTimeMs = VROTimeCurrentMillis() - startTime;
+        return true;
+    }
+
+    /**
+     * Convenience overload rotating by a camera orientation.
+     */
+    bool process(const VRONV12Image &image, VROImageRect crop, VROCameraOrientation orientation,
+                 VROResizeFilter filter, const VROTensorFormat &format, void *output) {
+        return process(image, crop, VROImageRotationForOrientation(orientation), filter, format, output);
+    }
+
+    double getLastTimeMs() const {
+        return _lastTimeMs;
+    }
+
+private:
+
+    /*
+     Precomputed filter taps for one axis: output sample i reads count[i]
+     source samples starting at start[i], with weights
+     weights[i * maxTaps ... i * maxTaps + count[i]).
+     */
+    struct Taps {
+        float sourceOffset = -1, sourceSize = -1;
+        int outputSize = -1, maxTaps = 0;
+        VROResizeFilter filter = VROResizeFilter::Bilinear;
+        std::vector<int> start;
+        std::vector<int> count;
+        std::vector<float> weights;
+    };
+
+    Taps _lumaX, _lumaY, _chromaX, _chromaY;
+
+    /*
+     Horizontal pass output (crop rows x resampled width), and the resampled
+     planes (resampled height x width, rows padded to a multiple of 4).
+     */
+    std::vector<float> _lumaRows, _cbRows, _crRows;
+    std::vector<float> _luma, _cb, _cr;
+    int _resampledWidth = 0, _resampledHeight = 0, _resampledStride = 0;
+    bool _fullRange = true, _bt709 = false;
+
+    double _lastTimeMs;
+
+    static VROImageRect clampRect(VROImageRect rect, int width, int height) {
+        int x0 = std::max(0, rect.x), y0 = std::max(0, rect.y);
+        int x1 = std::min(width, rect.x + rect.width), y1 = std::min(height, rect.y + rect.height);
+        return VROImageRect(x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0));
+    }
+
+#pragma mark - Resampling
+
+    /*
+     Compute taps mapping sourceSize samples (starting at sourceOffset in the
+     plane, plane size planeSize) to outputSize samples. Sample centers are
+     aligned (pixel-center convention). A one-sample plane (the chroma of a
+     2 or 3 pixel wide crop) gets a single tap, so no tap reads past it.
+     */
+    static void computeTaps(Taps &taps, float sourceOffset, float sourceSize, int planeSize, int outputSize,
+                            VROResizeFilter filter) {
+        if (taps.sourceOffset == sourceOffset && taps.sourceSize == sourceSize &&
+            taps.outputSize == outputSize && taps.filter == filter) {
+            return;
+        }
+        taps.sourceOffset = sourceOffset;
+        taps.sourceSize = sourceSize;
+        taps.outputSize = outputSize;
+        taps.filter = filter;
+
+        float scale = sourceSize / outputSize;
+        bool area = (filter == VROResizeFilter::Area) && scale > 1.0f;
+        taps.maxTaps = area ? (int) ceilf(scale) + 2 : 2;
+        taps.start.assign(outputSize, 0);
+        taps.count.assign(outputSize, 0);
+        taps.weights.assign((size_t) outputSize * taps.maxTaps, 0.0f);
+
+        for (int i = 0; i < outputSize; i++) {
+            float *weights = &taps.weights[(size_t) i * taps.maxTaps];
+            if (area) {
+                // Box covering [left, right) in source samples
+                float left = sourceOffset + i * scale;
+                float right = left + scale;
+                int first = std::max(0, (int) floorf(left));
+                int last = std::min(planeSize - 1, (int) ceilf(right) - 1);
+                float total = 0;
+                int n = 0;
+                for (int s = first; s <= last && n < taps.maxTaps; s++, n++) {
+                    float coverage = std::min(right, (float) s + 1) - std::max(left, (float) s);
+                    weights[n] = std::max(0.0f, coverage);
+                    total += weights[n];
+                }
+                for (int k = 0; k < n; k++) {
+                    weights[k] /= total;
+                }
+                taps.start[i] = first;
+                taps.count[i] = n;
+            }
+            else {
+                float center = sourceOffset + (i + 0.5f) * scale - 0.5f;
+                center = std::max(0.0f, std::min((float) (planeSize - 1), center));
+                int s0 = std::min(planeSize - 2, (int) floorf(center));
+                s0 = std::max(0, s0);
+                float t = center - s0;
+                weights[0] = 1.0f - t;
+                weights[1] = t;
+                taps.start[i] = s0;
+                taps.count[i] = std::min(2, planeSize);
+            }
+        }
+    }
+
+    void resamplePlanes(const VRONV12Image &image, VROImageRect crop, int width, int height, VROResizeFilter filter) {
+        int chromaWidth = image.width / 2, chromaHeight = image.height / 2;
+        computeTaps(_lumaX, (float) crop.x, (float) crop.width, image.width, width, filter);
+        computeTaps(_lumaY, (float) crop.y, (float) crop.height, image.height, height, filter);
+        computeTaps(_chromaX, crop.x * 0.5f, crop.width * 0.5f, chromaWidth, width, filter);
+        computeTaps(_chromaY, crop.y * 0.5f, crop.height * 0.5f, chromaHeight, height, filter);
+
+        _resampledWidth = width;
+        _resampledHeight = height;
+        _resampledStride = (width + 3) & ~3;
+
+        // Rows of the source the vertical taps touch
+        int lumaRowStart, lumaRowEnd, chromaRowStart, chromaRowEnd;
+        getRowRange(_lumaY, &lumaRowStart, &lumaRowEnd);
+        getRowRange(_chromaY, &chromaRowStart, &chromaRowEnd);
+
+        _lumaRows.resize((size_t) (lumaRowEnd - lumaRowStart) * _resampledStride);
+        _cbRows.resize((size_t) (chromaRowEnd - chromaRowStart) * _resampledStride);
+        _crRows.resize(_cbRows.size());
+        _luma.resize((size_t) height * _resampledStride);
+        _cb.resize(_luma.size());
+        _cr.resize(_luma.size());
+
+        VROThreadPool &pool = VROThreadPool::shared();
+        pool.parallelFor(lumaRowEnd - lumaRowStart, 16, [&](int start, int end) {
+            for (int r = start; r < end; r++) {
+                const uint8_t *row = image.luma + (size_t) (lumaRowStart + r) * image.lumaBytesPerRow;
+                resampleRowHorizontal(row, 1, _lumaX, &_lumaRows[(size_t) r * _resampledStride]);
+            }
+        });
+        pool.parallelFor(chromaRowEnd - chromaRowStart, 16, [&](int start, int end) {
+            for (int r = start; r < end; r++) {
+                const uint8_t *row = image.chroma + (size_t) (chromaRowStart + r) * image.chromaBytesPerRow;
+                resampleRowHorizontal(row, 2, _chromaX, &_cbRows[(size_t) r * _resampledStride]);
+                resampleRowHorizontal(row + 1, 2, _chromaX, &_crRows[(size_t) r * _resampledStride]);
+            }
+        });
+        pool.parallelFor(height, 8, [&](int start, int end) {
+            for (int y = start; y < end; y++) {
+                resampleRowVertical(_lumaRows, lumaRowStart, _lumaY, y, &_luma[(size_t) y * _resampledStride]);
+                resampleRowVertical(_cbRows, chromaRowStart, _chromaY, y, &_cb[(size_t) y * _resampledStride]);
+                resampleRowVertical(_crRows, chromaRowStart, _chromaY, y, &_cr[(size_t) y * _resampledStride]);
+            }
+        });
+    }
+
+    static void getRowRange(const Taps &taps, int *outStart, int *outEnd) {
+        *outStart = taps.start[0];
+        *outEnd = taps.start[0] + taps.count[0];
+        for (int i = 1; i < taps.outputSize; i++) {
+            *outStart = std::min(*outStart, taps.start[i]);
+            *outEnd = std::max(*outEnd, taps.start[i] + taps.count[i]);
+        }
+    }
+
+    static void resampleRowHorizontal(const uint8_t *row, int pixelStride, const Taps &taps, float *out) {
+        for (int i = 0; i < taps.outputSize; i++) {
+            const float *weights = &taps.weights[(size_t) i * taps.maxTaps];
+            const uint8_t *source = row + (size_t) taps.start[i] * pixelStride;
+            float sum = 0;
+            for (int k = 0; k < taps.count[i]; k++) {
+                sum += weights[k] * source[k * pixelStride];
+            }
+            out[i] = sum;
+        }
+    }
+
+    void resampleRowVertical(const std::vector<float> &rows, int rowStart, const Taps &taps, int y, float *out) const {
+        const float *weights = &taps.weights[(size_t) y * taps.maxTaps];
+        const float *first = &rows[(size_t) (taps.start[y] - rowStart) * _resampledStride];
+        for (int x = 0; x < _resampledStride; x += 4) {
+            VROFloat4 sum = VROFloat4::splat(0.0f);
+            for (int k = 0; k < taps.count[y]; k++) {
+                sum = VROFloat4MulAdd(VROFloat4::splat(weights[k]), VROFloat4::load(first + (size_t) k * _resampledStride + x), sum);
+            }
+            sum.store(out + x);
+        }
+    }
+
+#pragma mark - Color Conversion
+
+    /*
+     Per-channel affine normalization folded with the 1/255 scale.
+     */
+    static void getNormalization(const VROTensorFormat &format, float *scale, float *bias) {
+        for (int c = 0; c < 3; c++) {
+            scale[c] = 1.0f / (255.0f * format.std[c]);
+            bias[c] = -format.mean[c] / format.std[c];
+        }
+    }
+
+    static void writePixel(const VROTensorFormat &format, void *output, int x, int y, const float *rgb) {
+        size_t plane = (size_t) format.width * format.height;
+        size_t pixel = (size_t) y * format.width + x;
+        for (int c = 0; c < 3; c++) {
+            int channel = format.bgr ? 2 - c : c;
+            size_t index = (format.layout == VROTensorLayout::CHW) ? channel * plane + pixel : pixel * 3 + channel;
+            if (format.type == VROTensorType::Float32) {
+                ((float *) output)[index] = rgb[c];
+            }
+            else {
+                ((uint16_t *) output)[index] = VROFloatToHalf(rgb[c]);
+            }
+        }
+    }
+
+    void fillPadding(const VROTensorFormat &format, VROImageRect destination, void *output) const {
+        if (destination.width == format.width && destination.height == format.height) {
+            return;
+        }
+        float scale[3], bias[3], rgb[3];
+        getNormalization(format, scale, bias);
+        for (int c = 0; c < 3; c++) {
+            rgb[c] = format.padding[c] * scale[c] + bias[c];
+        }
+        for (int y = 0; y < format.height; y++) {
+            bool rowInside = y >= destination.y && y < destination.y + destination.height;
+            for (int x = 0; x < format.width; x++) {
+                if (rowInside && x >= destination.x && x < destination.x + destination.width) {
+                    x = destination.x + destination.width - 1;
+                    continue;
+                }
+                writePixel(format, output, x, y, rgb);
+            }
+        }
+    }
+
+    /*
+     Location in the resampled (unrotated) planes of destination pixel (x, y)
+     after rotating by the given clockwise quarter turns.
+     */
+    size_t getResampledIndex(int rotation, int x, int y) const {
+        int sx, sy;
+        switch (rotation) {
+            case 1:  sx = y;                        sy = _resampledHeight - 1 - x; break;
+            case 2:  sx = _resampledWidth - 1 - x;  sy = _resampledHeight - 1 - y; break;
+            case 3:  sx = _resampledWidth - 1 - y;  sy = x;                        break;
+            default: sx = x;                        sy = y;                        break;
+        }
+        return (size_t) sy * _resampledStride + sx;
+    }
+
+    void convertRow(const VROTensorFormat &format, VROImageRect destination, int rotation, int y, void *output) const {
+        float scale[3], bias[3];
+        getNormalization(format, scale, bias);
+
+        // YCbCr to RGB coefficients, with the video-range expansion folded in
+        float kr = 1.402f, kgb = -0.344136f, kgr = -0.714136f, kb = 1.772f;
+        if (_bt709) {
+            kr = 1.5748f; kgb = -0.187324f; kgr = -0.468124f; kb = 1.8556f;
+        }
+        float lumaScale = 1.0f, lumaOffset = 0.0f, chromaScale = 1.0f;
+        if (!_fullRange) {
+            lumaScale = 255.0f / 219.0f;
+            lumaOffset = -16.0f * lumaScale;
+            chromaScale = 255.0f / 224.0f;
+        }
+
+        const VROFloat4 zero = VROFloat4::splat(0.0f);
+        const VROFloat4 max = VROFloat4::splat(255.0f);
+        const VROFloat4 half = VROFloat4::splat(128.0f);
+        VROFloat4 scales[3], biases[3];
+        for (int c = 0; c < 3; c++) {
+            scales[c] = VROFloat4::splat(scale[c]);
+            biases[c] = VROFloat4::splat(bias[c]);
+        }
+
+        int outY = destination.y + y;
+        int width = destination.width;
+        size_t plane = (size_t) format.width * format.height;
+        float lumaValues[4], cbValues[4], crValues[4];
+
+        for (int x = 0; x < width; x += 4) {
+            int lanes = std::min(4, width - x);
+            if (rotation == 0 && lanes == 4) {
+                size_t index = getResampledIndex(0, x, y);
+                memcpy(lumaValues, &_luma[index], sizeof(lumaValues));
+                memcpy(cbValues, &_cb[index], sizeof(cbValues));
+                memcpy(crValues, &_cr[index], sizeof(crValues));
+            }
+            else {
+                for (int i = 0; i < 4; i++) {
+                    size_t index = getResampledIndex(rotation, std::min(x + i, width - 1), y);
+                    lumaValues[i] = _luma[index];
+                    cbValues[i] = _cb[index];
+                    crValues[i] = _cr[index];
+                }
+            }
+
+            VROFloat4 luma = VROFloat4MulAdd(VROFloat4::load(lumaValues), VROFloat4::splat(lumaScale), VROFloat4::splat(lumaOffset));
+            VROFloat4 cb = (VROFloat4::load(cbValues) - half) * VROFloat4::splat(chromaScale);
+            VROFloat4 cr = (VROFloat4::load(crValues) - half) * VROFloat4::splat(chromaScale);
+
+            VROFloat4 rgb[3];
+            rgb[0] = VROFloat4MulAdd(cr, VROFloat4::splat(kr), luma);
+            rgb[1] = VROFloat4MulAdd(cr, VROFloat4::splat(kgr), VROFloat4MulAdd(cb, VROFloat4::splat(kgb), luma));
+            rgb[2] = VROFloat4MulAdd(cb, VROFloat4::splat(kb), luma);
+
+            size_t pixel = (size_t) outY * format.width + destination.x + x;
+            for (int c = 0; c < 3; c++) {
+                VROFloat4 value = VROFloat4MulAdd(VROFloat4Min(max, VROFloat4Max(zero, rgb[c])), scales[c], biases[c]);
+                int channel = format.bgr ? 2 - c : c;
+
+                if (format.layout == VROTensorLayout::CHW && lanes == 4) {
+                    if (format.type == VROTensorType::Float32) {
+                        value.store((float *) output + channel * plane + pixel);
+                    }
+                    else {
+                        VROFloat4StoreHalf(value, (uint16_t *) output + channel * plane + pixel);
+                    }
+                    continue;
+                }
+
+                float values[4];
+                value.store(values);
+                for (int i = 0; i < lanes; i++) {
+                    size_t index = (format.layout == VROTensorLayout::CHW) ? channel * plane + pixel + i : (pixel + i) * 3 + channel;
+                    if (format.type == VROTensorType::Float32) {
+                        ((float *) output)[index] = values[i];
+                    }
+                    else {
+                        ((uint16_t *) output)[index] = VROFloatToHalf(values[i]);
+                    }
+                }
+            }
+        }
+    }
+
+};
+
+#endif /* VROImagePreprocessor_h */
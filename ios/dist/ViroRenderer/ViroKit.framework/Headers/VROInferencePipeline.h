@@ -0,0 +1,349 @@
+//
+//  VROInferencePipeline.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROInferencePipeline_h
+#define VROInferencePipeline_h
+
+#include <deque>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <functional>
+#include <condition_variable>
+#include <stdint.h>
+#include "VROLatencyHistogram.h"
+#include "VROTime.h"
+
+/*
+ Bounded FIFO queue that drops its oldest entry when full. For real-time
+ inference, a stale frame is worth less than the newest one, so producers
+ never block.
+ */
+template <typename T>
+class VROBoundedQueue {
+public:
+
+    VROBoundedQueue(size_t capacity) :
+        _capacity(std::max<size_t>(1, capacity)), _closed(false), _dropped(0) {}
+
+    /*
+     Push an item, dropping the oldest queued item if the queue is full.
+     Returns false if an item was dropped. A closed queue rejects the item
+     itself (also counted as dropped), so a stage finishing its frame while
+     the pipeline stops cannot leave it queued for after a restart.
+     */
+    bool push(T item) {
+        bool dropped = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_closed) {
+                _dropped++;
+                return false;
+            }
+            if (_items.size() >= _capacity) {
+                _items.pop_front();
+                _dropped++;
+                dropped = true;
+            }
+            _items.push_back(std::move(item));
+        }
+        _condition.notify_one();
+        return !dropped;
+    }
+
+    /*
+     Block until an item is available or the queue is closed. Returns false
+     if the queue was closed.
+     */
+    bool pop(T *outItem) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this] { return _closed || !_items.empty(); });
+        if (_closed) {
+            return false;
+        }
+        *outItem = std::move(_items.front());
+        _items.pop_front();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+            _items.clear();
+        }
+        _condition.notify_all();
+    }
+
+    void reopen() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = false;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.size();
+    }
+
+    uint64_t getDroppedCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _dropped;
+    }
+
+private:
+
+    const size_t _capacity;
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<T> _items;
+    bool _closed;
+    uint64_t _dropped;
+
+};
+
+/*
+ Timing of a single frame through the pipeline, in VROTimeCurrentMillis().
+ */
+struct VROInferenceFrameInfo {
+    uint64_t frameId = 0;
+    double submitTimeMs = 0;
+    double preprocessStartMs = 0;
+    double inferenceStartMs = 0;
+    double postprocessStartMs = 0;
+};
+
+enum class VROInferenceStage {
+    Preprocess = 0,
+    Inference = 1,
+    Postprocess = 2,
+    EndToEnd = 3,
+};
+
+/*
+ Three-stage asynchronous inference pipeline: preprocess (crop, scale, color
+ convert), inference (run the model) and postprocess (decode the output and
+ hand it to the delegate). Each stage runs on its own thread, connected by
+ bounded drop-oldest queues, so frame N + 1 can be preprocessed while frame N
+ is in the model and frame N - 1 is being decoded. submit() never blocks the
+ rendering thread: if a downstream stage falls behind, its oldest pending
+ frames are dropped in favor of newer ones.
+
+ The pipeline is independent of CoreML and of the frame types; body tracking,
+ monocular depth and semantics each instantiate it with their own types:
+
+   TInput     What the render thread submits (e.g. a retained CVPixelBuffer
+              with its display transform and orientation).
+   TPrepared  The model input (e.g. a cropped, scaled pixel buffer).
+   TOutput    The raw model output (e.g. an MLMultiArray).
+
+ Each stage records its latency into a VROLatencyHistogram, as does the total
+ submit-to-postprocessed latency. Throughput is measured from completions.
+
+ Because the model is just a function, the pipeline can be tested on any
+ platform with a fake model.
+ */
+template <typename TInput, typename TPrepared, typename TOutput>
+class VROInferencePipeline {
+public:
+
+    typedef std::function<bool(TInput &input, TPrepared *outPrepared)> PreprocessFunction;
+    typedef std::function<bool(TPrepared &prepared, TOutput *outOutput)> InferenceFunction;
+    typedef std::function<void(TOutput &output, const VROInferenceFrameInfo &info)> PostprocessFunction;
+
+    /*
+     Create a pipeline with the given stage functions. Each function runs on
+     its stage's thread; preprocess and inference return false to drop the
+     frame (e.g. when cropping fails). queueCapacity bounds the number of
+     frames waiting in front of each stage.
+     */
+    VROInferencePipeline(std::string name,
+                         PreprocessFunction preprocess,
+                         InferenceFunction inference,
+                         PostprocessFunction postprocess,
+                         size_t queueCapacity = 1) :
+        _name(name),
+        _preprocess(preprocess), _inference(inference), _postprocess(postprocess),
+        _inputQueue(queueCapacity), _preparedQueue(queueCapacity), _outputQueue(queueCapacity),
+        _running(false), _nextFrameId(0), _submitted(0), _completed(0),
+        _lastCompletionMs(0), _averageIntervalMs(0) {}
+
+    virtual ~VROInferencePipeline() {
+        stop();
+    }
+
+    void start() {
+        if (_running.exchange(true)) {
+            return;
+        }
+        _inputQueue.reopen();
+        _preparedQueue.reopen();
+        _outputQueue.reopen();
+        _preprocessThread = std::thread(&VROInferencePipeline::runPreprocess, this);
+        _inferenceThread = std::thread(&VROInferencePipeline::runInference, this);
+        _postprocessThread = std::thread(&VROInferencePipeline::runPostprocess, this);
+    }
+
+    /*
+     Stop all stages, discarding frames in flight. Blocks until the stage
+     threads exit, so it must not be invoked from a stage function.
+     */
+    void stop() {
+        if (!_running.exchange(false)) {
+            return;
+        }
+        _inputQueue.close();
+        _preparedQueue.close();
+        _outputQueue.close();
+        _preprocessThread.join();
+        _inferenceThread.join();
+        _postprocessThread.join();
+    }
+
+    /*
+     Submit a frame. Returns immediately; returns false if an older pending
+     frame was dropped to make room, or if the pipeline is stopped and the
+     frame itself was dropped.
+     */
+    bool submit(TInput input) {
+        Frame<TInput> frame;
+        frame.info.frameId = _nextFrameId++;
+        frame.info.submitTimeMs = VROTimeCurrentMillis();
+        frame.data = std::move(input);
+        _submitted++;
+        return _inputQueue.push(std::move(frame));
+    }
+
+    const VROLatencyHistogram &getLatency(VROInferenceStage stage) const {
+        return _latency[(int) stage];
+    }
+
+    /*
+     Frames completed per second, averaged over recent completions.
+     */
+    double getFPS() const {
+        double interval = _averageIntervalMs.load();
+        return interval > 0 ? 1000.0 / interval : 0;
+    }
+
+    uint64_t getSubmittedCount() const { return _submitted; }
+    uint64_t getCompletedCount() const { return _completed; }
+
+    /*
+     Frames dropped in total: displaced from a full queue, or rejected by a
+     stage function.
+     */
+    uint64_t getDroppedCount() const {
+        return _inputQueue.getDroppedCount() + _preparedQueue.getDroppedCount() +
+               _outputQueue.getDroppedCount() + _rejected;
+    }
+
+    const std::string &getName() const { return _name; }
+
+private:
+
+    template <typename T>
+    struct Frame {
+        VROInferenceFrameInfo info;
+        T data;
+    };
+
+    std::string _name;
+    PreprocessFunction _preprocess;
+    InferenceFunction _inference;
+    PostprocessFunction _postprocess;
+
+    VROBoundedQueue<Frame<TInput>> _inputQueue;
+    VROBoundedQueue<Frame<TPrepared>> _preparedQueue;
+    VROBoundedQueue<Frame<TOutput>> _outputQueue;
+    std::thread _preprocessThread, _inferenceThread, _postprocessThread;
+
+    std::atomic<bool> _running;
+    std::atomic<uint64_t> _nextFrameId;
+    std::atomic<uint64_t> _submitted, _completed, _rejected { 0 };
+
+    VROLatencyHistogram _latency[4];
+
+    /*
+     Exponential moving average of the time between completions. Written only
+     by the postprocess thread.
+     */
+    double _lastCompletionMs;
+    std::atomic<double> _averageIntervalMs;
+
+    void runPreprocess() {
+        Frame<TInput> input;
+        while (_inputQueue.pop(&input)) {
+            Frame<TPrepared> prepared;
+            prepared.info = input.info;
+            prepared.info.preprocessStartMs = VROTimeCurrentMillis();
+            if (!_preprocess(input.data, &prepared.data)) {
+                _rejected++;
+                continue;
+            }
+            _latency[(int) VROInferenceStage::Preprocess].record(VROTimeCurrentMillis() - prepared.info.preprocessStartMs);
+            _preparedQueue.push(std::move(prepared));
+        }
+    }
+
+    void runInference() {
+        Frame<TPrepared> prepared;
+        while (_preparedQueue.pop(&prepared)) {
+            Frame<TOutput> output;
+            output.info = prepared.info;
+            output.info.inferenceStartMs = VROTimeCurrentMillis();
+            if (!_inference(prepared.data, &output.data)) {
+                _rejected++;
+                continue;
+            }
+            _latency[(int) VROInferenceStage::Inference].record(VROTimeCurrentMillis() - output.info.inferenceStartMs);
+            _outputQueue.push(std::move(output));
+        }
+    }
+
+    void runPostprocess() {
+        Frame<TOutput> output;
+        while (_outputQueue.pop(&output)) {
+            output.info.postprocessStartMs = VROTimeCurrentMillis();
+            _postprocess(output.data, output.info);
+
+            double now = VROTimeCurrentMillis();
+            _latency[(int) VROInferenceStage::Postprocess].record(now - output.info.postprocessStartMs);
+            _latency[(int) VROInferenceStage::EndToEnd].record(now - output.info.submitTimeMs);
+            _completed++;
+
+            if (_lastCompletionMs > 0) {
+                double interval = now - _lastCompletionMs;
+                double average = _averageIntervalMs.load();
+                _averageIntervalMs = (average > 0) ? average * 0.9 + interval * 0.1 : interval;
+            }
+            _lastCompletionMs = now;
+        }
+    }
+
+};
+
+#endif /* VROInferencePipeline_h */
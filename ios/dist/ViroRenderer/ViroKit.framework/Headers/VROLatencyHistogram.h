@@ -0,0 +1,133 @@
+//
+//  VROLatencyHistogram.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROLatencyHistogram_h
+#define VROLatencyHistogram_h
+
+#include <mutex>
+#include <cmath>
+#include <algorithm>
+#include <stdint.h>
+
+/*
+ Fixed-size, log-scale histogram of durations in milliseconds. Buckets are
+ spaced by a factor of sqrt(2) starting at 0.125 ms, which covers up to ~5.8
+ seconds in 32 buckets with at most ~41% relative error per percentile,
+ without storing individual samples. Longer durations are counted in the
+ last bucket; getMaxMs() still reports them exactly.
+
+ Thread-safe: samples may be recorded from a worker thread while another
+ thread reads percentiles.
+ */
+class VROLatencyHistogram {
+public:
+
+    static const int kNumBuckets = 32;
+
+    VROLatencyHistogram() {
+        reset();
+    }
+
+    void record(double ms) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _buckets[getBucket(ms)]++;
+        _count++;
+        _sumMs += ms;
+        _minMs = std::min(_minMs, ms);
+        _maxMs = std::max(_maxMs, ms);
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::fill(_buckets, _buckets + kNumBuckets, 0);
+        _count = 0;
+        _sumMs = 0;
+        _minMs = INFINITY;
+        _maxMs = 0;
+    }
+
+    uint64_t getCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count;
+    }
+
+    double getMeanMs() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count ? _sumMs / _count : 0;
+    }
+
+    double getMaxMs() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _maxMs;
+    }
+
+    /*
+     Approximate the given percentile (0-100), returning the upper bound of the
+     bucket that contains it, clamped to the observed min and max.
+     */
+    double getPercentileMs(double percentile) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_count == 0) {
+            return 0;
+        }
+        uint64_t target = (uint64_t) ceil(_count * std::max(0.0, std::min(100.0, percentile)) / 100.0);
+        target = std::max<uint64_t>(target, 1);
+
+        uint64_t seen = 0;
+        for (int i = 0; i < kNumBuckets; i++) {
+            seen += _buckets[i];
+            if (seen >= target) {
+                return std::max(_minMs, std::min(_maxMs, getBucketUpperBound(i)));
+            }
+        }
+        return _maxMs;
+    }
+
+    static double getBucketUpperBound(int bucket) {
+        return kFirstBucketMs * pow(2.0, bucket * 0.5);
+    }
+
+private:
+
+    static constexpr double kFirstBucketMs = 0.125;
+
+    mutable std::mutex _mutex;
+    uint64_t _buckets[kNumBuckets];
+    uint64_t _count;
+    double _sumMs;
+    double _minMs;
+    double _maxMs;
+
+    static int getBucket(double ms) {
+        if (!(ms > kFirstBucketMs)) {
+            return 0;
+        }
+        int bucket = (int) ceil(2.0 * log2(ms / kFirstBucketMs));
+        return std::min(kNumBuckets - 1, bucket);
+    }
+
+};
+
+#endif /* VROLatencyHistogram_h */
@@ -0,0 +1,752 @@
+//
+//  VROMipChainBloom.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROMipChainBloom_h
+#define VROMipChainBloom_h
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include "VROOpenGL.h"
+#include "VROShaderProgramCache.h"
+#include "VROUniformStreamBuffer.h"
+#include "VROTime.h"
+#include "VROLog.h"
+
+/*
+ The bloom implementations VROBloomRenderPass selects between.
+ GaussianPingPong is VROGaussianBlurRenderPass; MipChain is
+ VROMipChainBloom.
+ */
+enum class VROBloomMode {
+    GaussianPingPong,
+    MipChain
+};
+
+/*
+ Fill cost of one bloom frame.
+ */
+struct VROBloomCost {
+    int passes = 0;
+    int64_t pixelsWritten = 0;
+    int64_t texelFetches = 0;
+
+    std::string toString() const {
+        std::stringstream ss;
+        ss << passes << " passes, " << pixelsWritten / 1000 << "K pixels written, "
+           << texelFetches / 1000 << "K texel fetches";
+        return ss.str();
+    }
+};
+
+/*
+ Measured cost of one bloom frame. iOS OpenGL ES has no timer queries, so
+ on iOS gpuMs is always -1 and only the CPU time to issue the passes is
+ reported. GPU time is only available on Android contexts that expose
+ GL_EXT_disjoint_timer_query (checked at runtime); it is polled in
+ beginFrame() and lags the frame it measures by up to kBloomTimerQueries
+ frames.
+ */
+struct VROBloomFrameStats {
+    VROBloomCost cost;
+    double cpuMs = 0;            // Time to issue the passes
+    double gpuMs = -1;           // Most recent GPU time, or -1 if unavailable
+
+    std::string toString() const {
+        std::stringstream ss;
+        ss << "Bloom: " << cost.toString() << ", CPU " << cpuMs << " ms";
+        if (gpuMs >= 0) {
+            ss << ", GPU " << gpuMs << " ms";
+        }
+        return ss.str();
+    }
+};
+
+static const int kBloomTimerQueries = 3;
+
+/*
+ Size of the std140 bloom_pass block (two vec4s), and the binding point it
+ is streamed to. The bloom programs have no material block of their own,
+ so the block takes the streamed material binding point.
+ */
+static const int kBloomPassBlockSize = 32;
+static const int kBloomPassUBOBindingPoint = kStreamedMaterialUBOBindingPoint;
+
+/*
+ Full-screen triangle generated from gl_VertexID; no vertex buffers.
+ */
+static const char *const kBloomVertexSource = R"(#version 300 es
+out highp vec2 v_texcoord;
+
+void main() {
+    highp vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    v_texcoord = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+/*
+ 13-tap downsample: four overlapping 2x2 box filters around the center
+ plus one inner box, weighted to suppress the flicker of a plain 2x2
+ box. The prefilter (x: threshold, y: knee, z: intensity, w: enabled)
+ applies a soft-knee bright pass on the first level. source_texel.xy is
+ the size of a source texel.
+ */
+static const char *const kBloomDownsampleSource = R"(#version 300 es
+precision highp float;
+
+uniform sampler2D source_texture;
+layout (std140) uniform bloom_pass {
+    vec4 source_texel;
+    vec4 prefilter;
+};
+
+in vec2 v_texcoord;
+out vec4 frag_color;
+
+vec3 sample_source(vec2 offset) {
+    return texture(source_texture, v_texcoord + offset * source_texel.xy).rgb;
+}
+
+void main() {
+    vec3 a = sample_source(vec2(-2.0,  2.0));
+    vec3 b = sample_source(vec2( 0.0,  2.0));
+    vec3 c = sample_source(vec2( 2.0,  2.0));
+    vec3 d = sample_source(vec2(-2.0,  0.0));
+    vec3 e = sample_source(vec2( 0.0,  0.0));
+    vec3 f = sample_source(vec2( 2.0,  0.0));
+    vec3 g = sample_source(vec2(-2.0, -2.0));
+    vec3 h = sample_source(vec2( 0.0, -2.0));
+    vec3 i = sample_source(vec2( 2.0, -2.0));
+    vec3 j = sample_source(vec2(-1.0,  1.0));
+    vec3 k = sample_source(vec2( 1.0,  1.0));
+    vec3 l = sample_source(vec2(-1.0, -1.0));
+    vec3 m = sample_source(vec2( 1.0, -1.0));
+
+    vec3 color = e * 0.125 + (a + c + g + i) * 0.03125 + (b + d + f + h) * 0.0625 + (j + k + l + m) * 0.125;
+    if (prefilter.w > 0.0) {
+        color = min(color, vec3(65000.0));
+        float brightness = max(color.r, max(color.g, color.b));
+        float soft = clamp(brightness - prefilter.x + prefilter.y, 0.0, 2.0 * prefilter.y);
+        soft = soft * soft / (4.0 * prefilter.y + 0.0001);
+        color *= prefilter.z * max(soft, brightness - prefilter.x) / max(brightness, 0.0001);
+    }
+    frag_color = vec4(color, 1.0);
+}
+)";
+
+/*
+ 3x3 tent upsample; the result is blended additively into the target.
+ source_texel.xy is the tent's spread in texture coordinates. The block
+ matches the downsample's; prefilter is unused.
+ */
+static const char *const kBloomUpsampleSource = R"(#version 300 es
+precision highp float;
+
+uniform sampler2D source_texture;
+layout (std140) uniform bloom_pass {
+    vec4 source_texel;
+    vec4 prefilter;
+};
+
+in vec2 v_texcoord;
+out vec4 frag_color;
+
+vec3 sample_source(vec2 offset) {
+    return texture(source_texture, v_texcoord + offset * source_texel.xy).rgb;
+}
+
+void main() {
+    vec3 color = sample_source(vec2(0.0, 0.0)) * 4.0;
+    color += (sample_source(vec2(-1.0, 0.0)) + sample_source(vec2(1.0, 0.0)) +
+              sample_source(vec2(0.0, -1.0)) + sample_source(vec2(0.0, 1.0))) * 2.0;
+    color += sample_source(vec2(-1.0, -1.0)) + sample_source(vec2(1.0, -1.0)) +
+             sample_source(vec2(-1.0,  1.0)) + sample_source(vec2(1.0,  1.0));
+    frag_color = vec4(color * (1.0 / 16.0), 1.0);
+}
+)";
+
+/*
+ Bloom by progressive downsampling and upsampling through a chain of
+ half-sized targets, as an alternative to the fixed-resolution Gaussian
+ ping-pong of VROGaussianBlurRenderPass.
+
+ The input is first downsampled to half resolution with the bright-pass
+ prefilter (threshold, soft knee, and intensity) applied, then repeatedly
+ halved with a 13-tap filter until the smallest level is reached. The chain
+ is then walked back up: each level is upsampled with a 3x3 tent filter and
+ added into the next larger level. The result, in the half-resolution
+ level, is the bloom texture to composite additively over the scene.
+
+ Each level has a quarter of the pixels of the one above it, so the whole
+ chain writes fewer pixels than three half-resolution passes, while giving a
+ wider blur than the Gaussian with far fewer fetches. Clearing each level
+ before its downsample lets tiled GPUs skip loading its previous contents.
+
+ The passes are issued directly in GL. Each pass's texel size and
+ prefilter are written to a bloom_pass uniform block in a
+ VROUniformStreamBuffer, uploaded once per render() and bound by offset
+ for each pass. Every piece of state the passes change is read beforehand
+ and restored afterward: the framebuffer binding, viewport, scissor, depth
+ and cull tests, blending with its function and equation, depth and color
+ masks, program, vertex array, the active texture unit and its 2D binding,
+ and the uniform buffer bindings. A VRODriverStateCache in front of the
+ same context therefore stays valid.
+
+ Per-frame stats are collected between beginFrame() and endFrame(), which
+ VROBloomRenderPass calls around each render. No driver calls them: the
+ prebuilt GL driver and VROChoreographer know nothing of the mip chain,
+ and still use VROGaussianBlurRenderPass unless VROBloomRenderPass is put
+ in its place.
+ */
+class VROMipChainBloom {
+public:
+
+    VROMipChainBloom(std::shared_ptr<VROShaderProgramCache> programs, int maxLevels = 6) :
+        _programs(programs),
+        _maxLevels(maxLevels),
+        _width(0), _height(0),
+        _threshold(1.0), _knee(0.5), _intensity(1.0), _radius(1.0),
+        _downsampleProgram(0), _upsampleProgram(0),
+        _downsampleSourceUniform(-1), _upsampleSourceUniform(-1), _vao(0),
+        _timerQueriesSupported(false), _queryIndex(0), _queryActive(false) {
+        for (int i = 0; i < kBloomTimerQueries; i++) {
+            _queries[i] = 0;
+            _queryPending[i] = false;
+        }
+    }
+    virtual ~VROMipChainBloom() {
+        deleteLevels();
+        if (_vao) {
+            GL( glDeleteVertexArrays(1, &_vao) );
+        }
+#ifdef GL_TIME_ELAPSED_EXT
+        if (_queries[0]) {
+            GL( glDeleteQueries(kBloomTimerQueries, _queries) );
+        }
+#endif
+    }
+
+    /*
+     True if the current context supports GPU timer queries. Always false
+     on iOS.
+     */
+    static bool isTimerQuerySupported() {
+#ifdef GL_TIME_ELAPSED_EXT
+        GLint count = 0;
+        GL( glGetIntegerv(GL_NUM_EXTENSIONS, &count) );
+        for (GLint i = 0; i < count; i++) {
+            const char *extension = (const char *) glGetStringi(GL_EXTENSIONS, i);
+            if (extension && strcmp(extension, "GL_EXT_disjoint_timer_query") == 0) {
+                return true;
+            }
+        }
+#endif
+        return false;
+    }
+
+#pragma mark - Settings
+
+    /*
+     Set the size of the input texture. The chain's first level is half this
+     size; levels are added until kMinLevelSize or maxLevels is reached.
+     */
+    void setViewport(int width, int height) {
+        if (width == _width && height == _height) {
+            return;
+        }
+        _width = width;
+        _height = height;
+        deleteLevels();
+
+        int levelWidth = width / 2;
+        int levelHeight = height / 2;
+        while ((int) _levels.size() < _maxLevels && levelWidth >= kMinLevelSize && levelHeight >= kMinLevelSize) {
+            Level level;
+            level.width = levelWidth;
+            level.height = levelHeight;
+            GL( glGenTextures(1, &level.texture) );
+            GL( glBindTexture(GL_TEXTURE_2D, level.texture) );
+            GL( glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, levelWidth, levelHeight) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE) );
+            GL( glGenFramebuffers(1, &level.framebuffer) );
+            GL( glBindFramebuffer(GL_FRAMEBUFFER, level.framebuffer) );
+            GL( glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, level.texture, 0) );
+            _levels.push_back(level);
+
+            levelWidth /= 2;
+            levelHeight /= 2;
+        }
+    }
+
+    /*
+     Luminance above which pixels bloom, and the width of the soft
+     transition below it.
+     */
+    void setThreshold(float threshold, float knee = 0.5) {
+        _threshold = threshold;
+        _knee = knee;
+    }
+
+    /*
+     Scale applied to the bright-pass result, equivalent to
+     VROGaussianBlurRenderPass::setReinforcedIntensity.
+     */
+    void setIntensity(float intensity) {
+        _intensity = intensity;
+    }
+
+    /*
+     Spread of the upsampling tent filter, in source texels. Larger values
+     widen the bloom at the cost of some ringing.
+     */
+    void setFilterRadius(float radius) {
+        _radius = radius;
+    }
+
+    int getNumLevels() const {
+        return (int) _levels.size();
+    }
+
+    /*
+     Size of the given level of the chain; level 0 is half the viewport.
+     */
+    int getLevelWidth(int level) const {
+        return _levels[level].width;
+    }
+    int getLevelHeight(int level) const {
+        return _levels[level].height;
+    }
+
+    /*
+     The half-resolution bloom texture produced by the last render().
+     */
+    GLuint getOutputTexture() const {
+        return _levels.empty() ? 0 : _levels[0].texture;
+    }
+
+    /*
+     The framebuffer with the output texture attached, for blitting the
+     bloom into another target.
+     */
+    GLuint getOutputFramebuffer() const {
+        return _levels.empty() ? 0 : _levels[0].framebuffer;
+    }
+
+    int getViewportWidth() const { return _width; }
+    int getViewportHeight() const { return _height; }
+
+#pragma mark - Rendering
+
+    /*
+     Build the bloom chain from the given (HDR) texture. Returns the output
+     texture, or 0 if the viewport has not been set or the programs failed
+     to compile.
+     */
+    GLuint render(GLuint inputTexture) {
+        if (_levels.empty() || !loadPrograms()) {
+            return 0;
+        }
+        double start = VROTimeCurrentMillis();
+        beginTimerQuery();
+
+        // Write every pass's parameters, then upload them in one go
+        _passUniforms->beginFrame();
+        std::vector<VROUniformAllocation> downsampleBlocks, upsampleBlocks;
+        for (int i = 0; i < (int) _levels.size(); i++) {
+            int sourceWidth = (i == 0) ? _width : _levels[i - 1].width;
+            int sourceHeight = (i == 0) ? _height : _levels[i - 1].height;
+            downsampleBlocks.push_back(writePassBlock(1.0 / sourceWidth, 1.0 / sourceHeight, i == 0));
+        }
+        for (int i = (int) _levels.size() - 1; i > 0; i--) {
+            upsampleBlocks.push_back(writePassBlock(_radius / _levels[i].width, _radius / _levels[i].height, false));
+        }
+        _passUniforms->commit();
+
+        SavedState saved;
+        saveState(&saved);
+
+        // Render passes may leave scissoring or a partial color mask set
+        GL( glDisable(GL_SCISSOR_TEST) );
+        GL( glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE) );
+        GL( glDisable(GL_DEPTH_TEST) );
+        GL( glDisable(GL_CULL_FACE) );
+        GL( glDisable(GL_BLEND) );
+        GL( glDepthMask(GL_FALSE) );
+        GL( glBindVertexArray(_vao) );
+        GL( glActiveTexture(GL_TEXTURE0) );
+
+        // Downsample, applying the bright pass on the first level
+        GL( glUseProgram(_downsampleProgram) );
+        GL( glUniform1i(_downsampleSourceUniform, 0) );
+        for (int i = 0; i < (int) _levels.size(); i++) {
+            GLuint source = (i == 0) ? inputTexture : _levels[i - 1].texture;
+            _passUniforms->bind(downsampleBlocks[i], kBloomPassUBOBindingPoint);
+            drawLevel(_levels[i], source, kDownsampleTaps);
+        }
+
+        // Upsample, adding each level into the next larger one
+        GL( glUseProgram(_upsampleProgram) );
+        GL( glUniform1i(_upsampleSourceUniform, 0) );
+        GL( glEnable(GL_BLEND) );
+        GL( glBlendEquation(GL_FUNC_ADD) );
+        GL( glBlendFunc(GL_ONE, GL_ONE) );
+        for (int i = (int) _levels.size() - 1; i > 0; i--) {
+            _passUniforms->bind(upsampleBlocks[_levels.size() - 1 - i], kBloomPassUBOBindingPoint);
+            drawLevel(_levels[i - 1], _levels[i].texture, kUpsampleTaps);
+        }
+        restoreState(saved);
+        _passUniforms->endFrame();
+
+        endTimerQuery();
+        _frameStats.cpuMs += VROTimeCurrentMillis() - start;
+        return _levels[0].texture;
+    }
+
+#pragma mark - Frame
+
+    void beginFrame() {
+        double gpuMs = _frameStats.gpuMs;
+        _frameStats = VROBloomFrameStats();
+        _frameStats.gpuMs = gpuMs;
+        pollTimerQueries();
+    }
+    void endFrame() {
+        _lastFrameStats = _frameStats;
+    }
+
+    const VROBloomFrameStats &getFrameStats() const { return _frameStats; }
+    const VROBloomFrameStats &getLastFrameStats() const { return _lastFrameStats; }
+
+    /*
+     Stats of the pass parameter stream for the last render().
+     */
+    VROUniformStreamStats getPassUniformStats() const {
+        return _passUniforms ? _passUniforms->getLastFrameStats() : VROUniformStreamStats();
+    }
+
+#pragma mark - Cost
+
+    /*
+     Fill cost of the mip chain for the given input size.
+     */
+    static VROBloomCost estimateCost(int width, int height, int maxLevels = 6) {
+        VROBloomCost cost;
+        std::vector<int64_t> pixels;
+        int levelWidth = width / 2;
+        int levelHeight = height / 2;
+        while ((int) pixels.size() < maxLevels && levelWidth >= kMinLevelSize && levelHeight >= kMinLevelSize) {
+            pixels.push_back((int64_t) levelWidth * levelHeight);
+            levelWidth /= 2;
+            levelHeight /= 2;
+        }
+        for (int i = 0; i < (int) pixels.size(); i++) {
+            cost.passes++;
+            cost.pixelsWritten += pixels[i];
+            cost.texelFetches += pixels[i] * kDownsampleTaps;
+        }
+        for (int i = (int) pixels.size() - 1; i > 0; i--) {
+            cost.passes++;
+            cost.pixelsWritten += pixels[i - 1];
+            cost.texelFetches += pixels[i - 1] * (kUpsampleTaps + 1); // Plus the blend read
+        }
+        return cost;
+    }
+
+    /*
+     Fill cost of VROGaussianBlurRenderPass with the given settings, for
+     comparison: one pre-blur pass, then one separable pass per iteration,
+     all at the blur scale.
+     */
+    static VROBloomCost estimateGaussianCost(int width, int height, float blurScale, int iterations,
+                                             int kernelSize, bool bilinearLookup) {
+        VROBloomCost cost;
+        int64_t pixels = (int64_t) (width * blurScale) * (int64_t) (height * blurScale);
+        int taps = bilinearLookup ? (kernelSize + 1) / 2 + 1 : kernelSize;
+
+        cost.passes = 1 + iterations;
+        cost.pixelsWritten = pixels * (1 + iterations);
+        cost.texelFetches = pixels + pixels * taps * iterations;
+        return cost;
+    }
+
+private:
+
+    static const int kMinLevelSize = 8;
+    static const int kDownsampleTaps = 13;
+    static const int kUpsampleTaps = 9;
+
+    struct Level {
+        int width, height;
+        GLuint texture = 0;
+        GLuint framebuffer = 0;
+    };
+
+    std::shared_ptr<VROShaderProgramCache> _programs;
+    int _maxLevels;
+    int _width, _height;
+    std::vector<Level> _levels;
+
+    float _threshold, _knee, _intensity, _radius;
+
+    GLuint _downsampleProgram, _upsampleProgram;
+    GLint _downsampleSourceUniform, _upsampleSourceUniform;
+    GLuint _vao;
+
+    /*
+     Parameters of each pass, streamed as bloom_pass blocks.
+     */
+    std::unique_ptr<VROUniformStreamBuffer> _passUniforms;
+
+    bool _timerQueriesSupported;
+    GLuint _queries[kBloomTimerQueries];
+    bool _queryPending[kBloomTimerQueries];
+    int _queryIndex;
+    bool _queryActive;
+
+    VROBloomFrameStats _frameStats;
+    VROBloomFrameStats _lastFrameStats;
+
+    /*
+     GL state changed by render(), captured before and restored after it.
+     */
+    struct SavedState {
+        GLint framebuffer, program, vertexArray, activeTexture, texture;
+        GLint uniformBuffer, passBlockBuffer;
+        GLint64 passBlockStart, passBlockSize;
+        GLint viewport[4];
+        GLint blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha;
+        GLint blendEquationRGB, blendEquationAlpha;
+        GLboolean colorMask[4];
+        GLboolean depthMask;
+        GLboolean scissorTest, depthTest, cullFace, blend;
+    };
+
+    static void saveState(SavedState *state) {
+        GL( glGetIntegerv(GL_FRAMEBUFFER_BINDING, &state->framebuffer) );
+        GL( glGetIntegerv(GL_CURRENT_PROGRAM, &state->program) );
+        GL( glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &state->vertexArray) );
+        GL( glGetIntegerv(GL_ACTIVE_TEXTURE, &state->activeTexture) );
+        GL( glActiveTexture(GL_TEXTURE0) );
+        GL( glGetIntegerv(GL_TEXTURE_BINDING_2D, &state->texture) );
+        GL( glGetIntegerv(GL_VIEWPORT, state->viewport) );
+        GL( glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, &state->uniformBuffer) );
+        GL( glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, kBloomPassUBOBindingPoint, &state->passBlockBuffer) );
+        GL( glGetInteger64i_v(GL_UNIFORM_BUFFER_START, kBloomPassUBOBindingPoint, &state->passBlockStart) );
+        GL( glGetInteger64i_v(GL_UNIFORM_BUFFER_SIZE, kBloomPassUBOBindingPoint, &state->passBlockSize) );
+        GL( glGetIntegerv(GL_BLEND_SRC_RGB, &state->blendSrcRGB) );
+        GL( glGetIntegerv(GL_BLEND_DST_RGB, &state->blendDstRGB) );
+        GL( glGetIntegerv(GL_BLEND_SRC_ALPHA, &state->blendSrcAlpha) );
+        GL( glGetIntegerv(GL_BLEND_DST_ALPHA, &state->blendDstAlpha) );
+        GL( glGetIntegerv(GL_BLEND_EQUATION_RGB, &state->blendEquationRGB) );
+        GL( glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &state->blendEquationAlpha) );
+        GL( glGetBooleanv(GL_COLOR_WRITEMASK, state->colorMask) );
+        GL( glGetBooleanv(GL_DEPTH_WRITEMASK, &state->depthMask) );
+        state->scissorTest = glIsEnabled(GL_SCISSOR_TEST);
+        state->depthTest = glIsEnabled(GL_DEPTH_TEST);
+        state->cullFace = glIsEnabled(GL_CULL_FACE);
+        state->blend = glIsEnabled(GL_BLEND);
+    }
+
+    static void setEnabled(GLenum capability, GLboolean enabled) {
+        if (enabled) {
+            GL( glEnable(capability) );
+        } else {
+            GL( glDisable(capability) );
+        }
+    }
+
+    static void restoreState(const SavedState &state) {
+        GL( glBindFramebuffer(GL_FRAMEBUFFER, state.framebuffer) );
+        GL( glUseProgram(state.program) );
+        GL( glBindVertexArray(state.vertexArray) );
+        GL( glActiveTexture(GL_TEXTURE0) );
+        GL( glBindTexture(GL_TEXTURE_2D, state.texture) );
+        GL( glActiveTexture(state.activeTexture) );
+        GL( glViewport(state.viewport[0], state.viewport[1], state.viewport[2], state.viewport[3]) );
+        if (state.passBlockSize > 0) {
+            GL( glBindBufferRange(GL_UNIFORM_BUFFER, kBloomPassUBOBindingPoint, state.passBlockBuffer,
+                                  (GLintptr) state.passBlockStart, (GLsizeiptr) state.passBlockSize) );
+        } else {
+            GL( glBindBufferBase(GL_UNIFORM_BUFFER, kBloomPassUBOBindingPoint, state.passBlockBuffer) );
+        }
+        GL( glBindBuffer(GL_UNIFORM_BUFFER, state.uniformBuffer) );
+        GL( glBlendFuncSeparate(state.blendSrcRGB, state.blendDstRGB, state.blendSrcAlpha, state.blendDstAlpha) );
+        GL( glBlendEquationSeparate(state.blendEquationRGB, state.blendEquationAlpha) );
+        GL( glColorMask(state.colorMask[0], state.colorMask[1], state.colorMask[2], state.colorMask[3]) );
+        GL( glDepthMask(state.depthMask) );
+        setEnabled(GL_SCISSOR_TEST, state.scissorTest);
+        setEnabled(GL_DEPTH_TEST, state.depthTest);
+        setEnabled(GL_CULL_FACE, state.cullFace);
+        setEnabled(GL_BLEND, state.blend);
+    }
+
+    /*
+     Allocate and fill one pass's bloom_pass block.
+     */
+    VROUniformAllocation writePassBlock(float texelX, float texelY, bool prefilter) {
+        VROUniformAllocation block = _passUniforms->allocate(kBloomPassBlockSize);
+        if (!block.isValid()) {
+            return block;
+        }
+        VROStd140Writer writer(block);
+        writer.writeVec4(VROVector4f(texelX, texelY, 0, 0));
+        writer.writeVec4(VROVector4f(_threshold, _knee, _intensity, prefilter ? 1.0 : 0.0));
+        return block;
+    }
+
+    void drawLevel(const Level &target, GLuint source, int taps) {
+        GL( glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer) );
+        GL( glViewport(0, 0, target.width, target.height) );
+        GL( glBindTexture(GL_TEXTURE_2D, source) );
+        if (taps == kDownsampleTaps) {
+            GL( glClear(GL_COLOR_BUFFER_BIT) );
+        }
+        GL( glDrawArrays(GL_TRIANGLES, 0, 3) );
+
+        int64_t pixels = (int64_t) target.width * target.height;
+        _frameStats.cost.passes++;
+        _frameStats.cost.pixelsWritten += pixels;
+        _frameStats.cost.texelFetches += pixels * (taps == kUpsampleTaps ? taps + 1 : taps);
+    }
+
+    void deleteLevels() {
+        for (Level &level : _levels) {
+            GL( glDeleteFramebuffers(1, &level.framebuffer) );
+            GL( glDeleteTextures(1, &level.texture) );
+        }
+        _levels.clear();
+    }
+
+    bool loadPrograms() {
+        if (_downsampleProgram && _upsampleProgram) {
+            return true;
+        }
+        VROShaderProgramSource downsample;
+        downsample.name = "bloom_downsample";
+        downsample.vertexSource = kBloomVertexSource;
+        downsample.fragmentSource = kBloomDownsampleSource;
+        _downsampleProgram = _programs->getProgram(downsample);
+
+        VROShaderProgramSource upsample;
+        upsample.name = "bloom_upsample";
+        upsample.vertexSource = kBloomVertexSource;
+        upsample.fragmentSource = kBloomUpsampleSource;
+        _upsampleProgram = _programs->getProgram(upsample);
+
+        if (!_downsampleProgram || !_upsampleProgram ||
+            !VROUniformStreamBuffer::bindBlock(_downsampleProgram, "bloom_pass", kBloomPassUBOBindingPoint) ||
+            !VROUniformStreamBuffer::bindBlock(_upsampleProgram, "bloom_pass", kBloomPassUBOBindingPoint)) {
+            pinfo("Failed to load mip-chain bloom programs");
+            _downsampleProgram = 0;
+            _upsampleProgram = 0;
+            return false;
+        }
+        _downsampleSourceUniform = glGetUniformLocation(_downsampleProgram, "source_texture");
+        _upsampleSourceUniform = glGetUniformLocation(_upsampleProgram, "source_texture");
+
+        // One aligned block per pass: a downsample per level, an upsample per level but the last
+        GLint alignment = 0;
+        GL( glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment) );
+        int blockStride = std::max((int) alignment, kBloomPassBlockSize);
+        _passUniforms.reset(new VROUniformStreamBuffer(blockStride * 2 * _maxLevels));
+
+        GL( glGenVertexArrays(1, &_vao) );
+#ifdef GL_TIME_ELAPSED_EXT
+        _timerQueriesSupported = isTimerQuerySupported();
+        if (_timerQueriesSupported) {
+            GL( glGenQueries(kBloomTimerQueries, _queries) );
+        }
+#endif
+        return true;
+    }
+
+#pragma mark - Timer Queries
+
+    void beginTimerQuery() {
+#ifdef GL_TIME_ELAPSED_EXT
+        // Skip timing this render if the next query's result is still in flight
+        if (!_timerQueriesSupported || _queryPending[_queryIndex]) {
+            return;
+        }
+        GL( glBeginQuery(GL_TIME_ELAPSED_EXT, _queries[_queryIndex]) );
+        _queryPending[_queryIndex] = true;
+        _queryActive = true;
+#endif
+    }
+
+    void endTimerQuery() {
+#ifdef GL_TIME_ELAPSED_EXT
+        if (!_queryActive) {
+            return;
+        }
+        GL( glEndQuery(GL_TIME_ELAPSED_EXT) );
+        _queryActive = false;
+        _queryIndex = (_queryIndex + 1) % kBloomTimerQueries;
+#endif
+    }
+
+    /*
+     Collect finished queries without stalling; results from disjoint
+     periods (e.g. a GPU frequency change) are discarded.
+     */
+    void pollTimerQueries() {
+#ifdef GL_TIME_ELAPSED_EXT
+        if (!_timerQueriesSupported) {
+            return;
+        }
+        GLint disjoint = 0;
+#ifdef GL_GPU_DISJOINT_EXT
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+#endif
+        for (int i = 0; i < kBloomTimerQueries; i++) {
+            if (!_queryPending[i]) {
+                continue;
+            }
+            GLuint available = 0;
+            GL( glGetQueryObjectuiv(_queries[i], GL_QUERY_RESULT_AVAILABLE, &available) );
+            if (!available) {
+                continue;
+            }
+            GLuint elapsedNs = 0;
+            GL( glGetQueryObjectuiv(_queries[i], GL_QUERY_RESULT, &elapsedNs) );
+            if (!disjoint) {
+                _frameStats.gpuMs = elapsedNs / 1000000.0;
+            }
+            _queryPending[i] = false;
+        }
+#endif
+    }
+
+};
+
+#endif /* VROMipChainBloom_h */
@@ -0,0 +1,318 @@
+//
+//  VROMorphBlender.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROMorphBlender_h
+#define VROMorphBlender_h
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include "VROSIMD.h"
+#include "VROThreadPool.h"
+#include "VROTime.h"
+#include "VROLog.h"
+
+struct VROMorphBlendStats {
+    int activeTargets = 0;        // Targets with non-zero weight
+    int changedTargets = 0;       // Targets whose weight changed since the last update
+    int dirtyVertices = 0;        // Vertices re-blended (and to be uploaded)
+    double blendTimeMs = 0;
+};
+
+/*
+ A morph target stored as the sparse set of vertices it moves: sorted vertex
+ indices and their deltas (padded to 4 floats). Most blendshapes of a face
+ rig move a small region, so this is typically a fraction of the dense
+ vector-per-vertex data held by VROMorphTarget.
+ */
+struct VROSparseMorphTarget {
+    std::vector<uint32_t> indices;
+    std::vector<float> deltas;
+
+    /*
+     Offsets into indices at each chunk boundary, so each chunk's deltas are
+     found without searching.
+     */
+    std::vector<uint32_t> chunkOffsets;
+
+    float weight = 0;
+    float uploadedWeight = 0;
+};
+
+/*
+ CPU morph target blending for one vertex attribute (e.g. positions or
+ normals) of a morphed geometry:
+
+   output = base + sum(weight[t] * delta[t])
+
+ Targets are stored sparsely, zero-weight targets are skipped, and only the
+ fixed-size chunks of vertices touched by targets whose weight changed are
+ re-blended, in parallel on the shared VROThreadPool with VROFloat4. Each
+ update reports the changed vertex ranges, so only those need to be written
+ back to the VROGeometrySource and uploaded.
+
+ The output is kept with 4 floats per vertex; writeOutput() packs the dirty
+ ranges into the attribute's own layout.
+ */
+class VROMorphBlender {
+public:
+
+    /*
+     Create a blender over the given base data (vertexCount vertices of
+     components floats each, 3 or 4, stride floats apart). chunkSize is the
+     granularity, in vertices, of dirty tracking and parallel work.
+     */
+    VROMorphBlender(const float *base, int vertexCount, int components, int stride, int chunkSize = 1024) :
+        _vertexCount(vertexCount), _components(components),
+        _chunkSize(std::max(1, chunkSize)),
+        _chunkCount((vertexCount + _chunkSize - 1) / _chunkSize),
+        _base((size_t) vertexCount * 4, 0), _output((size_t) vertexCount * 4, 0),
+        _chunkDirty(_chunkCount, 0) {
+        for (int v = 0; v < vertexCount; v++) {
+            for (int c = 0; c < components; c++) {
+                _base[v * 4 + c] = base[(size_t) v * stride + c];
+            }
+        }
+        _output = _base;
+        markAllDirty();
+    }
+
+    /*
+     Add a target from dense per-vertex deltas (laid out like the base data).
+     Vertices whose delta is within threshold on every component are dropped.
+     Returns the target's index.
+     */
+    int addTarget(const float *deltas, int stride, float threshold = 0) {
+        VROSparseMorphTarget target;
+        for (int v = 0; v < _vertexCount; v++) {
+            const float *delta = &deltas[(size_t) v * stride];
+            bool moved = false;
+            for (int c = 0; c < _components; c++) {
+                moved |= std::fabs(delta[c]) > threshold;
+            }
+            if (!moved) {
+                continue;
+            }
+            target.indices.push_back(v);
+            for (int c = 0; c < 4; c++) {
+                target.deltas.push_back(c < _components ? delta[c] : 0);
+            }
+        }
+        return addTarget(std::move(target));
+    }
+
+    /*
+     Add a target already in sparse form. Indices must be sorted, unique and
+     less than the vertex count, with 4 floats of delta per index. Returns
+     the target's index, or -1 if the target is malformed.
+     */
+    int addTarget(VROSparseMorphTarget target) {
+        if (target.deltas.size() != target.indices.size() * 4) {
+            pwarn("Rejected morph target: %d deltas for %d indices",
+                  (int) target.deltas.size(), (int) target.indices.size());
+            return -1;
+        }
+        for (size_t i = 0; i < target.indices.size(); i++) {
+            if (target.indices[i] >= (uint32_t) _vertexCount || (i > 0 && target.indices[i] <= target.indices[i - 1])) {
+                pwarn("Rejected morph target: index %d out of range or out of order", (int) target.indices[i]);
+                return -1;
+            }
+        }
+
+        target.chunkOffsets.assign(_chunkCount + 1, 0);
+        size_t i = 0;
+        for (int chunk = 0; chunk <= _chunkCount; chunk++) {
+            uint32_t start = (uint32_t) std::min(chunk * _chunkSize, _vertexCount);
+            while (i < target.indices.size() && target.indices[i] < start) {
+                i++;
+            }
+            target.chunkOffsets[chunk] = (uint32_t) i;
+        }
+        target.chunkOffsets[_chunkCount] = (uint32_t) target.indices.size();
+        target.weight = 0;
+        target.uploadedWeight = 0;
+
+        _targets.push_back(std::move(target));
+        return (int) _targets.size() - 1;
+    }
+
+    void setWeight(int target, float weight) {
+        _targets[target].weight = weight;
+    }
+    float getWeight(int target) const {
+        return _targets[target].weight;
+    }
+    int getTargetCount() const {
+        return (int) _targets.size();
+    }
+
+    /*
+     Re-blend the vertices affected by weight changes since the last update.
+     Returns false if nothing changed.
+     */
+    bool update() {
+        double start = VROTimeCurrentMillis();
+        _stats = VROMorphBlendStats();
+        _activeTargets.clear();
+
+        for (int t = 0; t < (int) _targets.size(); t++) {
+            VROSparseMorphTarget &target = _targets[t];
+            if (target.weight != 0) {
+                _activeTargets.push_back(t);
+            }
+            if (target.weight != target.uploadedWeight) {
+                markDirty(target);
+                target.uploadedWeight = target.weight;
+                _stats.changedTargets++;
+            }
+        }
+        _stats.activeTargets = (int) _activeTargets.size();
+
+        _dirtyChunks.clear();
+        for (int chunk = 0; chunk < _chunkCount; chunk++) {
+            if (_chunkDirty[chunk]) {
+                _dirtyChunks.push_back(chunk);
+                _chunkDirty[chunk] = 0;
+            }
+        }
+
+        VROThreadPool::shared().parallelFor((int) _dirtyChunks.size(), 1, [this](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                blendChunk(_dirtyChunks[i]);
+            }
+        });
+
+        // Merge adjacent dirty chunks into upload ranges
+        _dirtyRanges.clear();
+        for (int chunk : _dirtyChunks) {
+            int first = chunk * _chunkSize;
+            int last = std::min(first + _chunkSize, _vertexCount);
+            if (!_dirtyRanges.empty() && _dirtyRanges.back().second == first) {
+                _dirtyRanges.back().second = last;
+            } else {
+                _dirtyRanges.push_back({ first, last });
+            }
+            _stats.dirtyVertices += last - first;
+        }
+        _stats.blendTimeMs = VROTimeCurrentMillis() - start;
+        return !_dirtyChunks.empty();
+    }
+
+    /*
+     Vertex ranges [first, last) re-blended by the last update.
+     */
+    const std::vector<std::pair<int, int>> &getDirtyRanges() const {
+        return _dirtyRanges;
+    }
+
+    /*
+     Blended output, 4 floats per vertex.
+     */
+    const float *getOutput() const {
+        return _output.data();
+    }
+
+    /*
+     Copy the ranges re-blended by the last update into dest, in the
+     attribute's layout (components floats per vertex, stride floats apart).
+     */
+    void writeOutput(float *dest, int stride) const {
+        for (const std::pair<int, int> &range : _dirtyRanges) {
+            for (int v = range.first; v < range.second; v++) {
+                for (int c = 0; c < _components; c++) {
+                    dest[(size_t) v * stride + c] = _output[v * 4 + c];
+                }
+            }
+        }
+    }
+
+    /*
+     Force every vertex to be re-blended and uploaded on the next update
+     (e.g. after the geometry's buffers are recreated).
+     */
+    void markAllDirty() {
+        std::fill(_chunkDirty.begin(), _chunkDirty.end(), 1);
+    }
+
+    const VROMorphBlendStats &getStats() const {
+        return _stats;
+    }
+
+private:
+
+    int _vertexCount;
+    int _components;
+    int _chunkSize;
+    int _chunkCount;
+
+    std::vector<float> _base;
+    std::vector<float> _output;
+    std::vector<VROSparseMorphTarget> _targets;
+
+    std::vector<uint8_t> _chunkDirty;
+    std::vector<int> _dirtyChunks;
+    std::vector<int> _activeTargets;
+    std::vector<std::pair<int, int>> _dirtyRanges;
+    VROMorphBlendStats _stats;
+
+    void markDirty(const VROSparseMorphTarget &target) {
+        for (int chunk = 0; chunk < _chunkCount; chunk++) {
+            if (target.chunkOffsets[chunk + 1] > target.chunkOffsets[chunk]) {
+                _chunkDirty[chunk] = 1;
+            }
+        }
+    }
+
+    /*
+     Reset the chunk to the base, then accumulate every active target's
+     deltas within it.
+     */
+    void blendChunk(int chunk) {
+        int first = chunk * _chunkSize;
+        int last = std::min(first + _chunkSize, _vertexCount);
+        float *output = _output.data();
+        std::copy(_base.data() + (size_t) first * 4, _base.data() + (size_t) last * 4, output + (size_t) first * 4);
+
+        for (int t : _activeTargets) {
+            const VROSparseMorphTarget &target = _targets[t];
+            uint32_t begin = target.chunkOffsets[chunk];
+            uint32_t end = target.chunkOffsets[chunk + 1];
+            if (begin == end) {
+                continue;
+            }
+            const VROFloat4 weight = VROFloat4::splat(target.weight);
+            const uint32_t *indices = target.indices.data();
+            const float *deltas = target.deltas.data();
+            for (uint32_t i = begin; i < end; i++) {
+                float *vertex = &output[(size_t) indices[i] * 4];
+                VROFloat4MulAdd(weight, VROFloat4::load(&deltas[(size_t) i * 4]), VROFloat4::load(vertex)).store(vertex);
+            }
+        }
+    }
+
+};
+
+#endif /* VROMorphBlender_h */
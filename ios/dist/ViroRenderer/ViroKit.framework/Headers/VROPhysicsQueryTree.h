@@ -0,0 +1,251 @@
+//
+//  VROPhysicsQueryTree.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROPhysicsQueryTree_h
+#define VROPhysicsQueryTree_h
+
+#include <algorithm>
+#include <vector>
+#include "VROVector3f.h"
+
+/*
+ Axis-aligned bounds of a proxy or tree node.
+ */
+struct VROPhysicsQueryBounds {
+    float min[3];
+    float max[3];
+
+    static VROPhysicsQueryBounds fromPoints(const VROVector3f &a, const VROVector3f &b) {
+        return { { std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z) },
+                 { std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z) } };
+    }
+
+    void merge(const VROPhysicsQueryBounds &other) {
+        for (int axis = 0; axis < 3; axis++) {
+            min[axis] = std::min(min[axis], other.min[axis]);
+            max[axis] = std::max(max[axis], other.max[axis]);
+        }
+    }
+
+    bool overlaps(const VROPhysicsQueryBounds &other) const {
+        for (int axis = 0; axis < 3; axis++) {
+            if (min[axis] > other.max[axis] || max[axis] < other.min[axis]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float centroid2(int axis) const {
+        return min[axis] + max[axis];
+    }
+};
+
+/*
+ A segment prepared for repeated slab tests against VROPhysicsQueryBounds.
+ */
+struct VROPhysicsQuerySegment {
+    float from[3];
+    float invDirection[3];
+
+    VROPhysicsQuerySegment(const VROVector3f &start, const VROVector3f &end) {
+        const float large = 1e18f;
+        float direction[3] = { end.x - start.x, end.y - start.y, end.z - start.z };
+        from[0] = start.x;
+        from[1] = start.y;
+        from[2] = start.z;
+        for (int axis = 0; axis < 3; axis++) {
+            invDirection[axis] = direction[axis] != 0 ? 1 / direction[axis] : large;
+        }
+    }
+
+    /*
+     Slab test of from + t * (to - from), t in [0, maxFraction], against the
+     bounds.
+     */
+    bool intersects(const VROPhysicsQueryBounds &bounds, float maxFraction) const {
+        float tMin = 0;
+        float tMax = maxFraction;
+        for (int axis = 0; axis < 3; axis++) {
+            float t0 = (bounds.min[axis] - from[axis]) * invDirection[axis];
+            float t1 = (bounds.max[axis] - from[axis]) * invDirection[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if (tMin > tMax) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/*
+ Bounding volume hierarchy over a snapshot of proxies: opaque objects with
+ axis-aligned bounds, for culling many ray or box queries before an exact
+ test. It does not depend on Bullet, so it can be built over any set of
+ bounds.
+
+ Build the tree once with addProxy and build, then traverse it from any
+ number of threads at once. A query visits O(log proxies) nodes instead of
+ every proxy.
+ */
+class VROPhysicsQueryTree {
+public:
+
+    struct Proxy {
+        const void *object;
+        VROPhysicsQueryBounds bounds;
+    };
+
+    void clear() {
+        _proxies.clear();
+        _nodes.clear();
+    }
+
+    void addProxy(const void *object, const VROPhysicsQueryBounds &bounds) {
+        _proxies.push_back({ object, bounds });
+    }
+
+    /*
+     Build the hierarchy over the proxies added since the last clear().
+     Reorders the proxies.
+     */
+    void build() {
+        _nodes.clear();
+        if (!_proxies.empty()) {
+            buildNode(0, (int) _proxies.size(), 0);
+        }
+    }
+
+    const std::vector<Proxy> &getProxies() const {
+        return _proxies;
+    }
+    int getNodeCount() const {
+        return (int) _nodes.size();
+    }
+
+    /*
+     Invoke visit(proxy) for every proxy in a leaf whose bounds, and whose
+     ancestors' bounds, pass overlaps(bounds). Only reads the hierarchy, so
+     any number of queries can traverse it at once. overlaps is re-evaluated
+     at every node, so it may tighten as visit finds hits.
+     */
+    template <typename Overlaps, typename Visit>
+    void traverse(Overlaps overlaps, Visit visit) const {
+        if (_nodes.empty()) {
+            return;
+        }
+        int stack[kMaxTreeDepth];
+        int size = 0;
+        stack[size++] = 0;
+        while (size > 0) {
+            const Node &node = _nodes[stack[--size]];
+            if (!overlaps(node.bounds)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (int i = node.start; i < node.start + node.count; i++) {
+                    visit(_proxies[i]);
+                }
+            }
+            else {
+                int first = (int) (&node - _nodes.data()) + 1;
+                stack[size++] = node.secondChild;
+                stack[size++] = first;
+            }
+        }
+    }
+
+private:
+
+    static const int kMaxProxiesPerLeaf = 4;
+    static const int kMaxTreeDepth = 64;
+
+    /*
+     Nodes are stored depth-first, so an interior node's first child
+     immediately follows it. Leaves (count > 0) reference the range
+     [start, start + count) of _proxies.
+     */
+    struct Node {
+        VROPhysicsQueryBounds bounds;
+        int start;
+        int count;
+        int secondChild;
+    };
+
+    std::vector<Proxy> _proxies;
+    std::vector<Node> _nodes;
+
+    /*
+     Build the hierarchy over _proxies[begin, end), splitting at the median
+     centroid along the longest axis. Returns the index of the new node.
+     */
+    int buildNode(int begin, int end, int depth) {
+        int index = (int) _nodes.size();
+        _nodes.push_back({ _proxies[begin].bounds, begin, 0, 0 });
+
+        VROPhysicsQueryBounds bounds = _proxies[begin].bounds;
+        float centroidMin[3], centroidMax[3];
+        for (int axis = 0; axis < 3; axis++) {
+            centroidMin[axis] = centroidMax[axis] = bounds.centroid2(axis);
+        }
+        for (int i = begin + 1; i < end; i++) {
+            const VROPhysicsQueryBounds &proxyBounds = _proxies[i].bounds;
+            bounds.merge(proxyBounds);
+            for (int axis = 0; axis < 3; axis++) {
+                centroidMin[axis] = std::min(centroidMin[axis], proxyBounds.centroid2(axis));
+                centroidMax[axis] = std::max(centroidMax[axis], proxyBounds.centroid2(axis));
+            }
+        }
+        _nodes[index].bounds = bounds;
+
+        if (end - begin <= kMaxProxiesPerLeaf || depth >= kMaxTreeDepth - 1) {
+            _nodes[index].count = end - begin;
+            return index;
+        }
+
+        int axis = 0;
+        for (int a = 1; a < 3; a++) {
+            if (centroidMax[a] - centroidMin[a] > centroidMax[axis] - centroidMin[axis]) {
+                axis = a;
+            }
+        }
+        int middle = (begin + end) / 2;
+        std::nth_element(_proxies.begin() + begin, _proxies.begin() + middle, _proxies.begin() + end,
+                         [axis](const Proxy &a, const Proxy &b) {
+                             return a.bounds.centroid2(axis) < b.bounds.centroid2(axis);
+                         });
+        buildNode(begin, middle, depth + 1);
+        int secondChild = buildNode(middle, end, depth + 1);
+        _nodes[index].secondChild = secondChild;
+        return index;
+    }
+
+};
+
+#endif /* VROPhysicsQueryTree_h */
@@ -0,0 +1,110 @@
+//
+//  VROPhysicsRawBody.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#ifndef VROPhysicsRawBody_h
+#define VROPhysicsRawBody_h
+
+#include <string>
+#include "VRODefines.h"
+#if VRO_PHYSICS_BULLET
+#include <btBulletDynamicsCommon.h>
+#endif
+
+class VROPhysicsBody;
+
+/*
+ User index stamped on raw Bullet bodies: bodies added to a VROPhysicsWorld
+ through addRigidBody rather than as VROPhysicsBodies. VROPhysicsBodyHandles
+ are non-negative and unstamped bodies are -1, so this value marks the body
+ as raw without colliding with either.
+ */
+static const int kVROPhysicsRawBodyUserIndex = -2;
+
+/*
+ Identifies the owner of a raw Bullet body, the way VROPhysicsBody::getTag
+ identifies a VROPhysicsBody.
+ */
+struct VROPhysicsRawBodyInfo {
+    std::string tag;
+    const void *owner = nullptr;
+};
+
+#if VRO_PHYSICS_BULLET
+
+/*
+ Helpers for telling raw bodies apart from VROPhysicsBodies.
+
+ VROPhysicsWorld's collision and ray callbacks are compiled into the
+ renderer and cast any non-null btCollisionObject user pointer to
+ VROPhysicsBody. A raw body must therefore keep a null user pointer.
+ Instead, it is stamped with kVROPhysicsRawBodyUserIndex, and its
+ VROPhysicsRawBodyInfo is stored in the user pointer of its collision
+ shape, which those callbacks never read. The shape must belong to this
+ body alone, and the info must outlive the body's membership in the world.
+
+ These helpers read and write Bullet objects, so they are only compiled
+ where VRO_PHYSICS_BULLET is set.
+ */
+class VROPhysicsRawBody {
+public:
+
+    static void tag(btCollisionObject *object, VROPhysicsRawBodyInfo *info) {
+        object->setUserPointer(nullptr);
+        object->setUserIndex(kVROPhysicsRawBodyUserIndex);
+        object->getCollisionShape()->setUserPointer(info);
+    }
+
+    static bool isRawBody(const btCollisionObject *object) {
+        return object->getUserIndex() == kVROPhysicsRawBodyUserIndex;
+    }
+
+    /*
+     Return the info of a raw body, or nullptr if the object is not a raw
+     body stamped through tag().
+     */
+    static const VROPhysicsRawBodyInfo *getInfo(const btCollisionObject *object) {
+        if (!isRawBody(object)) {
+            return nullptr;
+        }
+        return (const VROPhysicsRawBodyInfo *) object->getCollisionShape()->getUserPointer();
+    }
+
+    /*
+     Return the VROPhysicsBody that owns the object, or nullptr if the
+     object is a raw body or has no owner.
+     */
+    static VROPhysicsBody *getPhysicsBody(const btCollisionObject *object) {
+        if (isRawBody(object)) {
+            return nullptr;
+        }
+        return (VROPhysicsBody *) object->getUserPointer();
+    }
+
+};
+
+#endif /* VRO_PHYSICS_BULLET */
+
+#endif /* VROPhysicsRawBody_h */
@@ -0,0 +1,216 @@
+//
+//  VROPhysicsSlotMap.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROPhysicsSlotMap_h
+#define VROPhysicsSlotMap_h
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <stdint.h>
+#include "VROVector3f.h"
+
+/*
+ Generational handle to an object in a VROPhysicsSlotMap. The handle packs
+ a slot index and the slot's generation into a single non-negative int, so
+ that it fits in the user index of a btRigidBody. A handle whose slot has
+ since been freed (and possibly reused) fails validation instead of
+ resolving to the wrong object.
+ */
+struct VROPhysicsBodyHandle {
+    static const int kIndexBits = 20;
+    static const uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static const uint32_t kGenerationMask = (1u << (31 - kIndexBits)) - 1;
+
+    int32_t value = -1;
+
+    VROPhysicsBodyHandle() {}
+    VROPhysicsBodyHandle(uint32_t index, uint32_t generation) :
+        value((int32_t) (((generation & kGenerationMask) << kIndexBits) | (index & kIndexMask))) {}
+
+    static VROPhysicsBodyHandle fromUserIndex(int userIndex) {
+        VROPhysicsBodyHandle handle;
+        handle.value = userIndex;
+        return handle;
+    }
+
+    bool isNull() const { return value < 0; }
+    uint32_t getIndex() const { return (uint32_t) value & kIndexMask; }
+    uint32_t getGeneration() const { return ((uint32_t) value >> kIndexBits) & kGenerationMask; }
+
+    bool operator==(const VROPhysicsBodyHandle &other) const { return value == other.value; }
+    bool operator!=(const VROPhysicsBodyHandle &other) const { return value != other.value; }
+};
+
+/*
+ A contact between two bodies addressed by handle, reported without any
+ string keys. The point and normal are on body B, matching
+ VROPhysicsBody::VROCollision.
+ */
+struct VROPhysicsContact {
+    VROPhysicsBodyHandle bodyA;
+    VROPhysicsBodyHandle bodyB;
+    VROVector3f point;
+    VROVector3f normal;
+    float penetrationDistance;
+};
+
+/*
+ Receives VROPhysicsContacts. Contacts are delivered every step for as long
+ as the bodies touch; unlike VROPhysicsBodyDelegate there is no
+ collision-enter filtering.
+ */
+class VROPhysicsContactListener {
+public:
+    virtual ~VROPhysicsContactListener() {}
+    virtual void onContact(const VROPhysicsContact &contact) = 0;
+};
+
+/*
+ Slot map from generational VROPhysicsBodyHandles to objects of type T.
+ Freed slots are reused, each time with a new generation, so a handle to a
+ freed slot fails validation instead of resolving to the slot's new
+ occupant. Resolving a handle is an array lookup.
+
+ VROPhysicsWorld tracks its bodies in a map keyed by string, so resolving
+ the two bodies of a contact costs two string-keyed tree lookups. Storing
+ each body's handle in its btRigidBody's user index would turn that into
+ two array lookups. VROPhysicsWorld is compiled into the prebuilt renderer
+ and Bullet's headers are not shipped with it, so that wiring cannot be
+ done from here; the map itself does not depend on Bullet and holds any
+ object type.
+ */
+template <typename T>
+class VROPhysicsSlotMap {
+public:
+
+    VROPhysicsSlotMap() : _firstFreeSlot(-1), _count(0) {}
+
+    /*
+     Store the object and return its handle. Storing an object that is
+     already in the map returns its existing handle. Returns a null handle
+     once every index is in use.
+     */
+    VROPhysicsBodyHandle add(std::shared_ptr<T> object) {
+        if (!object) {
+            return VROPhysicsBodyHandle();
+        }
+        VROPhysicsBodyHandle existing = find(object.get());
+        if (!existing.isNull()) {
+            return existing;
+        }
+
+        uint32_t index;
+        if (_firstFreeSlot >= 0) {
+            index = (uint32_t) _firstFreeSlot;
+            _firstFreeSlot = _slots[index].nextFree;
+        }
+        else {
+            index = (uint32_t) _slots.size();
+            if (index > VROPhysicsBodyHandle::kIndexMask) {
+                return VROPhysicsBodyHandle();
+            }
+            _slots.emplace_back();
+        }
+
+        Slot &slot = _slots[index];
+        slot.object = object;
+        slot.nextFree = -1;
+        slot.alive = true;
+        _slotsByObject[object.get()] = index;
+        _count++;
+        return VROPhysicsBodyHandle(index, slot.generation);
+    }
+
+    /*
+     Free the handle's slot and return the object it held, or nullptr if
+     the handle is stale. The handle, and any copies of it, become invalid.
+     */
+    std::shared_ptr<T> remove(VROPhysicsBodyHandle handle) {
+        if (!isValid(handle)) {
+            return nullptr;
+        }
+        uint32_t index = handle.getIndex();
+        Slot &slot = _slots[index];
+        std::shared_ptr<T> object = std::move(slot.object);
+
+        _slotsByObject.erase(object.get());
+        slot.object.reset();
+        slot.alive = false;
+        slot.generation = (slot.generation + 1) & VROPhysicsBodyHandle::kGenerationMask;
+        slot.nextFree = _firstFreeSlot;
+        _firstFreeSlot = (int) index;
+        _count--;
+        return object;
+    }
+
+    bool isValid(VROPhysicsBodyHandle handle) const {
+        if (handle.isNull() || handle.getIndex() >= _slots.size()) {
+            return false;
+        }
+        const Slot &slot = _slots[handle.getIndex()];
+        return slot.alive && slot.generation == handle.getGeneration();
+    }
+
+    /*
+     Resolve a handle to its object, or nullptr if the handle is stale.
+     */
+    T *get(VROPhysicsBodyHandle handle) const {
+        return isValid(handle) ? _slots[handle.getIndex()].object.get() : nullptr;
+    }
+
+    /*
+     Find the handle of an object, or a null handle if the object is not in
+     the map. Hot paths should keep the handle returned by add.
+     */
+    VROPhysicsBodyHandle find(const T *object) const {
+        auto it = _slotsByObject.find(object);
+        if (it == _slotsByObject.end()) {
+            return VROPhysicsBodyHandle();
+        }
+        return VROPhysicsBodyHandle(it->second, _slots[it->second].generation);
+    }
+
+    int getCount() const {
+        return _count;
+    }
+
+private:
+
+    struct Slot {
+        std::shared_ptr<T> object;
+        uint32_t generation = 0;
+        int nextFree = -1;
+        bool alive = false;
+    };
+
+    std::vector<Slot> _slots;
+    std::unordered_map<const T *, uint32_t> _slotsByObject;
+    int _firstFreeSlot;
+    int _count;
+
+};
+
+#endif /* VROPhysicsSlotMap_h */
@@ -0,0 +1,343 @@
+//
+//  VROPoseFilterBank.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROPoseFilterBank_h
+#define VROPoseFilterBank_h
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "VROBodyTracker.h"
+#include "VROSIMD.h"
+
+/*
+ Fixed-capacity ring buffer of joint frames in structure-of-arrays form:
+ per frame, a timestamp and the x, y, z and confidence of every joint
+ (confidence 0 for joints not found). Storage is allocated once; pushing a
+ frame overwrites the oldest one. Replaces the growing vector of VROPoseFrames
+ kept as the tracking window by VROPoseFilter.
+ */
+class VROPoseHistory {
+public:
+
+    VROPoseHistory(int jointCount, int capacity) :
+        _jointCount(jointCount), _capacity(std::max(1, capacity)), _head(0), _size(0),
+        _timestamps(_capacity, 0),
+        _data((size_t) _capacity * 4 * jointCount, 0.0f) {}
+
+    void push(double timestamp, const float *x, const float *y, const float *z, const float *confidence) {
+        int slot = _head;
+        _head = (_head + 1) % _capacity;
+        _size = std::min(_size + 1, _capacity);
+
+        _timestamps[slot] = timestamp;
+        float *frame = &_data[(size_t) slot * 4 * _jointCount];
+        std::copy(x, x + _jointCount, frame);
+        std::copy(y, y + _jointCount, frame + _jointCount);
+        std::copy(z, z + _jointCount, frame + 2 * _jointCount);
+        std::copy(confidence, confidence + _jointCount, frame + 3 * _jointCount);
+    }
+
+    void clear() {
+        _head = 0;
+        _size = 0;
+    }
+
+    int size() const { return _size; }
+    int getCapacity() const { return _capacity; }
+    int getJointCount() const { return _jointCount; }
+
+    /*
+     Accessors by age: 0 is the newest frame, size() - 1 the oldest.
+     */
+    double getTimestamp(int age) const { return _timestamps[getSlot(age)]; }
+    const float *getX(int age) const { return getFrame(age); }
+    const float *getY(int age) const { return getFrame(age) + _jointCount; }
+    const float *getZ(int age) const { return getFrame(age) + 2 * _jointCount; }
+    const float *getConfidence(int age) const { return getFrame(age) + 3 * _jointCount; }
+
+    /*
+     Number of frames, newest first, whose timestamps are within period of the
+     newest frame.
+     */
+    int getCountWithin(double period) const {
+        if (_size == 0) {
+            return 0;
+        }
+        double newest = getTimestamp(0);
+        int count = 1;
+        while (count < _size && newest - getTimestamp(count) <= period) {
+            count++;
+        }
+        return count;
+    }
+
+private:
+
+    int _jointCount;
+    int _capacity;
+    int _head;
+    int _size;
+    std::vector<double> _timestamps;
+    std::vector<float> _data;
+
+    int getSlot(int age) const {
+        return (_head - 1 - age + 2 * _capacity) % _capacity;
+    }
+
+    const float *getFrame(int age) const {
+        return &_data[(size_t) getSlot(age) * 4 * _jointCount];
+    }
+
+};
+
+/*
+ Bank of 1€ filters (see VROOneEuroFilter.h) for all joints of a body,
+ stored as structure-of-arrays and updated four joints at a time with
+ VROFloat4. One filterJoints() call replaces a VROOneEuroFilter object per
+ joint, with no allocation after construction.
+
+ Each joint follows the published 1€ recurrence that VROOneEuroFilter
+ implements: the sampling frequency is taken from the time since that
+ joint's previous sample, the derivative is low-pass filtered with the
+ derivative cutoff, and the position is low-pass filtered with a cutoff that
+ grows with the derivative's magnitude.
+
+ Unlike VROOneEuroFilter, which keeps double-precision state, the bank's
+ state is single precision so that four joints fit a VROFloat4. This is
+ intentional: joint positions come from the tracker as floats, and over a
+ long irregularly timed sequence the bank stays within 1e-4 m of
+ per-joint VROOneEuroFilters (VROPoseFilterBankTests). Repeated timestamps
+ keep the previous sampling frequency rather than dividing by zero.
+
+ Joints missing from a frame (below the confidence threshold) keep their
+ state, as a per-joint VROOneEuroFilter that is not invoked would.
+ */
+class VROPoseFilterBank {
+public:
+
+    VROPoseFilterBank(int jointCount = kNumBodyJoints, double frequency = 30.0, double minCutoff = 1.0,
+                      double beta = 0.0, double derivativeCutoff = 1.0, float confidenceThreshold = 0.0f,
+                      int historyCapacity = 32) :
+        _jointCount(jointCount),
+        _laneCount((jointCount + 3) & ~3),
+        _minCutoff((float) minCutoff), _beta((float) beta), _derivativeCutoff((float) derivativeCutoff),
+        _confidenceThreshold(confidenceThreshold),
+        _history(jointCount, historyCapacity) {
+
+        for (std::vector<float> *lanes : { &_rawX, &_rawY, &_rawZ, &_x, &_y, &_z, &_dx, &_dy, &_dz,
+                                           &_initialized, &_inputX, &_inputY, &_inputZ, &_inputConfidence,
+                                           &_historyConfidence }) {
+            lanes->assign(_laneCount, 0.0f);
+        }
+        _frequency.assign(_laneCount, (float) frequency);
+        _lastTimestamps.assign(_laneCount, -1.0);
+        _present.assign(_laneCount, 0.0f);
+    }
+    virtual ~VROPoseFilterBank() {}
+
+    void setBeta(float beta) { _beta = beta; }
+    void setFCMin(float minCutoff) { _minCutoff = minCutoff; }
+
+    /*
+     Filter a frame of joints sampled at the given timestamp (in seconds).
+     For each joint type, the most confident joint above the threshold is
+     used. Returns a frame with one filtered joint per type found.
+     */
+    VROPoseFrame filterJoints(const VROPoseFrame &frame, double timestamp) {
+        for (int j = 0; j < _jointCount; j++) {
+            _inputConfidence[j] = 0;
+            if (j >= (int) frame.size()) {
+                continue;
+            }
+            const VROInferredBodyJoint *best = nullptr;
+            for (const VROInferredBodyJoint &joint : frame[j]) {
+                if (joint.getConfidence() > _confidenceThreshold &&
+                    (!best || joint.getConfidence() > best->getConfidence())) {
+                    best = &joint;
+                }
+            }
+            if (best) {
+                VROVector3f center = best->getCenter();
+                _inputX[j] = center.x;
+                _inputY[j] = center.y;
+                _inputZ[j] = center.z;
+                _inputConfidence[j] = (float) best->getConfidence();
+            }
+        }
+
+        filter(_inputX.data(), _inputY.data(), _inputZ.data(), _inputConfidence.data(), timestamp);
+
+        VROPoseFrame filtered = newPoseFrame();
+        filtered.resize(std::max((int) filtered.size(), _jointCount));
+        for (int j = 0; j < _jointCount; j++) {
+            if (_present[j] == 0) {
+                continue;
+            }
+            VROInferredBodyJoint joint((VROBodyJointType) j);
+            joint.setCenter(VROVector3f(_x[j], _y[j], _z[j]));
+            joint.setConfidence(_inputConfidence[j]);
+            filtered[j].push_back(joint);
+        }
+        return filtered;
+    }
+
+    /*
+     Filter raw joint positions in structure-of-arrays form. Joints with
+     confidence at or below the threshold are treated as missing. Results are
+     available through getX(), getY() and getZ(), and the frame is appended to
+     the history.
+     */
+    void filter(const float *x, const float *y, const float *z, const float *confidence, double timestamp) {
+        for (int j = 0; j < _laneCount; j++) {
+            bool present = j < _jointCount && confidence[j] > _confidenceThreshold;
+            _present[j] = present ? 1.0f : 0.0f;
+            if (present) {
+                // Per-joint sampling frequency, as each joint's filter would see it
+                if (_lastTimestamps[j] >= 0 && timestamp > _lastTimestamps[j]) {
+                    _frequency[j] = (float) (1.0 / (timestamp - _lastTimestamps[j]));
+                }
+                _lastTimestamps[j] = timestamp;
+                _inputX[j] = x[j];
+                _inputY[j] = y[j];
+                _inputZ[j] = z[j];
+            }
+        }
+
+        const VROFloat4 zero = VROFloat4::splat(0.0f);
+        const VROFloat4 half = VROFloat4::splat(0.5f);
+        const VROFloat4 twoPi = VROFloat4::splat(2.0f * (float) M_PI);
+        const VROFloat4 minCutoff = VROFloat4::splat(_minCutoff);
+        const VROFloat4 beta = VROFloat4::splat(_beta);
+        const VROFloat4 derivativeCutoff = VROFloat4::splat(_derivativeCutoff * 2.0f * (float) M_PI);
+
+        for (int j = 0; j < _laneCount; j += 4) {
+            VROFloat4 present = VROFloat4Greater(VROFloat4::load(&_present[j]), half);
+            if (present.getMask() == 0) {
+                continue;
+            }
+            VROFloat4 initialized = VROFloat4Greater(VROFloat4::load(&_initialized[j]), half);
+            VROFloat4 frequency = VROFloat4::load(&_frequency[j]);
+
+            VROFloat4 vx = VROFloat4::load(&_inputX[j]);
+            VROFloat4 vy = VROFloat4::load(&_inputY[j]);
+            VROFloat4 vz = VROFloat4::load(&_inputZ[j]);
+            VROFloat4 rawX = VROFloat4::load(&_rawX[j]);
+            VROFloat4 rawY = VROFloat4::load(&_rawY[j]);
+            VROFloat4 rawZ = VROFloat4::load(&_rawZ[j]);
+
+            // Derivative of the raw signal, zero on the first sample
+            VROFloat4 dvx = VROFloat4Select(initialized, (vx - rawX) * frequency, zero);
+            VROFloat4 dvy = VROFloat4Select(initialized, (vy - rawY) * frequency, zero);
+            VROFloat4 dvz = VROFloat4Select(initialized, (vz - rawZ) * frequency, zero);
+
+            // alpha = 1 / (1 + tau / te) = 2 pi fc / (2 pi fc + frequency)
+            VROFloat4 derivativeAlpha = derivativeCutoff / (derivativeCutoff + frequency);
+            VROFloat4 dx = lowPass(dvx, VROFloat4::load(&_dx[j]), derivativeAlpha, initialized);
+            VROFloat4 dy = lowPass(dvy, VROFloat4::load(&_dy[j]), derivativeAlpha, initialized);
+            VROFloat4 dz = lowPass(dvz, VROFloat4::load(&_dz[j]), derivativeAlpha, initialized);
+
+            VROFloat4 speed = VROFloat4Sqrt(dx * dx + dy * dy + dz * dz);
+            VROFloat4 cutoff = twoPi * VROFloat4MulAdd(beta, speed, minCutoff);
+            VROFloat4 alpha = cutoff / (cutoff + frequency);
+            VROFloat4 fx = lowPass(vx, VROFloat4::load(&_x[j]), alpha, initialized);
+            VROFloat4 fy = lowPass(vy, VROFloat4::load(&_y[j]), alpha, initialized);
+            VROFloat4 fz = lowPass(vz, VROFloat4::load(&_z[j]), alpha, initialized);
+
+            // Only joints present in this frame advance their state
+            VROFloat4Select(present, vx, rawX).store(&_rawX[j]);
+            VROFloat4Select(present, vy, rawY).store(&_rawY[j]);
+            VROFloat4Select(present, vz, rawZ).store(&_rawZ[j]);
+            VROFloat4Select(present, dx, VROFloat4::load(&_dx[j])).store(&_dx[j]);
+            VROFloat4Select(present, dy, VROFloat4::load(&_dy[j])).store(&_dy[j]);
+            VROFloat4Select(present, dz, VROFloat4::load(&_dz[j])).store(&_dz[j]);
+            VROFloat4Select(present, fx, VROFloat4::load(&_x[j])).store(&_x[j]);
+            VROFloat4Select(present, fy, VROFloat4::load(&_y[j])).store(&_y[j]);
+            VROFloat4Select(present, fz, VROFloat4::load(&_z[j])).store(&_z[j]);
+            VROFloat4Select(present, VROFloat4::splat(1.0f), VROFloat4::load(&_initialized[j])).store(&_initialized[j]);
+        }
+
+        for (int j = 0; j < _jointCount; j++) {
+            _historyConfidence[j] = _present[j] > 0 ? confidence[j] : 0.0f;
+        }
+        _history.push(timestamp, _x.data(), _y.data(), _z.data(), _historyConfidence.data());
+    }
+
+    /*
+     Filtered positions, one lane per joint. Joints never seen are zero.
+     */
+    const float *getX() const { return _x.data(); }
+    const float *getY() const { return _y.data(); }
+    const float *getZ() const { return _z.data(); }
+
+    /*
+     Filtered frames, newest first.
+     */
+    const VROPoseHistory &getHistory() const { return _history; }
+
+    void reset() {
+        std::fill(_initialized.begin(), _initialized.end(), 0.0f);
+        std::fill(_lastTimestamps.begin(), _lastTimestamps.end(), -1.0);
+        _history.clear();
+    }
+
+private:
+
+    int _jointCount;
+    int _laneCount;
+    float _minCutoff;
+    float _beta;
+    float _derivativeCutoff;
+    float _confidenceThreshold;
+
+    /*
+     Filter state, one lane per joint, padded to a multiple of 4: last raw
+     value, last filtered value, last filtered derivative, sampling frequency
+     and whether the joint has been seen.
+     */
+    std::vector<float> _rawX, _rawY, _rawZ;
+    std::vector<float> _x, _y, _z;
+    std::vector<float> _dx, _dy, _dz;
+    std::vector<float> _frequency;
+    std::vector<float> _initialized;
+    std::vector<double> _lastTimestamps;
+
+    /*
+     Per-call scratch.
+     */
+    std::vector<float> _inputX, _inputY, _inputZ, _inputConfidence, _present, _historyConfidence;
+
+    VROPoseHistory _history;
+
+    /*
+     alpha * value + (1 - alpha) * previous, or value on the first sample.
+     */
+    static VROFloat4 lowPass(VROFloat4 value, VROFloat4 previous, VROFloat4 alpha, VROFloat4 initialized) {
+        return VROFloat4Select(initialized, VROFloat4MulAdd(alpha, value - previous, previous), value);
+    }
+
+};
+
+#endif /* VROPoseFilterBank_h */
@@ -0,0 +1,820 @@
+//
+//  VRORecordingDriver.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VRORecordingDriver_h
+#define VRORecordingDriver_h
+
+#include <functional>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <sstream>
+#include <stdint.h>
+#include "VRODriver.h"
+#include "VROMaterialSubstrate.h"
+#include "VROSound.h"
+#include "VROAudioPlayer.h"
+#include "VROFrameScheduler.h"
+#include "VROShaderProgram.h"
+#include "VRODriverStateCache.h"
+#include "VROData.h"
+#include "VROGeometry.h"
+#include "VROMaterial.h"
+#include "VROTexture.h"
+#include "VRORenderContext.h"
+#include "VRORenderTarget.h"
+#include "VROGeometrySubstrate.h"
+#include "VROTextureSubstrate.h"
+#include "VROVertexBuffer.h"
+#include "VROImagePostProcess.h"
+
+enum class VRODriverCommand : uint8_t {
+    BeginFrame,
+    EndFrame,
+    BeginEye,
+    EndEye,
+    SetActiveTextureUnit,       // a: unit index
+    BindTexture,                // a: unit index, b: texture
+    SetDepthWritingEnabled,     // a: enabled
+    SetDepthReadingEnabled,     // a: enabled
+    SetStencilTestEnabled,      // a: enabled
+    SetCullMode,                // a: VROCullMode
+    SetRenderTargetColorMask,   // a: VROColorMask
+    SetMaterialColorMask,       // a: VROColorMask
+    SetBlendMode,               // a: VROBlendMode
+    BindShader,                 // a: shader ID
+    UnbindShader,
+    BindRenderTarget,           // a: render target ID, b: VRORenderTargetUnbindOp
+    UnbindRenderTarget,
+    BindMaterial,               // a: material ID
+    BindMaterialShader,         // a: material ID, b: lights hash
+    BindGeometry,               // a: material ID, b: geometry ID
+    BindView,                   // a: material ID, b: VROEyeType
+    Draw,                       // a: geometry ID, b: element index
+    Clear,                      // a: render target ID, b: VRORecordingClearBits
+    Blit,                       // a: source render target ID, b: destination ID
+    PostProcess,                // a: post-process ID, b: input textures
+    Upload,                     // a: resource ID, b: bytes
+    CreateGeometry,             // a: geometry ID
+    CreateMaterial,             // a: material ID
+    CreateTexture,              // a: width, b: height
+    CreateRenderTarget,         // a: VRORenderTargetType, b: attachments
+    CreateVertexBuffer,         // a: resource ID
+    NumCommands,
+};
+
+/*
+ A recorded driver call: the command and up to two integer arguments, 12
+ bytes per entry.
+ */
+struct VRODriverCommandRecord {
+    VRODriverCommand command;
+    int32_t a;
+    int32_t b;
+};
+
+/*
+ Compact log of driver commands, with a running count per command type.
+ Objects (shaders, render targets, materials) are identified by small
+ integer IDs assigned in order of first use, so logs from different runs of
+ the same scene compare equal.
+ */
+class VRODriverCommandLog {
+public:
+
+    VRODriverCommandLog() :
+        _recording(true), _nextId(0) {
+        clear();
+    }
+
+    void record(VRODriverCommand command, int32_t a = 0, int32_t b = 0) {
+        _counts[(int) command]++;
+        if (_recording) {
+            _commands.push_back({ command, a, b });
+        }
+    }
+
+    /*
+     Stop or resume storing individual commands; counts are always kept.
+     */
+    void setRecording(bool recording) {
+        _recording = recording;
+    }
+
+    void clear() {
+        _commands.clear();
+        std::fill(_counts, _counts + (int) VRODriverCommand::NumCommands, 0);
+    }
+
+    const std::vector<VRODriverCommandRecord> &getCommands() const {
+        return _commands;
+    }
+
+    uint64_t getCount(VRODriverCommand command) const {
+        return _counts[(int) command];
+    }
+
+    uint64_t getDrawCount() const {
+        return getCount(VRODriverCommand::Draw);
+    }
+
+    /*
+     Context state changes: texture, shader, render target, blend, cull,
+     depth, stencil and color mask commands.
+     */
+    uint64_t getStateChangeCount() const {
+        uint64_t count = 0;
+        for (int c = (int) VRODriverCommand::SetActiveTextureUnit; c <= (int) VRODriverCommand::UnbindRenderTarget; c++) {
+            count += _counts[c];
+        }
+        return count;
+    }
+
+    /*
+     Return a stable small integer for the given object. Objects are keyed by
+     address, so the ID must be released with releaseId() when the object is
+     destroyed; otherwise a new object allocated at the same address would
+     inherit it.
+     */
+    int32_t getId(const void *object) {
+        return getId(object, std::weak_ptr<const void>());
+    }
+
+    /*
+     As above, for an object with a shared owner. The entry watches the
+     owner, so once the object is destroyed its address maps to a fresh ID
+     without an explicit release.
+     */
+    int32_t getId(const void *object, std::weak_ptr<const void> owner) {
+        if (!object) {
+            return -1;
+        }
+        auto it = _ids.find(object);
+        if (it != _ids.end() && !(it->second.owned && it->second.owner.expired())) {
+            return it->second.id;
+        }
+        IdEntry &entry = _ids[object];
+        entry.id = _nextId++;
+        entry.owned = !owner.expired();
+        entry.owner = owner;
+        return entry.id;
+    }
+
+    template <typename T>
+    int32_t getId(const std::shared_ptr<T> &object) {
+        return getId(object.get(), object);
+    }
+
+    /*
+     Forget the ID of a destroyed object. The next object at its address is
+     given a new ID.
+     */
+    void releaseId(const void *object) {
+        _ids.erase(object);
+    }
+
+    static const char *getName(VRODriverCommand command) {
+        static const char *names[] = {
+            "BeginFrame", "EndFrame", "BeginEye", "EndEye", "SetActiveTextureUnit", "BindTexture",
+            "SetDepthWritingEnabled", "SetDepthReadingEnabled", "SetStencilTestEnabled", "SetCullMode",
+            "SetRenderTargetColorMask", "SetMaterialColorMask", "SetBlendMode", "BindShader", "UnbindShader",
+            "BindRenderTarget", "UnbindRenderTarget", "BindMaterial", "BindMaterialShader", "BindGeometry",
+            "BindView", "Draw", "Clear", "Blit", "PostProcess",
+            "Upload", "CreateGeometry", "CreateMaterial", "CreateTexture", "CreateRenderTarget",
+            "CreateVertexBuffer",
+        };
+        return names[(int) command];
+    }
+
+    /*
+     One line per command type that occurred, with its count.
+     */
+    std::string getSummary() const {
+        std::stringstream ss;
+        for (int c = 0; c < (int) VRODriverCommand::NumCommands; c++) {
+            if (_counts[c] > 0) {
+                ss << getName((VRODriverCommand) c) << ": " << _counts[c] << "\n";
+            }
+        }
+        return ss.str();
+    }
+
+private:
+
+    struct IdEntry {
+        int32_t id;
+        bool owned;
+        std::weak_ptr<const void> owner;
+    };
+
+    bool _recording;
+    std::vector<VRODriverCommandRecord> _commands;
+    uint64_t _counts[(int) VRODriverCommand::NumCommands];
+    std::unordered_map<const void *, IdEntry> _ids;
+    int32_t _nextId;
+
+};
+
+/*
+ Material substrate that records its binds instead of issuing GL or Metal
+ calls. Its shader selection is logged as BindMaterialShader with the lights
+ hash, separately from the driver's BindShader.
+ */
+class VRORecordingMaterialSubstrate : public VROMaterialSubstrate {
+public:
+
+    VRORecordingMaterialSubstrate(std::shared_ptr<VRODriverCommandLog> log) :
+        _log(log) {
+        _log->record(VRODriverCommand::CreateMaterial, _log->getId(this));
+    }
+    virtual ~VRORecordingMaterialSubstrate() {
+        _log->releaseId(this);
+    }
+
+    void updateTextures() {}
+    void updateSortKey(VROSortKey & /* key */, const std::vector<std::shared_ptr<VROLight>> & /* lights */,
+                       const VRORenderContext & /* context */, std::shared_ptr<VRODriver> /* driver */) {}
+
+    bool bindShader(int lightsHash, const std::vector<std::shared_ptr<VROLight>> & /* lights */,
+                    const VRORenderContext & /* context */, std::shared_ptr<VRODriver> & /* driver */) {
+        _log->record(VRODriverCommand::BindMaterialShader, _log->getId(this), lightsHash);
+        return true;
+    }
+    void bindProperties(std::shared_ptr<VRODriver> & /* driver */) {
+        _log->record(VRODriverCommand::BindMaterial, _log->getId(this));
+    }
+    void bindGeometry(float /* opacity */, const VROGeometry &geometry) {
+        _log->record(VRODriverCommand::BindGeometry, _log->getId(this), _log->getId(&geometry, geometry.weak_from_this()));
+    }
+    void bindView(VROMatrix4f /* modelMatrix */, VROMatrix4f /* viewMatrix */,
+                  VROMatrix4f /* projectionMatrix */, VROMatrix4f /* normalMatrix */,
+                  VROVector3f /* cameraPosition */, VROEyeType eyeType,
+                  const VRORenderContext & /* context */) {
+        _log->record(VRODriverCommand::BindView, _log->getId(this), (int32_t) eyeType);
+    }
+
+private:
+
+    std::shared_ptr<VRODriverCommandLog> _log;
+
+};
+
+/*
+ Buffers named in Clear commands.
+ */
+enum VRORecordingClearBits {
+    VRORecordingClearColor   = 1,
+    VRORecordingClearDepth   = 1 << 1,
+    VRORecordingClearStencil = 1 << 2,
+};
+
+/*
+ Geometry substrate that binds the material's geometry and view through its
+ substrate, as the GL substrate does, then records a Draw of the element.
+ Silhouette passes draw every element.
+ */
+class VRORecordingGeometrySubstrate : public VROGeometrySubstrate {
+public:
+
+    VRORecordingGeometrySubstrate(const VROGeometry &geometry, std::shared_ptr<VRODriverCommandLog> log) :
+        _log(log) {
+        _log->record(VRODriverCommand::CreateGeometry, getGeometryId(geometry));
+    }
+    virtual ~VRORecordingGeometrySubstrate() {}
+
+    void update(const VROGeometry & /* geometry */, std::shared_ptr<VRODriver> & /* driver */) {}
+
+    void render(const VROGeometry &geometry, int elementIndex,
+                VROMatrix4f transform, VROMatrix4f normalMatrix, float opacity,
+                const std::shared_ptr<VROMaterial> &material,
+                const VRORenderContext &context, std::shared_ptr<VRODriver> &driver) {
+        VROMaterialSubstrate *substrate = material ? material->getSubstrate(driver) : nullptr;
+        if (substrate) {
+            substrate->bindGeometry(opacity, geometry);
+            substrate->bindView(transform, context.getViewMatrix(), context.getProjectionMatrix(), normalMatrix,
+                                context.getCamera().getPosition(), context.getEyeType(), context);
+        }
+        _log->record(VRODriverCommand::Draw, getGeometryId(geometry), elementIndex);
+    }
+    void renderSilhouette(const VROGeometry &geometry, VROMatrix4f /* transform */,
+                          std::shared_ptr<VROMaterial> & /* material */,
+                          const VRORenderContext & /* context */, std::shared_ptr<VRODriver> & /* driver */) {
+        int numElements = (int) geometry.getGeometryElements().size();
+        for (int i = 0; i < numElements; i++) {
+            _log->record(VRODriverCommand::Draw, getGeometryId(geometry), i);
+        }
+    }
+    void renderSilhouetteTextured(const VROGeometry &geometry, int element, VROMatrix4f /* transform */,
+                                  std::shared_ptr<VROMaterial> & /* material */,
+                                  const VRORenderContext & /* context */, std::shared_ptr<VRODriver> & /* driver */) {
+        _log->record(VRODriverCommand::Draw, getGeometryId(geometry), element);
+    }
+
+private:
+
+    std::shared_ptr<VRODriverCommandLog> _log;
+
+    int32_t getGeometryId(const VROGeometry &geometry) {
+        return _log->getId(&geometry, geometry.weak_from_this());
+    }
+
+};
+
+/*
+ Texture substrate with no storage. Its data was recorded as an Upload when
+ the driver created it.
+ */
+class VRORecordingTextureSubstrate : public VROTextureSubstrate {
+public:
+    virtual ~VRORecordingTextureSubstrate() {}
+    void updateWrapMode(VROWrapMode /* wrapS */, VROWrapMode /* wrapT */) {}
+};
+
+/*
+ Render target that keeps its viewport and attachments but no framebuffer.
+ Offscreen targets are given one 2D texture per attachment (with a recording
+ substrate) when first sized, so passes that sample them get a texture.
+ Clears and blits are logged; binds are logged by the driver.
+ */
+class VRORecordingRenderTarget : public VRORenderTarget {
+public:
+
+    VRORecordingRenderTarget(VRORenderTargetType type, int numAttachments, int numImages,
+                             std::shared_ptr<VRODriverCommandLog> log) :
+        VRORenderTarget(type, numImages),
+        _log(log),
+        _numAttachments(numAttachments) {}
+    virtual ~VRORecordingRenderTarget() {
+        _log->releaseId(this);
+    }
+
+    void setViewport(VROViewport viewport) {
+        bool resized = viewport.getWidth() != _viewport.getWidth() || viewport.getHeight() != _viewport.getHeight();
+        _viewport = viewport;
+        if (resized && _type != kVRORenderTargetDisplay) {
+            attachNewTextures();
+        }
+    }
+    bool hydrate() {
+        return true;
+    }
+    int getWidth() const {
+        return _viewport.getWidth();
+    }
+    int getHeight() const {
+        return _viewport.getHeight();
+    }
+
+    bool bind() { return true; }
+    void bindRead() {}
+    bool invalidate() { return true; }
+
+    void blitColor(std::shared_ptr<VRORenderTarget> destination, bool /* flipY */,
+                   std::shared_ptr<VRODriver> /* driver */) {
+        _log->record(VRODriverCommand::Blit, _log->getId(this), _log->getId(destination.get()));
+    }
+    void blitStencil(std::shared_ptr<VRORenderTarget> destination, bool /* flipY */,
+                     std::shared_ptr<VRODriver> /* driver */) {
+        _log->record(VRODriverCommand::Blit, _log->getId(this), _log->getId(destination.get()));
+    }
+
+    void deleteFramebuffers() {
+        _textures.clear();
+    }
+    bool restoreFramebuffers() {
+        if (_type != kVRORenderTargetDisplay) {
+            attachNewTextures();
+        }
+        return true;
+    }
+
+    bool hasTextureAttached(int attachment) {
+        return attachment < (int) _textures.size() && _textures[attachment] != nullptr;
+    }
+    void clearTextures() {
+        _textures.clear();
+    }
+    void attachNewTextures() {
+        _textures.clear();
+        for (int i = 0; i < _numAttachments; i++) {
+            std::unique_ptr<VROTextureSubstrate> substrate(new VRORecordingTextureSubstrate());
+            _textures.push_back(std::make_shared<VROTexture>(VROTextureType::Texture2D, VROTextureInternalFormat::RGBA8,
+                                                             std::move(substrate)));
+        }
+    }
+    void setTextureImageIndex(int /* index */, int /* attachment */) {}
+    void setTextureCubeFace(int /* face */, int /* mipLevel */, int /* attachment */) {}
+    void setMipLevel(int /* mipLevel */, int /* attachment */) {}
+    bool attachTexture(std::shared_ptr<VROTexture> texture, int attachment) {
+        if (attachment >= (int) _textures.size()) {
+            _textures.resize(attachment + 1);
+        }
+        _textures[attachment] = texture;
+        return true;
+    }
+    const std::shared_ptr<VROTexture> getTexture(int attachment) const {
+        return attachment < (int) _textures.size() ? _textures[attachment] : nullptr;
+    }
+
+    void clearStencil() {
+        _log->record(VRODriverCommand::Clear, _log->getId(this), VRORecordingClearStencil);
+    }
+    void clearDepth() {
+        _log->record(VRODriverCommand::Clear, _log->getId(this), VRORecordingClearDepth);
+    }
+    void clearColor() {
+        _log->record(VRODriverCommand::Clear, _log->getId(this), VRORecordingClearColor);
+    }
+    void clearDepthAndColor() {
+        _log->record(VRODriverCommand::Clear, _log->getId(this), VRORecordingClearDepth | VRORecordingClearColor);
+    }
+
+    void enablePortalStencilWriting(VROFace /* face */) {}
+    void enablePortalStencilRemoval(VROFace /* face */) {}
+    void disablePortalStencilWriting(VROFace /* face */) {}
+    void setPortalStencilPassFunction(VROFace /* face */, VROStencilFunc /* func */, int /* ref */) {}
+
+private:
+
+    std::shared_ptr<VRODriverCommandLog> _log;
+    int _numAttachments;
+    VROViewport _viewport;
+    std::vector<std::shared_ptr<VROTexture>> _textures;
+
+};
+
+/*
+ Image post-process that binds its shader through the driver, as the GL
+ implementation does, and records each full-screen blit as a PostProcess
+ with the number of input textures. Blits are not counted as draws.
+ */
+class VRORecordingImagePostProcess : public VROImagePostProcess {
+public:
+
+    VRORecordingImagePostProcess(std::shared_ptr<VROShaderProgram> shader, std::shared_ptr<VRODriverCommandLog> log) :
+        _shader(shader),
+        _log(log) {}
+    virtual ~VRORecordingImagePostProcess() {
+        _log->releaseId(this);
+    }
+
+    void setVerticalFlip(bool /* flip */) {}
+    void blit(std::vector<std::shared_ptr<VROTexture>> textures, std::shared_ptr<VRODriver> &driver) {
+        begin(driver);
+        blitOpt(textures, driver);
+        end(driver);
+    }
+    void begin(std::shared_ptr<VRODriver> &driver) {
+        driver->bindShader(_shader);
+    }
+    void blitOpt(std::vector<std::shared_ptr<VROTexture>> textures, std::shared_ptr<VRODriver> & /* driver */) {
+        _log->record(VRODriverCommand::PostProcess, _log->getId(this), (int32_t) textures.size());
+    }
+    void end(std::shared_ptr<VRODriver> & /* driver */) {}
+
+private:
+
+    std::shared_ptr<VROShaderProgram> _shader;
+    std::shared_ptr<VRODriverCommandLog> _log;
+
+};
+
+/*
+ Vertex buffer that keeps its data and never uploads it; the data was
+ recorded as an Upload when the driver created it.
+ */
+class VRORecordingVertexBuffer : public VROVertexBuffer {
+public:
+    VRORecordingVertexBuffer(std::shared_ptr<VROData> data) :
+        VROVertexBuffer(data) {}
+    virtual ~VRORecordingVertexBuffer() {}
+    void hydrate() {}
+};
+
+/*
+ Silent sound and audio player, so sound requests succeed without audio
+ output.
+ */
+class VROSilentSound : public VROSound {
+public:
+    VROSilentSound(VROSoundType type) { _type = type; }
+    virtual ~VROSilentSound() {}
+    void play() {}
+    void pause() {}
+    void setVolume(float volume) { _volume = volume; }
+    void setMuted(bool muted) { _muted = muted; }
+    void setLoop(bool loop) { _loop = loop; }
+    void seekToTime(float /* seconds */) {}
+    void setRotation(VROQuaternion rotation) { _rotation = rotation; }
+    void setPosition(VROVector3f position) { _position = position; }
+    VROVector3f getPosition() { return _position; }
+    void setTransformedPosition(VROVector3f transformedPosition) { _transformedPosition = transformedPosition; }
+    void setDistanceRolloffModel(VROSoundRolloffModel model, float minDistance, float maxDistance) {
+        _rolloffModel = model;
+        _rolloffMinDistance = minDistance;
+        _rolloffMaxDistance = maxDistance;
+    }
+};
+
+class VROSilentAudioPlayer : public VROAudioPlayer {
+public:
+    virtual ~VROSilentAudioPlayer() {}
+    void setup() {}
+    void setLoop(bool /* loop */) {}
+    void play() {}
+    void pause() {}
+    void setVolume(float /* volume */) {}
+    void setMuted(bool /* muted */) {}
+    void seekToTime(float /* seconds */) {}
+};
+
+/*
+ VRODriver that issues nothing and records every frame, eye, state change,
+ bind, draw, resource request and upload made through it into a
+ VRODriverCommandLog. It needs no GPU or window, so scenes can be rendered
+ through VROChoreographer and its render passes in CI, and code that talks
+ to VRODriver directly can be exercised and its calls counted.
+
+ Every factory returns a recording object: geometry substrates log a Draw
+ per element rendered, render targets (including the display) log clears
+ and blits, post-processes log their blits, and texture and vertex buffer
+ data is recorded as an Upload when it is handed to the factory. Sounds and
+ audio players are silent. Video texture caches are not available, so
+ video is not rendered.
+
+ Typefaces need a font library, which only the platform driver has. Give
+ one with setTypefaceDriver() to render text, and to render frames through
+ VRORenderer: its first prepareFrame() builds the debug HUD's text. Without
+ one, newTypefaceCollection() returns nullptr.
+
+ By default every call is logged as issued, so the log shows exactly what
+ the caller asked for. With setStateCachingEnabled(true), state and bind
+ calls first pass through a VRODriverStateCache and redundant ones are left
+ out of the log; the cache's stats then give issued and elided counts per
+ category.
+ */
+class VRORecordingDriver : public VRODriver {
+public:
+
+    VRORecordingDriver(VROColorRenderingMode colorRenderingMode = VROColorRenderingMode::Linear) :
+        _log(std::make_shared<VRODriverCommandLog>()),
+        _colorRenderingMode(colorRenderingMode),
+        _softwareGammaPass(false),
+        _activeUnit(0),
+        _frameScheduler(std::make_shared<VROFrameScheduler>()) {
+        _stateCache.setEnabled(false);
+    }
+    virtual ~VRORecordingDriver() {}
+
+    std::shared_ptr<VRODriverCommandLog> getCommandLog() const {
+        return _log;
+    }
+
+    /*
+     Set the driver typeface collections are created with, typically the
+     platform driver of a VROView. Glyphs are uploaded through that driver,
+     not recorded.
+     */
+    void setTypefaceDriver(std::shared_ptr<VRODriver> driver) {
+        _typefaceDriver = driver;
+    }
+
+    void setStateCachingEnabled(bool enabled) {
+        _stateCache.setEnabled(enabled);
+    }
+    VRODriverStateCache &getStateCache() {
+        return _stateCache;
+    }
+
+    /*
+     For substrates to record a data upload of the given size.
+     */
+    void recordUpload(const void *resource, int bytes) {
+        _log->record(VRODriverCommand::Upload, _log->getId(resource), bytes);
+    }
+
+#pragma mark - Frame
+
+    void willRenderFrame(const VRORenderContext & /* context */) {
+        _stateCache.beginFrame();
+        _log->record(VRODriverCommand::BeginFrame);
+    }
+    void didRenderFrame(const VROFrameTimer & /* timer */, const VRORenderContext & /* context */) {
+        _log->record(VRODriverCommand::EndFrame);
+        _stateCache.endFrame();
+    }
+    void willRenderEye(const VRORenderContext & /* context */) { _log->record(VRODriverCommand::BeginEye); }
+    void didRenderEye(const VRORenderContext & /* context */) { _log->record(VRODriverCommand::EndEye); }
+    void pause() {}
+    void resume() {
+        _stateCache.invalidate();
+    }
+
+    void readGPUType() {}
+    VROGPUType getGPUType() { return VROGPUType::Normal; }
+    void readDisplayFramebuffer() {}
+
+#pragma mark - State
+
+    /*
+     Units are passed as GL_TEXTURE0 + i, as the GL driver takes them; the
+     cache and the log use the index i.
+     */
+    void setActiveTextureUnit(int unit) {
+        _activeUnit = unit - GL_TEXTURE0;
+        if (_stateCache.setActiveTextureUnit(_activeUnit)) {
+            _log->record(VRODriverCommand::SetActiveTextureUnit, _activeUnit);
+        }
+    }
+    void bindTexture(int target, int texture) {
+        if (_stateCache.bindTexture(_activeUnit, target, texture)) {
+            _log->record(VRODriverCommand::BindTexture, _activeUnit, texture);
+        }
+    }
+    void bindTexture(int unit, int target, int texture) {
+        int index = unit - GL_TEXTURE0;
+        if (_stateCache.bindTexture(index, target, texture)) {
+            _log->record(VRODriverCommand::BindTexture, index, texture);
+        }
+    }
+    void setDepthWritingEnabled(bool enabled) {
+        if (_stateCache.setDepthWritingEnabled(enabled)) {
+            _log->record(VRODriverCommand::SetDepthWritingEnabled, enabled);
+        }
+    }
+    void setDepthReadingEnabled(bool enabled) {
+        if (_stateCache.setDepthReadingEnabled(enabled)) {
+            _log->record(VRODriverCommand::SetDepthReadingEnabled, enabled);
+        }
+    }
+    void setStencilTestEnabled(bool enabled) {
+        if (_stateCache.setStencilTestEnabled(enabled)) {
+            _log->record(VRODriverCommand::SetStencilTestEnabled, enabled);
+        }
+    }
+    void setCullMode(VROCullMode cullMode) {
+        if (_stateCache.setCullMode(cullMode)) {
+            _log->record(VRODriverCommand::SetCullMode, (int32_t) cullMode);
+        }
+    }
+    void setRenderTargetColorWritingMask(VROColorMask mask) {
+        if (_stateCache.setRenderTargetColorWritingMask(mask)) {
+            _log->record(VRODriverCommand::SetRenderTargetColorMask, mask);
+        }
+    }
+    void setMaterialColorWritingMask(VROColorMask mask) {
+        if (_stateCache.setMaterialColorWritingMask(mask)) {
+            _log->record(VRODriverCommand::SetMaterialColorMask, mask);
+        }
+    }
+    void setBlendingMode(VROBlendMode mode) {
+        if (_stateCache.setBlendingMode(mode)) {
+            _log->record(VRODriverCommand::SetBlendMode, (int32_t) mode);
+        }
+    }
+    void bindShader(std::shared_ptr<VROShaderProgram> program) {
+        if (_stateCache.bindShader(program.get())) {
+            _log->record(VRODriverCommand::BindShader, program ? (int32_t) program->getShaderId() : -1);
+        }
+    }
+    void unbindShader() {
+        if (_stateCache.bindShader(nullptr)) {
+            _log->record(VRODriverCommand::UnbindShader);
+        }
+    }
+
+    bool bindRenderTarget(std::shared_ptr<VRORenderTarget> target, VRORenderTargetUnbindOp unbindOp) {
+        _log->record(VRODriverCommand::BindRenderTarget, _log->getId(target), (int32_t) unbindOp);
+        bool bound = _renderTarget != target;
+        _stateCache.countRenderTargetBind(bound);
+        _renderTarget = target;
+        return bound;
+    }
+    void unbindRenderTarget() {
+        _log->record(VRODriverCommand::UnbindRenderTarget);
+        _stateCache.countRenderTargetBind(true);
+        _renderTarget.reset();
+    }
+    std::shared_ptr<VRORenderTarget> getRenderTarget() {
+        return _renderTarget;
+    }
+
+    VROColorRenderingMode getColorRenderingMode() { return _colorRenderingMode; }
+    void setHasSoftwareGammaPass(bool softwareGamma) { _softwareGammaPass = softwareGamma; }
+    bool hasSoftwareGammaPass() const { return _softwareGammaPass; }
+    bool isBloomSupported() { return true; }
+
+#pragma mark - Resources
+
+    VROGeometrySubstrate *newGeometrySubstrate(const VROGeometry &geometry) {
+        return new VRORecordingGeometrySubstrate(geometry, _log);
+    }
+    VROMaterialSubstrate *newMaterialSubstrate(VROMaterial & /* material */) {
+        return new VRORecordingMaterialSubstrate(_log);
+    }
+    VROTextureSubstrate *newTextureSubstrate(VROTextureType /* type */, VROTextureFormat /* format */,
+                                             VROTextureInternalFormat /* internalFormat */, bool /* sRGB */,
+                                             VROMipmapMode /* mipmapMode */,
+                                             std::vector<std::shared_ptr<VROData>> &data,
+                                             int width, int height, std::vector<uint32_t> /* mipSizes */,
+                                             VROWrapMode /* wrapS */, VROWrapMode /* wrapT */,
+                                             VROFilterMode /* minFilter */, VROFilterMode /* magFilter */, VROFilterMode /* mipFilter */) {
+        // Texture creation binds the new texture on the active unit
+        _stateCache.invalidateTextures();
+        _log->record(VRODriverCommand::CreateTexture, width, height);
+        for (const std::shared_ptr<VROData> &image : data) {
+            if (image) {
+                _log->record(VRODriverCommand::Upload, _log->getId(image), image->getDataLength());
+            }
+        }
+        return new VRORecordingTextureSubstrate();
+    }
+    std::shared_ptr<VRORenderTarget> newRenderTarget(VRORenderTargetType type, int numAttachments, int numImages,
+                                                     bool /* enableMipmaps */, bool /* needsDepthStencil */) {
+        _stateCache.invalidateTextures();
+        _log->record(VRODriverCommand::CreateRenderTarget, (int32_t) type, numAttachments);
+        return std::make_shared<VRORecordingRenderTarget>(type, numAttachments, numImages, _log);
+    }
+    std::shared_ptr<VROVertexBuffer> newVertexBuffer(std::shared_ptr<VROData> data) {
+        _log->record(VRODriverCommand::CreateVertexBuffer, _log->getId(data));
+        if (data) {
+            _log->record(VRODriverCommand::Upload, _log->getId(data), data->getDataLength());
+        }
+        return std::make_shared<VRORecordingVertexBuffer>(data);
+    }
+    std::shared_ptr<VRORenderTarget> getDisplay() {
+        if (!_display) {
+            _display = std::make_shared<VRORecordingRenderTarget>(kVRORenderTargetDisplay, 0, 1, _log);
+        }
+        return _display;
+    }
+    std::shared_ptr<VROImagePostProcess> newImagePostProcess(std::shared_ptr<VROShaderProgram> shader) {
+        return std::make_shared<VRORecordingImagePostProcess>(shader, _log);
+    }
+    std::shared_ptr<VROVideoTextureCache> newVideoTextureCache() { return nullptr; }
+
+    std::shared_ptr<VROSound> newSound(std::shared_ptr<VROSoundData> /* data */, VROSoundType type) {
+        return std::make_shared<VROSilentSound>(type);
+    }
+    std::shared_ptr<VROSound> newSound(std::string /* resource */, VROResourceType /* resourceType */, VROSoundType type) {
+        return std::make_shared<VROSilentSound>(type);
+    }
+    std::shared_ptr<VROAudioPlayer> newAudioPlayer(std::shared_ptr<VROSoundData> /* data */) {
+        return std::make_shared<VROSilentAudioPlayer>();
+    }
+    std::shared_ptr<VROAudioPlayer> newAudioPlayer(std::string /* path */, bool /* isLocal */) {
+        return std::make_shared<VROSilentAudioPlayer>();
+    }
+    std::shared_ptr<VROTypefaceCollection> newTypefaceCollection(std::string typefaces, int size,
+                                                                 VROFontStyle style, VROFontWeight weight) {
+        std::shared_ptr<VRODriver> typefaceDriver = _typefaceDriver.lock();
+        if (!typefaceDriver) {
+            return nullptr;
+        }
+        return typefaceDriver->newTypefaceCollection(typefaces, size, style, weight);
+    }
+    void setSoundRoom(float /* sizeX */, float /* sizeY */, float /* sizeZ */, std::string /* wallMaterial */,
+                      std::string /* ceilingMaterial */, std::string /* floorMaterial */) {}
+
+    std::shared_ptr<VROFrameScheduler> getFrameScheduler() { return _frameScheduler; }
+    void *getGraphicsContext() { return nullptr; }
+
+private:
+
+    std::shared_ptr<VRODriverCommandLog> _log;
+    VRODriverStateCache _stateCache;
+    VROColorRenderingMode _colorRenderingMode;
+    bool _softwareGammaPass;
+    int _activeUnit;
+    std::shared_ptr<VRORenderTarget> _renderTarget;
+    std::shared_ptr<VRORenderTarget> _display;
+    std::shared_ptr<VROFrameScheduler> _frameScheduler;
+    std::weak_ptr<VRODriver> _typefaceDriver;
+
+};
+
+#endif /* VRORecordingDriver_h */
@@ -0,0 +1,509 @@
+//
+//  VRORenderGraph.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VRORenderGraph_h
+#define VRORenderGraph_h
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <sstream>
+#include <stdint.h>
+#include "VRODriver.h"
+#include "VROLog.h"
+
+class VRORenderTarget;
+class VRORenderGraph;
+
+/*
+ Description of a render target used by the graph. Sizes are relative to
+ the viewport, so that one description serves every viewport size.
+ */
+struct VRORenderGraphTargetDesc {
+    std::string name;
+    VRORenderTargetType type;
+    float scale = 1;                  // Fraction of the viewport width and height
+    int numAttachments = 1;
+    int bytesPerPixel = 4;            // Per color attachment, e.g. 4 for RGBA8, 8 for RGBA16F
+    bool needsDepthStencil = false;
+    bool mipmaps = false;
+
+    /*
+     Two targets may share memory only if they are interchangeable.
+     */
+    bool isCompatible(const VRORenderGraphTargetDesc &other) const {
+        return type == other.type && scale == other.scale && numAttachments == other.numAttachments &&
+               bytesPerPixel == other.bytesPerPixel && needsDepthStencil == other.needsDepthStencil &&
+               mipmaps == other.mipmaps;
+    }
+
+    int64_t getBytes(int viewportWidth, int viewportHeight) const {
+        int64_t width = std::max(1, (int) (viewportWidth * scale));
+        int64_t height = std::max(1, (int) (viewportHeight * scale));
+        int64_t bytes = width * height * bytesPerPixel * numAttachments;
+        if (needsDepthStencil) {
+            bytes += width * height * 4;
+        }
+        if (mipmaps) {
+            bytes = bytes * 4 / 3;
+        }
+        return bytes;
+    }
+};
+
+/*
+ Passed to each pass when the graph executes, to look up the physical
+ target behind each of the pass's resources.
+ */
+class VRORenderGraphContext {
+public:
+
+    VRORenderGraphContext(const VRORenderGraph &graph, std::shared_ptr<VRODriver> driver) :
+        _graph(graph), _driver(driver) {}
+
+    std::shared_ptr<VRORenderTarget> getTarget(int resource) const;
+    std::shared_ptr<VRODriver> getDriver() const { return _driver; }
+
+private:
+
+    const VRORenderGraph &_graph;
+    std::shared_ptr<VRODriver> _driver;
+
+};
+
+typedef std::function<void(const VRORenderGraphContext &context)> VRORenderGraphPassFunction;
+
+/*
+ Creates (or resizes) the physical target for a description at the given
+ pixel size. Provided by the choreographer, which owns target creation.
+ */
+typedef std::function<std::shared_ptr<VRORenderTarget>(const VRORenderGraphTargetDesc &desc,
+                                                       int width, int height,
+                                                       std::shared_ptr<VRORenderTarget> existing)> VRORenderGraphAllocator;
+
+/*
+ Declarative description of the choreographer's frame: passes declare the
+ targets they read and write, and the graph derives everything the
+ choreographer otherwise hard-codes in createRenderTargets().
+
+ - Passes whose outputs are never read, directly or indirectly, by an
+   output resource or a side-effect pass are culled, so disabling a
+   feature (bloom, a post-process effect) is a matter of not reading its
+   result.
+ - Transient targets whose lifetimes do not overlap share one physical
+   target (e.g. the bloom ping-pong targets and the post-process targets
+   once bloom has been composited).
+ - Physical targets are kept across compiles and reused by compatible
+   descriptions, so toggling features does not recreate targets.
+
+ Each pass writes its outputs as new resources: a ping-pong between two
+ targets is written as a chain of resources, and the graph decides which
+ of them alias. A pass that draws over a target's existing contents (e.g.
+ transparent geometry over the opaque HDR target) writes a version of it
+ from loadTarget() instead; every version stays in the target's physical
+ slot.
+
+ Usage each time the configuration changes: reset(), declare resources
+ and passes, then compile(). Each frame: execute().
+
+ VROChoreographer is compiled into the framework and still creates its
+ targets in createRenderTargets(); nothing in this tree drives the graph
+ yet. VRORenderGraphTests declares the choreographer's HDR, bloom and
+ post-process frame and compares its memory with the hard-coded targets.
+ */
+class VRORenderGraph {
+public:
+
+    VRORenderGraph() : _compiled(false), _viewportWidth(0), _viewportHeight(0) {}
+    virtual ~VRORenderGraph() {}
+
+    /*
+     Clear the declared passes and resources. Physical targets are kept for
+     reuse by the next compile.
+     */
+    void reset() {
+        for (Slot &slot : _slots) {
+            if (slot.target) {
+                _pool.push_back({ slot.desc, slot.target });
+            }
+        }
+        _slots.clear();
+        _resources.clear();
+        _passes.clear();
+        _order.clear();
+        _compiled = false;
+    }
+
+#pragma mark - Declaration
+
+    /*
+     Declare a transient target, to be written by exactly one pass.
+     */
+    int createTarget(const VRORenderGraphTargetDesc &desc) {
+        Resource resource;
+        resource.desc = desc;
+        _resources.push_back(resource);
+        return (int) _resources.size() - 1;
+    }
+
+    /*
+     Declare a target owned outside the graph (e.g. the display). It is
+     never aliased, and passes writing it are never culled.
+     */
+    int importTarget(const std::string &name, std::shared_ptr<VRORenderTarget> target) {
+        Resource resource;
+        resource.desc.name = name;
+        resource.imported = target;
+        resource.isImported = true;
+        _resources.push_back(resource);
+        return (int) _resources.size() - 1;
+    }
+
+    /*
+     Declare a new version of a target, for a pass that loads its contents
+     and draws over them. The pass writing the version reads the previous
+     one (it is added to the pass's inputs if not listed), and all versions
+     of a target share its physical target for their combined lifetime.
+     Versions of an imported target are imported.
+     */
+    int loadTarget(int resource) {
+        Resource version;
+        version.desc = _resources[resource].desc;
+        version.previous = resource;
+        version.root = getRoot(resource);
+        version.isImported = _resources[version.root].isImported;
+        _resources.push_back(version);
+        return (int) _resources.size() - 1;
+    }
+
+    /*
+     Replace the target behind an imported resource, e.g. when the display
+     changes between frames.
+     */
+    void setImportedTarget(int resource, std::shared_ptr<VRORenderTarget> target) {
+        _resources[resource].imported = target;
+    }
+
+    /*
+     Declare a pass. Passes execute in declaration order.
+     */
+    void addPass(const std::string &name, const std::vector<int> &inputs, const std::vector<int> &outputs,
+                 VRORenderGraphPassFunction execute, bool hasSideEffects = false) {
+        Pass pass;
+        pass.name = name;
+        pass.inputs = inputs;
+        pass.outputs = outputs;
+        pass.execute = execute;
+        pass.hasSideEffects = hasSideEffects;
+        for (int output : outputs) {
+            passert (_resources[output].writer < 0);
+            _resources[output].writer = (int) _passes.size();
+
+            int previous = _resources[output].previous;
+            if (previous >= 0 && std::find(pass.inputs.begin(), pass.inputs.end(), previous) == pass.inputs.end()) {
+                pass.inputs.push_back(previous);
+            }
+        }
+        _passes.push_back(pass);
+        _compiled = false;
+    }
+
+    /*
+     Mark a resource as a result of the frame, keeping the passes that
+     produce it. Its target lives to the end of the frame, so no later
+     transient aliases it.
+     */
+    void markOutput(int resource) {
+        _resources[resource].isOutput = true;
+    }
+
+#pragma mark - Compilation
+
+    /*
+     Cull unused passes and assign transient resources to physical targets.
+     */
+    void compile() {
+        const int passCount = (int) _passes.size();
+
+        // Walk back from outputs and side effects, keeping every pass whose
+        // result is needed
+        std::vector<int> stack;
+        for (int p = 0; p < passCount; p++) {
+            _passes[p].culled = true;
+            bool writesImported = false;
+            for (int output : _passes[p].outputs) {
+                writesImported |= _resources[output].isImported || _resources[output].isOutput;
+            }
+            if (_passes[p].hasSideEffects || writesImported) {
+                stack.push_back(p);
+            }
+        }
+        while (!stack.empty()) {
+            int p = stack.back();
+            stack.pop_back();
+            if (!_passes[p].culled) {
+                continue;
+            }
+            _passes[p].culled = false;
+            for (int input : _passes[p].inputs) {
+                int writer = _resources[input].writer;
+                if (writer >= 0 && _passes[writer].culled) {
+                    stack.push_back(writer);
+                }
+            }
+        }
+
+        // Lifetime of each resource over the surviving passes
+        _order.clear();
+        for (Resource &resource : _resources) {
+            resource.firstUse = INT32_MAX;
+            resource.lastUse = -1;
+            resource.slot = -1;
+        }
+        for (int p = 0; p < passCount; p++) {
+            if (_passes[p].culled) {
+                continue;
+            }
+            int index = (int) _order.size();
+            _order.push_back(p);
+            for (const std::vector<int> *list : { &_passes[p].inputs, &_passes[p].outputs }) {
+                for (int r : *list) {
+                    _resources[r].firstUse = std::min(_resources[r].firstUse, index);
+                    _resources[r].lastUse = std::max(_resources[r].lastUse, index);
+                }
+            }
+        }
+        // Versions of a target extend its lifetime, as they share its slot
+        for (Resource &resource : _resources) {
+            if (resource.root >= 0 && resource.lastUse >= 0) {
+                Resource &root = _resources[resource.root];
+                root.firstUse = std::min(root.firstUse, resource.firstUse);
+                root.lastUse = std::max(root.lastUse, resource.lastUse);
+            }
+        }
+        for (int r = 0; r < (int) _resources.size(); r++) {
+            if (_resources[r].isOutput && _resources[r].lastUse >= 0) {
+                _resources[getRoot(r)].lastUse = INT32_MAX;
+            }
+        }
+
+        // Assign transient resources to slots in order of first use; a slot
+        // is free once its last resource's lifetime has ended
+        for (Slot &slot : _slots) {
+            if (slot.target) {
+                _pool.push_back({ slot.desc, slot.target });
+            }
+        }
+        _slots.clear();
+
+        std::vector<int> transient;
+        for (int r = 0; r < (int) _resources.size(); r++) {
+            if (!_resources[r].isImported && _resources[r].root < 0 && _resources[r].lastUse >= 0) {
+                transient.push_back(r);
+            }
+        }
+        std::stable_sort(transient.begin(), transient.end(), [this](int a, int b) {
+            return _resources[a].firstUse < _resources[b].firstUse;
+        });
+        for (int r : transient) {
+            Resource &resource = _resources[r];
+            int chosen = -1;
+            for (int s = 0; s < (int) _slots.size(); s++) {
+                if (_slots[s].lastUse < resource.firstUse && _slots[s].desc.isCompatible(resource.desc)) {
+                    chosen = s;
+                    break;
+                }
+            }
+            if (chosen < 0) {
+                Slot slot;
+                slot.desc = resource.desc;
+                _slots.push_back(slot);
+                chosen = (int) _slots.size() - 1;
+            } else {
+                _slots[chosen].desc.name += "+" + resource.desc.name;
+            }
+            _slots[chosen].lastUse = resource.lastUse;
+            resource.slot = chosen;
+        }
+        for (Resource &resource : _resources) {
+            if (resource.root >= 0 && resource.lastUse >= 0) {
+                resource.slot = _resources[resource.root].slot;
+            }
+        }
+
+        // Take physical targets from the pool where possible
+        for (Slot &slot : _slots) {
+            for (auto it = _pool.begin(); it != _pool.end(); ++it) {
+                if (it->first.isCompatible(slot.desc)) {
+                    slot.target = it->second;
+                    _pool.erase(it);
+                    break;
+                }
+            }
+        }
+        _pool.clear();
+        _compiled = true;
+        _viewportWidth = _viewportHeight = 0;
+    }
+
+#pragma mark - Execution
+
+    /*
+     Run the surviving passes in order, creating or resizing physical
+     targets for the viewport first if needed.
+     */
+    void execute(int viewportWidth, int viewportHeight, std::shared_ptr<VRODriver> driver,
+                 VRORenderGraphAllocator allocator) {
+        if (!_compiled) {
+            compile();
+        }
+        if (viewportWidth != _viewportWidth || viewportHeight != _viewportHeight) {
+            for (Slot &slot : _slots) {
+                slot.target = allocator(slot.desc,
+                                        std::max(1, (int) (viewportWidth * slot.desc.scale)),
+                                        std::max(1, (int) (viewportHeight * slot.desc.scale)),
+                                        slot.target);
+            }
+            _viewportWidth = viewportWidth;
+            _viewportHeight = viewportHeight;
+        }
+
+        VRORenderGraphContext context(*this, driver);
+        for (int p : _order) {
+            _passes[p].execute(context);
+        }
+    }
+
+    std::shared_ptr<VRORenderTarget> getTarget(int resource) const {
+        const Resource &r = _resources[resource];
+        if (r.isImported) {
+            return _resources[getRoot(resource)].imported;
+        }
+        return r.slot >= 0 ? _slots[r.slot].target : nullptr;
+    }
+
+#pragma mark - Reporting
+
+    bool isPassCulled(int pass) const { return _passes[pass].culled; }
+    int getPassCount() const { return (int) _passes.size(); }
+    int getExecutedPassCount() const { return (int) _order.size(); }
+    int getPhysicalTargetCount() const { return (int) _slots.size(); }
+    int getPhysicalTarget(int resource) const { return _resources[resource].slot; }
+
+    /*
+     Memory of the transient targets used by surviving passes if each had
+     its own target, and of the physical targets after aliasing. Versions
+     share their target's memory. Both are modelled from the descriptions'
+     sizes, not measured from the driver's allocations.
+     */
+    int64_t getUnaliasedBytes(int viewportWidth, int viewportHeight) const {
+        int64_t bytes = 0;
+        for (const Resource &resource : _resources) {
+            if (!resource.isImported && resource.root < 0 && resource.lastUse >= 0) {
+                bytes += resource.desc.getBytes(viewportWidth, viewportHeight);
+            }
+        }
+        return bytes;
+    }
+    int64_t getAliasedBytes(int viewportWidth, int viewportHeight) const {
+        int64_t bytes = 0;
+        for (const Slot &slot : _slots) {
+            bytes += slot.desc.getBytes(viewportWidth, viewportHeight);
+        }
+        return bytes;
+    }
+
+    std::string getReport(int viewportWidth, int viewportHeight) const {
+        std::stringstream ss;
+        ss << "Render graph: " << _order.size() << " of " << _passes.size() << " passes, "
+           << _slots.size() << " physical targets\n";
+        for (int p = 0; p < (int) _passes.size(); p++) {
+            ss << (_passes[p].culled ? "  [culled] " : "  ") << _passes[p].name << "\n";
+        }
+        for (int s = 0; s < (int) _slots.size(); s++) {
+            ss << "  target " << s << ": " << _slots[s].desc.name << " ("
+               << _slots[s].desc.getBytes(viewportWidth, viewportHeight) / 1024 << " KB)\n";
+        }
+        ss << "  modelled memory " << getUnaliasedBytes(viewportWidth, viewportHeight) / 1024 << " KB unaliased, "
+           << getAliasedBytes(viewportWidth, viewportHeight) / 1024 << " KB aliased";
+        return ss.str();
+    }
+
+private:
+
+    struct Resource {
+        VRORenderGraphTargetDesc desc;
+        bool isImported = false;
+        bool isOutput = false;
+        std::shared_ptr<VRORenderTarget> imported;
+        int writer = -1;
+        int previous = -1;            // Version this one was loaded from
+        int root = -1;                // First version, which owns the slot
+        int firstUse = INT32_MAX;
+        int lastUse = -1;
+        int slot = -1;
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<int> inputs;
+        std::vector<int> outputs;
+        VRORenderGraphPassFunction execute;
+        bool hasSideEffects = false;
+        bool culled = false;
+    };
+
+    struct Slot {
+        VRORenderGraphTargetDesc desc;
+        int lastUse = -1;
+        std::shared_ptr<VRORenderTarget> target;
+    };
+
+    std::vector<Resource> _resources;
+    std::vector<Pass> _passes;
+    std::vector<int> _order;
+    std::vector<Slot> _slots;
+
+    /*
+     Physical targets from the previous compile, available for reuse.
+     */
+    std::vector<std::pair<VRORenderGraphTargetDesc, std::shared_ptr<VRORenderTarget>>> _pool;
+
+    bool _compiled;
+    int _viewportWidth, _viewportHeight;
+
+    int getRoot(int resource) const {
+        return _resources[resource].root >= 0 ? _resources[resource].root : resource;
+    }
+
+};
+
+inline std::shared_ptr<VRORenderTarget> VRORenderGraphContext::getTarget(int resource) const {
+    return _graph.getTarget(resource);
+}
+
+#endif /* VRORenderGraph_h */
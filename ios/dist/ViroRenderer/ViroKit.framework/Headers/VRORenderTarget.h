@@ -0,0 +1,136 @@
+//
+//  VRORenderTarget.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VRORenderTarget_h
+#define VRORenderTarget_h
+
+#include <memory>
+#include "VROVector4f.h"
+#include "VROViewport.h"
+
+class VROTexture;
+class VRODriver;
+enum class VROFace;
+enum class VROStencilFunc;
+
+/*
+ The type of a render target. Display is the platform framebuffer; the
+ remaining values are offscreen color and depth attachments, whose
+ enumerators live with the platform drivers.
+ */
+enum class VRORenderTargetType;
+static const VRORenderTargetType kVRORenderTargetDisplay = (VRORenderTargetType) 0;
+
+/*
+ A framebuffer the renderer draws into: either the display or a set of
+ texture attachments. Implemented per platform (VRORenderTargetOpenGL,
+ VRODisplayOpenGL); the framework's render passes call it through this
+ interface, so the order of the virtual functions and the base members
+ below must not change. VROPlatformInterfaceTests checks both against
+ VRORenderTargetOpenGL's vtable and constructor in the binary.
+ */
+class VRORenderTarget {
+public:
+
+    VRORenderTarget(VRORenderTargetType type, int numImages) :
+        _type(type),
+        _numImages(numImages) {}
+    virtual ~VRORenderTarget() {}
+
+    VRORenderTargetType getType() const {
+        return _type;
+    }
+    int getNumImages() const {
+        return _numImages;
+    }
+
+    void setClearColor(VROVector4f color) {
+        _clearColor = color;
+    }
+    VROVector4f getClearColor() const {
+        return _clearColor;
+    }
+
+    /*
+     Set the viewport, in pixels, creating or resizing the attachments to
+     match.
+     */
+    virtual void setViewport(VROViewport viewport) = 0;
+    virtual bool hydrate() = 0;
+    virtual int getWidth() const = 0;
+    virtual int getHeight() const = 0;
+
+    /*
+     Bind for drawing, or for reading in a blit.
+     */
+    virtual bool bind() = 0;
+    virtual void bindRead() = 0;
+
+    /*
+     Discard the contents of the attachments, so tile-based GPUs need not
+     store them.
+     */
+    virtual bool invalidate() = 0;
+
+    virtual void blitColor(std::shared_ptr<VRORenderTarget> destination, bool flipY,
+                           std::shared_ptr<VRODriver> driver) = 0;
+    virtual void blitStencil(std::shared_ptr<VRORenderTarget> destination, bool flipY,
+                             std::shared_ptr<VRODriver> driver) = 0;
+
+    virtual void deleteFramebuffers() = 0;
+    virtual bool restoreFramebuffers() = 0;
+
+#pragma mark - Attachments
+
+    virtual bool hasTextureAttached(int attachment) = 0;
+    virtual void clearTextures() = 0;
+    virtual void attachNewTextures() = 0;
+    virtual void setTextureImageIndex(int index, int attachment) = 0;
+    virtual void setTextureCubeFace(int face, int mipLevel, int attachment) = 0;
+    virtual void setMipLevel(int mipLevel, int attachment) = 0;
+    virtual bool attachTexture(std::shared_ptr<VROTexture> texture, int attachment) = 0;
+    virtual const std::shared_ptr<VROTexture> getTexture(int attachment) const = 0;
+
+#pragma mark - Clearing and Stencil
+
+    virtual void clearStencil() = 0;
+    virtual void clearDepth() = 0;
+    virtual void clearColor() = 0;
+    virtual void clearDepthAndColor() = 0;
+
+    virtual void enablePortalStencilWriting(VROFace face) = 0;
+    virtual void enablePortalStencilRemoval(VROFace face) = 0;
+    virtual void disablePortalStencilWriting(VROFace face) = 0;
+    virtual void setPortalStencilPassFunction(VROFace face, VROStencilFunc func, int ref) = 0;
+
+protected:
+
+    VRORenderTargetType _type;
+    int _numImages;
+    VROVector4f _clearColor;
+
+};
+
+#endif /* VRORenderTarget_h */
@@ -0,0 +1,384 @@
+//
+//  VROSIMD.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROSIMD_h
+#define VROSIMD_h
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ Define VRO_SIMD_DISABLE to force the portable path, e.g. to compare kernels
+ against their scalar reference on the same machine.
+ */
+#if defined(VRO_SIMD_DISABLE)
+#define VRO_SIMD_NEON 0
+#define VRO_SIMD_SSE 0
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VRO_SIMD_NEON 1
+#define VRO_SIMD_SSE 0
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VRO_SIMD_NEON 0
+#define VRO_SIMD_SSE 1
+#else
+#define VRO_SIMD_NEON 0
+#define VRO_SIMD_SSE 0
+#endif
+
+/*
+ Minimal 4-wide float vector used by the CPU kernels (depth meshing, filtering,
+ image preprocessing, skinning). Maps to NEON on device, SSE2 on x86 (simulator
+ and desktop test builds), and plain arrays elsewhere, so every kernel has a
+ single implementation that can be validated headlessly against its scalar
+ reference.
+
+ Comparisons return lane masks as VROFloat4 (all bits set for true lanes) for
+ use with select() and getMask().
+ */
+struct VROFloat4 {
+
+#if VRO_SIMD_NEON
+    float32x4_t v;
+#elif VRO_SIMD_SSE
+    __m128 v;
+#else
+    float v[4];
+#endif
+
+    static VROFloat4 load(const float *p) {
+        VROFloat4 r;
+#if VRO_SIMD_NEON
+        r.v = vld1q_f32(p);
+#elif VRO_SIMD_SSE
+        r.v = _mm_loadu_ps(p);
+#else
+        for (int i = 0; i < 4; i++) { r.v[i] = p[i]; }
+#endif
+        return r;
+    }
+
+    static VROFloat4 splat(float s) {
+        VROFloat4 r;
+#if VRO_SIMD_NEON
+        r.v = vdupq_n_f32(s);
+#elif VRO_SIMD_SSE
+        r.v = _mm_set1_ps(s);
+#else
+        for (int i = 0; i < 4; i++) { r.v[i] = s; }
+#endif
+        return r;
+    }
+
+    static VROFloat4 make(float a, float b, float c, float d) {
+        const float values[4] = { a, b, c, d };
+        return load(values);
+    }
+
+    void store(float *p) const {
+#if VRO_SIMD_NEON
+        vst1q_f32(p, v);
+#elif VRO_SIMD_SSE
+        _mm_storeu_ps(p, v);
+#else
+        for (int i = 0; i < 4; i++) { p[i] = v[i]; }
+#endif
+    }
+
+    float operator[](int lane) const {
+        float values[4];
+        store(values);
+        return values[lane];
+    }
+
+    /*
+     Bit i of the result is set if lane i of this mask is true.
+     */
+    int getMask() const {
+#if VRO_SIMD_NEON
+        uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(v), 31);
+        return (int) (vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) |
+                      (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+#elif VRO_SIMD_SSE
+        return _mm_movemask_ps(v);
+#else
+        int mask = 0;
+        for (int i = 0; i < 4; i++) {
+            uint32_t bits;
+            memcpy(&bits, &v[i], 4);
+            mask |= (bits >> 31) << i;
+        }
+        return mask;
+#endif
+    }
+};
+
+#if !VRO_SIMD_NEON && !VRO_SIMD_SSE
+#define VRO_FLOAT4_SCALAR_OP(expr) \
+    VROFloat4 r; for (int i = 0; i < 4; i++) { r.v[i] = (expr); } return r;
+
+static inline VROFloat4 VROFloat4MaskFromBool(bool b) {
+    VROFloat4 r;
+    uint32_t bits = b ? 0xFFFFFFFFu : 0;
+    for (int i = 0; i < 4; i++) { memcpy(&r.v[i], &bits, 4); }
+    return r;
+}
+#endif
+
+inline VROFloat4 operator+(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vaddq_f32(a.v, b.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_add_ps(a.v, b.v); return r;
+#else
+    VRO_FLOAT4_SCALAR_OP(a.v[i] + b.v[i])
+#endif
+}
+
+inline VROFloat4 operator-(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vsubq_f32(a.v, b.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_sub_ps(a.v, b.v); return r;
+#else
+    VRO_FLOAT4_SCALAR_OP(a.v[i] - b.v[i])
+#endif
+}
+
+inline VROFloat4 operator*(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vmulq_f32(a.v, b.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_mul_ps(a.v, b.v); return r;
+#else
+    VRO_FLOAT4_SCALAR_OP(a.v[i] * b.v[i])
+#endif
+}
+
+inline VROFloat4 operator/(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON && defined(__aarch64__)
+    VROFloat4 r; r.v = vdivq_f32(a.v, b.v); return r;
+#elif VRO_SIMD_NEON
+    // ARMv7 has no vector divide: reciprocal estimate plus two Newton-Raphson steps
+    float32x4_t reciprocal = vrecpeq_f32(b.v);
+    reciprocal = vmulq_f32(vrecpsq_f32(b.v, reciprocal), reciprocal);
+    reciprocal = vmulq_f32(vrecpsq_f32(b.v, reciprocal), reciprocal);
+    VROFloat4 r; r.v = vmulq_f32(a.v, reciprocal); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_div_ps(a.v, b.v); return r;
+#else
+    VRO_FLOAT4_SCALAR_OP(a.v[i] / b.v[i])
+#endif
+}
+
+/*
+ Returns a * b + c.
+ */
+inline VROFloat4 VROFloat4MulAdd(VROFloat4 a, VROFloat4 b, VROFloat4 c) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vmlaq_f32(c.v, a.v, b.v); return r;
+#else
+    return a * b + c;
+#endif
+}
+
+inline VROFloat4 VROFloat4Min(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vminq_f32(a.v, b.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_min_ps(a.v, b.v); return r;
+#else
+    VRO_FLOAT4_SCALAR_OP(a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+#endif
+}
+
+inline VROFloat4 VROFloat4Max(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vmaxq_f32(a.v, b.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_max_ps(a.v, b.v); return r;
+#else
+    VRO_FLOAT4_SCALAR_OP(a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+#endif
+}
+
+inline VROFloat4 VROFloat4Abs(VROFloat4 a) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vabsq_f32(a.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); return r;
+#else
+    VRO_FLOAT4_SCALAR_OP(fabsf(a.v[i]))
+#endif
+}
+
+inline VROFloat4 VROFloat4Sqrt(VROFloat4 a) {
+#if VRO_SIMD_NEON && defined(__aarch64__)
+    VROFloat4 r; r.v = vsqrtq_f32(a.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_sqrt_ps(a.v); return r;
+#else
+    float values[4];
+    a.store(values);
+    for (int i = 0; i < 4; i++) { values[i] = sqrtf(values[i]); }
+    return VROFloat4::load(values);
+#endif
+}
+
+/*
+ Lane-wise comparisons, returning masks.
+ */
+inline VROFloat4 VROFloat4Greater(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_cmpgt_ps(a.v, b.v); return r;
+#else
+    VROFloat4 r;
+    for (int i = 0; i < 4; i++) { r.v[i] = VROFloat4MaskFromBool(a.v[i] > b.v[i]).v[0]; }
+    return r;
+#endif
+}
+
+inline VROFloat4 VROFloat4GreaterEqual(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v)); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_cmpge_ps(a.v, b.v); return r;
+#else
+    VROFloat4 r;
+    for (int i = 0; i < 4; i++) { r.v[i] = VROFloat4MaskFromBool(a.v[i] >= b.v[i]).v[0]; }
+    return r;
+#endif
+}
+
+inline VROFloat4 VROFloat4LessEqual(VROFloat4 a, VROFloat4 b) {
+    return VROFloat4GreaterEqual(b, a);
+}
+
+inline VROFloat4 VROFloat4And(VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_and_ps(a.v, b.v); return r;
+#else
+    VROFloat4 r;
+    for (int i = 0; i < 4; i++) {
+        uint32_t x, y;
+        memcpy(&x, &a.v[i], 4); memcpy(&y, &b.v[i], 4);
+        x &= y;
+        memcpy(&r.v[i], &x, 4);
+    }
+    return r;
+#endif
+}
+
+/*
+ Lane-wise mask ? a : b.
+ */
+inline VROFloat4 VROFloat4Select(VROFloat4 mask, VROFloat4 a, VROFloat4 b) {
+#if VRO_SIMD_NEON
+    VROFloat4 r; r.v = vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v); return r;
+#elif VRO_SIMD_SSE
+    VROFloat4 r; r.v = _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)); return r;
+#else
+    VROFloat4 r;
+    int bits = mask.getMask();
+    for (int i = 0; i < 4; i++) { r.v[i] = (bits & (1 << i)) ? a.v[i] : b.v[i]; }
+    return r;
+#endif
+}
+
+/*
+ Sum of the four lanes.
+ */
+inline float VROFloat4HorizontalSum(VROFloat4 a) {
+#if VRO_SIMD_NEON && defined(__aarch64__)
+    return vaddvq_f32(a.v);
+#else
+    float values[4];
+    a.store(values);
+    return (values[0] + values[1]) + (values[2] + values[3]);
+#endif
+}
+
+/*
+ Convert a float to IEEE half precision bits, rounding to nearest even.
+ Overflow saturates to infinity; NaN is preserved.
+ */
+inline uint16_t VROFloatToHalf(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, 4);
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    if (magnitude >= 0x7F800000) {
+        return (uint16_t) (sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0));
+    }
+    if (magnitude >= 0x477FF000) {
+        return (uint16_t) (sign | 0x7C00);
+    }
+    if (magnitude < 0x38800000) {
+        // Subnormal or zero: shift the mantissa, with the implicit bit, into place
+        if (magnitude < 0x33000000) {
+            return (uint16_t) sign;
+        }
+        uint32_t exponent = magnitude >> 23;
+        uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+        uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t midpoint = 1u << (shift - 1);
+        if (remainder > midpoint || (remainder == midpoint && (half & 1))) {
+            half++;
+        }
+        return (uint16_t) (sign | half);
+    }
+    uint32_t half = (magnitude - 0x38000000) >> 13;
+    uint32_t remainder = magnitude & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        half++;
+    }
+    return (uint16_t) (sign | half);
+}
+
+/*
+ Store the four lanes as half precision floats.
+ */
+inline void VROFloat4StoreHalf(VROFloat4 a, uint16_t *p) {
+#if VRO_SIMD_NEON && defined(__aarch64__)
+    vst1_u16(p, vreinterpret_u16_f16(vcvt_f16_f32(a.v)));
+#else
+    float values[4];
+    a.store(values);
+    for (int i = 0; i < 4; i++) {
+        p[i] = VROFloatToHalf(values[i]);
+    }
+#endif
+}
+
+#endif /* VROSIMD_h */
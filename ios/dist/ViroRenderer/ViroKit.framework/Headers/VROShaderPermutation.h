@@ -0,0 +1,486 @@
+//
+//  VROShaderPermutation.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROShaderPermutation_h
+#define VROShaderPermutation_h
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <algorithm>
+#include <stdint.h>
+#include "VROShaderModifier.h"
+#include "VROLog.h"
+
+/*
+ Identifies one shader program permutation in 64 bits, packed from three
+ interned IDs:
+
+   bits 56-63  base shader (VROShaderModifierRegistry::internShader)
+   bits 32-55  vertex attribute mask (VROShaderMask)
+   bits  0-31  ordered modifier list (VROShaderModifierRegistry::createKey)
+
+ Each field is an ID the registry hands out for exactly one value, so two
+ keys are equal if and only if their permutations are: comparing keys is
+ one integer compare, with no hash collisions to check and nothing stored
+ beyond the 64 bits. The zero key identifies no permutation; base shader
+ IDs start at 1.
+ */
+class VROShaderPermutationKey {
+public:
+
+    static const uint32_t kMaxBaseShaders = 1 << 8;
+    static const uint32_t kMaxAttributes = 1 << 24;
+
+    VROShaderPermutationKey() : _key(0) {}
+    VROShaderPermutationKey(uint32_t baseShader, uint32_t attributes, uint32_t modifierList) {
+        passert (baseShader > 0 && baseShader < kMaxBaseShaders);
+        passert (attributes < kMaxAttributes);
+        _key = ((uint64_t) baseShader << 56) | ((uint64_t) attributes << 32) | modifierList;
+    }
+
+    uint64_t getKey() const { return _key; }
+    uint32_t getBaseShader() const { return (uint32_t) (_key >> 56); }
+    uint32_t getAttributes() const { return (uint32_t) (_key >> 32) & (kMaxAttributes - 1); }
+    uint32_t getModifierList() const { return (uint32_t) _key; }
+    bool isValid() const { return _key != 0; }
+
+    /*
+     The key's bits mixed for use as a hash table index, since the low bits
+     (the modifier list ID) are dense and the high bits rarely vary.
+     */
+    uint64_t getHash() const {
+        uint64_t h = _key;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    bool operator==(const VROShaderPermutationKey &other) const {
+        return _key == other._key;
+    }
+    bool operator!=(const VROShaderPermutationKey &other) const {
+        return _key != other._key;
+    }
+
+private:
+
+    uint64_t _key;
+
+};
+
+/*
+ Assigns small dense IDs to shader modifiers. Modifiers without uniform
+ binders are interned by content (entry point, attributes, uniform and body
+ source, and replacements), so that modifiers created separately with
+ identical code share permutations. Modifiers with binders keep IDs of
+ their own, since a program binds uniforms through its modifiers' binders.
+ Base shader names are interned the same way. Ordered lists of modifier
+ IDs are interned too, one list per distinct sequence, each extending the
+ list of its first n - 1 modifiers by one ID, so that interning a list of
+ n modifiers is n lookups of a 64-bit (parent list, modifier) pair.
+
+ A modifier's signature is built once and memoized by its
+ getShaderModifierId(), together with a fingerprint of the state its public
+ mutators change (attributes, uniform binders, and replacements). A
+ modifier changed after it was interned fails the fingerprint check and is
+ interned again, so it never keeps a permutation built for its old code or
+ shared with modifiers whose binders would not bind its uniforms.
+
+ Each intern() call, including one that hits the memoized ID, copies the
+ modifier's uniform names (getUniforms() returns them by value), hashes its
+ mutable state and takes the registry mutex; only a miss formats the
+ signature string. createKey() pays this once per modifier, plus one list
+ lookup per modifier. That is still well below building
+ VROShaderModifier::getShaderModifierKey() strings and looking them up in a
+ std::map (VROShaderPermutationTests benchmarks both resolving the linked
+ programs of 1,000 materials), but it is not allocation-free. Callers on hot paths
+ should build a material's key once and rebuild it only when its modifiers
+ change.
+
+ The registry holds each modifier weakly. Entries for destroyed modifiers
+ are pruned as the registry grows, along with the signatures of modifiers
+ with binders, which no other modifier can share, and the modifier lists
+ that contain them. Interned IDs are never reused, so a key built for a
+ destroyed modifier matches no later one. Thread-safe.
+ */
+class VROShaderModifierRegistry {
+public:
+
+    static VROShaderModifierRegistry &shared() {
+        static VROShaderModifierRegistry registry;
+        return registry;
+    }
+
+    uint32_t intern(const std::shared_ptr<VROShaderModifier> &modifierPtr) {
+        const VROShaderModifier &modifier = *modifierPtr;
+        std::vector<std::string> uniforms = modifier.getUniforms();
+        uint64_t fingerprint = getFingerprint(modifier, uniforms);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _byModifierId.find(modifier.getShaderModifierId());
+        if (it != _byModifierId.end() && it->second.fingerprint == fingerprint) {
+            return it->second.id;
+        }
+        if (it != _byModifierId.end()) {
+            releaseSignature(it->second);
+        }
+
+        std::string signature = std::to_string((int) modifier.getEntryPoint()) + "|" +
+                                std::to_string(modifier.getAttributes()) + "|" +
+                                modifier.getUniformsSource() + "|" + modifier.getBodySource();
+        for (auto &kv : modifier.getReplacements()) {
+            signature += "|" + kv.first + ">" + kv.second;
+        }
+        if (!uniforms.empty()) {
+            signature = "#" + std::to_string(modifier.getShaderModifierId()) + "|" + signature;
+            for (const std::string &uniform : uniforms) {
+                signature += "|" + uniform;
+            }
+        }
+        uint32_t id = internString(_bySignature, signature, &_nextModifierId);
+        InternedModifier &interned = _byModifierId[modifier.getShaderModifierId()];
+        interned.id = id;
+        interned.fingerprint = fingerprint;
+        interned.modifier = modifierPtr;
+        interned.signature = uniforms.empty() ? std::string() : signature;
+
+        if (_byModifierId.size() >= _pruneThreshold) {
+            prune();
+        }
+        return id;
+    }
+
+    uint32_t internShader(const std::string &name) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return internString(_byShaderName, name, &_nextShaderId);
+    }
+
+    /*
+     The number of modifiers currently interned, including destroyed
+     modifiers not yet pruned.
+     */
+    size_t getModifierCount() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _byModifierId.size();
+    }
+
+    /*
+     The number of distinct modifier lists currently interned.
+     */
+    size_t getModifierListCount() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _lists.size();
+    }
+
+    /*
+     Build the permutation key for a base shader with the given attributes
+     and modifiers.
+     */
+    VROShaderPermutationKey createKey(uint32_t baseShader, int attributes,
+                                      const std::vector<std::shared_ptr<VROShaderModifier>> &modifiers) {
+        uint32_t ids[16];
+        std::vector<uint32_t> moreIds;
+        uint32_t *modifierIds = ids;
+        if (modifiers.size() > 16) {
+            moreIds.resize(modifiers.size());
+            modifierIds = moreIds.data();
+        }
+        for (size_t i = 0; i < modifiers.size(); i++) {
+            modifierIds[i] = intern(modifiers[i]);
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint32_t list = 0;
+        for (size_t i = 0; i < modifiers.size(); i++) {
+            uint64_t link = ((uint64_t) list << 32) | modifierIds[i];
+            auto it = _lists.find(link);
+            if (it != _lists.end()) {
+                list = it->second;
+            } else {
+                list = _nextListId++;
+                _lists[link] = list;
+            }
+        }
+        return VROShaderPermutationKey(baseShader, (uint32_t) attributes, list);
+    }
+
+private:
+
+    static const size_t kMinPruneThreshold = 256;
+
+    struct InternedModifier {
+        uint32_t id;
+        uint64_t fingerprint;
+        std::weak_ptr<VROShaderModifier> modifier;
+
+        /*
+         The signature of a modifier with binders, which is unique to it and
+         released with it; empty for modifiers interned by content.
+         */
+        std::string signature;
+    };
+
+    std::mutex _mutex;
+    std::unordered_map<int, InternedModifier> _byModifierId;
+    std::unordered_map<std::string, uint32_t> _bySignature;
+    std::unordered_map<std::string, uint32_t> _byShaderName;
+    uint32_t _nextModifierId = 1;
+    uint32_t _nextShaderId = 1;
+
+    /*
+     Interned modifier lists: (parent list ID << 32 | modifier ID) to the
+     ID of the parent list extended by that modifier. The empty list is 0.
+     */
+    std::unordered_map<uint64_t, uint32_t> _lists;
+    uint32_t _nextListId = 1;
+
+    /*
+     _byModifierId is pruned when it reaches this size, which is then set to
+     twice the surviving count, so pruning costs amortized constant time per
+     intern.
+     */
+    size_t _pruneThreshold = kMinPruneThreshold;
+
+    void prune() {
+        for (auto it = _byModifierId.begin(); it != _byModifierId.end();) {
+            if (it->second.modifier.expired()) {
+                releaseSignature(it->second);
+                it = _byModifierId.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        _pruneThreshold = _byModifierId.size() * 2;
+        if (_pruneThreshold < kMinPruneThreshold) {
+            _pruneThreshold = kMinPruneThreshold;
+        }
+        pruneLists();
+    }
+
+    /*
+     Remove the lists that contain a modifier ID no longer interned. A
+     modifier's ID stays interned while its signature does: for modifiers
+     without binders, for good; for modifiers with binders, while they live.
+     Lists are visited in ID order, since a list's ID is always greater than
+     its parent's, so a list whose parent was removed is removed too.
+     */
+    void pruneLists() {
+        std::unordered_map<uint32_t, bool> interned;
+        for (auto &kv : _bySignature) {
+            interned[kv.second] = true;
+        }
+        std::vector<std::pair<uint32_t, uint64_t>> lists;
+        lists.reserve(_lists.size());
+        for (auto &kv : _lists) {
+            lists.push_back({ kv.second, kv.first });
+        }
+        std::sort(lists.begin(), lists.end());
+
+        std::unordered_map<uint32_t, bool> removed;
+        for (auto &list : lists) {
+            uint32_t parent = (uint32_t) (list.second >> 32);
+            uint32_t modifier = (uint32_t) list.second;
+            if (interned.count(modifier) == 0 || removed.count(parent) > 0) {
+                removed[list.first] = true;
+                _lists.erase(list.second);
+            }
+        }
+    }
+
+    void releaseSignature(const InternedModifier &interned) {
+        if (!interned.signature.empty()) {
+            _bySignature.erase(interned.signature);
+        }
+    }
+
+    /*
+     FNV-1a over the modifier state that can change after construction. The
+     entry point and sources are fixed at construction.
+     */
+    static uint64_t getFingerprint(const VROShaderModifier &modifier, const std::vector<std::string> &uniforms) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        auto add = [&hash](const void *data, size_t length) {
+            const uint8_t *bytes = (const uint8_t *) data;
+            for (size_t i = 0; i < length; i++) {
+                hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+            }
+        };
+        int attributes = modifier.getAttributes();
+        add(&attributes, sizeof(attributes));
+        for (const std::string &uniform : uniforms) {
+            add(uniform.data(), uniform.size() + 1);
+        }
+        add("|", 1);
+        for (auto &kv : modifier.getReplacements()) {
+            add(kv.first.data(), kv.first.size() + 1);
+            add(kv.second.data(), kv.second.size() + 1);
+        }
+        return hash;
+    }
+
+    static uint32_t internString(std::unordered_map<std::string, uint32_t> &table, const std::string &string,
+                                 uint32_t *nextId) {
+        auto it = table.find(string);
+        if (it != table.end()) {
+            return it->second;
+        }
+        uint32_t id = (*nextId)++;
+        table[string] = id;
+        return id;
+    }
+
+};
+
+/*
+ Open-addressing hash table from permutation keys to compiled programs (or
+ any other value), used in place of string-keyed maps on the material
+ substrate creation and rebind paths. Each slot holds the 64-bit key and
+ its value; lookups probe linearly from the key's hash and compare keys as
+ integers, with the load factor held at or below one half. Empty slots hold
+ the zero key.
+ */
+template <typename T>
+class VROShaderPermutationTable {
+public:
+
+    VROShaderPermutationTable(int capacity = 64) :
+        _size(0) {
+        int slots = 16;
+        while (slots < capacity * 2) {
+            slots *= 2;
+        }
+        _slots.resize(slots);
+    }
+
+    /*
+     Return a pointer to the value for the key, or nullptr if absent. The
+     pointer is invalidated by the next insertion.
+     */
+    T *find(const VROShaderPermutationKey &key) {
+        return const_cast<T *>(static_cast<const VROShaderPermutationTable *>(this)->find(key));
+    }
+    const T *find(const VROShaderPermutationKey &key) const {
+        size_t mask = _slots.size() - 1;
+        for (size_t i = key.getHash() & mask; ; i = (i + 1) & mask) {
+            const Slot &slot = _slots[i];
+            if (slot.key == key) {
+                return key.isValid() ? &slot.value : nullptr;
+            }
+            if (!slot.key.isValid()) {
+                return nullptr;
+            }
+        }
+    }
+
+    /*
+     Insert or replace the value for the key.
+     */
+    void insert(const VROShaderPermutationKey &key, T value) {
+        passert (key.isValid());
+        if ((_size + 1) * 2 > _slots.size()) {
+            grow();
+        }
+        size_t mask = _slots.size() - 1;
+        for (size_t i = key.getHash() & mask; ; i = (i + 1) & mask) {
+            Slot &slot = _slots[i];
+            if (!slot.key.isValid()) {
+                slot.key = key;
+                slot.value = std::move(value);
+                _size++;
+                return;
+            }
+            if (slot.key == key) {
+                slot.value = std::move(value);
+                return;
+            }
+        }
+    }
+
+    /*
+     Return the value for the key, creating it with the given function if
+     absent.
+     */
+    template <typename F>
+    T &getOrCreate(const VROShaderPermutationKey &key, F create) {
+        T *value = find(key);
+        if (!value) {
+            insert(key, create());
+            value = find(key);
+        }
+        return *value;
+    }
+
+    void clear() {
+        for (Slot &slot : _slots) {
+            slot = Slot();
+        }
+        _size = 0;
+    }
+
+    size_t size() const { return _size; }
+
+    /*
+     Invoke the function on every stored value.
+     */
+    template <typename F>
+    void forEach(F function) {
+        for (Slot &slot : _slots) {
+            if (slot.key.isValid()) {
+                function(slot.key, slot.value);
+            }
+        }
+    }
+
+private:
+
+    struct Slot {
+        VROShaderPermutationKey key;
+        T value = T();
+    };
+
+    std::vector<Slot> _slots;
+    size_t _size;
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(_slots);
+        _slots.resize(old.size() * 2);
+        _size = 0;
+        for (Slot &slot : old) {
+            if (slot.key.isValid()) {
+                insert(slot.key, std::move(slot.value));
+            }
+        }
+    }
+
+};
+
+#endif /* VROShaderPermutation_h */
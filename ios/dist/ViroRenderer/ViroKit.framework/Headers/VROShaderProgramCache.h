@@ -0,0 +1,603 @@
+//
+//  VROShaderProgramCache.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROShaderProgramCache_h
+#define VROShaderProgramCache_h
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdint.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "VROOpenGL.h"
+#include "VROShaderProgram.h"
+#include "VROTime.h"
+#include "VROLog.h"
+
+/*
+ Everything that determines a linked program: its final GLSL sources, the
+ key of the shader modifiers that produced them (see
+ VROShaderModifier::getShaderModifierKey), and its attribute bindings.
+ */
+struct VROShaderProgramSource {
+    std::string name;
+    std::string vertexSource;
+    std::string fragmentSource;
+    std::string modifierKey;
+
+    /*
+     Attribute locations bound before the program is linked. These are part
+     of the cache key, since they change the linked program.
+     */
+    std::vector<std::pair<std::string, GLuint>> attributeLocations;
+};
+
+/*
+ Timing for the first acquisition of one program permutation.
+ */
+struct VROShaderCompileRecord {
+    uint64_t key = 0;
+    std::string name;
+    bool failed = false;
+    double compileMs = 0;         // Vertex plus fragment shader compilation
+    double linkMs = 0;
+};
+
+/*
+ Cache of linked GL programs for the programs the framework's headers
+ build themselves (such as VROMipChainBloom's), keyed by a 64-bit hash of
+ the sources, the modifier key and the attribute bindings (see getKey()).
+ Each permutation is compiled and linked once per context.
+
+ The cache stores no program binaries. iOS OpenGL ES reports
+ GL_NUM_PROGRAM_BINARY_FORMATS as 0, so glProgramBinary has nothing to
+ load there, and every launch compiles every program it uses. What carries
+ over between launches is the list of programs: the source of each program
+ the cache links is stored under the cache directory, and
+ enqueueStoredWarmUp() queues all of them, so a second launch compiles its
+ permutations while loading instead of on first draw.
+
+ Permutations a scene will need can be queued with enqueueWarmUp() and
+ compiled ahead of their first draw, either with warmUp() under a time
+ budget each loading frame on the rendering thread, or with warmUpAll() on
+ a background thread whose current context shares objects with the
+ renderer's.
+
+ The renderer's own programs do not go through this cache: VROShaderProgram
+ compiles and links inside the prebuilt hydrate(), which does not consult
+ it. Its permutations can still be queued with enqueueWarmUp(); warmUp()
+ hydrates them on the rendering thread within the same budget and records
+ their timing alongside the cache's own, but their sources are not stored
+ for the next launch.
+
+ The cache owns the programs it returns. Programs that fail to compile or
+ link are not cached, so a later call retries them. All methods except
+ the constructor require a current GL context; the cache is thread-safe.
+ */
+class VROShaderProgramCache {
+public:
+
+    VROShaderProgramCache(std::string directory) :
+        _directory(directory) {
+        mkdir(_directory.c_str(), 0755);
+    }
+    virtual ~VROShaderProgramCache() {}
+
+    /*
+     Compute the cache key of the given program source.
+     */
+    static uint64_t getKey(const VROShaderProgramSource &source) {
+        uint64_t hash = kFNVOffset;
+        hash = hashString(source.vertexSource, hash);
+        hash = hashString(source.fragmentSource, hash);
+        hash = hashString(source.modifierKey, hash);
+        for (const auto &attribute : source.attributeLocations) {
+            hash = hashString(attribute.first, hash);
+            hash = hashUInt(attribute.second, hash);
+        }
+        return hash;
+    }
+
+    /*
+     Return the linked program for the given source, compiling it if
+     needed. Returns 0 if the program failed to compile or link; the
+     failure is recorded but not cached.
+     */
+    GLuint getProgram(const VROShaderProgramSource &source) {
+        uint64_t key = getKey(source);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _programs.find(key);
+            if (it != _programs.end()) {
+                return it->second;
+            }
+        }
+
+        VROShaderCompileRecord record;
+        record.key = key;
+        record.name = source.name;
+
+        GLuint program = compileAndLink(source, &record);
+        if (program != 0) {
+            storeSource(key, source);
+        } else {
+            remove(getPath(key).c_str());
+        }
+        if (program != 0) {
+            // Make the program visible to other contexts in the share group
+            GL( glFlush() );
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        addRecord(record);
+        if (program == 0) {
+            return 0;
+        }
+        auto it = _programs.find(key);
+        if (it != _programs.end()) {
+            // Another thread got here first
+            GL( glDeleteProgram(program) );
+            return it->second;
+        }
+        _programs[key] = program;
+        return program;
+    }
+
+    bool hasProgram(const VROShaderProgramSource &source) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _programs.find(getKey(source)) != _programs.end();
+    }
+
+#pragma mark - Warm-up
+
+    /*
+     Queue permutations to be compiled before they are first drawn.
+     */
+    void enqueueWarmUp(const std::vector<VROShaderProgramSource> &sources) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _warmUpQueue.insert(_warmUpQueue.end(), sources.begin(), sources.end());
+    }
+
+    /*
+     Queue VROShaderProgram permutations to be hydrated before they are
+     first drawn. Only warmUp() hydrates these, since VROShaderProgram must
+     be hydrated on the rendering thread.
+     */
+    void enqueueWarmUp(const std::vector<std::shared_ptr<VROShaderProgram>> &shaders) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _shaderWarmUpQueue.insert(_shaderWarmUpQueue.end(), shaders.begin(), shaders.end());
+    }
+
+    /*
+     Queue every program whose source an earlier run stored under the cache
+     directory. Returns the number of programs queued.
+     */
+    int enqueueStoredWarmUp() {
+        std::vector<VROShaderProgramSource> sources;
+        DIR *directory = opendir(_directory.c_str());
+        if (!directory) {
+            return 0;
+        }
+        while (struct dirent *entry = readdir(directory)) {
+            std::string name = entry->d_name;
+            if (name.size() != 20 || name.compare(16, 4, ".src") != 0) {
+                continue;
+            }
+            VROShaderProgramSource source;
+            std::string path = _directory + "/" + name;
+            if (loadSource(path, &source)) {
+                sources.push_back(std::move(source));
+            } else {
+                remove(path.c_str());
+            }
+        }
+        closedir(directory);
+
+        enqueueWarmUp(sources);
+        return (int) sources.size();
+    }
+
+    /*
+     Acquire queued programs, then hydrate queued VROShaderPrograms, until
+     budgetMs has elapsed. Intended to be called once per frame on the
+     rendering thread while a scene loads. Returns the number of programs
+     and shaders still queued.
+     */
+    int warmUp(double budgetMs) {
+        double start = VROTimeCurrentMillis();
+        while (VROTimeCurrentMillis() - start < budgetMs) {
+            VROShaderProgramSource source;
+            if (popWarmUp(&source)) {
+                getProgram(source);
+                continue;
+            }
+            std::shared_ptr<VROShaderProgram> shader = popShaderWarmUp();
+            if (!shader) {
+                break;
+            }
+            if (!shader->isHydrated()) {
+                hydrate(shader);
+            }
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        return (int) (_warmUpQueue.size() + _shaderWarmUpQueue.size());
+    }
+
+    /*
+     Acquire every queued program. Intended for a background thread with a
+     current context shared with the renderer's. Queued VROShaderPrograms
+     are left for warmUp().
+     */
+    void warmUpAll() {
+        VROShaderProgramSource source;
+        while (popWarmUp(&source)) {
+            getProgram(source);
+        }
+        GL( glFinish() );
+    }
+
+#pragma mark - Lifecycle
+
+    /*
+     Delete every program. With lostContext, the GL objects are assumed
+     gone with their context and are only forgotten.
+     */
+    void evict(bool lostContext) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!lostContext) {
+            for (auto &kv : _programs) {
+                if (kv.second != 0) {
+                    GL( glDeleteProgram(kv.second) );
+                }
+            }
+        }
+        _programs.clear();
+    }
+
+    /*
+     Compile and link times of the most recent kMaxRecords permutations
+     acquired, oldest first.
+     */
+    std::vector<VROShaderCompileRecord> getRecords() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return std::vector<VROShaderCompileRecord>(_records.begin(), _records.end());
+    }
+
+    /*
+     Totals over every permutation acquired, including records that have
+     since been dropped from getRecords().
+     */
+    std::string getSummary() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        char summary[256];
+        snprintf(summary, sizeof(summary),
+                 "%d programs compiled (%.1f ms compile, %.1f ms link), %d failed",
+                 _totals.compiled, _totals.compileMs, _totals.linkMs, _totals.failed);
+        return summary;
+    }
+
+    static const int kMaxRecords = 256;
+
+private:
+
+    static const uint64_t kFNVOffset = 0xcbf29ce484222325ULL;
+    static const uint64_t kFNVPrime = 0x100000001b3ULL;
+    static const uint32_t kSourceMagic = 0x43524f56; // 'VROC'
+    static const uint32_t kSourceVersion = 1;
+
+    std::string _directory;
+    std::mutex _mutex;
+    std::map<uint64_t, GLuint> _programs;
+    std::deque<VROShaderProgramSource> _warmUpQueue;
+    std::deque<std::shared_ptr<VROShaderProgram>> _shaderWarmUpQueue;
+
+    /*
+     The most recent kMaxRecords records, and running totals over all of
+     them for getSummary().
+     */
+    std::deque<VROShaderCompileRecord> _records;
+    struct {
+        int compiled = 0, failed = 0;
+        double compileMs = 0, linkMs = 0;
+    } _totals;
+
+    static uint64_t hashString(const std::string &string, uint64_t hash) {
+        for (char c : string) {
+            hash ^= (uint8_t) c;
+            hash *= kFNVPrime;
+        }
+        // Terminate each string so that concatenations don't collide
+        hash ^= 0xff;
+        hash *= kFNVPrime;
+        return hash;
+    }
+
+    static uint64_t hashUInt(uint32_t value, uint64_t hash) {
+        for (int i = 0; i < 4; i++) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= kFNVPrime;
+        }
+        return hash;
+    }
+
+    bool popWarmUp(VROShaderProgramSource *source) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_warmUpQueue.empty()) {
+            return false;
+        }
+        *source = std::move(_warmUpQueue.front());
+        _warmUpQueue.pop_front();
+        return true;
+    }
+
+    std::shared_ptr<VROShaderProgram> popShaderWarmUp() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_shaderWarmUpQueue.empty()) {
+            return nullptr;
+        }
+        std::shared_ptr<VROShaderProgram> shader = _shaderWarmUpQueue.front();
+        _shaderWarmUpQueue.pop_front();
+        return shader;
+    }
+
+    void hydrate(const std::shared_ptr<VROShaderProgram> &shader) {
+        VROShaderCompileRecord record;
+        record.key = shader->getShaderId();
+        record.name = shader->getName();
+
+        // hydrate() compiles and links in one call, so its time is all
+        // counted as compile time
+        double start = VROTimeCurrentMillis();
+        record.failed = !shader->hydrate();
+        record.compileMs = VROTimeCurrentMillis() - start;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        addRecord(record);
+    }
+
+    void addRecord(const VROShaderCompileRecord &record) {
+        if (record.failed) {
+            _totals.failed++;
+        } else {
+            _totals.compiled++;
+        }
+        _totals.compileMs += record.compileMs;
+        _totals.linkMs += record.linkMs;
+
+        _records.push_back(record);
+        if (_records.size() > kMaxRecords) {
+            _records.pop_front();
+        }
+    }
+
+    std::string getPath(uint64_t key) const {
+        char name[32];
+        snprintf(name, sizeof(name), "/%016llx.src", (unsigned long long) key);
+        return _directory + name;
+    }
+
+    /*
+     Write the file at path through a temporary file and rename, so readers
+     never see a partial file. The temporary name is unique to this write,
+     since two threads (or processes) that miss on the same key may store it
+     concurrently.
+     */
+    static bool writeFile(const std::string &path, const void *header, size_t headerLength,
+                          const void *payload, size_t payloadLength) {
+        static std::atomic<uint32_t> sWriteCounter(0);
+        char suffix[48];
+        snprintf(suffix, sizeof(suffix), ".%d.%u.tmp", (int) getpid(), (unsigned) sWriteCounter.fetch_add(1));
+        std::string temporaryPath = path + suffix;
+        FILE *file = fopen(temporaryPath.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        bool success = fwrite(header, headerLength, 1, file) == 1 &&
+                       fwrite(payload, 1, payloadLength, file) == payloadLength;
+        success &= fclose(file) == 0;
+        if (!success || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            remove(temporaryPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     Sources are stored as a header followed by length-prefixed strings: the
+     name, the vertex, fragment and modifier sources, then each attribute
+     name and location.
+     */
+    struct SourceHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t attributeCount;
+        uint32_t length;
+    };
+
+    static void appendString(const std::string &string, std::vector<uint8_t> *payload) {
+        uint32_t length = (uint32_t) string.size();
+        const uint8_t *bytes = (const uint8_t *) &length;
+        payload->insert(payload->end(), bytes, bytes + sizeof(length));
+        payload->insert(payload->end(), string.begin(), string.end());
+    }
+
+    static bool readString(const std::vector<uint8_t> &payload, size_t *offset, std::string *string) {
+        uint32_t length;
+        if (payload.size() - *offset < sizeof(length)) {
+            return false;
+        }
+        memcpy(&length, &payload[*offset], sizeof(length));
+        *offset += sizeof(length);
+        if (payload.size() - *offset < length) {
+            return false;
+        }
+        string->assign((const char *) &payload[*offset], length);
+        *offset += length;
+        return true;
+    }
+
+    void storeSource(uint64_t key, const VROShaderProgramSource &source) {
+        std::vector<uint8_t> payload;
+        appendString(source.name, &payload);
+        appendString(source.vertexSource, &payload);
+        appendString(source.fragmentSource, &payload);
+        appendString(source.modifierKey, &payload);
+        for (const auto &attribute : source.attributeLocations) {
+            appendString(attribute.first, &payload);
+            const uint8_t *bytes = (const uint8_t *) &attribute.second;
+            payload.insert(payload.end(), bytes, bytes + sizeof(GLuint));
+        }
+
+        SourceHeader header;
+        header.magic = kSourceMagic;
+        header.version = kSourceVersion;
+        header.key = key;
+        header.attributeCount = (uint32_t) source.attributeLocations.size();
+        header.length = (uint32_t) payload.size();
+        writeFile(getPath(key), &header, sizeof(header), payload.data(), payload.size());
+    }
+
+    /*
+     Read a stored source. Returns false if the file is truncated, corrupt,
+     or does not hash to the key it was stored under.
+     */
+    static bool loadSource(const std::string &path, VROShaderProgramSource *source) {
+        FILE *file = fopen(path.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+        long fileSize = -1;
+        if (fseek(file, 0, SEEK_END) == 0) {
+            fileSize = ftell(file);
+            fseek(file, 0, SEEK_SET);
+        }
+        SourceHeader header;
+        std::vector<uint8_t> payload;
+        bool valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                     header.magic == kSourceMagic && header.version == kSourceVersion &&
+                     fileSize >= (long) sizeof(header) &&
+                     (uint64_t) header.length == (uint64_t) fileSize - sizeof(header);
+        if (valid) {
+            payload.resize(header.length);
+            valid = fread(payload.data(), 1, payload.size(), file) == payload.size();
+        }
+        fclose(file);
+
+        size_t offset = 0;
+        valid = valid &&
+                readString(payload, &offset, &source->name) &&
+                readString(payload, &offset, &source->vertexSource) &&
+                readString(payload, &offset, &source->fragmentSource) &&
+                readString(payload, &offset, &source->modifierKey);
+        for (uint32_t i = 0; valid && i < header.attributeCount; i++) {
+            std::string name;
+            GLuint location;
+            valid = readString(payload, &offset, &name) && payload.size() - offset >= sizeof(location);
+            if (valid) {
+                memcpy(&location, &payload[offset], sizeof(location));
+                offset += sizeof(location);
+                source->attributeLocations.push_back({ name, location });
+            }
+        }
+        return valid && offset == payload.size() && getKey(*source) == header.key;
+    }
+
+    GLuint compileAndLink(const VROShaderProgramSource &source, VROShaderCompileRecord *record) {
+        double start = VROTimeCurrentMillis();
+        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, source.vertexSource, source.name);
+        GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, source.fragmentSource, source.name);
+        record->compileMs = VROTimeCurrentMillis() - start;
+
+        if (vertexShader == 0 || fragmentShader == 0) {
+            if (vertexShader) {
+                GL( glDeleteShader(vertexShader) );
+            }
+            if (fragmentShader) {
+                GL( glDeleteShader(fragmentShader) );
+            }
+            record->failed = true;
+            return 0;
+        }
+
+        start = VROTimeCurrentMillis();
+        GLuint program = glCreateProgram();
+        GL( glAttachShader(program, vertexShader) );
+        GL( glAttachShader(program, fragmentShader) );
+        for (const auto &attribute : source.attributeLocations) {
+            GL( glBindAttribLocation(program, attribute.second, attribute.first.c_str()) );
+        }
+        GL( glLinkProgram(program) );
+
+        GLint status = GL_FALSE;
+        GL( glGetProgramiv(program, GL_LINK_STATUS, &status) );
+        GL( glDetachShader(program, vertexShader) );
+        GL( glDetachShader(program, fragmentShader) );
+        GL( glDeleteShader(vertexShader) );
+        GL( glDeleteShader(fragmentShader) );
+        record->linkMs = VROTimeCurrentMillis() - start;
+
+        if (status != GL_TRUE) {
+            GLchar log[1024];
+            GL( glGetProgramInfoLog(program, sizeof(log), nullptr, log) );
+            pinfo("Failed to link shader %s: %s", source.name.c_str(), log);
+            GL( glDeleteProgram(program) );
+            record->failed = true;
+            return 0;
+        }
+        return program;
+    }
+
+    GLuint compileShader(GLenum type, const std::string &code, const std::string &name) {
+        GLuint shader = glCreateShader(type);
+        const GLchar *sources[] = { code.c_str() };
+        GL( glShaderSource(shader, 1, sources, nullptr) );
+        GL( glCompileShader(shader) );
+
+        GLint status = GL_FALSE;
+        GL( glGetShaderiv(shader, GL_COMPILE_STATUS, &status) );
+        if (status != GL_TRUE) {
+            GLchar log[1024];
+            GL( glGetShaderInfoLog(shader, sizeof(log), nullptr, log) );
+            pinfo("Failed to compile %s shader %s: %s", type == GL_VERTEX_SHADER ? "vertex" : "fragment",
+                  name.c_str(), log);
+            GL( glDeleteShader(shader) );
+            return 0;
+        }
+        return shader;
+    }
+
+};
+
+#endif /* VROShaderProgramCache_h */
@@ -0,0 +1,441 @@
+//
+//  VROShadowAtlas.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROShadowAtlas_h
+#define VROShadowAtlas_h
+
+#include <memory>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdint.h>
+#include "VROLight.h"
+#include "VROFrustum.h"
+#include "VROBoundingBox.h"
+#include "VROMatrix4f.h"
+#include "VROOpenGL.h"
+#include "VROTime.h"
+
+/*
+ An object that may cast shadows, as submitted to the atlas each frame.
+ Static casters are expected not to move; when one does, its version must
+ change so that the cached depth of every light it affects is rebuilt.
+ */
+struct VROShadowCaster {
+    uint32_t id;                  // Stable identifier, e.g. the node's unique ID
+    VROBoundingBox bounds;        // World-space bounds
+    bool isStatic;
+    uint32_t version;             // Changes whenever a static caster moves or changes shape
+    int shadowCastingBitMask;     // Matched against each light's influence bit mask
+};
+
+/*
+ Pixel rectangle of one light's tile within the atlas, and the same
+ rectangle in normalized texture coordinates for the lighting shader.
+ */
+struct VROShadowTile {
+    int x = 0, y = 0, size = 0;
+    float u = 0, v = 0, scale = 0;
+};
+
+/*
+ What to render for one light this frame. On a static cache miss, the
+ light's static cache tile is cleared and staticDraws are rendered into it;
+ on a hit it is reused as is. The tile is then copied into the atlas, and
+ dynamicDraws are rendered on top.
+ */
+struct VROShadowLightPlan {
+    const VROLight *light;
+    VROShadowTile tile;
+    bool staticCacheHit;
+    std::vector<uint32_t> staticDraws;
+    std::vector<uint32_t> dynamicDraws;
+};
+
+struct VROShadowAtlasStats {
+    int lights = 0;
+    int tilesDownscaled = 0;      // Tiles smaller than requested because the atlas was full
+    int lightsDropped = 0;        // Lights with no tile, even at the minimum tile size
+    int staticCacheHits = 0;      // Lights whose static depth was reused
+    int staticDraws = 0;          // Static casters rendered into the cache
+    int staticDrawsSaved = 0;     // Static casters not rendered thanks to the cache
+    int dynamicDraws = 0;
+    int culledCasters = 0;        // Caster-light pairs rejected by the light frustum
+    double planTimeMs = 0;        // CPU time culling and planning
+    double renderTimeMs = 0;      // CPU time in VROShadowAtlas::render()
+
+    int getTotalDraws() const { return staticDraws + dynamicDraws; }
+
+    std::string toString() const {
+        std::stringstream ss;
+        ss << lights << " lights (" << tilesDownscaled << " downscaled, " << lightsDropped << " dropped), "
+           << getTotalDraws() << " shadow draws (" << staticDraws << " static, "
+           << dynamicDraws << " dynamic), " << staticDrawsSaved << " static draws saved by "
+           << staticCacheHits << " cache hits, " << culledCasters << " culled, plan " << planTimeMs
+           << " ms, render " << renderTimeMs << " ms";
+        return ss.str();
+    }
+};
+
+/*
+ The GL textures behind a VROShadowAtlas: the atlas depth texture sampled
+ by the lighting shaders, and a static cache with the same layout. Each
+ light's static casters are rendered into the cache only when its plan
+ misses; the cached tile is then blitted into the atlas before the dynamic
+ casters are drawn. Must be used on the rendering thread.
+ */
+class VROShadowAtlasTargets {
+public:
+
+    VROShadowAtlasTargets(int size) :
+        _size(size) {
+        GL( glGenTextures(2, _textures) );
+        GL( glGenFramebuffers(2, _framebuffers) );
+        for (int i = 0; i < 2; i++) {
+            GL( glBindTexture(GL_TEXTURE_2D, _textures[i]) );
+            GL( glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, size, size) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE) );
+            GL( glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL) );
+            GL( glBindFramebuffer(GL_FRAMEBUFFER, _framebuffers[i]) );
+            GL( glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _textures[i], 0) );
+        }
+    }
+    virtual ~VROShadowAtlasTargets() {
+        GL( glDeleteFramebuffers(2, _framebuffers) );
+        GL( glDeleteTextures(2, _textures) );
+    }
+
+    GLuint getAtlasTexture() const { return _textures[kAtlas]; }
+
+    /*
+     Bind the static cache and clear the tile, to render a light's static
+     casters.
+     */
+    void beginStatic(const VROShadowTile &tile) {
+        bindTile(kStatic, tile);
+    }
+
+    /*
+     Copy the light's static depth into the atlas, then leave the atlas tile
+     bound to render the dynamic casters.
+     */
+    void beginDynamic(const VROShadowTile &tile) {
+        GL( glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffers[kStatic]) );
+        GL( glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _framebuffers[kAtlas]) );
+        int x1 = tile.x + tile.size, y1 = tile.y + tile.size;
+        GL( glBlitFramebuffer(tile.x, tile.y, x1, y1, tile.x, tile.y, x1, y1, GL_DEPTH_BUFFER_BIT, GL_NEAREST) );
+        GL( glBindFramebuffer(GL_FRAMEBUFFER, _framebuffers[kAtlas]) );
+        GL( glViewport(tile.x, tile.y, tile.size, tile.size) );
+    }
+
+private:
+
+    static const int kAtlas = 0;
+    static const int kStatic = 1;
+
+    int _size;
+    GLuint _textures[2];
+    GLuint _framebuffers[2];
+
+    void bindTile(int target, const VROShadowTile &tile) {
+        GL( glBindFramebuffer(GL_FRAMEBUFFER, _framebuffers[target]) );
+        GL( glViewport(tile.x, tile.y, tile.size, tile.size) );
+        GL( glEnable(GL_SCISSOR_TEST) );
+        GL( glScissor(tile.x, tile.y, tile.size, tile.size) );
+        GL( glDepthMask(GL_TRUE) );
+        GL( glClear(GL_DEPTH_BUFFER_BIT) );
+        GL( glDisable(GL_SCISSOR_TEST) );
+    }
+
+};
+
+/*
+ Packs every shadow-casting light into tiles of one depth texture, and
+ plans each frame's shadow rendering so that static casters are drawn only
+ when their light or the static casters it sees change.
+
+ Tiles are allocated with a quadtree (buddy) allocator from the lights'
+ requested shadow map sizes, largest first. If the requests add up to more
+ than the atlas, the largest are halved until they fit; lights are only
+ dropped once every tile is at the minimum size. Each light's casters are
+ culled against the light's VROFrustum. For the static casters that pass,
+ a signature of their IDs and versions, together with the light's view and
+ projection, determines whether the cached static depth is still valid.
+ Tiles and caches are keyed by light ID, so a light allocated where a
+ destroyed one lived never inherits its cached depth.
+
+ plan() is independent of GL; render() executes the plan on a
+ VROShadowAtlasTargets and times it.
+ */
+class VROShadowAtlas {
+public:
+
+    VROShadowAtlas(int atlasSize = 4096, int minTileSize = 128) :
+        _atlasSize(atlasSize), _minTileSize(minTileSize) {}
+    virtual ~VROShadowAtlas() {}
+
+    int getAtlasSize() const { return _atlasSize; }
+
+    /*
+     Plan this frame's shadow passes for the given lights and casters.
+     Lights that do not cast shadows are ignored. Returns one plan per
+     shadow-casting light, in the order given.
+     */
+    const std::vector<VROShadowLightPlan> &plan(const std::vector<std::shared_ptr<VROLight>> &lights,
+                                                const std::vector<VROShadowCaster> &casters) {
+        double start = VROTimeCurrentMillis();
+        _stats = VROShadowAtlasStats();
+        _plans.clear();
+
+        std::vector<const VROLight *> shadowLights;
+        for (const std::shared_ptr<VROLight> &light : lights) {
+            if (light->getCastsShadow()) {
+                shadowLights.push_back(light.get());
+            }
+        }
+        allocateTiles(shadowLights);
+
+        std::map<uint32_t, LightCache> caches;
+        for (const VROLight *light : shadowLights) {
+            VROShadowLightPlan plan;
+            plan.light = light;
+            plan.tile = _tiles[light->getLightId()];
+            plan.staticCacheHit = false;
+            if (plan.tile.size == 0) {
+                continue;
+            }
+
+            VROMatrix4f view = light->getShadowViewMatrix();
+            VROMatrix4f projection = light->getShadowProjectionMatrix();
+            VROFrustum frustum;
+            frustum.fitToModelView(view.getArray(), projection.getArray(), 0, 0, 0);
+
+            uint64_t signature = kFNVOffset;
+            signature = hashBytes(view.getArray(), sizeof(float) * 16, signature);
+            signature = hashBytes(projection.getArray(), sizeof(float) * 16, signature);
+            signature = hashBytes(&plan.tile, sizeof(int) * 3, signature);
+
+            for (const VROShadowCaster &caster : casters) {
+                if ((caster.shadowCastingBitMask & light->getInfluenceBitMask()) == 0) {
+                    continue;
+                }
+                if (frustum.intersectWithFarPointsOpt(caster.bounds) == VROFrustumResult::Outside) {
+                    _stats.culledCasters++;
+                    continue;
+                }
+                if (caster.isStatic) {
+                    plan.staticDraws.push_back(caster.id);
+                    signature = hashBytes(&caster.id, sizeof(caster.id), signature);
+                    signature = hashBytes(&caster.version, sizeof(caster.version), signature);
+                } else {
+                    plan.dynamicDraws.push_back(caster.id);
+                }
+            }
+
+            LightCache &cache = caches[light->getLightId()];
+            auto previous = _caches.find(light->getLightId());
+            if (previous != _caches.end() && previous->second.valid && previous->second.signature == signature) {
+                plan.staticCacheHit = true;
+                _stats.staticCacheHits++;
+                _stats.staticDrawsSaved += (int) plan.staticDraws.size();
+                plan.staticDraws.clear();
+            } else {
+                _stats.staticDraws += (int) plan.staticDraws.size();
+            }
+            cache.signature = signature;
+            cache.valid = true;
+
+            _stats.dynamicDraws += (int) plan.dynamicDraws.size();
+            _plans.push_back(std::move(plan));
+        }
+
+        // Lights that no longer cast shadows are dropped from the cache
+        _caches.swap(caches);
+        _stats.lights = (int) _plans.size();
+        _stats.planTimeMs = VROTimeCurrentMillis() - start;
+        return _plans;
+    }
+
+    /*
+     Discard every light's cached static depth (e.g. after the atlas
+     textures are recreated or the context is lost).
+     */
+    void invalidate() {
+        _caches.clear();
+    }
+
+    /*
+     Execute this frame's plan on the given targets. For each light, draw is
+     invoked with the light's plan and the IDs of the casters to render into
+     the bound tile: its static casters on a cache miss, then its dynamic
+     casters. The CPU time spent, including draw, is reported in
+     getStats().renderTimeMs.
+     */
+    template <typename F>
+    void render(VROShadowAtlasTargets *targets, F draw) {
+        double start = VROTimeCurrentMillis();
+        for (const VROShadowLightPlan &plan : _plans) {
+            if (!plan.staticCacheHit) {
+                targets->beginStatic(plan.tile);
+                draw(plan, plan.staticDraws);
+            }
+            targets->beginDynamic(plan.tile);
+            draw(plan, plan.dynamicDraws);
+        }
+        _stats.renderTimeMs = VROTimeCurrentMillis() - start;
+    }
+
+    const std::vector<VROShadowLightPlan> &getPlans() const { return _plans; }
+    const VROShadowAtlasStats &getStats() const { return _stats; }
+
+private:
+
+    static const uint64_t kFNVOffset = 0xcbf29ce484222325ULL;
+    static const uint64_t kFNVPrime = 0x100000001b3ULL;
+
+    struct LightCache {
+        uint64_t signature = 0;
+        bool valid = false;
+    };
+
+    int _atlasSize;
+    int _minTileSize;
+    std::map<uint32_t, VROShadowTile> _tiles;
+    std::map<uint32_t, LightCache> _caches;
+    std::vector<VROShadowLightPlan> _plans;
+    VROShadowAtlasStats _stats;
+
+    static uint64_t hashBytes(const void *data, size_t length, uint64_t hash) {
+        const uint8_t *bytes = (const uint8_t *) data;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= bytes[i];
+            hash *= kFNVPrime;
+        }
+        return hash;
+    }
+
+    int getRequestedSize(const VROLight *light) const {
+        int requested = std::max(_minTileSize, std::min(light->getShadowMapSize(), _atlasSize));
+        int size = _minTileSize;
+        while (size * 2 <= requested) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    /*
+     Assign each light a square power-of-two tile. Free space is a list of
+     free quadtree nodes; a request takes the smallest free node that fits,
+     splitting it into quadrants as needed. Power-of-two squares placed
+     largest first always fit while their total area is within the atlas,
+     so requests are halved, largest first, until they are.
+     */
+    void allocateTiles(const std::vector<const VROLight *> &lights) {
+        std::vector<std::pair<int, const VROLight *>> requests;
+        int64_t area = 0;
+        for (const VROLight *light : lights) {
+            int size = getRequestedSize(light);
+            requests.push_back({ size, light });
+            area += (int64_t) size * size;
+        }
+
+        std::vector<bool> downscaled(requests.size(), false);
+        while (area > (int64_t) _atlasSize * _atlasSize) {
+            // Halve the largest request, the last one given among equals
+            int largest = -1;
+            for (int i = 0; i < (int) requests.size(); i++) {
+                if (requests[i].first > _minTileSize && (largest < 0 || requests[i].first >= requests[largest].first)) {
+                    largest = i;
+                }
+            }
+            if (largest < 0) {
+                break;
+            }
+            int size = requests[largest].first;
+            area -= (int64_t) size * size - (int64_t) (size / 2) * (size / 2);
+            requests[largest].first = size / 2;
+            downscaled[largest] = true;
+        }
+        for (int i = 0; i < (int) requests.size(); i++) {
+            if (downscaled[i]) {
+                _stats.tilesDownscaled++;
+            }
+        }
+        std::stable_sort(requests.begin(), requests.end(),
+                         [](const std::pair<int, const VROLight *> &a, const std::pair<int, const VROLight *> &b) {
+                             return a.first > b.first;
+                         });
+
+        // Free nodes as (x, y, size)
+        std::vector<VROShadowTile> free;
+        VROShadowTile root;
+        root.size = _atlasSize;
+        free.push_back(root);
+
+        _tiles.clear();
+        for (auto &request : requests) {
+            int size = request.first;
+            uint32_t lightId = request.second->getLightId();
+            int best = -1;
+            for (int i = 0; i < (int) free.size(); i++) {
+                if (free[i].size >= size && (best < 0 || free[i].size < free[best].size)) {
+                    best = i;
+                }
+            }
+            if (best < 0) {
+                pinfo("Shadow atlas full, light dropped");
+                _tiles[lightId] = VROShadowTile();
+                _stats.lightsDropped++;
+                continue;
+            }
+
+            VROShadowTile node = free[best];
+            free.erase(free.begin() + best);
+            while (node.size > size) {
+                int half = node.size / 2;
+                VROShadowTile quadrant;
+                quadrant.size = half;
+                const int offsets[3][2] = { { half, 0 }, { 0, half }, { half, half } };
+                for (const int *offset : offsets) {
+                    quadrant.x = node.x + offset[0];
+                    quadrant.y = node.y + offset[1];
+                    free.push_back(quadrant);
+                }
+                node.size = half;
+            }
+            node.u = (float) node.x / _atlasSize;
+            node.v = (float) node.y / _atlasSize;
+            node.scale = (float) node.size / _atlasSize;
+            _tiles[lightId] = node;
+        }
+    }
+
+};
+
+#endif /* VROShadowAtlas_h */
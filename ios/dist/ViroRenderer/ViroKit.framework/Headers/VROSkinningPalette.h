@@ -0,0 +1,420 @@
+//
+//  VROSkinningPalette.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROSkinningPalette_h
+#define VROSkinningPalette_h
+
+#include <memory>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "VROMatrix4f.h"
+#include "VROThreadPool.h"
+
+/*
+ Every palette entry is 12 floats, whichever format is used.
+ */
+static const int kSkinningPaletteFloatsPerBone = 12;
+
+enum class VROSkinningPaletteFormat {
+    Matrix,          // The top three rows of each bone matrix, row-major
+    DualQuaternion,  // Real part (xyzw), dual part (xyzw), then scale (xyz, 0),
+                     // applied before the rigid transform
+};
+
+/*
+ Local transform of a bone relative to its parent, as translation, rotation
+ quaternion (x, y, z, w) and scale.
+ */
+struct VROBonePose {
+    float translation[3] = { 0, 0, 0 };
+    float rotation[4] = { 0, 0, 0, 1 };
+    float scale[3] = { 1, 1, 1 };
+};
+
+/*
+ One animation layer's contribution to a frame: the pose of every bone,
+ and a dense per-bone blend weight (see VROSkinningRig::createLayerWeights()).
+ */
+struct VROSkinningLayer {
+    const VROBonePose *poses;
+    const float *weights;
+};
+
+/*
+ The immutable part of palette computation for a skeleton and skinner: bone
+ hierarchy in parent-first order, rest pose, and the skinner's bind
+ transforms (see VROSkinner::getBindTransforms()). Shared by every character
+ that uses the same skinned model.
+ */
+class VROSkinningRig {
+public:
+
+    /*
+     Create a rig from each bone's parent index (-1 for roots), its rest pose
+     (used for bones no layer animates) and its bind transform. Returns
+     nullptr if the hierarchy contains a cycle.
+     */
+    static std::shared_ptr<VROSkinningRig> create(const std::vector<int> &parents,
+                                                  const std::vector<VROBonePose> &restPose,
+                                                  const std::vector<VROMatrix4f> &bindTransforms) {
+        const int count = (int) parents.size();
+        if ((int) restPose.size() != count || (int) bindTransforms.size() != count) {
+            return nullptr;
+        }
+        std::shared_ptr<VROSkinningRig> rig(new VROSkinningRig());
+        rig->_parents = parents;
+        rig->_restPose = restPose;
+        rig->_bindTransforms.resize(count * 12);
+        for (int i = 0; i < count; i++) {
+            toAffine(bindTransforms[i].getArray(), &rig->_bindTransforms[i * 12]);
+        }
+
+        // Order bones so that each parent precedes its children
+        std::vector<int> state(count, 0);
+        for (int i = 0; i < count; i++) {
+            std::vector<int> path;
+            for (int bone = i; bone >= 0 && state[bone] != 2; bone = parents[bone]) {
+                if (state[bone] == 1 || parents[bone] >= count) {
+                    return nullptr;
+                }
+                state[bone] = 1;
+                path.push_back(bone);
+            }
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                state[*it] = 2;
+                rig->_order.push_back(*it);
+            }
+        }
+        return rig;
+    }
+
+    /*
+     Expand a layer's default bone weight and per-bone overrides (as set on
+     VROSkeletalAnimationLayer) into a dense array, once per layer rather than
+     once per bone per frame.
+     */
+    std::vector<float> createLayerWeights(float defaultWeight, const std::map<int, float> &boneWeights) const {
+        std::vector<float> weights(getBoneCount(), defaultWeight);
+        for (const auto &kv : boneWeights) {
+            if (kv.first >= 0 && kv.first < getBoneCount()) {
+                weights[kv.first] = kv.second;
+            }
+        }
+        return weights;
+    }
+
+    int getBoneCount() const { return (int) _parents.size(); }
+    const std::vector<VROBonePose> &getRestPose() const { return _restPose; }
+
+private:
+
+    friend class VROSkinningPalette;
+
+    std::vector<int> _parents;
+    std::vector<int> _order;
+    std::vector<VROBonePose> _restPose;
+
+    /*
+     Bind transforms as 3x4 affine matrices, column-major.
+     */
+    std::vector<float> _bindTransforms;
+
+    VROSkinningRig() {}
+
+    static void toAffine(const float *m, float *out) {
+        for (int c = 0; c < 4; c++) {
+            out[c * 3 + 0] = m[c * 4 + 0];
+            out[c * 3 + 1] = m[c * 4 + 1];
+            out[c * 3 + 2] = m[c * 4 + 2];
+        }
+    }
+
+};
+
+/*
+ Computes a character's skinning palette in one pass per frame: blends the
+ animation layers for each bone, composes the model transform of every bone
+ in hierarchy order (each parent's transform is computed once and reused by
+ its children), applies the bind transforms, and writes the result in the
+ requested upload format.
+
+ Every bone is treated as a local transform (relative to its parent, see
+ VROSkinner.h). For skeletons made only of local bones, with bind transforms
+ taken from VROSkinner::getBindTransforms() (which already include the
+ geometryBindTransform), the palette matches calling
+ VROSkinner::getModelTransform() per bone. Skeletons with concatenated or
+ legacy bone transforms are not supported and must keep using VROSkinner.
+ */
+class VROSkinningPalette {
+public:
+
+    VROSkinningPalette(std::shared_ptr<const VROSkinningRig> rig,
+                       VROSkinningPaletteFormat format = VROSkinningPaletteFormat::Matrix) :
+        _rig(rig), _format(format),
+        _palette(rig->getBoneCount() * kSkinningPaletteFloatsPerBone, 0),
+        _modelTransforms(rig->getBoneCount() * 12, 0) {}
+
+    /*
+     Compute the palette from the given layers. Each bone's pose is the
+     weighted average of the layers' poses (rotations are blended with
+     normalized quaternion interpolation); bones with zero total weight use
+     the rest pose.
+     */
+    void compute(const VROSkinningLayer *layers, int layerCount) {
+        const VROSkinningRig &rig = *_rig;
+        for (int bone : rig._order) {
+            VROBonePose pose;
+            blend(rig, bone, layers, layerCount, &pose);
+
+            float local[12];
+            composeTRS(pose, local);
+
+            float *model = &_modelTransforms[bone * 12];
+            int parent = rig._parents[bone];
+            if (parent >= 0) {
+                multiplyAffine(&_modelTransforms[parent * 12], local, model);
+            } else {
+                std::copy(local, local + 12, model);
+            }
+
+            float skin[12];
+            multiplyAffine(model, &rig._bindTransforms[bone * 12], skin);
+            float *out = &_palette[bone * kSkinningPaletteFloatsPerBone];
+            if (_format == VROSkinningPaletteFormat::Matrix) {
+                writeMatrix(skin, out);
+            } else {
+                writeDualQuaternion(skin, out);
+            }
+        }
+    }
+
+    /*
+     Palette for upload: kSkinningPaletteFloatsPerBone floats per bone, in
+     bone index order.
+     */
+    const float *getPalette() const { return _palette.data(); }
+    size_t getPaletteSize() const { return _palette.size(); }
+
+    /*
+     The animated model transform of a bone (without its bind transform), as
+     a VROMatrix4f.
+     */
+    VROMatrix4f getModelTransform(int bone) const {
+        const float *a = &_modelTransforms[bone * 12];
+        float m[16] = { a[0], a[1], a[2], 0, a[3], a[4], a[5], 0, a[6], a[7], a[8], 0, a[9], a[10], a[11], 1 };
+        return VROMatrix4f(m);
+    }
+
+    VROSkinningPaletteFormat getFormat() const { return _format; }
+    const std::shared_ptr<const VROSkinningRig> &getRig() const { return _rig; }
+
+    /*
+     Compute many characters' palettes in parallel on the shared
+     VROThreadPool. Each palette is paired with its layers.
+     */
+    struct Job {
+        VROSkinningPalette *palette;
+        const VROSkinningLayer *layers;
+        int layerCount;
+    };
+    static void computeAll(const std::vector<Job> &jobs) {
+        VROThreadPool::shared().parallelFor((int) jobs.size(), 2, [&](int start, int end) {
+            for (int i = start; i < end; i++) {
+                jobs[i].palette->compute(jobs[i].layers, jobs[i].layerCount);
+            }
+        });
+    }
+
+private:
+
+    std::shared_ptr<const VROSkinningRig> _rig;
+    VROSkinningPaletteFormat _format;
+    std::vector<float> _palette;
+
+    /*
+     Animated model transform of each bone, 3x4 affine, column-major.
+     */
+    std::vector<float> _modelTransforms;
+
+    static void blend(const VROSkinningRig &rig, int bone, const VROSkinningLayer *layers, int layerCount,
+                      VROBonePose *outPose) {
+        float total = 0;
+        float t[3] = { 0, 0, 0 };
+        float s[3] = { 0, 0, 0 };
+        float q[4] = { 0, 0, 0, 0 };
+        const float *reference = nullptr;
+
+        for (int l = 0; l < layerCount; l++) {
+            float w = layers[l].weights[bone];
+            if (w <= 0) {
+                continue;
+            }
+            const VROBonePose &pose = layers[l].poses[bone];
+            if (!reference) {
+                reference = pose.rotation;
+            }
+            // Blend in the hemisphere of the first rotation
+            float dot = pose.rotation[0] * reference[0] + pose.rotation[1] * reference[1] +
+                        pose.rotation[2] * reference[2] + pose.rotation[3] * reference[3];
+            float wq = dot < 0 ? -w : w;
+            for (int i = 0; i < 3; i++) {
+                t[i] += pose.translation[i] * w;
+                s[i] += pose.scale[i] * w;
+            }
+            for (int i = 0; i < 4; i++) {
+                q[i] += pose.rotation[i] * wq;
+            }
+            total += w;
+        }
+
+        if (total <= 0) {
+            *outPose = rig._restPose[bone];
+            return;
+        }
+        float inverse = 1.0f / total;
+        float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        float inverseLength = length > 0 ? 1.0f / length : 0;
+        for (int i = 0; i < 3; i++) {
+            outPose->translation[i] = t[i] * inverse;
+            outPose->scale[i] = s[i] * inverse;
+        }
+        for (int i = 0; i < 4; i++) {
+            outPose->rotation[i] = q[i] * inverseLength;
+        }
+        if (length == 0) {
+            outPose->rotation[3] = 1;
+        }
+    }
+
+    /*
+     T * R * S as a 3x4 column-major affine matrix.
+     */
+    static void composeTRS(const VROBonePose &pose, float *out) {
+        float x = pose.rotation[0], y = pose.rotation[1], z = pose.rotation[2], w = pose.rotation[3];
+        float sx = pose.scale[0], sy = pose.scale[1], sz = pose.scale[2];
+
+        out[0] = (1 - 2 * (y * y + z * z)) * sx;
+        out[1] = (2 * (x * y + z * w)) * sx;
+        out[2] = (2 * (x * z - y * w)) * sx;
+        out[3] = (2 * (x * y - z * w)) * sy;
+        out[4] = (1 - 2 * (x * x + z * z)) * sy;
+        out[5] = (2 * (y * z + x * w)) * sy;
+        out[6] = (2 * (x * z + y * w)) * sz;
+        out[7] = (2 * (y * z - x * w)) * sz;
+        out[8] = (1 - 2 * (x * x + y * y)) * sz;
+        out[9] = pose.translation[0];
+        out[10] = pose.translation[1];
+        out[11] = pose.translation[2];
+    }
+
+    static void multiplyAffine(const float *a, const float *b, float *out) {
+        for (int c = 0; c < 4; c++) {
+            const float *column = &b[c * 3];
+            for (int r = 0; r < 3; r++) {
+                out[c * 3 + r] = a[r] * column[0] + a[3 + r] * column[1] + a[6 + r] * column[2] +
+                                 (c == 3 ? a[9 + r] : 0);
+            }
+        }
+    }
+
+    static void writeMatrix(const float *m, float *out) {
+        for (int r = 0; r < 3; r++) {
+            out[r * 4 + 0] = m[r];
+            out[r * 4 + 1] = m[3 + r];
+            out[r * 4 + 2] = m[6 + r];
+            out[r * 4 + 3] = m[9 + r];
+        }
+    }
+
+    /*
+     Decompose into scale, rotation and translation, and encode the rigid
+     part as a unit dual quaternion. Shear is discarded, as it cannot be
+     represented.
+     */
+    static void writeDualQuaternion(const float *m, float *out) {
+        float scale[3];
+        float r[9];
+        for (int c = 0; c < 3; c++) {
+            scale[c] = sqrtf(m[c * 3] * m[c * 3] + m[c * 3 + 1] * m[c * 3 + 1] + m[c * 3 + 2] * m[c * 3 + 2]);
+            float inverse = scale[c] > 0 ? 1.0f / scale[c] : 0;
+            r[c * 3 + 0] = m[c * 3 + 0] * inverse;
+            r[c * 3 + 1] = m[c * 3 + 1] * inverse;
+            r[c * 3 + 2] = m[c * 3 + 2] * inverse;
+        }
+
+        // Rotation matrix (column-major, r[c * 3 + row]) to quaternion
+        float q[4];
+        float trace = r[0] + r[4] + r[8];
+        if (trace > 0) {
+            float s = sqrtf(trace + 1.0f) * 2;
+            q[3] = 0.25f * s;
+            q[0] = (r[5] - r[7]) / s;
+            q[1] = (r[6] - r[2]) / s;
+            q[2] = (r[1] - r[3]) / s;
+        } else if (r[0] > r[4] && r[0] > r[8]) {
+            float s = sqrtf(1.0f + r[0] - r[4] - r[8]) * 2;
+            q[3] = (r[5] - r[7]) / s;
+            q[0] = 0.25f * s;
+            q[1] = (r[3] + r[1]) / s;
+            q[2] = (r[6] + r[2]) / s;
+        } else if (r[4] > r[8]) {
+            float s = sqrtf(1.0f + r[4] - r[0] - r[8]) * 2;
+            q[3] = (r[6] - r[2]) / s;
+            q[0] = (r[3] + r[1]) / s;
+            q[1] = 0.25f * s;
+            q[2] = (r[7] + r[5]) / s;
+        } else {
+            float s = sqrtf(1.0f + r[8] - r[0] - r[4]) * 2;
+            q[3] = (r[1] - r[3]) / s;
+            q[0] = (r[6] + r[2]) / s;
+            q[1] = (r[7] + r[5]) / s;
+            q[2] = 0.25f * s;
+        }
+        float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        for (int i = 0; i < 4; i++) {
+            q[i] /= length;
+        }
+
+        // Dual part: 0.5 * (t, 0) * q
+        float tx = m[9], ty = m[10], tz = m[11];
+        out[0] = q[0];
+        out[1] = q[1];
+        out[2] = q[2];
+        out[3] = q[3];
+        out[4] = 0.5f * ( tx * q[3] + ty * q[2] - tz * q[1]);
+        out[5] = 0.5f * (-tx * q[2] + ty * q[3] + tz * q[0]);
+        out[6] = 0.5f * ( tx * q[1] - ty * q[0] + tz * q[3]);
+        out[7] = 0.5f * (-tx * q[0] - ty * q[1] - tz * q[2]);
+        out[8] = scale[0];
+        out[9] = scale[1];
+        out[10] = scale[2];
+        out[11] = 0;
+    }
+
+};
+
+#endif /* VROSkinningPalette_h */
@@ -0,0 +1,717 @@
+//
+//  VROTSDFVolume.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROTSDFVolume_h
+#define VROTSDFVolume_h
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include "VROARDepthMesh.h"
+#include "VRODepthImage.h"
+#include "VROThreadPool.h"
+#include "VROTime.h"
+
+/**
+ * Configuration for TSDF fusion.
+ */
+struct VROTSDFConfig {
+    float voxelSize = 0.04f;            // Voxel edge length in meters
+    float truncationVoxels = 4.0f;      // Truncation band, in voxels
+    float maxWeight = 64.0f;            // Cap on accumulated weight; lower adapts faster to change
+    float maxDepth = 4.0f;              // Ignore depth beyond this distance in meters
+    float minConfidence = 0.3f;         // Ignore depth below this confidence (0.0-1.0)
+    int allocationStride = 4;           // Pixel stride used to find the blocks a frame touches
+    int maxBlocks = 4096;               // Block budget; least recently observed blocks are evicted
+};
+
+/**
+ * Statistics from the last integrate() and extractMeshes() calls.
+ */
+struct VROTSDFStats {
+    int residentBlocks = 0;             // Blocks currently allocated
+    int integratedBlocks = 0;           // Blocks updated by the last frame
+    int allocatedBlocks = 0;            // Blocks newly allocated by the last frame
+    int evictedBlocks = 0;              // Blocks evicted by the last frame to stay within budget
+    int meshedBlocks = 0;               // Blocks re-meshed by the last extraction
+    int vertexCount = 0;                // Vertices across all block meshes
+    int triangleCount = 0;              // Triangles across all block meshes
+    double integrationTimeMs = 0.0;     // Time spent in the last integrate()
+    double meshingTimeMs = 0.0;         // Time spent in the last extractMeshes()
+    size_t residentBytes = 0;           // Voxel memory in use
+};
+
+/**
+ * Mesh of a single TSDF block, in world space.
+ */
+struct VROTSDFBlockMesh {
+    std::vector<VROVector3f> vertices;
+    std::vector<int> indices;
+};
+
+/**
+ * VROTSDFVolume fuses successive depth frames and camera poses into a
+ * truncated signed distance field stored in a sparse, hashed grid of 8x8x8
+ * voxel blocks (voxel hashing). Unlike VROARWorldMesh, which only keeps the
+ * latest frame's mesh, the fused geometry persists when the camera looks away,
+ * so occlusion and physics do not flicker.
+ *
+ * Each integrate() call allocates the blocks within the truncation band of the
+ * observed surface, then updates every voxel of those blocks in parallel by
+ * projecting it into the depth image (a running weighted average of the
+ * truncated distance). Memory is bounded by maxBlocks: when the budget is
+ * exceeded, the least recently observed blocks are evicted.
+ *
+ * Meshes are extracted incrementally: extractMeshes() runs marching cubes only
+ * on blocks that changed since the last extraction (and on the neighbors that
+ * share their boundary voxels), producing one VROTSDFBlockMesh per block.
+ * Surfaces are closed across block boundaries.
+ *
+ * The volume only consumes VRODepthImages, so it can be driven offline from
+ * recorded depth and pose sequences. It is not thread-safe; call it from one
+ * thread (internally it parallelizes on the VROThreadPool).
+ */
+class VROTSDFVolume {
+public:
+
+    static const int kBlockSize = 8;
+    static const int kVoxelsPerBlock = kBlockSize * kBlockSize * kBlockSize;
+
+    VROTSDFVolume(VROTSDFConfig config = VROTSDFConfig()) :
+        _config(config), _frame(0) {}
+    virtual ~VROTSDFVolume() {}
+
+    /**
+     * Fuse a depth frame. image.cameraToWorld must be a rigid transform.
+     */
+    void integrate(const VRODepthImage &image) {
+        double startTime = VROTimeCurrentMillis();
+        _stats.integratedBlocks = 0;
+        _stats.allocatedBlocks = 0;
+        _stats.evictedBlocks = 0;
+        _evictedKeys.clear();
+        if (!image.isValid()) {
+            return;
+        }
+        _frame++;
+
+        allocateVisibleBlocks(image);
+
+        // Rigid inverse of the camera pose, applied as R^T * (p - t). The pose
+        // is column-major, so the rows of R^T are its first three columns
+        const VROMatrix4f &m = image.cameraToWorld;
+        float rotation[9] = { m[0], m[1], m[2],
+                              m[4], m[5], m[6],
+                              m[8], m[9], m[10] };
+        VROVector3f translation(m[12], m[13], m[14]);
+
+        VROThreadPool::shared().parallelFor((int) _visibleBlocks.size(), 1, [&](int start, int end) {
+            for (int i = start; i < end; i++) {
+                integrateBlock(_blocks[_visibleBlocks[i]], image, rotation, translation);
+            }
+        });
+        for (int index : _visibleBlocks) {
+            markDirtyWithNeighbors(_blocks[index].key);
+        }
+
+        _stats.integratedBlocks = (int) _visibleBlocks.size();
+        _stats.residentBlocks = (int) _blockIndex.size();
+        _stats.residentBytes = _blockIndex.size() * sizeof(float) * 2 * kVoxelsPerBlock;
+        _stats.integrationTimeMs = VROTimeCurrentMillis() - startTime;
+    }
+
+    /**
+     * Re-run marching cubes on every block changed since the last extraction.
+     */
+    void extractMeshes() {
+        double startTime = VROTimeCurrentMillis();
+        std::vector<int> dirty;
+        for (auto &entry : _blockIndex) {
+            if (_blocks[entry.second].meshDirty) {
+                dirty.push_back(entry.second);
+            }
+        }
+
+        VROThreadPool::shared().parallelFor((int) dirty.size(), 1, [&](int start, int end) {
+            for (int i = start; i < end; i++) {
+                meshBlock(_blocks[dirty[i]]);
+            }
+        });
+
+        _stats.meshedBlocks = (int) dirty.size();
+        _stats.vertexCount = 0;
+        _stats.triangleCount = 0;
+        for (auto &entry : _blockIndex) {
+            const Block &block = _blocks[entry.second];
+            _stats.vertexCount += (int) block.mesh.vertices.size();
+            _stats.triangleCount += (int) block.mesh.indices.size() / 3;
+        }
+        _stats.meshingTimeMs = VROTimeCurrentMillis() - startTime;
+    }
+
+    /**
+     * Invoke the given function for the mesh of each resident block. The key
+     * identifies the block across calls; keys of evicted blocks are reported
+     * through getEvictedBlockKeys() so consumers can drop their copies.
+     */
+    void forEachBlockMesh(const std::function<void(int64_t key, const VROTSDFBlockMesh &mesh)> &fn) const {
+        for (auto &entry : _blockIndex) {
+            const Block &block = _blocks[entry.second];
+            if (!block.mesh.indices.empty()) {
+                fn(entry.first, block.mesh);
+            }
+        }
+    }
+
+    /**
+     * Keys of the blocks evicted by the last integrate() call, so consumers
+     * can drop their meshes. Empty if that call evicted nothing.
+     */
+    const std::vector<int64_t> &getEvictedBlockKeys() const {
+        return _evictedKeys;
+    }
+
+    /**
+     * Merge all block meshes into a single VROARDepthMesh, for consumers such
+     * as VROPhysicsShape. Returns nullptr if there is no surface.
+     */
+    std::shared_ptr<VROARDepthMesh> createDepthMesh() const {
+        std::vector<VROVector3f> vertices;
+        std::vector<int> indices;
+        forEachBlockMesh([&](int64_t, const VROTSDFBlockMesh &mesh) {
+            int base = (int) vertices.size();
+            vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+            for (int index : mesh.indices) {
+                indices.push_back(base + index);
+            }
+        });
+        if (indices.empty()) {
+            return nullptr;
+        }
+        std::vector<float> confidences(vertices.size(), 1.0f);
+        return std::make_shared<VROARDepthMesh>(vertices, indices, confidences);
+    }
+
+    /**
+     * Signed distance in meters at the voxel containing the given point, or
+     * NaN if the voxel is unobserved.
+     */
+    float getDistance(VROVector3f point) const {
+        int vx = (int) floorf(point.x / _config.voxelSize);
+        int vy = (int) floorf(point.y / _config.voxelSize);
+        int vz = (int) floorf(point.z / _config.voxelSize);
+        float weight;
+        float tsdf = getVoxel(vx, vy, vz, &weight);
+        return weight > 0 ? tsdf * getTruncation() : NAN;
+    }
+
+    void clear() {
+        _blocks.clear();
+        _freeBlocks.clear();
+        _blockIndex.clear();
+        _evictedKeys.clear();
+        _stats = VROTSDFStats();
+    }
+
+    const VROTSDFStats &getStats() const { return _stats; }
+    const VROTSDFConfig &getConfig() const { return _config; }
+
+private:
+
+    struct Block {
+        int64_t key = 0;
+        int bx = 0, by = 0, bz = 0;
+        uint64_t lastObservedFrame = 0;
+        bool meshDirty = false;
+        std::vector<float> tsdf;
+        std::vector<float> weight;
+        VROTSDFBlockMesh mesh;
+    };
+
+    VROTSDFConfig _config;
+    uint64_t _frame;
+
+    std::vector<Block> _blocks;
+    std::vector<int> _freeBlocks;
+    std::unordered_map<int64_t, int> _blockIndex;
+    std::vector<int> _visibleBlocks;
+    std::vector<int64_t> _evictedKeys;
+    VROTSDFStats _stats;
+
+    float getTruncation() const {
+        return _config.truncationVoxels * _config.voxelSize;
+    }
+
+    static int64_t packKey(int bx, int by, int bz) {
+        const int64_t mask = (1 << 21) - 1;
+        return ((int64_t) (bx & mask) << 42) | ((int64_t) (by & mask) << 21) | (int64_t) (bz & mask);
+    }
+
+    static int floorDiv(int a, int b) {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    const Block *findBlock(int bx, int by, int bz) const {
+        auto it = _blockIndex.find(packKey(bx, by, bz));
+        return it == _blockIndex.end() ? nullptr : &_blocks[it->second];
+    }
+
+    /*
+     TSDF value (normalized to [-1, 1]) and weight of the given global voxel.
+     */
+    float getVoxel(int vx, int vy, int vz, float *weight) const {
+        int bx = floorDiv(vx, kBlockSize), by = floorDiv(vy, kBlockSize), bz = floorDiv(vz, kBlockSize);
+        const Block *block = findBlock(bx, by, bz);
+        if (!block) {
+            *weight = 0;
+            return 1;
+        }
+        int i = voxelIndex(vx - bx * kBlockSize, vy - by * kBlockSize, vz - bz * kBlockSize);
+        *weight = block->weight[i];
+        return block->tsdf[i];
+    }
+
+    static int voxelIndex(int x, int y, int z) {
+        return (z * kBlockSize + y) * kBlockSize + x;
+    }
+
+#pragma mark - Allocation
+
+    void allocateVisibleBlocks(const VRODepthImage &image) {
+        std::unordered_set<int64_t> visible;
+        float truncation = getTruncation();
+        float blockExtent = kBlockSize * _config.voxelSize;
+        int stride = std::max(1, _config.allocationStride);
+        VROVector3f cameraPosition(image.cameraToWorld[12], image.cameraToWorld[13], image.cameraToWorld[14]);
+
+        for (int y = 0; y < image.height; y += stride) {
+            for (int x = 0; x < image.width; x += stride) {
+                float depth = image.getDepth(x, y);
+                if (!(depth > 0 && depth <= _config.maxDepth) || image.getConfidence(x, y) < _config.minConfidence) {
+                    continue;
+                }
+                VROVector3f surface = image.unprojectToWorld((float) x, (float) y, depth);
+                VROVector3f ray = surface - cameraPosition;
+                float length = sqrtf(ray.x * ray.x + ray.y * ray.y + ray.z * ray.z);
+                if (length <= 0) {
+                    continue;
+                }
+                ray /= length;
+
+                // Blocks along the ray within the truncation band around the surface
+                for (float s = -truncation; s <= truncation + 1e-4f; s += std::min(truncation, blockExtent * 0.5f)) {
+                    VROVector3f p = surface + ray * s;
+                    visible.insert(packKey((int) floorf(p.x / blockExtent),
+                                           (int) floorf(p.y / blockExtent),
+                                           (int) floorf(p.z / blockExtent)));
+                }
+            }
+        }
+
+        _visibleBlocks.clear();
+        std::vector<int64_t> missing;
+        for (int64_t key : visible) {
+            auto it = _blockIndex.find(key);
+            if (it != _blockIndex.end()) {
+                _blocks[it->second].lastObservedFrame = _frame;
+                _visibleBlocks.push_back(it->second);
+            }
+            else {
+                missing.push_back(key);
+            }
+        }
+
+        int budget = std::max(0, _config.maxBlocks);
+        int overflow = (int) (_blockIndex.size() + missing.size()) - budget;
+        if (overflow > 0) {
+            evictBlocks(overflow);
+        }
+
+        for (int64_t key : missing) {
+            if ((int) _blockIndex.size() >= budget) {
+                break;
+            }
+            _visibleBlocks.push_back(allocateBlock(key));
+            _stats.allocatedBlocks++;
+        }
+    }
+
+    int allocateBlock(int64_t key) {
+        int index;
+        if (!_freeBlocks.empty()) {
+            index = _freeBlocks.back();
+            _freeBlocks.pop_back();
+        }
+        else {
+            index = (int) _blocks.size();
+            _blocks.emplace_back();
+        }
+
+        Block &block = _blocks[index];
+        block.key = key;
+        block.bx = signExtend((key >> 42) & ((1 << 21) - 1));
+        block.by = signExtend((key >> 21) & ((1 << 21) - 1));
+        block.bz = signExtend(key & ((1 << 21) - 1));
+        block.lastObservedFrame = _frame;
+        block.meshDirty = true;
+        block.tsdf.assign(kVoxelsPerBlock, 1.0f);
+        block.weight.assign(kVoxelsPerBlock, 0.0f);
+        block.mesh.vertices.clear();
+        block.mesh.indices.clear();
+
+        _blockIndex[key] = index;
+        return index;
+    }
+
+    static int signExtend(int64_t value) {
+        return (int) (value >= (1 << 20) ? value - (1 << 21) : value);
+    }
+
+    /*
+     Evict up to count blocks that were not observed this frame, oldest first.
+     */
+    void evictBlocks(int count) {
+        std::vector<std::pair<uint64_t, int>> candidates;
+        for (auto &entry : _blockIndex) {
+            const Block &block = _blocks[entry.second];
+            if (block.lastObservedFrame != _frame) {
+                candidates.push_back({ block.lastObservedFrame, entry.second });
+            }
+        }
+        count = std::min(count, (int) candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+
+        for (int i = 0; i < count; i++) {
+            Block &block = _blocks[candidates[i].second];
+            _evictedKeys.push_back(block.key);
+            _blockIndex.erase(block.key);
+            markDirtyWithNeighbors(block.key);
+
+            block.tsdf.clear();
+            block.tsdf.shrink_to_fit();
+            block.weight.clear();
+            block.weight.shrink_to_fit();
+            block.mesh = VROTSDFBlockMesh();
+            _freeBlocks.push_back(candidates[i].second);
+        }
+        _stats.evictedBlocks = count;
+    }
+
+    /*
+     A block's mesh covers the cubes whose minimum corner is inside it, so it
+     also depends on the voxels of its +X, +Y and +Z neighbors. When a block
+     changes, the neighbors on its -X, -Y and -Z sides must be re-meshed too.
+     */
+    void markDirtyWithNeighbors(int64_t key) {
+        int bx = signExtend((key >> 42) & ((1 << 21) - 1));
+        int by = signExtend((key >> 21) & ((1 << 21) - 1));
+        int bz = signExtend(key & ((1 << 21) - 1));
+        for (int dz = -1; dz <= 0; dz++) {
+            for (int dy = -1; dy <= 0; dy++) {
+                for (int dx = -1; dx <= 0; dx++) {
+                    auto it = _blockIndex.find(packKey(bx + dx, by + dy, bz + dz));
+                    if (it != _blockIndex.end()) {
+                        _blocks[it->second].meshDirty = true;
+                    }
+                }
+            }
+        }
+    }
+
+#pragma mark - Integration
+
+    void integrateBlock(Block &block, const VRODepthImage &image, const float *r, const VROVector3f &t) const {
+        float voxelSize = _config.voxelSize;
+        float truncation = getTruncation();
+        float inverseTruncation = 1.0f / truncation;
+        float maxWeight = _config.maxWeight;
+
+        for (int z = 0; z < kBlockSize; z++) {
+            for (int y = 0; y < kBlockSize; y++) {
+                for (int x = 0; x < kBlockSize; x++) {
+                    VROVector3f world(((block.bx * kBlockSize + x) + 0.5f) * voxelSize - t.x,
+                                      ((block.by * kBlockSize + y) + 0.5f) * voxelSize - t.y,
+                                      ((block.bz * kBlockSize + z) + 0.5f) * voxelSize - t.z);
+
+                    // World to camera space; the camera looks down -Z
+                    float cx = r[0] * world.x + r[1] * world.y + r[2] * world.z;
+                    float cy = r[3] * world.x + r[4] * world.y + r[5] * world.z;
+                    float cz = r[6] * world.x + r[7] * world.y + r[8] * world.z;
+                    float voxelDepth = -cz;
+                    if (voxelDepth <= 0) {
+                        continue;
+                    }
+
+                    int u = (int) (image.fx * cx / voxelDepth + image.cx + 0.5f);
+                    int v = (int) (-image.fy * cy / voxelDepth + image.cy + 0.5f);
+                    if (u < 0 || v < 0 || u >= image.width || v >= image.height) {
+                        continue;
+                    }
+                    float depth = image.getDepth(u, v);
+                    if (!(depth > 0 && depth <= _config.maxDepth) || image.getConfidence(u, v) < _config.minConfidence) {
+                        continue;
+                    }
+
+                    float sdf = depth - voxelDepth;
+                    if (sdf < -truncation) {
+                        continue;
+                    }
+                    float tsdf = std::min(1.0f, sdf * inverseTruncation);
+
+                    int i = voxelIndex(x, y, z);
+                    float weight = block.weight[i];
+                    block.tsdf[i] = (block.tsdf[i] * weight + tsdf) / (weight + 1.0f);
+                    block.weight[i] = std::min(weight + 1.0f, maxWeight);
+                }
+            }
+        }
+    }
+
+#pragma mark - Marching Cubes
+
+    /*
+     Marching cubes tables, generated once rather than hard-coded. Corner i of
+     a cube is offset by (i & 1, (i >> 1) & 1, (i >> 2) & 1); a corner is
+     inside when its distance is negative.
+
+     For each configuration the isosurface polygons are traced directly on
+     the cube's faces: on every face, each crossing where the boundary walk
+     (counter-clockwise from outside) leaves the inside is joined to the
+     crossing that precedes it. On ambiguous faces this separates the inside
+     corners, and since the rule depends only on the face's corner signs, the
+     two cubes sharing a face always agree and the surface has no holes. The
+     resulting loops are fan-triangulated.
+     */
+    struct Tables {
+        static const int kMaxIndices = 37;
+
+        int edgeCorners[12][2];
+        int8_t triangles[256][kMaxIndices];
+
+        Tables() {
+            int edgeCount = 0;
+            int edgeForCorners[8][8];
+            for (int a = 0; a < 8; a++) {
+                for (int axis = 0; axis < 3; axis++) {
+                    if (!(a & (1 << axis))) {
+                        int b = a | (1 << axis);
+                        edgeCorners[edgeCount][0] = a;
+                        edgeCorners[edgeCount][1] = b;
+                        edgeForCorners[a][b] = edgeForCorners[b][a] = edgeCount;
+                        edgeCount++;
+                    }
+                }
+            }
+
+            // Corners of each face, counter-clockwise when viewed from outside the cube
+            int faces[6][4];
+            for (int axis = 0; axis < 3; axis++) {
+                int u = 1 << ((axis + 1) % 3);
+                int v = 1 << ((axis + 2) % 3);
+                for (int side = 0; side < 2; side++) {
+                    int base = side ? (1 << axis) : 0;
+                    int *face = faces[axis * 2 + side];
+                    if (side) {
+                        face[0] = base; face[1] = base | u; face[2] = base | u | v; face[3] = base | v;
+                    }
+                    else {
+                        face[0] = base; face[1] = base | v; face[2] = base | u | v; face[3] = base | u;
+                    }
+                }
+            }
+
+            int edgeFaces[12] = { 0 };
+            for (int f = 0; f < 6; f++) {
+                for (int k = 0; k < 4; k++) {
+                    edgeFaces[edgeForCorners[faces[f][k]][faces[f][(k + 1) % 4]]] |= 1 << f;
+                }
+            }
+
+            for (int config = 0; config < 256; config++) {
+                int next[12];
+                for (int e = 0; e < 12; e++) {
+                    next[e] = -1;
+                }
+
+                for (int f = 0; f < 6; f++) {
+                    int crossings[4];
+                    bool leaving[4];
+                    int count = 0;
+                    for (int k = 0; k < 4; k++) {
+                        int a = faces[f][k];
+                        int b = faces[f][(k + 1) % 4];
+                        bool insideA = config & (1 << a);
+                        bool insideB = config & (1 << b);
+                        if (insideA != insideB) {
+                            crossings[count] = edgeForCorners[a][b];
+                            leaving[count] = insideA;
+                            count++;
+                        }
+                    }
+                    for (int k = 0; k < count; k++) {
+                        if (leaving[k]) {
+                            int previous = crossings[(k + count - 1) % count];
+                            next[previous] = crossings[k];
+                        }
+                    }
+                }
+
+                int n = 0;
+                bool visited[12] = { false };
+                for (int start = 0; start < 12; start++) {
+                    if (next[start] < 0 || visited[start]) {
+                        continue;
+                    }
+                    int loop[12];
+                    int length = 0;
+                    for (int e = start; !visited[e]; e = next[e]) {
+                        visited[e] = true;
+                        loop[length++] = e;
+                    }
+
+                    // Fan from the vertex whose diagonals cross the fewest
+                    // cube faces: a diagonal lying on a face could be chosen
+                    // by the neighboring cube as well, leaving an edge shared
+                    // by four triangles
+                    int bestStart = 0;
+                    int bestCount = 13;
+                    for (int r = 0; r < length; r++) {
+                        int count = 0;
+                        for (int k = 2; k + 1 < length; k++) {
+                            if (edgeFaces[loop[r]] & edgeFaces[loop[(r + k) % length]]) {
+                                count++;
+                            }
+                        }
+                        if (count < bestCount) {
+                            bestCount = count;
+                            bestStart = r;
+                        }
+                    }
+                    for (int k = 1; k + 1 < length; k++) {
+                        triangles[config][n++] = (int8_t) loop[bestStart];
+                        triangles[config][n++] = (int8_t) loop[(bestStart + k) % length];
+                        triangles[config][n++] = (int8_t) loop[(bestStart + k + 1) % length];
+                    }
+                }
+                triangles[config][n] = -1;
+            }
+        }
+    };
+
+    static const Tables &getTables() {
+        static const Tables tables;
+        return tables;
+    }
+
+    void meshBlock(Block &block) const {
+        const Tables &tables = getTables();
+        block.mesh.vertices.clear();
+        block.mesh.indices.clear();
+        block.meshDirty = false;
+
+        // Gather the block's voxels plus one layer from its +X, +Y, +Z neighbors
+        const int n = kBlockSize + 1;
+        float values[n * n * n];
+        float weights[n * n * n];
+        for (int z = 0; z < n; z++) {
+            for (int y = 0; y < n; y++) {
+                for (int x = 0; x < n; x++) {
+                    int i = (z * n + y) * n + x;
+                    if (x < kBlockSize && y < kBlockSize && z < kBlockSize) {
+                        values[i] = block.tsdf[voxelIndex(x, y, z)];
+                        weights[i] = block.weight[voxelIndex(x, y, z)];
+                    }
+                    else {
+                        values[i] = getVoxel(block.bx * kBlockSize + x, block.by * kBlockSize + y,
+                                             block.bz * kBlockSize + z, &weights[i]);
+                    }
+                }
+            }
+        }
+
+        // One cached vertex per edge of the (n x n x n) lattice, keyed by the
+        // edge's minimum corner and axis, so vertices are shared within the block
+        static thread_local std::vector<int> edgeVertex;
+        edgeVertex.assign(n * n * n * 3, -1);
+
+        float voxelSize = _config.voxelSize;
+        VROVector3f origin((block.bx * kBlockSize + 0.5f) * voxelSize,
+                           (block.by * kBlockSize + 0.5f) * voxelSize,
+                           (block.bz * kBlockSize + 0.5f) * voxelSize);
+
+        for (int z = 0; z < kBlockSize; z++) {
+            for (int y = 0; y < kBlockSize; y++) {
+                for (int x = 0; x < kBlockSize; x++) {
+                    int config = 0;
+                    bool observed = true;
+                    for (int c = 0; c < 8; c++) {
+                        int i = ((z + ((c >> 2) & 1)) * n + (y + ((c >> 1) & 1))) * n + (x + (c & 1));
+                        if (weights[i] <= 0) {
+                            observed = false;
+                            break;
+                        }
+                        if (values[i] < 0) {
+                            config |= 1 << c;
+                        }
+                    }
+                    if (!observed || config == 0 || config == 255) {
+                        continue;
+                    }
+
+                    const int8_t *triangle = tables.triangles[config];
+                    for (int k = 0; triangle[k] >= 0; k++) {
+                        int edge = triangle[k];
+                        int a = tables.edgeCorners[edge][0];
+                        int b = tables.edgeCorners[edge][1];
+                        int ax = x + (a & 1), ay = y + ((a >> 1) & 1), az = z + ((a >> 2) & 1);
+                        int axis = (b ^ a) == 1 ? 0 : ((b ^ a) == 2 ? 1 : 2);
+
+                        int &cached = edgeVertex[((az * n + ay) * n + ax) * 3 + axis];
+                        if (cached < 0) {
+                            int bx = x + (b & 1), by = y + ((b >> 1) & 1), bz = z + ((b >> 2) & 1);
+                            float va = values[(az * n + ay) * n + ax];
+                            float vb = values[(bz * n + by) * n + bx];
+                            float s = va / (va - vb);
+
+                            cached = (int) block.mesh.vertices.size();
+                            block.mesh.vertices.push_back(VROVector3f(origin.x + (ax + s * (bx - ax)) * voxelSize,
+                                                                      origin.y + (ay + s * (by - ay)) * voxelSize,
+                                                                      origin.z + (az + s * (bz - az)) * voxelSize));
+                        }
+                        block.mesh.indices.push_back(cached);
+                    }
+                }
+            }
+        }
+    }
+
+};
+
+#endif /* VROTSDFVolume_h */
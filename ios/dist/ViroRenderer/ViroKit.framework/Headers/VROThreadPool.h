@@ -0,0 +1,215 @@
+//
+//  VROThreadPool.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROThreadPool_h
+#define VROThreadPool_h
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+/*
+ Fixed-size pool of worker threads for data-parallel CPU work that must
+ complete within the current frame. Unlike VROPlatformDispatchAsyncBackground,
+ work submitted through parallelFor is synchronous: the index range is split
+ into chunks, the chunks are run on the workers *and* on the calling thread,
+ and parallelFor returns once every chunk has finished.
+
+ Calls to parallelFor from multiple threads are serialized. Calls made from
+ within a chunk (nested parallelism) run serially on the thread running
+ that chunk, whether it is a worker or the thread that submitted the job.
+ */
+class VROThreadPool {
+public:
+
+    /*
+     Pool shared by the renderer, sized to the hardware concurrency. The
+     calling thread participates in each job, so one fewer worker is spawned.
+     */
+    static VROThreadPool &shared() {
+        static VROThreadPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    VROThreadPool(int numWorkers) :
+        _job(nullptr), _count(0), _chunkSize(1), _nextIndex(0), _chunksRemaining(0),
+        _generation(0), _activeWorkers(0), _shutdown(false) {
+        for (int i = 0; i < numWorkers; i++) {
+            _workers.emplace_back(&VROThreadPool::workerLoop, this);
+        }
+    }
+
+    ~VROThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _shutdown = true;
+        }
+        _wake.notify_all();
+        for (std::thread &worker : _workers) {
+            worker.join();
+        }
+    }
+
+    /*
+     Number of threads that execute a job, including the calling thread.
+     */
+    int getConcurrency() const {
+        return (int) _workers.size() + 1;
+    }
+
+    /*
+     Invoke fn(start, end) over disjoint sub-ranges covering [0, count). No
+     sub-range is smaller than minChunkSize (except the last), so callers
+     can keep per-chunk overhead low for cheap loop bodies.
+     */
+    void parallelFor(int count, int minChunkSize, const std::function<void(int, int)> &fn) {
+        if (count <= 0) {
+            return;
+        }
+        int chunkSize = std::max(minChunkSize, 1);
+
+        // Oversubscribe by 4 chunks per thread to balance uneven chunk costs
+        chunkSize = std::max(chunkSize, (count + getConcurrency() * 4 - 1) / (getConcurrency() * 4));
+        int numChunks = (count + chunkSize - 1) / chunkSize;
+        if (numChunks <= 1 || _workers.empty() || isWorkerThread() || isSubmitting()) {
+            fn(0, count);
+            return;
+        }
+
+        // The submitting thread runs chunks too; mark it so that a nested
+        // call from one of those chunks does not re-lock _submitMutex
+        SubmittingScope submitting;
+        std::lock_guard<std::mutex> submitLock(_submitMutex);
+        {
+            // A worker that woke late for the previous job may still be
+            // leaving runChunks(); wait for it before replacing the job
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this] { return _activeWorkers == 0; });
+            _job = &fn;
+            _count = count;
+            _chunkSize = chunkSize;
+            _nextIndex = 0;
+            _chunksRemaining = numChunks;
+            ++_generation;
+        }
+        _wake.notify_all();
+        runChunks(fn, count, chunkSize);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _chunksRemaining == 0 && _activeWorkers == 0; });
+        _job = nullptr;
+    }
+
+private:
+
+    std::vector<std::thread> _workers;
+    std::mutex _submitMutex;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    /*
+     State of the job currently executing. Written under _mutex before the
+     job's generation is published; workers copy it under _mutex when they
+     observe the generation, and never read these fields afterward.
+     */
+    const std::function<void(int, int)> *_job;
+    int _count;
+    int _chunkSize;
+    std::atomic<int> _nextIndex;
+    std::atomic<int> _chunksRemaining;
+    uint64_t _generation;
+    int _activeWorkers;
+    bool _shutdown;
+
+    static bool &isWorkerThread() {
+        static thread_local bool sIsWorker = false;
+        return sIsWorker;
+    }
+
+    /*
+     True on a thread for the duration of its parallelFor call, on any pool.
+     */
+    static bool &isSubmitting() {
+        static thread_local bool sIsSubmitting = false;
+        return sIsSubmitting;
+    }
+
+    struct SubmittingScope {
+        SubmittingScope() { isSubmitting() = true; }
+        ~SubmittingScope() { isSubmitting() = false; }
+    };
+
+    void workerLoop() {
+        isWorkerThread() = true;
+        uint64_t seenGeneration = 0;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _wake.wait(lock, [&] { return _shutdown || _generation != seenGeneration; });
+            if (_shutdown) {
+                return;
+            }
+            seenGeneration = _generation;
+            const std::function<void(int, int)> *job = _job;
+            int count = _count;
+            int chunkSize = _chunkSize;
+            ++_activeWorkers;
+
+            lock.unlock();
+            if (job) {
+                runChunks(*job, count, chunkSize);
+            }
+            lock.lock();
+
+            --_activeWorkers;
+            if (_activeWorkers == 0 && _chunksRemaining == 0) {
+                _done.notify_all();
+            }
+        }
+    }
+
+    void runChunks(const std::function<void(int, int)> &job, int count, int chunkSize) {
+        while (true) {
+            int start = _nextIndex.fetch_add(chunkSize);
+            if (start >= count) {
+                return;
+            }
+            job(start, std::min(start + chunkSize, count));
+
+            if (_chunksRemaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _done.notify_all();
+            }
+        }
+    }
+
+};
+
+#endif /* VROThreadPool_h */
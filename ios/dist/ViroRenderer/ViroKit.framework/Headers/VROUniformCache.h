@@ -0,0 +1,353 @@
+//
+//  VROUniformCache.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROUniformCache_h
+#define VROUniformCache_h
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <stdint.h>
+#include "VROUniform.h"
+#include "VROShaderProgram.h"
+#include "VROMaterial.h"
+
+/*
+ How often a uniform's value can change, which determines how often its
+ binding block is run.
+ */
+enum class VROUniformFrequency {
+    PerPass,        // View, projection, camera position: once per pass (or eye) per program
+    PerMaterial,    // Material parameters: when the material changes in the draw stream
+    PerDraw,        // Transforms, lights and other per-object state: every draw
+};
+
+struct VROUniformCacheStats {
+    int uploads = 0;              // Values passed to the underlying uniform
+    int uploadsAvoided = 0;       // Values equal to the last one set on this program
+    int bindersRun = 0;           // Binding blocks executed
+    int bindersSkipped = 0;       // Binding blocks skipped by frequency grouping
+};
+
+/*
+ Wraps a program's VROUniform with a copy of the last value set, including
+ every element of arrays, which VROUniform's own caching does not cover.
+ Setting the same value again is a memcmp and no GL call. Because GL keeps
+ uniform values per program, the copy remains valid across program
+ switches, as long as every set of this uniform on the program goes
+ through the wrapper.
+
+ The typed setters (setInt(), setFloat(), setVec3(), setVec4(), setMat4())
+ compare and copy only the bytes they pass, and upload the rest of the
+ cached array unchanged. set() compares the whole array. VROUniform's typed
+ setters are not virtual: called through a VROUniform pointer, setInt()
+ goes straight to glUniform1i and is not cached, and the others reach set().
+
+ The compiled VROShaderProgram and material substrates set uniforms on the
+ underlying VROUniform, not on the wrapper. If both set the same uniform,
+ the wrapper's copy goes stale: after the program sets B behind its back, a
+ set of the wrapper's last value A is skipped and the uniform keeps B. Only
+ wrap uniforms that nothing else sets, or reset() the wrapper after others
+ have.
+ */
+class VROCachedUniform : public VROUniform {
+public:
+
+    VROCachedUniform(VROUniform *uniform, VROShaderProperty type, int arraySize,
+                     VROUniformFrequency frequency, VROUniformCacheStats *stats) :
+        VROUniform(uniform->getName()),
+        _uniform(uniform),
+        _frequency(frequency),
+        _size(getComponents(type) * std::max(arraySize, 1) * (int) sizeof(float)),
+        _value(_size, 0),
+        _valid(false),
+        _stats(stats) {
+        _location = uniform->getLocation();
+    }
+    virtual ~VROCachedUniform() {}
+
+    void set(const void *value) {
+        if (_valid && memcmp(value, _value.data(), _size) == 0) {
+            _stats->uploadsAvoided++;
+            return;
+        }
+        memcpy(_value.data(), value, _size);
+        _valid = true;
+        _stats->uploads++;
+        _uniform->set(value);
+    }
+
+    void setInt(int value) {
+        setLeading(&value, sizeof(int));
+    }
+    void setFloat(float value) {
+        setLeading(&value, sizeof(float));
+    }
+    void setVec3(VROVector3f value) {
+        float array[3] = { value.x, value.y, value.z };
+        setLeading(array, sizeof(array));
+    }
+    void setVec4(VROVector4f value) {
+        float array[4] = { value.x, value.y, value.z, value.w };
+        setLeading(array, sizeof(array));
+    }
+    void setMat4(VROMatrix4f value) {
+        setLeading(value.getArray(), 16 * sizeof(float));
+    }
+
+    /*
+     Forget the last value (e.g. after the program is relinked), and pick
+     up the uniform's current location.
+     */
+    void reset() {
+        _valid = false;
+        _location = _uniform->getLocation();
+        _uniform->reset();
+    }
+
+    VROUniform *getUniform() const { return _uniform; }
+    VROUniformFrequency getFrequency() const { return _frequency; }
+
+    static int getComponents(VROShaderProperty type) {
+        switch (type) {
+            case VROShaderProperty::Bool:
+            case VROShaderProperty::Int:
+            case VROShaderProperty::Float:
+                return 1;
+            case VROShaderProperty::Vec2:
+            case VROShaderProperty::BVec2:
+            case VROShaderProperty::IVec2:
+                return 2;
+            case VROShaderProperty::Vec3:
+            case VROShaderProperty::BVec3:
+            case VROShaderProperty::IVec3:
+                return 3;
+            case VROShaderProperty::Vec4:
+            case VROShaderProperty::BVec4:
+            case VROShaderProperty::IVec4:
+            case VROShaderProperty::Mat2:
+                return 4;
+            case VROShaderProperty::Mat3:
+                return 9;
+            case VROShaderProperty::Mat4:
+                return 16;
+        }
+        return 16;
+    }
+
+private:
+
+    /*
+     Set the first size bytes of the value. The underlying uniform is
+     given the whole cached array, so it never reads past the caller's
+     value.
+     */
+    void setLeading(const void *value, int size) {
+        if (_location == -1) {
+            return;
+        }
+        size = std::min(size, _size);
+        if (_valid && memcmp(value, _value.data(), size) == 0) {
+            _stats->uploadsAvoided++;
+            return;
+        }
+        memcpy(_value.data(), value, size);
+        _valid = true;
+        _stats->uploads++;
+        _uniform->set(_value.data());
+    }
+
+    VROUniform *_uniform;
+    VROUniformFrequency _frequency;
+    int _size;
+    std::vector<uint8_t> _value;
+    bool _valid;
+    VROUniformCacheStats *_stats;
+
+};
+
+/*
+ Binds the uniforms of one shader program through VROCachedUniforms,
+ running each uniform's binding block only as often as its frequency
+ requires. Given a draw stream sorted by program and then material, a
+ program's per-pass uniforms are set at its first draw of the pass, its
+ per-material uniforms when the material differs from the previous draw's,
+ and its per-draw uniforms at every draw.
+
+ A frame renders the same program with different cameras (each stereo eye,
+ shadow and other passes), so camera state is per-pass rather than
+ per-frame. Lights are bound per draw, since the renderer selects them per
+ object (VROLight::hashLights).
+
+ Call beginFrame() once per frame and beginPass() at the start of each pass
+ or eye, then bind() for each draw after the program is bound.
+
+ The compiled VROShaderProgram and the material substrates that drive it
+ still bind uniforms themselves and do not go through this cache; a driver
+ must create and use one per program to opt in, and must not let the
+ program's own binders set the uniforms it caches (see VROCachedUniform).
+
+ Cached uniforms point back at this object's stats, so it can be neither
+ copied nor moved; hold it by pointer.
+ */
+class VROProgramUniformCache {
+public:
+
+    VROProgramUniformCache(std::shared_ptr<VROShaderProgram> program) :
+        _program(program), _glProgram(0), _passBound(false),
+        _hasMaterial(false), _lastMaterialId(0) {}
+    virtual ~VROProgramUniformCache() {}
+
+    VROProgramUniformCache(const VROProgramUniformCache &toCopy) = delete;
+    VROProgramUniformCache &operator=(const VROProgramUniformCache &rhs) = delete;
+
+    /*
+     Wrap the program's uniform with the given name in a cache. Returns
+     nullptr if the program has no such uniform. The returned uniform is
+     owned by this object.
+     */
+    VROCachedUniform *addUniform(const std::string &name, VROShaderProperty type, int arraySize,
+                                 VROUniformFrequency frequency) {
+        VROUniform *uniform = _program->getUniform(name);
+        if (!uniform) {
+            return nullptr;
+        }
+        _uniforms.emplace_back(new VROCachedUniform(uniform, type, arraySize, frequency, &_stats));
+        return _uniforms.back().get();
+    }
+
+    /*
+     Add a binding block that computes the named uniform's value. The block
+     receives the cached uniform as a VROUniform, so integers it sets with
+     setInt() are not cached; set them with set().
+     */
+    bool addBinder(const std::string &name, VROShaderProperty type, int arraySize,
+                   VROUniformFrequency frequency, VROUniformBindingBlock bindingBlock) {
+        VROCachedUniform *uniform = addUniform(name, type, arraySize, frequency);
+        if (!uniform) {
+            return false;
+        }
+        _binders[(int) frequency].push_back({ uniform, bindingBlock });
+        return true;
+    }
+
+    /*
+     Start a new frame: resets the stats and begins the frame's first pass.
+     If the program was relinked since the last frame, every cached value is
+     discarded.
+     */
+    void beginFrame() {
+        _stats = VROUniformCacheStats();
+
+        GLuint glProgram = _program->getProgram();
+        if (glProgram != _glProgram) {
+            invalidate();
+            _glProgram = glProgram;
+        }
+        beginPass();
+    }
+
+    /*
+     Start a new pass or eye: per-pass and per-material blocks run again at
+     the next draw. Cached values are kept, so uniforms the new pass sets to
+     the same value are still not re-issued.
+     */
+    void beginPass() {
+        _passBound = false;
+        _hasMaterial = false;
+    }
+
+    /*
+     Set the uniforms for a draw of the given geometry and material. The
+     program must already be bound.
+     */
+    void bind(const VROGeometry *geometry, const VROMaterial *material) {
+        if (!_passBound) {
+            runBinders(VROUniformFrequency::PerPass, geometry, material);
+            _passBound = true;
+        } else {
+            skipBinders(VROUniformFrequency::PerPass);
+        }
+
+        uint32_t materialId = material ? material->getMaterialId() : 0;
+        if (!_hasMaterial || materialId != _lastMaterialId) {
+            runBinders(VROUniformFrequency::PerMaterial, geometry, material);
+            _hasMaterial = true;
+            _lastMaterialId = materialId;
+        } else {
+            skipBinders(VROUniformFrequency::PerMaterial);
+        }
+
+        runBinders(VROUniformFrequency::PerDraw, geometry, material);
+    }
+
+    /*
+     Discard every cached value, so the next set of each uniform is issued.
+     */
+    void invalidate() {
+        for (std::unique_ptr<VROCachedUniform> &uniform : _uniforms) {
+            uniform->reset();
+        }
+        _passBound = false;
+        _hasMaterial = false;
+    }
+
+    std::shared_ptr<VROShaderProgram> getProgram() const { return _program; }
+    const VROUniformCacheStats &getStats() const { return _stats; }
+
+private:
+
+    struct Binder {
+        VROCachedUniform *uniform;
+        VROUniformBindingBlock block;
+    };
+
+    std::shared_ptr<VROShaderProgram> _program;
+    GLuint _glProgram;
+
+    std::vector<std::unique_ptr<VROCachedUniform>> _uniforms;
+    std::vector<Binder> _binders[3];
+
+    bool _passBound;
+    bool _hasMaterial;
+    uint32_t _lastMaterialId;
+    VROUniformCacheStats _stats;
+
+    void runBinders(VROUniformFrequency frequency, const VROGeometry *geometry, const VROMaterial *material) {
+        for (Binder &binder : _binders[(int) frequency]) {
+            binder.block(binder.uniform, geometry, material);
+        }
+        _stats.bindersRun += (int) _binders[(int) frequency].size();
+    }
+
+    void skipBinders(VROUniformFrequency frequency) {
+        _stats.bindersSkipped += (int) _binders[(int) frequency].size();
+    }
+
+};
+
+#endif /* VROUniformCache_h */
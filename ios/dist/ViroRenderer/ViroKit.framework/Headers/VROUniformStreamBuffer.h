@@ -0,0 +1,421 @@
+//
+//  VROUniformStreamBuffer.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROUniformStreamBuffer_h
+#define VROUniformStreamBuffer_h
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include "VROOpenGL.h"
+#include "VROMatrix4f.h"
+#include "VROVector4f.h"
+#include "VROTime.h"
+#include "VROLog.h"
+
+/*
+ Binding points for streamed blocks, following those assigned in
+ VROShaderProgram.
+ */
+static const int kStreamedTransformsUBOBindingPoint = 5;
+static const int kStreamedMaterialUBOBindingPoint = 6;
+
+/*
+ Number of frame segments in the ring, matching the Metal VROConcurrentBuffer.
+ */
+static const int kUniformStreamSegments = 3;
+
+struct VROUniformStreamStats {
+    int allocations = 0;          // Blocks allocated this frame
+    int bytesWritten = 0;         // Bytes of uniform data streamed this frame
+    int apiCalls = 0;             // GL calls made by the stream (map, upload, bind, fence)
+    int bindCalls = 0;            // glBindBufferRange calls issued
+    int bindsElided = 0;          // Binds skipped because the range was already bound
+    int overflows = 0;            // Allocations that did not fit in the segment
+    int fenceWaits = 0;           // Segments that were still in use by the GPU
+    int fenceTimeouts = 0;        // Segments still in use after the timeout, replaced by new storage
+    double fenceWaitMs = 0;       // Time blocked on segment fences
+    double submitTimeMs = 0;      // CPU time in allocation, upload and binding
+};
+
+/*
+ A region of the stream buffer holding one uniform block for one draw.
+ */
+struct VROUniformAllocation {
+    int offset = -1;              // Byte offset into the stream buffer, or -1 if allocation failed
+    int size = 0;
+    uint8_t *data = nullptr;      // CPU-visible destination for the block's contents
+
+    bool isValid() const {
+        return offset >= 0;
+    }
+};
+
+/*
+ Writes values into a uniform block using std140 layout rules.
+ */
+class VROStd140Writer {
+public:
+
+    VROStd140Writer(const VROUniformAllocation &allocation) :
+        _data(allocation.data), _size(allocation.size), _offset(0) {}
+
+    void writeFloat(float value) { write(&value, 1, 4); }
+    void writeInt(int value) { write(&value, 1, 4); }
+    void writeVec4(VROVector4f value) {
+        float array[4] = { value.x, value.y, value.z, value.w };
+        write(array, 4, 16);
+    }
+    void writeMat4(const VROMatrix4f &value) { write(value.getArray(), 16, 16); }
+
+    /*
+     Arrays of scalars or vectors are padded to 16 bytes per element.
+     */
+    void writeVec4Array(const float *values, int count) { write(values, count * 4, 16); }
+
+    int getOffset() const { return _offset; }
+
+private:
+
+    uint8_t *_data;
+    int _size;
+    int _offset;
+
+    void write(const void *value, int floats, int alignment) {
+        _offset = (_offset + alignment - 1) & ~(alignment - 1);
+        int bytes = floats * 4;
+        if (_offset + bytes > _size) {
+            pabort("Uniform block overflow: %d bytes at offset %d, block size %d", bytes, _offset, _size);
+        }
+        memcpy(_data + _offset, value, bytes);
+        _offset += bytes;
+    }
+};
+
+/*
+ Streams per-draw uniform blocks (transforms and material parameters) for
+ the OpenGL driver through one large uniform buffer. This replaces a
+ glUniform* call per uniform per draw with one upload per frame and one
+ glBindBufferRange per block.
+
+ The buffer is split into kUniformStreamSegments segments, one per frame in
+ flight. Each segment is guarded by a fence, and the CPU only writes a
+ segment once the GPU is done with it. If the GPU still holds the segment
+ after a one second wait, the whole buffer is replaced with new storage
+ rather than overwritten; GL keeps the old storage alive until the GPU has
+ finished with it. Blocks are sub-allocated linearly at
+ GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+
+ GLES 3.0 has no persistent mapping, so a frame runs in two phases:
+
+ 1. beginFrame(), then allocate() and fill a block for each draw;
+ 2. commit() uploads the segment, then bind() each block at draw time.
+
+ The upload maps the segment unsynchronized, or uses one glBufferSubData
+ where VRO_AVOID_BUFFER_SUB_DATA is not set. endFrame() fences the segment.
+ If a frame overflows its segment, the buffer is grown at the next
+ beginFrame(); until then allocate() returns an invalid allocation and the
+ caller falls back to setting uniforms directly.
+
+ commit() leaves GL_UNIFORM_BUFFER unbound. bind() uses glBindBufferRange,
+ which also sets the GL_UNIFORM_BUFFER binding, as the glBindBufferBase
+ calls in VROShaderProgram do.
+
+ VROMipChainBloom streams its per-pass parameters through this buffer. The
+ OpenGL driver and VROShaderProgram are compiled into the framework and
+ still set each uniform with glUniform*; adopting the stream there means
+ allocating blocks in their draw path, whose sources are not in these
+ headers.
+ */
+class VROUniformStreamBuffer {
+public:
+
+    VROUniformStreamBuffer(int segmentSize = 256 * 1024) :
+        _buffer(0), _segmentSize(0), _requestedSegmentSize(segmentSize),
+        _alignment(256), _frame(0), _segment(0), _head(0), _committed(false) {
+        for (int i = 0; i < kUniformStreamSegments; i++) {
+            _fences[i] = 0;
+        }
+        for (int i = 0; i < kMaxBindingPoints; i++) {
+            _boundOffset[i] = -1;
+            _boundSize[i] = 0;
+        }
+    }
+
+    virtual ~VROUniformStreamBuffer() {
+        for (int i = 0; i < kUniformStreamSegments; i++) {
+            if (_fences[i]) {
+                GL( glDeleteSync(_fences[i]) );
+            }
+        }
+        if (_buffer) {
+            GL( glDeleteBuffers(1, &_buffer) );
+        }
+    }
+
+    /*
+     Begin writing the next frame's segment, waiting for the GPU if it is
+     still reading it. Must be called on the rendering thread.
+     */
+    void beginFrame() {
+        double start = VROTimeCurrentMillis();
+        _stats = VROUniformStreamStats();
+
+        if (_buffer == 0 || _requestedSegmentSize > _segmentSize) {
+            allocateBuffer();
+        }
+
+        _segment = (int) (_frame % kUniformStreamSegments);
+        if (!waitForSegment(_segment)) {
+            pinfo("Uniform stream segment %d still in use after timeout, replacing buffer", _segment);
+            _stats.fenceTimeouts++;
+            allocateBuffer();
+        }
+
+        _head = 0;
+        _committed = false;
+        _staging.resize(_segmentSize);
+        for (int i = 0; i < kMaxBindingPoints; i++) {
+            _boundOffset[i] = -1;
+        }
+        _stats.submitTimeMs += VROTimeCurrentMillis() - start - _stats.fenceWaitMs;
+    }
+
+    /*
+     Allocate a block of the given size in this frame's segment. The block's
+     contents must be written before commit().
+     */
+    VROUniformAllocation allocate(int size) {
+        VROUniformAllocation allocation;
+        passert (!_committed);
+
+        int offset = (_head + _alignment - 1) / _alignment * _alignment;
+        if (offset + size > _segmentSize) {
+            _stats.overflows++;
+            _requestedSegmentSize = std::max(_requestedSegmentSize, _segmentSize * 2);
+            return allocation;
+        }
+        allocation.offset = _segment * _segmentSize + offset;
+        allocation.size = size;
+        allocation.data = &_staging[offset];
+        _head = offset + size;
+
+        _stats.allocations++;
+        _stats.bytesWritten += size;
+        return allocation;
+    }
+
+    /*
+     Upload everything allocated this frame to the GPU.
+     */
+    void commit() {
+        if (_committed) {
+            return;
+        }
+        _committed = true;
+        if (_head == 0) {
+            return;
+        }
+        double start = VROTimeCurrentMillis();
+        GLintptr offset = (GLintptr) _segment * _segmentSize;
+
+        GL( glBindBuffer(GL_UNIFORM_BUFFER, _buffer) );
+        _stats.apiCalls++;
+
+        bool uploaded = false;
+#if VRO_AVOID_BUFFER_SUB_DATA
+        // Only a successful map may be unmapped. If mapping fails, or the
+        // unmap reports the store was lost, fall back to glBufferSubData
+        void *dest = glMapBufferRange(GL_UNIFORM_BUFFER, offset, _head,
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        _stats.apiCalls++;
+        if (dest) {
+            memcpy(dest, _staging.data(), _head);
+            uploaded = glUnmapBuffer(GL_UNIFORM_BUFFER) == GL_TRUE;
+            _stats.apiCalls++;
+        }
+        else {
+            pinfo("Uniform stream segment %d could not be mapped [error %d]", _segment, glGetError());
+        }
+#endif
+        if (!uploaded) {
+            GL( glBufferSubData(GL_UNIFORM_BUFFER, offset, _head, _staging.data()) );
+            _stats.apiCalls++;
+        }
+        GL( glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+        _stats.apiCalls++;
+        _stats.submitTimeMs += VROTimeCurrentMillis() - start;
+    }
+
+    /*
+     Bind the given block to a uniform block binding point. Rebinding the
+     range already bound to that point is skipped.
+     */
+    void bind(const VROUniformAllocation &allocation, int bindingPoint) {
+        if (!allocation.isValid()) {
+            return;
+        }
+        passert (_committed);
+        if (bindingPoint < kMaxBindingPoints &&
+            _boundOffset[bindingPoint] == allocation.offset && _boundSize[bindingPoint] == allocation.size) {
+            _stats.bindsElided++;
+            return;
+        }
+        double start = VROTimeCurrentMillis();
+        GL( glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, _buffer, allocation.offset, allocation.size) );
+        if (bindingPoint < kMaxBindingPoints) {
+            _boundOffset[bindingPoint] = allocation.offset;
+            _boundSize[bindingPoint] = allocation.size;
+        }
+        _stats.bindCalls++;
+        _stats.apiCalls++;
+        _stats.submitTimeMs += VROTimeCurrentMillis() - start;
+    }
+
+    /*
+     Fence this frame's segment so it is not overwritten while the GPU may
+     still read it.
+     */
+    void endFrame() {
+        commit();
+        if (_fences[_segment]) {
+            GL( glDeleteSync(_fences[_segment]) );
+        }
+        _fences[_segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _stats.apiCalls++;
+        _lastFrameStats = _stats;
+        _frame++;
+    }
+
+    /*
+     Bind the named uniform block of the given program to a binding point,
+     after linking. Returns false if the program has no such block.
+     */
+    static bool bindBlock(GLuint program, const char *blockName, int bindingPoint) {
+        GLuint index = glGetUniformBlockIndex(program, blockName);
+        if (index == GL_INVALID_INDEX) {
+            return false;
+        }
+        GL( glUniformBlockBinding(program, index, bindingPoint) );
+        return true;
+    }
+
+    int getSegmentSize() const { return _segmentSize; }
+    int getAlignment() const { return _alignment; }
+    const VROUniformStreamStats &getStats() const { return _stats; }
+    const VROUniformStreamStats &getLastFrameStats() const { return _lastFrameStats; }
+
+private:
+
+    static const int kMaxBindingPoints = 16;
+    static const GLuint64 kFenceTimeoutNs = 1000000000;
+
+    GLuint _buffer;
+    int _segmentSize;
+    int _requestedSegmentSize;
+    int _alignment;
+
+    uint64_t _frame;
+    int _segment;
+    int _head;
+    bool _committed;
+
+    /*
+     Contents of the current segment, written by allocate() callers and
+     uploaded by commit().
+     */
+    std::vector<uint8_t> _staging;
+    GLsync _fences[kUniformStreamSegments];
+
+    /*
+     Range bound to each binding point during the current frame.
+     */
+    int _boundOffset[kMaxBindingPoints];
+    int _boundSize[kMaxBindingPoints];
+
+    VROUniformStreamStats _stats;
+    VROUniformStreamStats _lastFrameStats;
+
+    /*
+     Create the buffer at the requested segment size. An existing buffer is
+     deleted without waiting on its fences: GL keeps its storage alive until
+     the GPU has finished reading it, and the new storage is not in use.
+     */
+    void allocateBuffer() {
+        for (int i = 0; i < kUniformStreamSegments; i++) {
+            if (_fences[i]) {
+                GL( glDeleteSync(_fences[i]) );
+                _fences[i] = 0;
+            }
+        }
+        if (_buffer) {
+            GL( glDeleteBuffers(1, &_buffer) );
+        }
+        GLint alignment = 0;
+        GL( glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment) );
+        if (alignment > 0) {
+            _alignment = alignment;
+        }
+        _segmentSize = (_requestedSegmentSize + _alignment - 1) / _alignment * _alignment;
+        _requestedSegmentSize = _segmentSize;
+
+        GL( glGenBuffers(1, &_buffer) );
+        GL( glBindBuffer(GL_UNIFORM_BUFFER, _buffer) );
+        GL( glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr) _segmentSize * kUniformStreamSegments, nullptr, GL_STREAM_DRAW) );
+        GL( glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+        _stats.apiCalls += 5;
+        pinfo("Uniform stream buffer allocated: %d segments of %d bytes", kUniformStreamSegments, _segmentSize);
+    }
+
+    /*
+     Wait for the GPU to finish reading the given segment. Returns false if
+     it is still in use after kFenceTimeoutNs; its fence is then kept.
+     */
+    bool waitForSegment(int segment) {
+        if (!_fences[segment]) {
+            return true;
+        }
+        double start = VROTimeCurrentMillis();
+        GLenum result = glClientWaitSync(_fences[segment], 0, 0);
+        _stats.apiCalls++;
+        if (result == GL_TIMEOUT_EXPIRED) {
+            _stats.fenceWaits++;
+            result = glClientWaitSync(_fences[segment], GL_SYNC_FLUSH_COMMANDS_BIT, kFenceTimeoutNs);
+            _stats.apiCalls++;
+        }
+        _stats.fenceWaitMs += VROTimeCurrentMillis() - start;
+        if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+            return false;
+        }
+        GL( glDeleteSync(_fences[segment]) );
+        _stats.apiCalls++;
+        _fences[segment] = 0;
+        return true;
+    }
+
+};
+
+#endif /* VROUniformStreamBuffer_h */
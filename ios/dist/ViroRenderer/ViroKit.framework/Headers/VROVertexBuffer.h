@@ -0,0 +1,53 @@
+//
+//  VROVertexBuffer.h
+//  ViroRenderer
+//
+//  Copyright © 2026 Viro Media. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining
+//  a copy of this software and associated documentation files (the
+//  "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to
+//  permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included
+//  in all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//  CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef VROVertexBuffer_h
+#define VROVertexBuffer_h
+
+#include <memory>
+
+class VROData;
+
+/*
+ Vertex data shared between geometry sources, uploaded to the GPU by
+ hydrate(). Created by VRODriver::newVertexBuffer. VROVertexBufferOpenGL
+ reads _data at the offset it has here, which VROPlatformInterfaceTests
+ checks along with the vtable.
+ */
+class VROVertexBuffer {
+public:
+    VROVertexBuffer(std::shared_ptr<VROData> data) :
+        _data(data) {}
+    virtual ~VROVertexBuffer() {}
+
+    virtual void hydrate() = 0;
+
+protected:
+
+    std::shared_ptr<VROData> _data;
+
+};
+
+#endif /* VROVertexBuffer_h */
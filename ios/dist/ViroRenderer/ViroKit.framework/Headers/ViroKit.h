@@ -177,6 +177,8 @@ FOUNDATION_EXPORT const unsigned char ViroKitVersionString[];
 #import <ViroKit/VROGeometryUtil.h>
 #import <ViroKit/VROTextureUtil.h>
 #import <ViroKit/VROTaskQueue.h>
+#import <ViroKit/VROThreadPool.h>
+#import <ViroKit/VROSIMD.h>
 #import <ViroKit/VRODeviceUtil.h>
 
 // Physics